@@ -32,6 +32,46 @@
 #include "AudioVisualNotifications.h"
 #include "Adafruit_NeoPixel.h"
 
+// Keyframe tables of the visual notifications, played by the LedAnimator.
+// Each keyframe sets the colors of the first two NeoPixels for a duration in milliseconds.
+static constexpr LedKeyframe NOT_READY_KEYFRAMES[] = {
+  { { LED_COLOR_RED, LED_COLOR_OFF }, 240, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_RED }, 240, LED_EASING_STEP }
+};
+
+// Four short blinks in a burst, then a pause before the next burst.
+static constexpr LedKeyframe READY_TO_SEND_KEYFRAMES[] = {
+  { { LED_COLOR_GREEN, LED_COLOR_GREEN }, 40, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_OFF }, 40, LED_EASING_STEP },
+  { { LED_COLOR_GREEN, LED_COLOR_GREEN }, 40, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_OFF }, 40, LED_EASING_STEP },
+  { { LED_COLOR_GREEN, LED_COLOR_GREEN }, 40, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_OFF }, 40, LED_EASING_STEP },
+  { { LED_COLOR_GREEN, LED_COLOR_GREEN }, 40, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_OFF }, 1240, LED_EASING_STEP }
+};
+
+static constexpr LedKeyframe WAITING_GNSS_FIX_KEYFRAMES[] = {
+  { { LED_COLOR_BLUE, LED_COLOR_OFF }, 240, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_BLUE }, 240, LED_EASING_STEP }
+};
+
+static constexpr LedKeyframe LOADING_KEYFRAMES[] = {
+  { { LED_COLOR_MAGENTA, LED_COLOR_OFF }, 240, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_MAGENTA }, 240, LED_EASING_STEP }
+};
+
+static constexpr LedKeyframe MAINTENANCE_KEYFRAMES[] = {
+  { { LED_COLOR_MAGENTA, LED_COLOR_MAGENTA }, 240, LED_EASING_STEP },
+  { { LED_COLOR_OFF, LED_COLOR_OFF }, 240, LED_EASING_STEP }
+};
+
+static constexpr LedAnimation NOT_READY_ANIMATION = loopingAnimation(NOT_READY_KEYFRAMES);
+static constexpr LedAnimation READY_TO_SEND_ANIMATION = loopingAnimation(READY_TO_SEND_KEYFRAMES);
+static constexpr LedAnimation WAITING_GNSS_FIX_ANIMATION = loopingAnimation(WAITING_GNSS_FIX_KEYFRAMES);
+static constexpr LedAnimation LOADING_ANIMATION = loopingAnimation(LOADING_KEYFRAMES);
+static constexpr LedAnimation MAINTENANCE_ANIMATION = loopingAnimation(MAINTENANCE_KEYFRAMES);
+
 /**
 * @brief Constructs an instance of the AudioVisualNotifications class.
 *
@@ -48,7 +88,8 @@ AudioVisualNotifications::AudioVisualNotifications(int neoPixelPin, int neoPixel
     _neoPixelCount(neoPixelCount),
     _neoPixelBrightness(neoPixelBrightness),
     _speakerPin(speakerPin),
-    _neoPixel(neoPixelCount, neoPixelPin, NEO_GRB + NEO_KHZ800) {
+    _neoPixel(neoPixelCount, neoPixelPin, NEO_GRB + NEO_KHZ800),
+    _animator(_neoPixel) {
 }
 
 /**
@@ -56,22 +97,23 @@ AudioVisualNotifications::AudioVisualNotifications(int neoPixelPin, int neoPixel
 *
 * This function initializes the NeoPixel LED strip with the specified pin and settings
 * provided during the construction of the SensoryAlert object.
+* It also creates the frame timer that plays the visual notifications.
 * It should be called once at the beginning of the program or whenever the NeoPixel strip needs to be re-initialized.
 */
 void AudioVisualNotifications::initializeVisualNotifications() {
   _neoPixel.begin();                             // INITIALIZE NeoPixel strip object (REQUIRED)
   _neoPixel.setBrightness(_neoPixelBrightness);  // Set BRIGHTNESS to about 1/5 (max = 255)
+  _animator.begin();                             // Create the frame timer of the animations
 }
 
 /**
 * @brief Clears all visual notifications.
 *
-* This function turns off all NeoPixels in the LED strip, effectively clearing any previous colors or patterns.
+* This function stops the playing animation and turns off all NeoPixels in the LED strip, effectively clearing any previous colors or patterns.
 * It can be used to reset the NeoPixel strip to its default state or turn off any active visual feedback.
 */
 void AudioVisualNotifications::clearAllVisualNotifications() {
-  _neoPixel.clear();
-  _neoPixel.show();
+  _animator.stop();
 }
 
 /**
@@ -145,24 +187,10 @@ void AudioVisualNotifications::maintenanceAudioNotification() {
 * by alternating the color of the first two NeoPixels between red and black.
 * It can be used as part of the device initialization process or when certain conditions are not met for operation.
 *
-* @note This function alternates the color of the first two NeoPixels between red and black to indicate a not-ready state,
-*       pausing for a brief interval between color changes.
+* @note This function returns immediately. The animation keeps looping until another indication replaces it.
 */
 void AudioVisualNotifications::notReadyVisualNotification() {
-  uint32_t interval = 240;
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(255, 0, 0));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(0, 0, 0));
-  _neoPixel.show();
-
-  delay(interval);
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(0, 0, 0));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(255, 0, 0));
-  _neoPixel.show();
-
-  // clearNeoPixel();
-  delay(interval);
+  _animator.play(NOT_READY_ANIMATION);
 }
 
 /**
@@ -172,26 +200,10 @@ void AudioVisualNotifications::notReadyVisualNotification() {
 * by blinking the first two NeoPixels in green color for a specified number of times in bursts.
 * It can be used to indicate that the device has completed its initialization process and is ready for operation.
 *
-* @param delayBeforeNextBurst The delay (in milliseconds) before starting the next burst of blinks.
-* @param blinkCount The number of times the NeoPixels should blink in one burst.
+* @note This function returns immediately. The animation keeps looping until another indication replaces it.
 */
 void AudioVisualNotifications::readyToSendVisualNotification() {
-  uint32_t delayBeforeNextBurst = 1200;
-  int blinkCount = 4;
-
-  // Loop through the specified number of blinks in one burst.
-  for (int i = 0; i < blinkCount; ++i) {
-    _neoPixel.setPixelColor(0, _neoPixel.Color(0, 255, 0));
-    _neoPixel.setPixelColor(1, _neoPixel.Color(0, 255, 0));
-    _neoPixel.show();
-
-    delay(40);
-    clearAllVisualNotifications();
-    delay(40);
-  }
-
-  // Add a delay before starting the next burst.
-  delay(delayBeforeNextBurst);
+  _animator.play(READY_TO_SEND_ANIMATION);
 }
 
 /**
@@ -201,24 +213,10 @@ void AudioVisualNotifications::readyToSendVisualNotification() {
 * by alternating the color of the first two NeoPixels between blue and black.
 * It can be used in applications where GNSS data is required for operation and the device is waiting for a valid signal.
 *
-* @note This function alternates the color of the first two NeoPixels between blue and black to indicate a waiting state for a GNSS fix,
-*       pausing for a brief interval between color changes.
+* @note This function returns immediately. The animation keeps looping until another indication replaces it.
 */
 void AudioVisualNotifications::waitingGnssFixVisualNotification() {
-  uint32_t interval = 240;
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(0, 0, 255));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(0, 0, 0));
-  _neoPixel.show();
-
-  delay(interval);
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(0, 0, 0));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(0, 0, 255));
-  _neoPixel.show();
-
-  // clearNeoPixel();
-  delay(interval);
+  _animator.play(WAITING_GNSS_FIX_ANIMATION);
 }
 
 /**
@@ -227,24 +225,10 @@ void AudioVisualNotifications::waitingGnssFixVisualNotification() {
 * This function visually indicates a loading state by alternating the color of the first two NeoPixels between magenta and black.
 * It can be used to provide visual feedback when the device is performing initialization or loading tasks.
 *
-* @note This function alternates the color of the first two NeoPixels between magenta and black to indicate a loading state,
-*       pausing for a brief interval between color changes.
+* @note This function returns immediately. The animation keeps looping until another indication replaces it.
 */
 void AudioVisualNotifications::loadingVisualNotification() {
-  uint32_t interval = 240;
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(255, 0, 255));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(0, 0, 0));
-  _neoPixel.show();
-
-  delay(interval);
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(0, 0, 0));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(255, 0, 255));
-  _neoPixel.show();
-
-  // clearNeoPixel();
-  delay(interval);
+  _animator.play(LOADING_ANIMATION);
 }
 
 /**
@@ -254,17 +238,8 @@ void AudioVisualNotifications::loadingVisualNotification() {
 * It can be used to temporarily signal that the device is undergoing maintenance or configuration changes,
 * without actually setting the device to a specific mode.
 *
-* @note This function illuminates the first two NeoPixels with magenta color to indicate maintenance mode,
-*       pauses for a brief interval, then clears the NeoPixel strip.
+* @note This function returns immediately. The animation keeps looping until another indication replaces it.
 */
 void AudioVisualNotifications::maintenanceVisualNotification() {
-  uint32_t interval = 240;
-
-  _neoPixel.setPixelColor(0, _neoPixel.Color(255, 0, 255));
-  _neoPixel.setPixelColor(1, _neoPixel.Color(255, 0, 255));
-  _neoPixel.show();
-
-  delay(interval);
-  clearAllVisualNotifications();
-  delay(interval);
+  _animator.play(MAINTENANCE_ANIMATION);
 }
\ No newline at end of file
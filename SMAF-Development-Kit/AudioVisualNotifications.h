@@ -33,6 +33,14 @@
 
 #include "Arduino.h"
 #include "Adafruit_NeoPixel.h"
+#include "LedAnimator.h"
+
+// Define notification colors as packed 0xRRGGBB values.
+#define LED_COLOR_OFF 0x000000      // Pixel turned off.
+#define LED_COLOR_RED 0xFF0000      // Not ready.
+#define LED_COLOR_GREEN 0x00FF00    // Ready to send.
+#define LED_COLOR_BLUE 0x0000FF     // Waiting for GNSS fix.
+#define LED_COLOR_MAGENTA 0xFF00FF  // Loading and maintenance.
 
 // Define piano notes.
 #define NOTE_B0 31
@@ -145,6 +153,7 @@ public:
   *
   * This function initializes the NeoPixel LED strip with the specified pin and settings
   * provided during the construction of the SensoryAlert object.
+  * It also creates the frame timer that plays the visual notifications.
   * It should be called once at the beginning of the program or whenever the NeoPixel strip needs to be re-initialized.
   */
   void initializeVisualNotifications();
@@ -152,7 +161,7 @@ public:
   /**
   * @brief Clears all visual notifications.
   *
-  * This function turns off all NeoPixels in the LED strip, effectively clearing any previous colors or patterns.
+  * This function stops the playing animation and turns off all NeoPixels in the LED strip, effectively clearing any previous colors or patterns.
   * It can be used to reset the NeoPixel strip to its default state or turn off any active visual feedback.
   */
   void clearAllVisualNotifications();
@@ -180,8 +189,7 @@ public:
   * by alternating the color of the first two NeoPixels between red and black.
   * It can be used as part of the device initialization process or when certain conditions are not met for operation.
   *
-  * @note This function alternates the color of the first two NeoPixels between red and black to indicate a not-ready state,
-  *       pausing for a brief interval between color changes.
+  * @note This function returns immediately. The animation keeps looping until another indication replaces it.
   */
   void notReadyVisualNotification();
 
@@ -192,8 +200,7 @@ public:
   * by blinking the first two NeoPixels in green color for a specified number of times in bursts.
   * It can be used to indicate that the device has completed its initialization process and is ready for operation.
   *
-  * @param delayBeforeNextBurst The delay (in milliseconds) before starting the next burst of blinks.
-  * @param blinkCount The number of times the NeoPixels should blink in one burst.
+  * @note This function returns immediately. The animation keeps looping until another indication replaces it.
   */
   void readyToSendVisualNotification();
 
@@ -204,8 +211,7 @@ public:
   * by alternating the color of the first two NeoPixels between blue and black.
   * It can be used in applications where GNSS data is required for operation and the device is waiting for a valid signal.
   *
-  * @note This function alternates the color of the first two NeoPixels between blue and black to indicate a waiting state for a GNSS fix,
-  *       pausing for a brief interval between color changes.
+  * @note This function returns immediately. The animation keeps looping until another indication replaces it.
   */
   void waitingGnssFixVisualNotification();
 
@@ -215,8 +221,7 @@ public:
   * This function visually indicates a loading state by alternating the color of the first two NeoPixels between magenta and black.
   * It can be used to provide visual feedback when the device is performing initialization or loading tasks.
   *
-  * @note This function alternates the color of the first two NeoPixels between magenta and black to indicate a loading state,
-  *       pausing for a brief interval between color changes.
+  * @note This function returns immediately. The animation keeps looping until another indication replaces it.
   */
   void loadingVisualNotification();
 
@@ -227,8 +232,7 @@ public:
   * It can be used to temporarily signal that the device is undergoing maintenance or configuration changes,
   * without actually setting the device to a specific mode.
   *
-  * @note This function illuminates the first two NeoPixels with magenta color to indicate maintenance mode,
-  *       pauses for a brief interval, then clears the NeoPixel strip.
+  * @note This function returns immediately. The animation keeps looping until another indication replaces it.
   */
   void maintenanceVisualNotification();
 
@@ -238,6 +242,7 @@ private:
   int _neoPixelBrightness;
   int _speakerPin;
   Adafruit_NeoPixel _neoPixel;  // Declare neoPixel as a member variable
+  LedAnimator _animator;        // Plays the visual notifications on neoPixel
 };
 
 #endif
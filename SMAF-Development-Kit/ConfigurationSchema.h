@@ -0,0 +1,183 @@
+/**
+* @file ConfigurationSchema.h
+* @brief Declaration of the configuration schema shared by all configuration code.
+*
+* This file contains the table of all configuration settings with their key, type,
+* default, bounds, label and secret flag. Loading, saving, validating and rendering
+* the configuration all work from this table, and the storage layout of the values
+* is derived from it at compile time, so a new setting is a single line.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef CONFIGURATION_SCHEMA_H
+#define CONFIGURATION_SCHEMA_H
+
+#include "Arduino.h"
+
+// Define constant strings for Wi-Fi network configuration.
+#define NETWORK_NAME "netName"  // Wi-Fi network name.
+#define NETWORK_PASS "netPass"  // Wi-Fi network password.
+
+// Define constant strings for MQTT configuration.
+#define MQTT_SERVER_ADDRESS "mqttSrvAdr"    // MQTT server address.
+#define MQTT_SERVER_PORT "mqttSrvPort"      // MQTT server port.
+#define MQTT_USERNAME "mqttUser"            // MQTT username.
+#define MQTT_PASS "mqttPass"                // MQTT password.
+#define MQTT_CLIENT_ID "mqttClient"         // MQTT client ID.
+#define MQTT_TOPIC "mqttTopic"              // MQTT topic.
+#define AUDIO_NOTIFICATIONS "audioNotif"    // Audio Notifications status.
+#define VISUAL_NOTIFICATIONS "visualNotif"  // Visual Notifications status.
+
+// Define constant strings for device access.
+#define ADMIN_PASS "adminPass"    // Password of the configuration server outside configuration mode.
+#define FIRMWARE_HOST "fwHost"    // Only server firmware updates are downloaded from.
+#define MQTT_IMPORT "mqttImport"  // Import configurations published on the MQTT configuration topic.
+
+// Define the flags reported by reloadPreferences() for the preferences that changed.
+#define CONFIG_CHANGED_NETWORK 0x01        // Wi-Fi network name or password.
+#define CONFIG_CHANGED_MQTT_BROKER 0x02    // MQTT server address, port, username, password or client ID.
+#define CONFIG_CHANGED_MQTT_TOPIC 0x04     // MQTT topic or configuration import.
+#define CONFIG_CHANGED_NOTIFICATIONS 0x08  // Audio or visual notifications.
+
+// Define the value of string settings that were never saved.
+#define CONFIG_UNSET_STRING "Unknown"
+
+// Enumeration of the types of configuration settings.
+enum ConfigurationTypeEnum : byte {
+  CONFIG_TYPE_STRING,  // Text, stored in a slot of its maximum length plus the terminator.
+  CONFIG_TYPE_NUMBER,  // Unsigned integer, stored in two bytes.
+  CONFIG_TYPE_BOOLEAN  // Switch, stored in one byte.
+};
+
+// Structure describing one configuration setting.
+struct ConfigurationField {
+  const char* key;             // Preference key, form field name and JSON name.
+  ConfigurationTypeEnum type;  // Type of the value.
+  const char* label;           // Label of the field on the configuration page.
+  const char* section;         // ID of the configuration page section showing the field.
+  const char* defaultString;   // Default of string settings.
+  uint16_t defaultNumber;      // Default of number and boolean settings.
+  uint16_t minimum;            // Minimum of numbers, or minimum length of non-empty strings.
+  uint16_t maximum;            // Maximum of numbers, or maximum length of strings.
+  bool isRequired;             // False if strings may be empty.
+  bool isSecret;               // Masked on the configuration page and in logs.
+  bool isDeviceSpecific;       // Kept by the device when a configuration is imported.
+  uint8_t changed;             // CONFIG_CHANGED_* flag reported when the value changes.
+};
+
+/**
+* @brief Describe a string setting.
+*/
+constexpr ConfigurationField stringSetting(const char* key, const char* label, const char* section, const char* defaultValue, uint16_t minimum, uint16_t maximum, bool isRequired, bool isSecret, bool isDeviceSpecific, uint8_t changed) {
+  return { key, CONFIG_TYPE_STRING, label, section, defaultValue, 0, minimum, maximum, isRequired, isSecret, isDeviceSpecific, changed };
+}
+
+/**
+* @brief Describe a number setting.
+*/
+constexpr ConfigurationField numberSetting(const char* key, const char* label, const char* section, uint16_t defaultValue, uint16_t minimum, uint16_t maximum, uint8_t changed) {
+  return { key, CONFIG_TYPE_NUMBER, label, section, nullptr, defaultValue, minimum, maximum, true, false, false, changed };
+}
+
+/**
+* @brief Describe a boolean setting.
+*/
+constexpr ConfigurationField booleanSetting(const char* key, const char* label, const char* section, bool defaultValue, uint8_t changed) {
+  return { key, CONFIG_TYPE_BOOLEAN, label, section, nullptr, defaultValue, 0, 1, false, false, false, changed };
+}
+
+// All configuration settings, in the order of the configuration page sections.
+// Strings: key, label, section, default, minimum and maximum length, required, secret, device specific, changed flag.
+// Numbers: key, label, section, default, minimum, maximum, changed flag.
+// Booleans: key, label, section, default, changed flag.
+// The table defines the layout of the saved record, increase CONFIG_RECORD_VERSION when it changes.
+static constexpr ConfigurationField CONFIGURATION_SCHEMA[] = {
+  stringSetting(NETWORK_NAME, "Select SSID", "network", CONFIG_UNSET_STRING, 1, 32, true, false, false, CONFIG_CHANGED_NETWORK),  // SSIDs have at most 32 bytes.
+  stringSetting(NETWORK_PASS, "SSID Password", "network", CONFIG_UNSET_STRING, 8, 63, false, true, false, CONFIG_CHANGED_NETWORK),  // WPA2 passphrases have 8 to 63 characters, open networks none.
+  stringSetting(MQTT_SERVER_ADDRESS, "MQTT Server", "broker", CONFIG_UNSET_STRING, 1, 64, true, false, false, CONFIG_CHANGED_MQTT_BROKER),
+  numberSetting(MQTT_SERVER_PORT, "MQTT Port", "broker", 0, 1, UINT16_MAX, CONFIG_CHANGED_MQTT_BROKER),
+  stringSetting(MQTT_USERNAME, "MQTT Username", "broker", CONFIG_UNSET_STRING, 0, 64, false, false, false, CONFIG_CHANGED_MQTT_BROKER),
+  stringSetting(MQTT_PASS, "MQTT Password", "broker", CONFIG_UNSET_STRING, 0, 64, false, true, false, CONFIG_CHANGED_MQTT_BROKER),
+  stringSetting(MQTT_CLIENT_ID, "MQTT Client ID", "client", CONFIG_UNSET_STRING, 1, 64, true, false, true, CONFIG_CHANGED_MQTT_BROKER),
+  stringSetting(MQTT_TOPIC, "MQTT Topic", "client", CONFIG_UNSET_STRING, 1, 128, true, false, true, CONFIG_CHANGED_MQTT_TOPIC),
+  booleanSetting(AUDIO_NOTIFICATIONS, "Enable audio notifications", "notifications", true, CONFIG_CHANGED_NOTIFICATIONS),
+  booleanSetting(VISUAL_NOTIFICATIONS, "Enable visual notifications", "notifications", true, CONFIG_CHANGED_NOTIFICATIONS),
+  stringSetting(ADMIN_PASS, "Admin Password", "device", "", 8, 64, false, true, true, 0),  // Empty keeps the server closed outside configuration mode.
+  stringSetting(FIRMWARE_HOST, "Firmware Server", "device", "", 1, 64, false, false, false, 0),  // Empty disables firmware downloads.
+  booleanSetting(MQTT_IMPORT, "Import configurations over MQTT", "device", false, CONFIG_CHANGED_MQTT_TOPIC)  // Off, anyone publishing to the broker could reconfigure the device.
+};
+
+// Number of configuration settings.
+static constexpr size_t CONFIGURATION_FIELD_COUNT = sizeof(CONFIGURATION_SCHEMA) / sizeof(CONFIGURATION_SCHEMA[0]);
+
+/**
+* @brief Check if a setting is stored with the strings.
+*/
+constexpr bool isStringSetting(size_t index) {
+  return CONFIGURATION_SCHEMA[index].type == CONFIG_TYPE_STRING;
+}
+
+/**
+* @brief Get the size of the stored value of a setting in bytes.
+*/
+constexpr size_t settingSize(size_t index) {
+  return isStringSetting(index) ? CONFIGURATION_SCHEMA[index].maximum + 1
+         : CONFIGURATION_SCHEMA[index].type == CONFIG_TYPE_NUMBER ? sizeof(uint16_t) : sizeof(uint8_t);
+}
+
+/**
+* @brief Get the offset of the stored value of a setting, within the strings or the numbers.
+*/
+constexpr size_t settingOffset(size_t index, size_t from = 0) {
+  return from == index ? 0 : (isStringSetting(from) == isStringSetting(index) ? settingSize(from) : 0) + settingOffset(index, from + 1);
+}
+
+/**
+* @brief Get the size of the strings or the numbers of all settings in bytes.
+*/
+constexpr size_t settingsSize(bool isString, size_t from = 0) {
+  return from == CONFIGURATION_FIELD_COUNT ? 0 : (isStringSetting(from) == isString ? settingSize(from) : 0) + settingsSize(isString, from + 1);
+}
+
+/**
+* @brief Compare two keys in constant expressions.
+*/
+constexpr bool isSameKey(const char* a, const char* b) {
+  return *a == *b && (*a == '\0' || isSameKey(a + 1, b + 1));
+}
+
+/**
+* @brief Get the index of a setting by its key.
+*
+* @return The index, or CONFIGURATION_FIELD_COUNT if there is no such setting.
+*/
+constexpr size_t settingIndex(const char* key, size_t from = 0) {
+  return from == CONFIGURATION_FIELD_COUNT || isSameKey(CONFIGURATION_SCHEMA[from].key, key) ? from : settingIndex(key, from + 1);
+}
+
+// Structure of the values of all settings, laid out by the schema.
+struct ConfigurationValues {
+  char strings[settingsSize(true)];      // String settings, each in a fixed, zero-padded slot.
+  uint8_t numbers[settingsSize(false)];  // Number and boolean settings, unaligned.
+};
+
+#endif
\ No newline at end of file
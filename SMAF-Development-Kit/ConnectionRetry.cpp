@@ -0,0 +1,84 @@
+/**
+* @file ConnectionRetry.cpp
+* @brief Implementation of the ConnectionRetry class pacing connection attempts.
+*
+* This file contains the implementation of the ConnectionRetry class, which holds the
+* retry step of connectToNetwork() and connectToMqttBroker() for the firmware and the
+* fleet simulator.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "ConnectionRetry.h"
+#include "Helpers.h"
+
+/**
+* @brief Construct a retry waiting the same delay after every attempt.
+*
+* @param delay The delay (in milliseconds) after every attempt.
+*/
+ConnectionRetry::ConnectionRetry(uint32_t delay)
+  : _baseDelay(delay), _maxDelay(delay), _isBackingOff(false), _attempts(0) {}
+
+/**
+* @brief Construct a retry backing off exponentially with jitter.
+*
+* @param baseDelay The delay (in milliseconds) after the first attempt.
+* @param maxDelay The upper bound (in milliseconds) for the delay.
+*/
+ConnectionRetry::ConnectionRetry(uint32_t baseDelay, uint32_t maxDelay)
+  : _baseDelay(baseDelay), _maxDelay(maxDelay), _isBackingOff(true), _attempts(0) {}
+
+/**
+* @brief Count a failed attempt and get the delay before the next one.
+*
+* Backing off retries avoid reconnect storms when many devices lost the same server.
+*
+* @return The delay in milliseconds to wait before the next attempt.
+*/
+uint32_t ConnectionRetry::nextDelay() {
+  uint32_t delay = _isBackingOff ? backoffDelay(_attempts, _baseDelay, _maxDelay) : _baseDelay;
+
+  // Stay at the upper bound instead of wrapping around to the base delay.
+  if (_attempts < UINT8_MAX) {
+    _attempts++;
+  }
+
+  return delay;
+}
+
+/**
+* @brief Start over at the base delay once connected.
+*/
+void ConnectionRetry::reset() {
+  _attempts = 0;
+}
+
+/**
+* @brief Get the number of failed attempts since the last connection.
+*
+* @return The number of attempts, saturated at UINT8_MAX.
+*/
+uint8_t ConnectionRetry::attempts() const {
+  return _attempts;
+}
\ No newline at end of file
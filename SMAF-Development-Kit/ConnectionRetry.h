@@ -0,0 +1,86 @@
+/**
+* @file ConnectionRetry.h
+* @brief Declaration of the ConnectionRetry class pacing connection attempts.
+*
+* This file contains the declaration of the ConnectionRetry class, which holds the
+* retry step of connectToNetwork() and connectToMqttBroker(). It counts the attempts
+* since the last connection and returns the delay before the next one, either fixed or
+* backing off exponentially with jitter. It never waits itself, so the firmware delays
+* while the fleet simulator schedules the next attempt on its event loop.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+
+#ifndef CONNECTION_RETRY_H
+#define CONNECTION_RETRY_H
+
+#include "Arduino.h"
+
+// Define the delays between connection attempts in milliseconds.
+#define NETWORK_RETRY_DELAY 6400    // Time the Wi-Fi network is given to associate after WiFi.begin().
+#define MQTT_RETRY_DELAY 4000       // Base delay between MQTT connection attempts.
+#define MQTT_RETRY_MAX_DELAY 16000  // Upper bound of the delay between MQTT connection attempts.
+
+class ConnectionRetry {
+public:
+  /**
+  * @brief Construct a retry waiting the same delay after every attempt.
+  *
+  * @param delay The delay (in milliseconds) after every attempt.
+  */
+  ConnectionRetry(uint32_t delay);
+
+  /**
+  * @brief Construct a retry backing off exponentially with jitter.
+  *
+  * @param baseDelay The delay (in milliseconds) after the first attempt.
+  * @param maxDelay The upper bound (in milliseconds) for the delay.
+  */
+  ConnectionRetry(uint32_t baseDelay, uint32_t maxDelay);
+
+  /**
+  * @brief Count a failed attempt and get the delay before the next one.
+  *
+  * @return The delay in milliseconds to wait before the next attempt.
+  */
+  uint32_t nextDelay();
+
+  /**
+  * @brief Start over at the base delay once connected.
+  */
+  void reset();
+
+  /**
+  * @brief Get the number of failed attempts since the last connection.
+  *
+  * @return The number of attempts, saturated at UINT8_MAX.
+  */
+  uint8_t attempts() const;
+
+private:
+  uint32_t _baseDelay;  // Delay after the first attempt in milliseconds.
+  uint32_t _maxDelay;   // Upper bound of the delay in milliseconds.
+  bool _isBackingOff;   // Whether the delay grows with the attempts.
+  uint8_t _attempts;    // Failed attempts since the last connection.
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+* @file EventBroadcaster.cpp
+* @brief Implementation of the EventBroadcaster class for server-sent events.
+*
+* This file contains the implementation of the EventBroadcaster class, which pushes
+* events to a bounded number of browsers as server-sent events, formatting each event
+* once into a fixed broadcast buffer.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "EventBroadcaster.h"
+
+/**
+* @brief Add a client to the subscribers.
+*
+* The client must have received the response headers already. If an event was
+* published before, it is sent right away, so new subscribers do not wait for the
+* next one.
+*
+* @param client The client to send events to. The broadcaster keeps its own copy.
+* @return true if the client was added, false if all subscriber slots are taken.
+*/
+bool EventBroadcaster::subscribe(WiFiClient& client) {
+  for (uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; ++i) {
+    if (!_isSubscribed[i]) {
+      _subscribers[i] = client;
+      _isSubscribed[i] = true;
+      _subscriberCount++;
+
+      // Send the latest event, if any, to the new subscriber only.
+      char frame[EVENT_BUFFER_SIZE];
+      size_t length;
+
+      portENTER_CRITICAL(&_lock);
+      length = _frameLength;
+      memcpy(frame, _frame, length);
+      portEXIT_CRITICAL(&_lock);
+
+      if (length > 0 && _subscribers[i].write((const uint8_t*)frame, length) != length) {
+        drop(i);
+        return false;
+      }
+
+      _sentAt = millis();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+* @brief Publish an event to all subscribers.
+*
+* Formats the server-sent event frame once into the broadcast buffer. It is sent
+* by the next update(), so publishing never waits for the network and may be called
+* from another task than update(). Events that do not fit EVENT_BUFFER_SIZE are dropped.
+*
+* @param data The event data, a single line such as a JSON object.
+*/
+void EventBroadcaster::publish(const char* data) {
+  // Format outside the lock, only the copy into the broadcast buffer is guarded.
+  char frame[EVENT_BUFFER_SIZE];
+  int length = snprintf(frame, sizeof(frame), "data: %s\n\n", data);
+
+  // Never send a truncated frame, it would merge with the next event.
+  if (length <= 0 || (size_t)length >= sizeof(frame)) {
+    return;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  memcpy(_frame, frame, length);
+  _frameLength = length;
+  _sequence++;
+  portEXIT_CRITICAL(&_lock);
+}
+
+/**
+* @brief Send the latest event to all subscribers.
+*
+* Must be called periodically. The frame is taken from the broadcast buffer once and
+* written to every subscriber from the same memory. Subscribers that disconnected or
+* can not keep up are dropped. Without events, a comment is sent every
+* EVENT_KEEP_ALIVE_INTERVAL to detect closed connections.
+*/
+void EventBroadcaster::update() {
+  if (_subscriberCount == 0) {
+    _sentSequence = _sequence;
+    return;
+  }
+
+  // Take the latest frame once, it is written to every subscriber from here.
+  char frame[EVENT_BUFFER_SIZE];
+  size_t length = 0;
+
+  portENTER_CRITICAL(&_lock);
+  if (_sentSequence != _sequence) {
+    length = _frameLength;
+    memcpy(frame, _frame, length);
+    _sentSequence = _sequence;
+  }
+  portEXIT_CRITICAL(&_lock);
+
+  if (length > 0) {
+    send(frame, length);
+  } else if (millis() - _sentAt > EVENT_KEEP_ALIVE_INTERVAL) {
+    // A comment line, ignored by browsers.
+    send(":\n\n", 3);
+  }
+}
+
+/**
+* @brief Get the number of subscribers.
+*
+* @return The number of connected subscribers.
+*/
+uint8_t EventBroadcaster::subscriberCount() {
+  return _subscriberCount;
+}
+
+/**
+* @brief Disconnect all subscribers.
+*/
+void EventBroadcaster::closeAll() {
+  for (uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; ++i) {
+    if (_isSubscribed[i]) {
+      drop(i);
+    }
+  }
+}
+
+/**
+* @brief Send a frame to all subscribers.
+*
+* @param frame The frame to send.
+* @param length Length of the frame in bytes.
+*/
+void EventBroadcaster::send(const char* frame, size_t length) {
+  for (uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; ++i) {
+    if (!_isSubscribed[i]) {
+      continue;
+    }
+
+    // A short write means the client is gone or its window is full, either way it is dropped.
+    if (!_subscribers[i].connected() || _subscribers[i].write((const uint8_t*)frame, length) != length) {
+      drop(i);
+    }
+  }
+
+  _sentAt = millis();
+}
+
+/**
+* @brief Disconnect a subscriber and free its slot.
+*
+* @param index Index of the subscriber slot.
+*/
+void EventBroadcaster::drop(uint8_t index) {
+  _subscribers[index].stop();
+  _subscribers[index] = WiFiClient();
+  _isSubscribed[index] = false;
+  _subscriberCount--;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+* @file EventBroadcaster.h
+* @brief Declaration of the EventBroadcaster class for server-sent events.
+*
+* This file contains the declaration of the EventBroadcaster class, which pushes
+* events such as sensor samples to a bounded number of browsers as server-sent
+* events. Each event is formatted once into a fixed broadcast buffer and written to
+* all subscribers from there, without per-client buffers or allocations.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef EVENT_BROADCASTER_H
+#define EVENT_BROADCASTER_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+// Define the event stream limits.
+#define EVENT_MAX_SUBSCRIBERS 4          // Number of clients receiving events at once.
+#define EVENT_BUFFER_SIZE 160            // Size of the broadcast buffer, including the framing.
+#define EVENT_KEEP_ALIVE_INTERVAL 15000  // Time without events after which a comment is sent, in milliseconds.
+
+class EventBroadcaster {
+public:
+  /**
+  * @brief Add a client to the subscribers.
+  *
+  * The client must have received the response headers already. If an event was
+  * published before, it is sent right away, so new subscribers do not wait for the
+  * next one.
+  *
+  * @param client The client to send events to. The broadcaster keeps its own copy.
+  * @return true if the client was added, false if all subscriber slots are taken.
+  */
+  bool subscribe(WiFiClient& client);
+
+  /**
+  * @brief Publish an event to all subscribers.
+  *
+  * Formats the server-sent event frame once into the broadcast buffer. It is sent
+  * by the next update(), so publishing never waits for the network and may be called
+  * from another task than update(). Events that do not fit EVENT_BUFFER_SIZE are dropped.
+  *
+  * @param data The event data, a single line such as a JSON object.
+  */
+  void publish(const char* data);
+
+  /**
+  * @brief Send the latest event to all subscribers.
+  *
+  * Must be called periodically. The frame is taken from the broadcast buffer once and
+  * written to every subscriber from the same memory. Subscribers that disconnected or
+  * can not keep up are dropped. Without events, a comment is sent every
+  * EVENT_KEEP_ALIVE_INTERVAL to detect closed connections.
+  */
+  void update();
+
+  /**
+  * @brief Get the number of subscribers.
+  *
+  * @return The number of connected subscribers.
+  */
+  uint8_t subscriberCount();
+
+  /**
+  * @brief Disconnect all subscribers.
+  */
+  void closeAll();
+
+private:
+  WiFiClient _subscribers[EVENT_MAX_SUBSCRIBERS];  // Subscribed clients.
+  bool _isSubscribed[EVENT_MAX_SUBSCRIBERS] = {};  // True for the slots holding a subscriber.
+  uint8_t _subscriberCount = 0;                    // Number of subscribed clients.
+  char _frame[EVENT_BUFFER_SIZE];                  // Broadcast buffer with the latest frame.
+  size_t _frameLength = 0;                         // Length of the latest frame.
+  uint32_t _sequence = 0;                          // Number of the latest published event.
+  uint32_t _sentSequence = 0;                      // Number of the latest sent event.
+  unsigned long _sentAt = 0;                       // Time anything was last sent, in milliseconds.
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+
+  /**
+  * @brief Send a frame to all subscribers.
+  *
+  * @param frame The frame to send.
+  * @param length Length of the frame in bytes.
+  */
+  void send(const char* frame, size_t length);
+
+  /**
+  * @brief Disconnect a subscriber and free its slot.
+  *
+  * @param index Index of the subscriber slot.
+  */
+  void drop(uint8_t index);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,259 @@
+/**
+* @file FirmwareUpdate.cpp
+* @brief Implementation of the FirmwareUpdate class for verified streaming firmware updates.
+*
+* This file contains the implementation of the FirmwareUpdate class, which streams a
+* firmware image to a FirmwareWriter in fixed-size chunks while hashing it with
+* SHA-256, and only makes the image bootable if its hash matches.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "FirmwareUpdate.h"
+
+/**
+* @brief Construct a new FirmwareUpdate object.
+*
+* @param writer The storage the firmware image is written to.
+*/
+FirmwareUpdate::FirmwareUpdate(FirmwareWriter& writer)
+  : _writer(writer) {
+  mbedtls_sha256_init(&_hash);
+}
+
+/**
+* @brief Destroy the FirmwareUpdate object, aborting an unfinished update.
+*/
+FirmwareUpdate::~FirmwareUpdate() {
+  if (_isActive) {
+    _writer.abort();
+  }
+
+  mbedtls_sha256_free(&_hash);
+}
+
+/**
+* @brief Start an update.
+*
+* @param size Size of the firmware image in bytes.
+* @param sha256 Expected SHA-256 hash of the image as 64 hexadecimal characters.
+* @return true if the update was started, otherwise see error().
+*/
+bool FirmwareUpdate::begin(size_t size, const char* sha256) {
+  _size = size;
+  _written = 0;
+  _error = nullptr;
+
+  if (size == 0) {
+    return fail("Firmware size is missing.");
+  }
+
+  if (!parseHash(sha256, _expectedHash)) {
+    return fail("Expected SHA-256 hash is missing or not 64 hexadecimal characters.");
+  }
+
+  if (!_writer.begin(size)) {
+    return fail("Firmware does not fit the update partition.");
+  }
+
+#if (VERSION_CHECK(ESP_ARDUINO_VERSION_MAJOR, ESP_ARDUINO_VERSION_MINOR, ESP_ARDUINO_VERSION_PATCH) < VERSION_CHECK(3, 0, 0))
+  mbedtls_sha256_starts_ret(&_hash, 0);
+#else
+  mbedtls_sha256_starts(&_hash, 0);
+#endif
+
+  _isActive = true;
+
+  return true;
+}
+
+/**
+* @brief Write the next part of the image.
+*
+* @param data The image data.
+* @param length Length of the data in bytes.
+* @return true if the data was written, otherwise see error().
+*/
+bool FirmwareUpdate::write(const uint8_t* data, size_t length) {
+  if (!_isActive) {
+    return false;
+  }
+
+  if (length > _size - _written) {
+    return fail("Firmware is larger than announced.");
+  }
+
+#if (VERSION_CHECK(ESP_ARDUINO_VERSION_MAJOR, ESP_ARDUINO_VERSION_MINOR, ESP_ARDUINO_VERSION_PATCH) < VERSION_CHECK(3, 0, 0))
+  mbedtls_sha256_update_ret(&_hash, data, length);
+#else
+  mbedtls_sha256_update(&_hash, data, length);
+#endif
+
+  if (!_writer.write(data, length)) {
+    return fail("Writing firmware to flash failed.");
+  }
+
+  _written += length;
+
+  return true;
+}
+
+/**
+* @brief Write the rest of the image from a client.
+*
+* Reads until the image is complete and passes it to the writer in chunks of
+* FIRMWARE_CHUNK_SIZE bytes, the last chunk may be shorter. Fails if no data
+* arrives for FIRMWARE_READ_TIMEOUT or the client disconnects.
+*
+* @param client The client sending the image.
+* @return true if the rest of the image was written, otherwise see error().
+*/
+bool FirmwareUpdate::writeFrom(Client& client) {
+  uint8_t chunk[FIRMWARE_CHUNK_SIZE];
+  size_t chunkLength = 0;
+  unsigned long receivedAt = millis();
+
+  while (_isActive && _written + chunkLength < _size) {
+    int available = client.available();
+
+    if (available <= 0) {
+      if (!client.connected()) {
+        return fail("Connection closed before the firmware was complete.");
+      }
+
+      if (millis() - receivedAt > FIRMWARE_READ_TIMEOUT) {
+        return fail("Timed out waiting for firmware data.");
+      }
+
+      // Let other tasks run while waiting for data.
+      delay(1);
+      continue;
+    }
+
+    // Fill the chunk, but never read past the end of the image.
+    size_t count = min((size_t)available, min(FIRMWARE_CHUNK_SIZE - chunkLength, _size - _written - chunkLength));
+    int read = client.read(chunk + chunkLength, count);
+
+    if (read <= 0) {
+      continue;
+    }
+
+    chunkLength += read;
+    receivedAt = millis();
+
+    // Write full chunks, and the last partial one.
+    if (chunkLength == FIRMWARE_CHUNK_SIZE || _written + chunkLength == _size) {
+      if (!write(chunk, chunkLength)) {
+        return false;
+      }
+
+      chunkLength = 0;
+    }
+  }
+
+  return _isActive;
+}
+
+/**
+* @brief Verify the image and make it bootable.
+*
+* @return true if the image is complete, its hash matches and the writer
+*         selected it for the next boot, otherwise see error().
+*/
+bool FirmwareUpdate::finish() {
+  if (!_isActive) {
+    return false;
+  }
+
+  if (_written != _size) {
+    return fail("Firmware is smaller than announced.");
+  }
+
+  uint8_t hash[FIRMWARE_SHA256_LENGTH];
+
+#if (VERSION_CHECK(ESP_ARDUINO_VERSION_MAJOR, ESP_ARDUINO_VERSION_MINOR, ESP_ARDUINO_VERSION_PATCH) < VERSION_CHECK(3, 0, 0))
+  mbedtls_sha256_finish_ret(&_hash, hash);
+#else
+  mbedtls_sha256_finish(&_hash, hash);
+#endif
+
+  if (memcmp(hash, _expectedHash, FIRMWARE_SHA256_LENGTH) != 0) {
+    return fail("Firmware SHA-256 hash does not match.");
+  }
+
+  // The writer validates the image before selecting it for the next boot.
+  _isActive = false;
+
+  if (!_writer.end()) {
+    _error = "Firmware image is not valid.";
+    return false;
+  }
+
+  return true;
+}
+
+/**
+* @brief Get the reason the update failed.
+*
+* @return Description of the failure, or nullptr if the update did not fail.
+*/
+const char* FirmwareUpdate::error() {
+  return _error;
+}
+
+/**
+* @brief Abort the update.
+*
+* @param error Description of the failure.
+* @return Always false.
+*/
+bool FirmwareUpdate::fail(const char* error) {
+  if (_isActive) {
+    _writer.abort();
+    _isActive = false;
+  }
+
+  _error = error;
+  debug(ERR, "Firmware update failed. %s", error);
+
+  return false;
+}
+
+/**
+* @brief Convert a hexadecimal SHA-256 hash to bytes.
+*
+* @param hex The hash as 64 hexadecimal characters, in upper or lower case.
+* @param hash The converted hash.
+* @return true if the hash is valid.
+*/
+bool FirmwareUpdate::parseHash(const char* hex, uint8_t* hash) {
+  if (hex == nullptr || strlen(hex) != FIRMWARE_SHA256_LENGTH * 2 || strspn(hex, "0123456789abcdefABCDEF") != FIRMWARE_SHA256_LENGTH * 2) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < FIRMWARE_SHA256_LENGTH; ++i) {
+    char digits[3] = { hex[i * 2], hex[i * 2 + 1], '\0' };
+    hash[i] = (uint8_t)strtoul(digits, nullptr, 16);
+  }
+
+  return true;
+}
\ No newline at end of file
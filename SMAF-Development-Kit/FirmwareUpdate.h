@@ -0,0 +1,131 @@
+/**
+* @file FirmwareUpdate.h
+* @brief Declaration of the FirmwareUpdate class for verified streaming firmware updates.
+*
+* This file contains the declaration of the FirmwareUpdate class, which streams a
+* firmware image to a FirmwareWriter in fixed-size chunks while hashing it with
+* SHA-256. The image is only made bootable if its hash matches the expected one,
+* and the whole image is never held in RAM.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef FIRMWARE_UPDATE_H
+#define FIRMWARE_UPDATE_H
+
+#include "Arduino.h"
+#include "Client.h"
+#include "mbedtls/sha256.h"
+#include "FirmwareWriter.h"
+#include "Helpers.h"
+
+// Define the firmware transfer settings.
+#define FIRMWARE_CHUNK_SIZE 1024     // Bytes written to the FirmwareWriter at once.
+#define FIRMWARE_READ_TIMEOUT 10000  // Time without data after which a transfer fails, in milliseconds.
+#define FIRMWARE_SHA256_LENGTH 32    // Length of a SHA-256 hash in bytes.
+
+class FirmwareUpdate {
+public:
+  /**
+  * @brief Construct a new FirmwareUpdate object.
+  *
+  * @param writer The storage the firmware image is written to.
+  */
+  FirmwareUpdate(FirmwareWriter& writer);
+
+  /**
+  * @brief Destroy the FirmwareUpdate object, aborting an unfinished update.
+  */
+  ~FirmwareUpdate();
+
+  /**
+  * @brief Start an update.
+  *
+  * @param size Size of the firmware image in bytes.
+  * @param sha256 Expected SHA-256 hash of the image as 64 hexadecimal characters.
+  * @return true if the update was started, otherwise see error().
+  */
+  bool begin(size_t size, const char* sha256);
+
+  /**
+  * @brief Write the next part of the image.
+  *
+  * @param data The image data.
+  * @param length Length of the data in bytes.
+  * @return true if the data was written, otherwise see error().
+  */
+  bool write(const uint8_t* data, size_t length);
+
+  /**
+  * @brief Write the rest of the image from a client.
+  *
+  * Reads until the image is complete and passes it to the writer in chunks of
+  * FIRMWARE_CHUNK_SIZE bytes, the last chunk may be shorter. Fails if no data
+  * arrives for FIRMWARE_READ_TIMEOUT or the client disconnects.
+  *
+  * @param client The client sending the image.
+  * @return true if the rest of the image was written, otherwise see error().
+  */
+  bool writeFrom(Client& client);
+
+  /**
+  * @brief Verify the image and make it bootable.
+  *
+  * @return true if the image is complete, its hash matches and the writer
+  *         selected it for the next boot, otherwise see error().
+  */
+  bool finish();
+
+  /**
+  * @brief Get the reason the update failed.
+  *
+  * @return Description of the failure, or nullptr if the update did not fail.
+  */
+  const char* error();
+
+private:
+  FirmwareWriter& _writer;
+  mbedtls_sha256_context _hash;                   // Hash of the data written so far.
+  uint8_t _expectedHash[FIRMWARE_SHA256_LENGTH];  // Hash the image must have.
+  size_t _size = 0;                               // Size of the image in bytes.
+  size_t _written = 0;                            // Bytes written so far.
+  bool _isActive = false;                         // True between begin() and finish().
+  const char* _error = nullptr;
+
+  /**
+  * @brief Abort the update.
+  *
+  * @param error Description of the failure.
+  * @return Always false.
+  */
+  bool fail(const char* error);
+
+  /**
+  * @brief Convert a hexadecimal SHA-256 hash to bytes.
+  *
+  * @param hex The hash as 64 hexadecimal characters, in upper or lower case.
+  * @param hash The converted hash.
+  * @return true if the hash is valid.
+  */
+  static bool parseHash(const char* hex, uint8_t* hash);
+};
+
+#endif
\ No newline at end of file
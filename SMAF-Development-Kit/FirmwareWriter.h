@@ -0,0 +1,71 @@
+/**
+* @file FirmwareWriter.h
+* @brief Declaration of the FirmwareWriter interface for storing firmware images.
+*
+* This file contains the declaration of the FirmwareWriter interface, the storage
+* layer used by FirmwareUpdate. Implementations write a firmware image in order,
+* one chunk at a time, and make it bootable once it is complete. Keeping the flash
+* access behind this interface lets the update flow run against other storage, such
+* as a file or memory on the host.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef FIRMWARE_WRITER_H
+#define FIRMWARE_WRITER_H
+
+#include "Arduino.h"
+
+class FirmwareWriter {
+public:
+  virtual ~FirmwareWriter() {}
+
+  /**
+  * @brief Prepare storage for a new firmware image.
+  *
+  * @param size Size of the image in bytes.
+  * @return true if an image of this size can be written.
+  */
+  virtual bool begin(size_t size) = 0;
+
+  /**
+  * @brief Append the next part of the image.
+  *
+  * @param data The image data.
+  * @param length Length of the data in bytes.
+  * @return true if the data was written.
+  */
+  virtual bool write(const uint8_t* data, size_t length) = 0;
+
+  /**
+  * @brief Finish the image and select it for the next boot.
+  *
+  * @return true if the image is valid and will be booted next.
+  */
+  virtual bool end() = 0;
+
+  /**
+  * @brief Discard the image written since begin().
+  */
+  virtual void abort() = 0;
+};
+
+#endif
\ No newline at end of file
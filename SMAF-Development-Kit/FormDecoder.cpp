@@ -0,0 +1,184 @@
+/**
+* @file FormDecoder.cpp
+* @brief Implementation of the FormDecoder class for single-pass form decoding.
+*
+* This file contains the implementation of the FormDecoder class, which decodes URL-encoded
+* form data such as a request query in a single pass. Names and values are
+* percent-decoded in place in the request buffer, and values of the expected fields
+* are collected into a fixed table of views keyed by field name, without allocations.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "FormDecoder.h"
+
+/**
+* @brief Construct a new FormDecoder object.
+*
+* @param names Array of the field names to collect, e.g. preference keys.
+* @param count Number of field names, at most FORM_DECODER_MAX_FIELDS.
+*/
+FormDecoder::FormDecoder(const char* const* names, uint8_t count)
+  : _names(names), _count(min(count, (uint8_t)FORM_DECODER_MAX_FIELDS)) {
+  for (uint8_t i = 0; i < FORM_DECODER_MAX_FIELDS; ++i) {
+    _values[i] = nullptr;
+  }
+}
+
+/**
+* @brief Decode URL-encoded form data in place.
+*
+* Walks the data once, splitting "name=value" pairs at '&', percent-decoding names
+* and values and replacing '+' with a space. Decoding never grows the data, so the
+* result is written over the input and each name and value is null-terminated.
+* Values of expected fields are stored in the field table, unknown fields are ignored,
+* and if a field appears more than once the first value is kept. Values consisting
+* only of spaces are treated as empty.
+*
+* @param data The null-terminated form data, overwritten by the decoded fields.
+*/
+void FormDecoder::decode(char* data) {
+  char* read = data;
+
+  while (*read != '\0') {
+    // Decode the name up to '=', then the value up to '&'.
+    char stop;
+    char* name = decodeInPlace(read, '=', stop);
+    char* value = stop == '=' ? decodeInPlace(read, '&', stop) : name + strlen(name);
+
+    // Collect only the first value of expected fields.
+    int8_t index = indexOf(name);
+
+    if (index < 0 || _values[index] != nullptr) {
+      continue;
+    }
+
+    // Treat values consisting only of spaces as empty.
+    if (value[strspn(value, " ")] == '\0') {
+      *value = '\0';
+    }
+
+    _values[index] = value;
+  }
+}
+
+/**
+* @brief Check if a field was present in the decoded data.
+*
+* @param name The field name.
+* @return true if the field was present, even with an empty value.
+*/
+bool FormDecoder::has(const char* name) {
+  int8_t index = indexOf(name);
+
+  return index >= 0 && _values[index] != nullptr;
+}
+
+/**
+* @brief Get the decoded value of a field.
+*
+* @param name The field name.
+* @return Null-terminated decoded value, or an empty string if the field was not present.
+*/
+const char* FormDecoder::value(const char* name) {
+  int8_t index = indexOf(name);
+
+  return index >= 0 && _values[index] != nullptr ? _values[index] : "";
+}
+
+/**
+* @brief Percent-decode characters up to a delimiter, writing the result in place.
+*
+* @param read Position of the next encoded character, advanced past the delimiter.
+* @param delimiter Character ending the decoded part, in addition to '&' and the end of data.
+* @param stop Set to the character that ended the part, '\0' at the end of data.
+* @return Start of the decoded, null-terminated part.
+*/
+char* FormDecoder::decodeInPlace(char*& read, char delimiter, char& stop) {
+  char* start = read;
+  char* write = read;
+
+  while (*read != '\0' && *read != delimiter && *read != '&') {
+    if (*read == '%' && isxdigit(read[1]) && isxdigit(read[2])) {
+      // Replace "%XX" with the encoded byte.
+      *write++ = char(hexToByte(read[1]) * 16 + hexToByte(read[2]));
+      read += 3;
+    } else if (*read == '+') {
+      *write++ = ' ';
+      read++;
+    } else {
+      *write++ = *read++;
+    }
+  }
+
+  // Step over the delimiter before the terminator is written, as it may overwrite it.
+  stop = *read;
+
+  if (stop != '\0') {
+    read++;
+  }
+
+  *write = '\0';
+  return start;
+}
+
+/**
+* @brief Find the table index of a field name.
+*
+* @param name The field name.
+* @return Index of the field, or -1 if it is not expected.
+*/
+int8_t FormDecoder::indexOf(const char* name) {
+  for (uint8_t i = 0; i < _count; ++i) {
+    if (strcmp(_names[i], name) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/**
+* @brief Convert a hexadecimal character to a byte.
+*
+* @param c The hexadecimal character to convert.
+* @return The decimal value of the hexadecimal character or 0 if not a valid digit.
+*/
+byte FormDecoder::hexToByte(char c) {
+  // Check if the character is a digit ('0' to '9').
+  if ('0' <= c && c <= '9') {
+    return c - '0';
+  }
+
+  // Check if the character is a lowercase hexadecimal digit ('a' to 'f').
+  if ('a' <= c && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  // Check if the character is an uppercase hexadecimal digit ('A' to 'F').
+  if ('A' <= c && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  // Return 0 if the character is not a valid hexadecimal digit.
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+* @file FormDecoder.h
+* @brief Declaration of the FormDecoder class for single-pass form decoding.
+*
+* This file contains the declaration of the FormDecoder class, which decodes URL-encoded
+* form data such as a request query in a single pass. Names and values are
+* percent-decoded in place in the request buffer, and values of the expected fields
+* are collected into a fixed table of views keyed by field name, without allocations.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef FORM_DECODER_H
+#define FORM_DECODER_H
+
+#include "Arduino.h"
+
+// Define the maximum number of fields collected by the decoder.
+#define FORM_DECODER_MAX_FIELDS 16
+
+class FormDecoder {
+public:
+  /**
+  * @brief Construct a new FormDecoder object.
+  *
+  * @param names Array of the field names to collect, e.g. preference keys.
+  * @param count Number of field names, at most FORM_DECODER_MAX_FIELDS.
+  */
+  FormDecoder(const char* const* names, uint8_t count);
+
+  /**
+  * @brief Decode URL-encoded form data in place.
+  *
+  * Walks the data once, splitting "name=value" pairs at '&', percent-decoding names
+  * and values and replacing '+' with a space. Decoding never grows the data, so the
+  * result is written over the input and each name and value is null-terminated.
+  * Values of expected fields are stored in the field table, unknown fields are ignored,
+  * and if a field appears more than once the first value is kept. Values consisting
+  * only of spaces are treated as empty.
+  *
+  * @param data The null-terminated form data, overwritten by the decoded fields.
+  */
+  void decode(char* data);
+
+  /**
+  * @brief Check if a field was present in the decoded data.
+  *
+  * @param name The field name.
+  * @return true if the field was present, even with an empty value.
+  */
+  bool has(const char* name);
+
+  /**
+  * @brief Get the decoded value of a field.
+  *
+  * @param name The field name.
+  * @return Null-terminated decoded value, or an empty string if the field was not present.
+  */
+  const char* value(const char* name);
+
+private:
+  const char* const* _names;                     // Expected field names.
+  uint8_t _count;                                // Number of expected fields.
+  const char* _values[FORM_DECODER_MAX_FIELDS];  // Decoded values, nullptr if not present.
+
+  /**
+  * @brief Percent-decode characters up to a delimiter, writing the result in place.
+  *
+  * @param read Position of the next encoded character, advanced past the delimiter.
+  * @param delimiter Character ending the decoded part, in addition to '&' and the end of data.
+  * @param stop Set to the character that ended the part, '\0' at the end of data.
+  * @return Start of the decoded, null-terminated part.
+  */
+  char* decodeInPlace(char*& read, char delimiter, char& stop);
+
+  /**
+  * @brief Find the table index of a field name.
+  *
+  * @param name The field name.
+  * @return Index of the field, or -1 if it is not expected.
+  */
+  int8_t indexOf(const char* name);
+
+  /**
+  * @brief Convert a hexadecimal character to a byte.
+  *
+  * @param c The hexadecimal character to convert.
+  * @return The decimal value of the hexadecimal character or 0 if not a valid digit.
+  */
+  static byte hexToByte(char c);
+};
+
+#endif
\ No newline at end of file
@@ -42,8 +42,9 @@ MessageTypeEnum messageType = LOG;
 * @param ... Additional arguments to be formatted.
 */
 void debug(MessageTypeEnum messageType, const char *format, ...) {
-  // Set up an empty string to store the message type as a string
-  String messageTypeStr;
+  // Set up a pointer to the message type label.
+  // Labels are string literals, so no heap allocation is needed per message.
+  const char *messageTypeStr = "";
 
   // Switch statement to determine the message type string based on the input byte
   switch (messageType) {
@@ -72,7 +73,7 @@ void debug(MessageTypeEnum messageType, const char *format, ...) {
   va_end(args);
 
   // Print the formatted debug message to the Serial monitor.
-  Serial.printf("CORE-%02d | %5s | %s\n\r", xPortGetCoreID(), messageTypeStr.c_str(), buffer);
+  Serial.printf("CORE-%02d | %5s | %s\n\r", xPortGetCoreID(), messageTypeStr, buffer);
 }
 
 /**
@@ -161,13 +162,80 @@ bool isEmpty(const char* str) {
 }
 
 /**
-* @brief Encloses the given string within double quotes.
+* @brief Parses a submitted form number.
 *
-* This function takes a string `data` and returns it enclosed within double quotes.
+* Only decimal digits are accepted, and the value must fit a number setting, so
+* invalid and out-of-range input is rejected rather than wrapped.
 *
-* @param data The string to be enclosed within double quotes.
-* @return A String containing the input `data` enclosed within double quotes.
+* @param value The null-terminated form value.
+* @param number Set to the parsed number if it is valid.
+* @return true if the value is a valid number, false otherwise.
 */
-String quotation(String data) {
-  return "\"" + data + "\"";
+bool parseFormNumber(const char* value, uint16_t& number) {
+  uint32_t parsed = 0;
+
+  if (*value == '\0') {
+    return false;
+  }
+
+  for (; *value != '\0'; ++value) {
+    if (!isdigit((unsigned char)*value) || (parsed = parsed * 10 + (*value - '0')) > UINT16_MAX) {
+      return false;
+    }
+  }
+
+  number = parsed;
+  return true;
+}
+
+/**
+* @brief Calculates a jittered exponential backoff delay for a retry attempt.
+*
+* The delay doubles with every attempt, starting at `baseDelay` and capped at `maxDelay`.
+* The returned value is randomized between half and the full capped delay, so devices that
+* lost their connection at the same moment do not retry in lockstep against the same server.
+*
+* @param attempt Zero-based number of the failed attempt.
+* @param baseDelay The delay (in milliseconds) used for the first retry.
+* @param maxDelay The upper bound (in milliseconds) for the delay.
+* @return The delay in milliseconds to wait before the next attempt.
+*/
+uint32_t backoffDelay(uint8_t attempt, uint32_t baseDelay, uint32_t maxDelay) {
+  uint32_t cappedDelay = baseDelay;
+
+  // Double the delay for every failed attempt until the upper bound is reached.
+  while (attempt > 0 && cappedDelay < maxDelay) {
+    cappedDelay *= 2;
+    attempt--;
+  }
+
+  if (cappedDelay > maxDelay) {
+    cappedDelay = maxDelay;
+  }
+
+  // Keep half of the delay fixed and randomize the other half.
+  return (cappedDelay / 2) + random(cappedDelay / 2 + 1);
+}
+
+/**
+* @brief Constructs an MQTT message string containing temperature, humidity, and timestamp data.
+*
+* Constructs a JSON-formatted MQTT message string containing temperature and humidity data 
+* (read from SHT4x) and a timestamp.
+*
+* @param temperature Temperature read from SHT4x.
+* @param humidity Humidity read from SHT4x.
+* @param timestamp Human-readable timestamp in UTC format.
+* @return A String containing the constructed MQTT message in JSON format.
+*/
+String constructMqttMessage(float temperature, float humidity, const char* timestamp) {
+  // Format the whole message in one pass into a stack buffer.
+  // The buffer fits the longest timestamp and values, and the result is copied to the heap once.
+  char message[160];
+
+  snprintf(message, sizeof(message),
+           "{\"timestamp\":\"%s\",\"temperature\":{\"value\":%.2f,\"unit\":\"C\"},\"humidity\":{\"value\":%.2f,\"unit\":\"%%\"}}",
+           timestamp, temperature, humidity);
+
+  return String(message);
 }
\ No newline at end of file
@@ -35,6 +35,10 @@
 // Define a macro for comparing version numbers
 #define VERSION_CHECK(major, minor, patch) ((major)*10000 + (minor)*100 + (patch))
 
+// Define the pace of the telemetry loop and the MQTT client buffer.
+#define LOOP_INTERVAL 1600     // Delay at the end of loop() between samples in milliseconds.
+#define MQTT_BUFFER_SIZE 1024  // Size of the MQTT client buffer, it fits constructMqttMessage().
+
 /**
 * @enum messageTypeEnum
 * @brief Enumeration for message types used in the project.
@@ -109,13 +113,42 @@ void suspendWatchdog();
 bool isEmpty(const char* str);
 
 /**
-* @brief Encloses the given string within double quotes.
+* @brief Parses a submitted form number.
+*
+* Only decimal digits are accepted, and the value must fit a number setting, so
+* invalid and out-of-range input is rejected rather than wrapped.
+*
+* @param value The null-terminated form value.
+* @param number Set to the parsed number if it is valid.
+* @return true if the value is a valid number, false otherwise.
+*/
+bool parseFormNumber(const char* value, uint16_t& number);
+
+/**
+* @brief Calculates a jittered exponential backoff delay for a retry attempt.
+*
+* The delay doubles with every attempt, starting at `baseDelay` and capped at `maxDelay`.
+* The returned value is randomized between half and the full capped delay, so devices that
+* lost their connection at the same moment do not retry in lockstep against the same server.
+*
+* @param attempt Zero-based number of the failed attempt.
+* @param baseDelay The delay (in milliseconds) used for the first retry.
+* @param maxDelay The upper bound (in milliseconds) for the delay.
+* @return The delay in milliseconds to wait before the next attempt.
+*/
+uint32_t backoffDelay(uint8_t attempt, uint32_t baseDelay, uint32_t maxDelay);
+
+/**
+* @brief Constructs an MQTT message string containing temperature, humidity, and timestamp data.
 *
-* This function takes a string `data` and returns it enclosed within double quotes.
+* Constructs a JSON-formatted MQTT message string containing temperature and humidity data 
+* (read from SHT4x) and a timestamp.
 *
-* @param data The string to be enclosed within double quotes.
-* @return A String containing the input `data` enclosed within double quotes.
+* @param temperature Temperature read from SHT4x.
+* @param humidity Humidity read from SHT4x.
+* @param timestamp Human-readable timestamp in UTC format.
+* @return A String containing the constructed MQTT message in JSON format.
 */
-String quotation(String data);
+String constructMqttMessage(float temperature, float humidity, const char* timestamp);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+* @file HttpConnection.cpp
+* @brief Implementation of the HttpConnection class for the configuration server.
+*
+* This file contains the implementation of the HttpConnection class, a per-connection state
+* machine for the configuration server. Each connection reads its request without
+* blocking into a fixed-size buffer and enforces a read timeout, so a fixed pool of
+* connections can serve several clients at once and an idle socket can not stall the server.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "HttpConnection.h"
+
+/**
+* @brief Take over a newly accepted client.
+*
+* @param client The accepted client.
+*/
+void HttpConnection::open(WiFiClient client) {
+  _client = client;
+  _isOpen = true;
+  _length = 0;
+  _openedAt = millis();
+  _isPersistent = false;
+  _parser.reset(_buffer, HTTP_REQUEST_BUFFER_SIZE);
+}
+
+/**
+* @brief Check if the connection slot is free.
+*
+* @return true if no client is assigned to this connection.
+*/
+bool HttpConnection::isIdle() {
+  return !_isOpen;
+}
+
+/**
+* @brief Check if the connection is kept open between requests.
+*
+* @return true if a persistent connection has no partial request buffered, so
+*         closing it to free the slot loses nothing.
+*/
+bool HttpConnection::isBetweenRequests() {
+  return _isOpen && _isPersistent && _length == 0;
+}
+
+/**
+* @brief Read available request data without blocking.
+*
+* Reads whatever the client has sent so far into the request buffer, parses the
+* new data and checks for a complete or invalid request, read timeout or disconnect.
+*
+* @return The state of the request after reading.
+*/
+HttpRequestStateEnum HttpConnection::poll() {
+  if (!_isOpen) {
+    return REQUEST_PENDING;
+  }
+
+  // Read only what has already arrived, never wait for more.
+  int available = _client.available();
+
+  // The request timer of a persistent connection starts with its first byte.
+  if (available > 0 && isBetweenRequests()) {
+    _openedAt = millis();
+  }
+
+  while (available > 0 && _length < HTTP_REQUEST_BUFFER_SIZE) {
+    int count = _client.read((uint8_t*)_buffer + _length, min((size_t)available, HTTP_REQUEST_BUFFER_SIZE - _length));
+
+    if (count <= 0) {
+      break;
+    }
+
+    _length += count;
+    available = _client.available();
+  }
+
+  // Continue parsing where the previous poll stopped.
+  switch (_parser.parse(_length)) {
+    case HTTP_PARSE_COMPLETE:
+      return REQUEST_COMPLETE;
+
+    case HTTP_PARSE_ERROR:
+      return REQUEST_INVALID;
+
+    case HTTP_PARSE_INCOMPLETE:
+      break;
+  }
+
+  if (!_client.connected()) {
+    return REQUEST_CLOSED;
+  }
+
+  // An idle persistent connection is closed quietly, a stalled request is answered.
+  if (isBetweenRequests()) {
+    if (millis() - _openedAt > HTTP_KEEP_ALIVE_TIMEOUT) {
+      return REQUEST_CLOSED;
+    }
+  } else if (millis() - _openedAt > HTTP_READ_TIMEOUT) {
+    return REQUEST_TIMEOUT;
+  }
+
+  return REQUEST_PENDING;
+}
+
+/**
+* @brief Get the client of this connection.
+*
+* @return Reference to the client, valid until close() is called.
+*/
+WiFiClient& HttpConnection::client() {
+  return _client;
+}
+
+/**
+* @brief Get the parsed request.
+*
+* @return Reference to the parser, whose views are valid until close() is called.
+*/
+HttpRequestParser& HttpConnection::request() {
+  return _parser;
+}
+
+/**
+* @brief Keep the connection open for the next request.
+*
+* Moves any pipelined bytes received after the handled request to the start of
+* the buffer and restarts parsing, so they are handled on the next poll.
+*/
+void HttpConnection::finishRequest() {
+  size_t requestLength = _parser.requestLength();
+
+  memmove(_buffer, _buffer + requestLength, _length - requestLength);
+  _length -= requestLength;
+  _openedAt = millis();
+  _isPersistent = true;
+  _parser.reset(_buffer, HTTP_REQUEST_BUFFER_SIZE);
+}
+
+/**
+* @brief Close the connection and free the slot.
+*/
+void HttpConnection::close() {
+  _client.stop();
+  _isOpen = false;
+  _length = 0;
+}
+
+/**
+* @brief Free the slot without closing the client.
+*
+* Used when a handler takes over the client, e.g. for a stream of events. The
+* client stays connected through the copy kept by the new owner.
+*/
+void HttpConnection::detach() {
+  _client = WiFiClient();
+  _isOpen = false;
+  _length = 0;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+* @file HttpConnection.h
+* @brief Declaration of the HttpConnection class for the configuration server.
+*
+* This file contains the declaration of the HttpConnection class, a per-connection state
+* machine for the configuration server. Each connection reads its request without
+* blocking into a fixed-size buffer and enforces a read timeout, so a fixed pool of
+* connections can serve several clients at once and an idle socket can not stall the server.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "HttpRequestParser.h"
+
+// Define the size of the request buffer in bytes.
+#define HTTP_REQUEST_BUFFER_SIZE 2048
+
+// Define the time in milliseconds a client has to send a complete request.
+#define HTTP_READ_TIMEOUT 5000
+
+// Define the time in milliseconds a persistent connection may stay idle between requests.
+#define HTTP_KEEP_ALIVE_TIMEOUT 10000
+
+// Enum to represent the state of a request after polling a connection.
+enum HttpRequestStateEnum : byte {
+  REQUEST_PENDING,   // Request is incomplete, or the connection is idle.
+  REQUEST_COMPLETE,  // Request is complete and ready to be handled.
+  REQUEST_INVALID,   // Request is malformed or exceeds a limit, see the parser error status.
+  REQUEST_TIMEOUT,   // Client did not send a complete request in time.
+  REQUEST_CLOSED     // Client closed the connection, or an idle persistent connection expired.
+};
+
+class HttpConnection {
+public:
+  /**
+  * @brief Take over a newly accepted client.
+  *
+  * @param client The accepted client.
+  */
+  void open(WiFiClient client);
+
+  /**
+  * @brief Check if the connection slot is free.
+  *
+  * @return true if no client is assigned to this connection.
+  */
+  bool isIdle();
+
+  /**
+  * @brief Check if the connection is kept open between requests.
+  *
+  * @return true if a persistent connection has no partial request buffered, so
+  *         closing it to free the slot loses nothing.
+  */
+  bool isBetweenRequests();
+
+  /**
+  * @brief Read available request data without blocking.
+  *
+  * Reads whatever the client has sent so far into the request buffer, parses the
+  * new data and checks for a complete or invalid request, read timeout or disconnect.
+  *
+  * @return The state of the request after reading.
+  */
+  HttpRequestStateEnum poll();
+
+  /**
+  * @brief Get the client of this connection.
+  *
+  * @return Reference to the client, valid until close() is called.
+  */
+  WiFiClient& client();
+
+  /**
+  * @brief Get the parsed request.
+  *
+  * @return Reference to the parser, whose views are valid until close() is called.
+  */
+  HttpRequestParser& request();
+
+  /**
+  * @brief Keep the connection open for the next request.
+  *
+  * Moves any pipelined bytes received after the handled request to the start of
+  * the buffer and restarts parsing, so they are handled on the next poll.
+  */
+  void finishRequest();
+
+  /**
+  * @brief Close the connection and free the slot.
+  */
+  void close();
+
+  /**
+  * @brief Free the slot without closing the client.
+  *
+  * Used when a handler takes over the client, e.g. for a stream of events. The
+  * client stays connected through the copy kept by the new owner.
+  */
+  void detach();
+
+private:
+  WiFiClient _client;
+  bool _isOpen = false;                    // True while a client is assigned.
+  char _buffer[HTTP_REQUEST_BUFFER_SIZE];  // Request data, parsed in place.
+  size_t _length = 0;                      // Number of buffered request bytes.
+  unsigned long _openedAt = 0;             // Time the request started, in milliseconds.
+  bool _isPersistent = false;              // True once a request was handled on this connection.
+  HttpRequestParser _parser;
+};
+
+#endif
\ No newline at end of file
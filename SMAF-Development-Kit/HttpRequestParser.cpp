@@ -0,0 +1,453 @@
+/**
+* @file HttpRequestParser.cpp
+* @brief Implementation of the HttpRequestParser class for incremental request parsing.
+*
+* This file contains the implementation of the HttpRequestParser class, an incremental HTTP/1.1
+* request parser working directly on a connection's fixed-size receive buffer. Each call
+* continues where the previous one stopped, and the method, path, query, headers and body
+* are exposed as views into the buffer without copying. Delimiters are replaced with null
+* characters in place, so the views can also be used as C strings (except the body).
+* Request line, header and body sizes are limited, and violations are reported with the
+* matching HTTP status code.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "HttpRequestParser.h"
+
+/**
+* @brief Compare the view with a C string.
+*
+* @param value The null-terminated string to compare with.
+* @return true if the view has the same characters as the string.
+*/
+bool HttpView::equals(const char* value) const {
+  return strlen(value) == length && memcmp(data, value, length) == 0;
+}
+
+/**
+* @brief Compare the view with a C string, ignoring case.
+*
+* @param value The null-terminated string to compare with.
+* @return true if the view has the same characters as the string, ignoring case.
+*/
+bool HttpView::equalsIgnoreCase(const char* value) const {
+  return strlen(value) == length && strncasecmp(data, value, length) == 0;
+}
+
+/**
+* @brief Prepare the parser for a new request.
+*
+* @param buffer The receive buffer holding the request. Delimiters are overwritten in place.
+* @param capacity The size of the receive buffer in bytes.
+*/
+void HttpRequestParser::reset(char* buffer, size_t capacity) {
+  _buffer = buffer;
+  _capacity = capacity;
+  _position = 0;
+  _state = PARSING_REQUEST_LINE;
+  _errorStatus = 0;
+  _method = HttpView();
+  _path = HttpView();
+  _query = HttpView();
+  _version = HttpView();
+  _headerCount = 0;
+  _bodyStart = 0;
+  _contentLength = 0;
+  _receivedLength = 0;
+  _isBodyStreamed = false;
+}
+
+/**
+* @brief Parse the data received so far.
+*
+* Continues parsing from where the previous call stopped, so each received byte is
+* examined only once. Call again with the new length whenever more data arrives.
+*
+* @param length The number of valid bytes in the receive buffer.
+* @return HTTP_PARSE_COMPLETE when the request including its body is complete,
+*         HTTP_PARSE_ERROR when the request is invalid or exceeds a limit,
+*         otherwise HTTP_PARSE_INCOMPLETE.
+*/
+HttpParseResultEnum HttpRequestParser::parse(size_t length) {
+  if (_state == PARSING_DONE) {
+    return _errorStatus == 0 ? HTTP_PARSE_COMPLETE : HTTP_PARSE_ERROR;
+  }
+
+  // Parse every complete line of the request line and header section.
+  while (_state == PARSING_REQUEST_LINE || _state == PARSING_HEADERS) {
+    char* line = _buffer + _position;
+    char* lineEnd = (char*)memchr(line, '\n', length - _position);
+
+    if (lineEnd == nullptr) {
+      // Enforce line limits before the line is complete, so oversize lines fail early.
+      size_t partialLength = length - _position;
+
+      if (_state == PARSING_REQUEST_LINE && partialLength > HTTP_MAX_REQUEST_LINE_LENGTH) {
+        return fail(414);
+      }
+
+      if (_state == PARSING_HEADERS && partialLength > HTTP_MAX_HEADER_LINE_LENGTH) {
+        return fail(431);
+      }
+
+      // A full buffer without a complete header section can never complete.
+      if (length == _capacity) {
+        return fail(_state == PARSING_REQUEST_LINE ? 414 : 431);
+      }
+
+      return HTTP_PARSE_INCOMPLETE;
+    }
+
+    _position = lineEnd - _buffer + 1;
+
+    // Strip the line terminator, accepting a bare LF as well as CRLF.
+    size_t lineLength = lineEnd - line;
+
+    if (lineLength > 0 && line[lineLength - 1] == '\r') {
+      lineLength--;
+    }
+
+    line[lineLength] = '\0';
+
+    if (!parseLine(line, lineLength)) {
+      return HTTP_PARSE_ERROR;
+    }
+  }
+
+  // Wait until the whole body has arrived, unless the handler streams it.
+  if (!_isBodyStreamed && length - _bodyStart < _contentLength) {
+    return HTTP_PARSE_INCOMPLETE;
+  }
+
+  _receivedLength = length;
+  _state = PARSING_DONE;
+  return HTTP_PARSE_COMPLETE;
+}
+
+/**
+* @brief Get the request method.
+*
+* @return View of the method, e.g. "GET".
+*/
+HttpView HttpRequestParser::method() {
+  return _method;
+}
+
+/**
+* @brief Get the request path without the query.
+*
+* @return View of the path, e.g. "/configuration".
+*/
+HttpView HttpRequestParser::path() {
+  return _path;
+}
+
+/**
+* @brief Get the request query.
+*
+* @return View of the query without the leading '?', empty if there is none.
+*/
+HttpView HttpRequestParser::query() {
+  return _query;
+}
+
+/**
+* @brief Get the number of request headers.
+*
+* @return The number of parsed headers.
+*/
+uint8_t HttpRequestParser::headerCount() {
+  return _headerCount;
+}
+
+/**
+* @brief Get the name of a request header.
+*
+* @param index Index of the header.
+* @return View of the header name.
+*/
+HttpView HttpRequestParser::headerName(uint8_t index) {
+  return _headerNames[index];
+}
+
+/**
+* @brief Get the value of a request header.
+*
+* @param index Index of the header.
+* @return View of the header value, without surrounding whitespace.
+*/
+HttpView HttpRequestParser::headerValue(uint8_t index) {
+  return _headerValues[index];
+}
+
+/**
+* @brief Find a request header by name, ignoring case.
+*
+* @param name The header name.
+* @return View of the header value, empty if the header is not present.
+*/
+HttpView HttpRequestParser::header(const char* name) {
+  for (uint8_t i = 0; i < _headerCount; ++i) {
+    if (_headerNames[i].equalsIgnoreCase(name)) {
+      return _headerValues[i];
+    }
+  }
+
+  return HttpView();
+}
+
+/**
+* @brief Get the request body.
+*
+* @return View of the body, only valid once parsing is complete. Not null-terminated.
+*/
+HttpView HttpRequestParser::body() {
+  HttpView body;
+  body.data = _buffer + _bodyStart;
+  body.length = _isBodyStreamed ? min(_receivedLength - _bodyStart, _contentLength) : _contentLength;
+
+  return body;
+}
+
+/**
+* @brief Get the total length of the request.
+*
+* @return Number of bytes of the request line, headers and body. For a streamed
+*         body, only the part received with the header section is counted.
+*/
+size_t HttpRequestParser::requestLength() {
+  return _bodyStart + body().length;
+}
+
+/**
+* @brief Stream the body of requests to a path instead of buffering it.
+*
+* Requests to the path are complete as soon as their header section is, with the
+* body bytes received so far available from body(). The handler reads the rest of
+* the body from the client, so bodies larger than the receive buffer are accepted.
+* The path is kept across reset().
+*
+* @param path The path whose request bodies are streamed, or nullptr for none.
+*/
+void HttpRequestParser::setStreamedPath(const char* path) {
+  _streamedPath = path;
+}
+
+/**
+* @brief Check if the body of the request is streamed.
+*
+* @return true if the request is complete without its whole body, see setStreamedPath().
+*/
+bool HttpRequestParser::isBodyStreamed() {
+  return _isBodyStreamed;
+}
+
+/**
+* @brief Get the length of the request body announced by the client.
+*
+* @return The Content-Length of the request, 0 if it has none.
+*/
+size_t HttpRequestParser::contentLength() {
+  return _contentLength;
+}
+
+/**
+* @brief Check if the connection should stay open after this request.
+*
+* HTTP/1.1 connections are persistent unless the client sends "Connection: close",
+* HTTP/1.0 connections only if the client sends "Connection: keep-alive".
+*
+* @return true if the client expects the connection to stay open.
+*/
+bool HttpRequestParser::keepAlive() {
+  HttpView connection = header("Connection");
+
+  // Connection tokens are case-insensitive, e.g. "Keep-Alive" or "close".
+  if (connection.length > 0) {
+    if (strcasestr(connection.data, "close") != nullptr) {
+      return false;
+    }
+
+    if (strcasestr(connection.data, "keep-alive") != nullptr) {
+      return true;
+    }
+  }
+
+  return !_version.equals("HTTP/1.0");
+}
+
+/**
+* @brief Get the HTTP status code describing a parse error.
+*
+* @return 400, 413, 414, 431 or 501 after a parse error, otherwise 0.
+*/
+uint16_t HttpRequestParser::errorStatus() {
+  return _errorStatus;
+}
+
+/**
+* @brief Parse one complete line of the request line or header section.
+*
+* @param line Start of the line.
+* @param length Length of the line without the line terminator.
+* @return true if the line is valid, false if parsing failed and the error status is set.
+*/
+bool HttpRequestParser::parseLine(char* line, size_t length) {
+  if (_state == PARSING_REQUEST_LINE) {
+    // Ignore empty lines before the request line.
+    if (length == 0) {
+      return true;
+    }
+
+    if (length > HTTP_MAX_REQUEST_LINE_LENGTH) {
+      fail(414);
+      return false;
+    }
+
+    // Split "METHOD TARGET VERSION" at the spaces.
+    char* methodEnd = strchr(line, ' ');
+    char* targetEnd = methodEnd ? strchr(methodEnd + 1, ' ') : nullptr;
+
+    if (methodEnd == nullptr || targetEnd == nullptr || strncmp(targetEnd + 1, "HTTP/1.", 7) != 0) {
+      fail(400);
+      return false;
+    }
+
+    *methodEnd = '\0';
+    *targetEnd = '\0';
+
+    _method.data = line;
+    _method.length = methodEnd - line;
+    _path.data = methodEnd + 1;
+    _path.length = targetEnd - _path.data;
+    _version.data = targetEnd + 1;
+    _version.length = line + length - _version.data;
+
+    // Split the query from the path.
+    char* queryStart = (char*)memchr(_path.data, '?', _path.length);
+
+    if (queryStart != nullptr) {
+      *queryStart = '\0';
+      _query.data = queryStart + 1;
+      _query.length = targetEnd - _query.data;
+      _path.length = queryStart - _path.data;
+    }
+
+    if (_method.length == 0 || _path.length == 0) {
+      fail(400);
+      return false;
+    }
+
+    _state = PARSING_HEADERS;
+    return true;
+  }
+
+  // An empty line ends the header section.
+  if (length == 0) {
+    _bodyStart = _position;
+
+    // Bodies of the streamed path are read by the handler.
+    if (_streamedPath != nullptr && _path.equals(_streamedPath)) {
+      _isBodyStreamed = true;
+      _state = PARSING_BODY;
+      return true;
+    }
+
+    // The body must fit in the receive buffer.
+    if (_contentLength > _capacity - _bodyStart) {
+      fail(413);
+      return false;
+    }
+
+    _state = PARSING_BODY;
+    return true;
+  }
+
+  if (length > HTTP_MAX_HEADER_LINE_LENGTH || _headerCount == HTTP_MAX_HEADER_COUNT) {
+    fail(431);
+    return false;
+  }
+
+  // Split "Name: value" at the colon.
+  char* colon = strchr(line, ':');
+
+  if (colon == nullptr || colon == line) {
+    fail(400);
+    return false;
+  }
+
+  *colon = '\0';
+
+  // Trim whitespace around the value.
+  char* value = colon + 1;
+  char* valueEnd = line + length;
+
+  while (*value == ' ' || *value == '\t') {
+    value++;
+  }
+
+  while (valueEnd > value && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t')) {
+    valueEnd--;
+  }
+
+  *valueEnd = '\0';
+
+  HttpView& name = _headerNames[_headerCount];
+  name.data = line;
+  name.length = colon - line;
+
+  HttpView& headerValue = _headerValues[_headerCount];
+  headerValue.data = value;
+  headerValue.length = valueEnd - value;
+
+  _headerCount++;
+
+  if (name.equalsIgnoreCase("Content-Length")) {
+    // Accept digits only, and stop before the value could overflow.
+    if (headerValue.length == 0 || headerValue.length > 9 || strspn(value, "0123456789") != headerValue.length) {
+      fail(400);
+      return false;
+    }
+
+    _contentLength = strtoul(value, nullptr, 10);
+  } else if (name.equalsIgnoreCase("Transfer-Encoding")) {
+    // Chunked request bodies are not supported.
+    fail(501);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+* @brief Stop parsing and record the status code describing the error.
+*
+* @param status The HTTP status code.
+* @return HTTP_PARSE_ERROR.
+*/
+HttpParseResultEnum HttpRequestParser::fail(uint16_t status) {
+  _errorStatus = status;
+  _state = PARSING_DONE;
+
+  return HTTP_PARSE_ERROR;
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+/**
+* @file HttpRequestParser.h
+* @brief Declaration of the HttpRequestParser class for incremental request parsing.
+*
+* This file contains the declaration of the HttpRequestParser class, an incremental HTTP/1.1
+* request parser working directly on a connection's fixed-size receive buffer. Each call
+* continues where the previous one stopped, and the method, path, query, headers and body
+* are exposed as views into the buffer without copying. Delimiters are replaced with null
+* characters in place, so the views can also be used as C strings (except the body).
+* Request line, header and body sizes are limited, and violations are reported with the
+* matching HTTP status code.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include "Arduino.h"
+
+// Define the request limits enforced by the parser.
+#define HTTP_MAX_REQUEST_LINE_LENGTH 512  // Longer request lines are rejected with 414.
+#define HTTP_MAX_HEADER_LINE_LENGTH 512   // Longer header lines are rejected with 431.
+#define HTTP_MAX_HEADER_COUNT 16          // More headers are rejected with 431.
+
+// Enum to represent the result of parsing received data.
+enum HttpParseResultEnum : byte {
+  HTTP_PARSE_INCOMPLETE,  // More data is needed.
+  HTTP_PARSE_COMPLETE,    // Request including its body is complete.
+  HTTP_PARSE_ERROR        // Request is invalid or exceeds a limit.
+};
+
+// Structure to represent a view of characters in the receive buffer.
+struct HttpView {
+  const char* data = "";  // Start of the characters.
+  size_t length = 0;      // Number of characters.
+
+  /**
+  * @brief Compare the view with a C string.
+  *
+  * @param value The null-terminated string to compare with.
+  * @return true if the view has the same characters as the string.
+  */
+  bool equals(const char* value) const;
+
+  /**
+  * @brief Compare the view with a C string, ignoring case.
+  *
+  * @param value The null-terminated string to compare with.
+  * @return true if the view has the same characters as the string, ignoring case.
+  */
+  bool equalsIgnoreCase(const char* value) const;
+};
+
+class HttpRequestParser {
+public:
+  /**
+  * @brief Prepare the parser for a new request.
+  *
+  * @param buffer The receive buffer holding the request. Delimiters are overwritten in place.
+  * @param capacity The size of the receive buffer in bytes.
+  */
+  void reset(char* buffer, size_t capacity);
+
+  /**
+  * @brief Parse the data received so far.
+  *
+  * Continues parsing from where the previous call stopped, so each received byte is
+  * examined only once. Call again with the new length whenever more data arrives.
+  *
+  * @param length The number of valid bytes in the receive buffer.
+  * @return HTTP_PARSE_COMPLETE when the request including its body is complete,
+  *         HTTP_PARSE_ERROR when the request is invalid or exceeds a limit,
+  *         otherwise HTTP_PARSE_INCOMPLETE.
+  */
+  HttpParseResultEnum parse(size_t length);
+
+  /**
+  * @brief Get the request method.
+  *
+  * @return View of the method, e.g. "GET".
+  */
+  HttpView method();
+
+  /**
+  * @brief Get the request path without the query.
+  *
+  * @return View of the path, e.g. "/configuration".
+  */
+  HttpView path();
+
+  /**
+  * @brief Get the request query.
+  *
+  * @return View of the query without the leading '?', empty if there is none.
+  */
+  HttpView query();
+
+  /**
+  * @brief Get the number of request headers.
+  *
+  * @return The number of parsed headers.
+  */
+  uint8_t headerCount();
+
+  /**
+  * @brief Get the name of a request header.
+  *
+  * @param index Index of the header.
+  * @return View of the header name.
+  */
+  HttpView headerName(uint8_t index);
+
+  /**
+  * @brief Get the value of a request header.
+  *
+  * @param index Index of the header.
+  * @return View of the header value, without surrounding whitespace.
+  */
+  HttpView headerValue(uint8_t index);
+
+  /**
+  * @brief Find a request header by name, ignoring case.
+  *
+  * @param name The header name.
+  * @return View of the header value, empty if the header is not present.
+  */
+  HttpView header(const char* name);
+
+  /**
+  * @brief Get the request body.
+  *
+  * @return View of the body, only valid once parsing is complete. Not null-terminated.
+  *         For a streamed body, only the part received with the header section.
+  */
+  HttpView body();
+
+  /**
+  * @brief Get the total length of the request.
+  *
+  * @return Number of bytes of the request line, headers and body. For a streamed
+  *         body, only the part received with the header section is counted.
+  */
+  size_t requestLength();
+
+  /**
+  * @brief Stream the body of requests to a path instead of buffering it.
+  *
+  * Requests to the path are complete as soon as their header section is, with the
+  * body bytes received so far available from body(). The handler reads the rest of
+  * the body from the client, so bodies larger than the receive buffer are accepted.
+  * The path is kept across reset().
+  *
+  * @param path The path whose request bodies are streamed, or nullptr for none.
+  */
+  void setStreamedPath(const char* path);
+
+  /**
+  * @brief Check if the body of the request is streamed.
+  *
+  * @return true if the request is complete without its whole body, see setStreamedPath().
+  */
+  bool isBodyStreamed();
+
+  /**
+  * @brief Get the length of the request body announced by the client.
+  *
+  * @return The Content-Length of the request, 0 if it has none.
+  */
+  size_t contentLength();
+
+  /**
+  * @brief Check if the connection should stay open after this request.
+  *
+  * HTTP/1.1 connections are persistent unless the client sends "Connection: close",
+  * HTTP/1.0 connections only if the client sends "Connection: keep-alive".
+  *
+  * @return true if the client expects the connection to stay open.
+  */
+  bool keepAlive();
+
+  /**
+  * @brief Get the HTTP status code describing a parse error.
+  *
+  * @return 400, 413, 414, 431 or 501 after a parse error, otherwise 0.
+  */
+  uint16_t errorStatus();
+
+private:
+  // Enum to represent the part of the request being parsed.
+  enum ParserStateEnum : byte {
+    PARSING_REQUEST_LINE,
+    PARSING_HEADERS,
+    PARSING_BODY,
+    PARSING_DONE
+  };
+
+  char* _buffer = nullptr;
+  size_t _capacity = 0;
+  size_t _position = 0;  // Start of the next unparsed line.
+  ParserStateEnum _state = PARSING_REQUEST_LINE;
+  uint16_t _errorStatus = 0;
+
+  HttpView _method;
+  HttpView _path;
+  HttpView _query;
+  HttpView _version;
+  HttpView _headerNames[HTTP_MAX_HEADER_COUNT];
+  HttpView _headerValues[HTTP_MAX_HEADER_COUNT];
+  uint8_t _headerCount = 0;
+  size_t _bodyStart = 0;
+  size_t _contentLength = 0;
+  size_t _receivedLength = 0;           // Bytes received when the request completed.
+  const char* _streamedPath = nullptr;  // Path whose request bodies are streamed.
+  bool _isBodyStreamed = false;         // True if the handler reads the body.
+
+  /**
+  * @brief Parse one complete line of the request line or header section.
+  *
+  * @param line Start of the line.
+  * @param length Length of the line without the line terminator.
+  * @return true if the line is valid, false if parsing failed and the error status is set.
+  */
+  bool parseLine(char* line, size_t length);
+
+  /**
+  * @brief Stop parsing and record the status code describing the error.
+  *
+  * @param status The HTTP status code.
+  * @return HTTP_PARSE_ERROR.
+  */
+  HttpParseResultEnum fail(uint16_t status);
+};
+
+#endif
\ No newline at end of file
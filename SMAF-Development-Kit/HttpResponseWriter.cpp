@@ -0,0 +1,378 @@
+/**
+* @file HttpResponseWriter.cpp
+* @brief Implementation of the HttpResponseWriter class for streaming HTTP responses.
+*
+* This file contains the implementation of the HttpResponseWriter class, which streams HTTP
+* responses to a WiFiClient through a fixed-size buffer. Dynamic bodies are sent with
+* `Transfer-Encoding: chunked` and flushed whenever the buffer fills, so the RAM used
+* for a response is bounded by the buffer size regardless of the body length. Static
+* bodies with a known length are sent directly with a precomputed `Content-Length`.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "HttpResponseWriter.h"
+
+/**
+* @brief Constructor for HttpResponseWriter class.
+*
+* @param client The client the response is written to.
+*/
+HttpResponseWriter::HttpResponseWriter(WiFiClient& client)
+  : _client(client) {
+}
+
+/**
+* @brief Add a header to the response.
+*
+* Must be called before begin() or send(). The name and value are not copied and
+* must stay valid until the headers are written.
+*
+* @param name The header name.
+* @param value The header value.
+*/
+void HttpResponseWriter::addHeader(const char* name, const char* value) {
+  if (_headerCount < HTTP_RESPONSE_MAX_HEADERS) {
+    _headerNames[_headerCount] = name;
+    _headerValues[_headerCount] = value;
+    _headerCount++;
+  }
+}
+
+/**
+* @brief Choose whether the connection stays open after the response.
+*
+* Must be called before begin() or send(). Responses close the connection by default.
+*
+* @param keepAlive true to keep the connection open for further requests.
+*/
+void HttpResponseWriter::setKeepAlive(bool keepAlive) {
+  _keepAlive = keepAlive;
+}
+
+/**
+* @brief Start a chunked response.
+*
+* Writes the status line and headers. The body is written afterwards with the
+* Print methods and must be finished with end().
+*
+* @param statusCode The HTTP status code.
+* @param contentType The value of the Content-Type header.
+*/
+void HttpResponseWriter::begin(uint16_t statusCode, const char* contentType) {
+  writeHead(statusCode, contentType, nullptr, HTTP_LENGTH_CHUNKED);
+}
+
+/**
+* @brief Start a response whose body ends with the connection.
+*
+* Writes the status line and headers without a length or chunked framing, and
+* closes the connection after the body. The body is written directly to the
+* client afterwards, e.g. as a stream of server-sent events.
+*
+* @param statusCode The HTTP status code.
+* @param contentType The value of the Content-Type header.
+*/
+void HttpResponseWriter::beginStream(uint16_t statusCode, const char* contentType) {
+  _keepAlive = false;
+  writeHead(statusCode, contentType, nullptr, HTTP_LENGTH_UNTIL_CLOSE);
+}
+
+/**
+* @brief Send a complete response with a known body length.
+*
+* Writes the status line, headers with a precomputed Content-Length and the body
+* straight from the given memory, which may be a flash resident array. Responses
+* without a body, such as 304 Not Modified, can pass nullptr as the content type.
+*
+* @param statusCode The HTTP status code.
+* @param contentType The value of the Content-Type header.
+* @param body Pointer to the body.
+* @param length Length of the body in bytes.
+* @param contentEncoding The value of the Content-Encoding header, or nullptr to omit it.
+*/
+void HttpResponseWriter::send(uint16_t statusCode, const char* contentType, const uint8_t* body, size_t length, const char* contentEncoding) {
+  writeHead(statusCode, contentType, contentEncoding, length);
+
+  if (length > 0) {
+    _client.write(body, length);
+  }
+}
+
+/**
+* @brief Write a single byte to the response body.
+*
+* @param data The byte to write.
+* @return The number of bytes written.
+*/
+size_t HttpResponseWriter::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+/**
+* @brief Write bytes to the response body.
+*
+* Bytes are collected in the buffer, which is sent as one chunk whenever it fills.
+*
+* @param data Pointer to the bytes to write.
+* @param length Number of bytes to write.
+* @return The number of bytes written.
+*/
+size_t HttpResponseWriter::write(const uint8_t* data, size_t length) {
+  size_t written = 0;
+
+  while (written < length) {
+    // Copy as much as fits in the buffer.
+    size_t count = min(length - written, (size_t)HTTP_RESPONSE_BUFFER_SIZE - _length);
+    memcpy(_buffer + HTTP_CHUNK_PREFIX_SIZE + _length, data + written, count);
+    _length += count;
+    written += count;
+
+    // Send the buffer as one chunk once it is full.
+    if (_length == HTTP_RESPONSE_BUFFER_SIZE) {
+      flushChunk();
+    }
+  }
+
+  return written;
+}
+
+/**
+* @brief Write a quoted and escaped JSON string to the response body.
+*
+* Quotes, backslashes and control characters are escaped, so user provided values
+* such as passwords can not break the JSON structure.
+*
+* @param value The string to write.
+*/
+void HttpResponseWriter::printJsonString(const char* value) {
+  write('"');
+
+  for (const char* c = value; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      write('\\');
+      write(*c);
+    } else if ((uint8_t)*c < 0x20) {
+      char escaped[7];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+      write(escaped, 6);
+    } else {
+      write(*c);
+    }
+  }
+
+  write('"');
+}
+
+/**
+* @brief Start a JSON object in the response body.
+*
+* Writes the opening brace. Fields written with printJsonField() until
+* endJsonObject() are separated by commas automatically.
+*/
+void HttpResponseWriter::beginJsonObject() {
+  write('{');
+  _needsSeparator = false;
+}
+
+/**
+* @brief Finish a JSON object in the response body.
+*
+* Writes the closing brace.
+*/
+void HttpResponseWriter::endJsonObject() {
+  write('}');
+  _needsSeparator = true;
+}
+
+/**
+* @brief Write the key of a JSON object field.
+*
+* Writes a comma first unless this is the first field of the object.
+*
+* @param key The key of the field.
+*/
+void HttpResponseWriter::printJsonKey(const char* key) {
+  if (_needsSeparator) {
+    write(',');
+  }
+
+  printJsonString(key);
+  write(':');
+  _needsSeparator = true;
+}
+
+/**
+* @brief Write a JSON object field with a string value.
+*
+* @param key The key of the field.
+* @param value The value of the field.
+*/
+void HttpResponseWriter::printJsonField(const char* key, const char* value) {
+  printJsonKey(key);
+  printJsonString(value);
+}
+
+/**
+* @brief Write a JSON object field with a numeric value.
+*
+* @param key The key of the field.
+* @param value The value of the field.
+*/
+void HttpResponseWriter::printJsonField(const char* key, int32_t value) {
+  char number[12];
+  int length = snprintf(number, sizeof(number), "%ld", (long)value);
+
+  printJsonKey(key);
+  write(number, length);
+}
+
+/**
+* @brief Write a JSON object field with a boolean value.
+*
+* @param key The key of the field.
+* @param value The value of the field.
+*/
+void HttpResponseWriter::printJsonField(const char* key, bool value) {
+  printJsonKey(key);
+  write(value ? "true" : "false");
+}
+
+/**
+* @brief Finish a chunked response.
+*
+* Sends any buffered body bytes and the terminating zero-length chunk.
+*/
+void HttpResponseWriter::end() {
+  if (_length > 0) {
+    flushChunk();
+  }
+
+  // Send the terminating zero-length chunk.
+  _client.write("0\r\n\r\n", 5);
+}
+
+/**
+* @brief Write the status line and headers.
+*
+* @param statusCode The HTTP status code.
+* @param contentType The value of the Content-Type header, or nullptr to omit it.
+* @param contentEncoding The value of the Content-Encoding header, or nullptr to omit it.
+* @param contentLength The body length, HTTP_LENGTH_CHUNKED or HTTP_LENGTH_UNTIL_CLOSE.
+*/
+void HttpResponseWriter::writeHead(uint16_t statusCode, const char* contentType, const char* contentEncoding, int32_t contentLength) {
+  // Format the headers in the buffer, which is still empty at this point.
+  char* head = (char*)_buffer;
+  size_t size = sizeof(_buffer);
+  size_t length = snprintf(head, size, "HTTP/1.1 %u %s\r\n", statusCode, statusText(statusCode));
+
+  if (contentType != nullptr) {
+    length += snprintf(head + min(length, size), size - min(length, size), "Content-Type: %s\r\n", contentType);
+  }
+
+  if (contentEncoding != nullptr) {
+    length += snprintf(head + min(length, size), size - min(length, size), "Content-Encoding: %s\r\n", contentEncoding);
+  }
+
+  for (uint8_t i = 0; i < _headerCount; ++i) {
+    length += snprintf(head + min(length, size), size - min(length, size), "%s: %s\r\n", _headerNames[i], _headerValues[i]);
+  }
+
+  // A 304 response has no body, and a body ending with the connection needs no length.
+  if (contentLength == HTTP_LENGTH_CHUNKED) {
+    length += snprintf(head + min(length, size), size - min(length, size), "Transfer-Encoding: chunked\r\n");
+  } else if (contentLength >= 0 && statusCode != 304) {
+    length += snprintf(head + min(length, size), size - min(length, size), "Content-Length: %u\r\n", (unsigned int)contentLength);
+  }
+
+  length += snprintf(head + min(length, size), size - min(length, size), "Connection: %s\r\n\r\n", _keepAlive ? "keep-alive" : "close");
+
+  _client.write(_buffer, min(length, size - 1));
+  _length = 0;
+}
+
+/**
+* @brief Send the buffered body bytes as one chunk.
+*
+* The chunk size line and trailing CRLF are written around the data in the same
+* buffer, so every chunk goes out in a single write.
+*/
+void HttpResponseWriter::flushChunk() {
+  // Write the fixed width chunk size line in front of the data.
+  char sizeLine[HTTP_CHUNK_PREFIX_SIZE + 1];
+  snprintf(sizeLine, sizeof(sizeLine), "%04x\r\n", (unsigned int)_length);
+  memcpy(_buffer, sizeLine, HTTP_CHUNK_PREFIX_SIZE);
+
+  // Terminate the chunk data with CRLF.
+  _buffer[HTTP_CHUNK_PREFIX_SIZE + _length] = '\r';
+  _buffer[HTTP_CHUNK_PREFIX_SIZE + _length + 1] = '\n';
+
+  _client.write(_buffer, HTTP_CHUNK_PREFIX_SIZE + _length + HTTP_CHUNK_SUFFIX_SIZE);
+  _length = 0;
+}
+
+/**
+* @brief Get the reason phrase for an HTTP status code.
+*
+* @param statusCode The HTTP status code.
+* @return The reason phrase, or "Unknown" for unsupported codes.
+*/
+const char* HttpResponseWriter::statusText(uint16_t statusCode) {
+  switch (statusCode) {
+    case 200:
+      return "OK";
+    case 204:
+      return "No Content";
+    case 302:
+      return "Found";
+    case 304:
+      return "Not Modified";
+    case 400:
+      return "Bad Request";
+    case 401:
+      return "Unauthorized";
+    case 403:
+      return "Forbidden";
+    case 404:
+      return "Not Found";
+    case 405:
+      return "Method Not Allowed";
+    case 408:
+      return "Request Timeout";
+    case 413:
+      return "Payload Too Large";
+    case 414:
+      return "URI Too Long";
+    case 431:
+      return "Request Header Fields Too Large";
+    case 500:
+      return "Internal Server Error";
+    case 501:
+      return "Not Implemented";
+    case 502:
+      return "Bad Gateway";
+    case 503:
+      return "Service Unavailable";
+    default:
+      return "Unknown";
+  }
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+/**
+* @file HttpResponseWriter.h
+* @brief Declaration of the HttpResponseWriter class for streaming HTTP responses.
+*
+* This file contains the declaration of the HttpResponseWriter class, which streams HTTP
+* responses to a WiFiClient through a fixed-size buffer. Dynamic bodies are sent with
+* `Transfer-Encoding: chunked` and flushed whenever the buffer fills, so the RAM used
+* for a response is bounded by the buffer size regardless of the body length. Static
+* bodies with a known length are sent directly with a precomputed `Content-Length`.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HTTP_RESPONSE_WRITER_H
+#define HTTP_RESPONSE_WRITER_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+// Define the size of the response body buffer in bytes.
+#define HTTP_RESPONSE_BUFFER_SIZE 512
+
+// Define the space reserved around each chunk for the size line ("01f0\r\n") and trailing CRLF.
+#define HTTP_CHUNK_PREFIX_SIZE 6
+#define HTTP_CHUNK_SUFFIX_SIZE 2
+
+// Define the special body lengths passed to writeHead().
+#define HTTP_LENGTH_CHUNKED -1      // The body is sent in chunks.
+#define HTTP_LENGTH_UNTIL_CLOSE -2  // The body ends when the connection is closed.
+
+// Define the maximum number of extra headers per response.
+#define HTTP_RESPONSE_MAX_HEADERS 4
+
+class HttpResponseWriter : public Print {
+public:
+  /**
+  * @brief Constructor for HttpResponseWriter class.
+  *
+  * @param client The client the response is written to.
+  */
+  HttpResponseWriter(WiFiClient& client);
+
+  /**
+  * @brief Add a header to the response.
+  *
+  * Must be called before begin() or send(). The name and value are not copied and
+  * must stay valid until the headers are written.
+  *
+  * @param name The header name.
+  * @param value The header value.
+  */
+  void addHeader(const char* name, const char* value);
+
+  /**
+  * @brief Choose whether the connection stays open after the response.
+  *
+  * Must be called before begin() or send(). Responses close the connection by default.
+  *
+  * @param keepAlive true to keep the connection open for further requests.
+  */
+  void setKeepAlive(bool keepAlive);
+
+  /**
+  * @brief Start a chunked response.
+  *
+  * Writes the status line and headers. The body is written afterwards with the
+  * Print methods and must be finished with end().
+  *
+  * @param statusCode The HTTP status code.
+  * @param contentType The value of the Content-Type header.
+  */
+  void begin(uint16_t statusCode, const char* contentType);
+
+  /**
+  * @brief Start a response whose body ends with the connection.
+  *
+  * Writes the status line and headers without a length or chunked framing, and
+  * closes the connection after the body. The body is written directly to the
+  * client afterwards, e.g. as a stream of server-sent events.
+  *
+  * @param statusCode The HTTP status code.
+  * @param contentType The value of the Content-Type header.
+  */
+  void beginStream(uint16_t statusCode, const char* contentType);
+
+  /**
+  * @brief Send a complete response with a known body length.
+  *
+  * Writes the status line, headers with a precomputed Content-Length and the body
+  * straight from the given memory, which may be a flash resident array. Responses
+  * without a body, such as 304 Not Modified, can pass nullptr as the content type.
+  *
+  * @param statusCode The HTTP status code.
+  * @param contentType The value of the Content-Type header.
+  * @param body Pointer to the body.
+  * @param length Length of the body in bytes.
+  * @param contentEncoding The value of the Content-Encoding header, or nullptr to omit it.
+  */
+  void send(uint16_t statusCode, const char* contentType, const uint8_t* body, size_t length, const char* contentEncoding = nullptr);
+
+  /**
+  * @brief Write a single byte to the response body.
+  *
+  * @param data The byte to write.
+  * @return The number of bytes written.
+  */
+  size_t write(uint8_t data) override;
+
+  /**
+  * @brief Write bytes to the response body.
+  *
+  * Bytes are collected in the buffer, which is sent as one chunk whenever it fills.
+  *
+  * @param data Pointer to the bytes to write.
+  * @param length Number of bytes to write.
+  * @return The number of bytes written.
+  */
+  size_t write(const uint8_t* data, size_t length) override;
+
+  // Make the remaining Print::write overloads visible.
+  using Print::write;
+
+  /**
+  * @brief Write a quoted and escaped JSON string to the response body.
+  *
+  * Quotes, backslashes and control characters are escaped, so user provided values
+  * such as passwords can not break the JSON structure.
+  *
+  * @param value The string to write.
+  */
+  void printJsonString(const char* value);
+
+  /**
+  * @brief Start a JSON object in the response body.
+  *
+  * Writes the opening brace. Fields written with printJsonField() until
+  * endJsonObject() are separated by commas automatically.
+  */
+  void beginJsonObject();
+
+  /**
+  * @brief Finish a JSON object in the response body.
+  *
+  * Writes the closing brace.
+  */
+  void endJsonObject();
+
+  /**
+  * @brief Write the key of a JSON object field.
+  *
+  * Writes a comma first unless this is the first field of the object.
+  *
+  * @param key The key of the field.
+  */
+  void printJsonKey(const char* key);
+
+  /**
+  * @brief Write a JSON object field with a string value.
+  *
+  * @param key The key of the field.
+  * @param value The value of the field.
+  */
+  void printJsonField(const char* key, const char* value);
+
+  /**
+  * @brief Write a JSON object field with a numeric value.
+  *
+  * @param key The key of the field.
+  * @param value The value of the field.
+  */
+  void printJsonField(const char* key, int32_t value);
+
+  /**
+  * @brief Write a JSON object field with a boolean value.
+  *
+  * @param key The key of the field.
+  * @param value The value of the field.
+  */
+  void printJsonField(const char* key, bool value);
+
+  /**
+  * @brief Finish a chunked response.
+  *
+  * Sends any buffered body bytes and the terminating zero-length chunk.
+  */
+  void end();
+
+private:
+  WiFiClient& _client;
+
+  // Buffer for the chunk size line, body bytes and trailing CRLF.
+  uint8_t _buffer[HTTP_CHUNK_PREFIX_SIZE + HTTP_RESPONSE_BUFFER_SIZE + HTTP_CHUNK_SUFFIX_SIZE];
+  size_t _length = 0;  // Number of buffered body bytes.
+
+  // True if the next JSON field needs a separating comma.
+  bool _needsSeparator = false;
+
+  // Extra headers, written with the status line.
+  const char* _headerNames[HTTP_RESPONSE_MAX_HEADERS];
+  const char* _headerValues[HTTP_RESPONSE_MAX_HEADERS];
+  uint8_t _headerCount = 0;
+  bool _keepAlive = false;
+
+  /**
+  * @brief Write the status line and headers.
+  *
+  * @param statusCode The HTTP status code.
+  * @param contentType The value of the Content-Type header, or nullptr to omit it.
+  * @param contentEncoding The value of the Content-Encoding header, or nullptr to omit it.
+  * @param contentLength The body length, HTTP_LENGTH_CHUNKED or HTTP_LENGTH_UNTIL_CLOSE.
+  */
+  void writeHead(uint16_t statusCode, const char* contentType, const char* contentEncoding, int32_t contentLength);
+
+  /**
+  * @brief Send the buffered body bytes as one chunk.
+  *
+  * The chunk size line and trailing CRLF are written around the data in the same
+  * buffer, so every chunk goes out in a single write.
+  */
+  void flushChunk();
+
+  /**
+  * @brief Get the reason phrase for an HTTP status code.
+  *
+  * @param statusCode The HTTP status code.
+  * @return The reason phrase, or "Unknown" for unsupported codes.
+  */
+  const char* statusText(uint16_t statusCode);
+};
+
+#endif
\ No newline at end of file
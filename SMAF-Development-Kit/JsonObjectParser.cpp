@@ -0,0 +1,386 @@
+/**
+* @file JsonObjectParser.cpp
+* @brief Implementation of the JsonObjectParser class for in-place parsing of flat JSON objects.
+*
+* This file contains the implementation of the JsonObjectParser class, a minimal parser for
+* flat JSON objects such as configuration updates. It parses the object in place in
+* the request buffer: strings are unescaped where they are and null-terminated, and
+* numbers and booleans are converted while parsing, so no memory is allocated. Nested
+* objects and arrays, and numbers with fractions or exponents, are not supported.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "JsonObjectParser.h"
+
+/**
+* @brief Parse a flat JSON object in place.
+*
+* @param data The JSON text, overwritten by the unescaped strings.
+* @param length Length of the JSON text in bytes.
+* @return true if the text is a valid flat JSON object, false otherwise.
+*/
+bool JsonObjectParser::parse(char* data, size_t length) {
+  _data = data;
+  _cursor = data;
+  _end = data + length;
+  _count = 0;
+
+  skipWhitespace();
+
+  if (_cursor == _end || *_cursor != '{') {
+    return false;
+  }
+
+  _cursor++;
+  skipWhitespace();
+
+  // An empty object has no members.
+  if (_cursor < _end && *_cursor == '}') {
+    _cursor++;
+  } else {
+    while (true) {
+      if (_count == JSON_MAX_MEMBERS) {
+        return false;
+      }
+
+      Member& member = _members[_count];
+
+      // Parse "key": value.
+      skipWhitespace();
+      member.key = parseString();
+
+      if (member.key == nullptr) {
+        return false;
+      }
+
+      skipWhitespace();
+
+      if (_cursor == _end || *_cursor != ':') {
+        return false;
+      }
+
+      _cursor++;
+      skipWhitespace();
+
+      if (!parseValue(member)) {
+        return false;
+      }
+
+      _count++;
+      skipWhitespace();
+
+      if (_cursor == _end) {
+        return false;
+      }
+
+      if (*_cursor == '}') {
+        _cursor++;
+        break;
+      }
+
+      if (*_cursor != ',') {
+        return false;
+      }
+
+      _cursor++;
+    }
+  }
+
+  // Only whitespace may follow the object.
+  skipWhitespace();
+  return _cursor == _end;
+}
+
+/**
+* @brief Get the number of members of the parsed object.
+*
+* @return The number of members.
+*/
+uint8_t JsonObjectParser::count() {
+  return _count;
+}
+
+/**
+* @brief Get the key of a member.
+*
+* @param index Index of the member.
+* @return Null-terminated, unescaped key.
+*/
+const char* JsonObjectParser::key(uint8_t index) {
+  return _members[index].key;
+}
+
+/**
+* @brief Get the value type of a member.
+*
+* @param index Index of the member.
+* @return The value type.
+*/
+JsonValueTypeEnum JsonObjectParser::type(uint8_t index) {
+  return _members[index].type;
+}
+
+/**
+* @brief Get the value of a string member.
+*
+* @param index Index of the member.
+* @return Null-terminated, unescaped value, or an empty string for other types.
+*/
+const char* JsonObjectParser::string(uint8_t index) {
+  return _members[index].type == JSON_STRING ? _members[index].string : "";
+}
+
+/**
+* @brief Get the value of a number member.
+*
+* @param index Index of the member.
+* @return The integer value, or 0 for other types.
+*/
+int32_t JsonObjectParser::number(uint8_t index) {
+  return _members[index].type == JSON_NUMBER ? _members[index].number : 0;
+}
+
+/**
+* @brief Get the value of a boolean member.
+*
+* @param index Index of the member.
+* @return The boolean value, or false for other types.
+*/
+bool JsonObjectParser::boolean(uint8_t index) {
+  return _members[index].type == JSON_BOOLEAN && _members[index].boolean;
+}
+
+/**
+* @brief Find a member by key.
+*
+* @param key The member key.
+* @return Index of the member, or -1 if the object has no such member.
+*/
+int8_t JsonObjectParser::indexOf(const char* key) {
+  for (uint8_t i = 0; i < _count; ++i) {
+    if (strcmp(_members[i].key, key) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/**
+* @brief Get the position of a syntax error.
+*
+* @return Offset in bytes of the character where parsing failed.
+*/
+size_t JsonObjectParser::errorOffset() {
+  return _cursor - _data;
+}
+
+/**
+* @brief Advance past whitespace characters.
+*/
+void JsonObjectParser::skipWhitespace() {
+  while (_cursor < _end && (*_cursor == ' ' || *_cursor == '\t' || *_cursor == '\r' || *_cursor == '\n')) {
+    _cursor++;
+  }
+}
+
+/**
+* @brief Parse a string at the current position and unescape it in place.
+*
+* Unescaping never grows the string, so the result is written over the input and
+* null-terminated at most at the position of the closing quote.
+*
+* @return Start of the unescaped string, or nullptr on a syntax error.
+*/
+char* JsonObjectParser::parseString() {
+  if (_cursor == _end || *_cursor != '"') {
+    return nullptr;
+  }
+
+  char* start = ++_cursor;
+  char* write = start;
+
+  while (_cursor < _end) {
+    char c = *_cursor;
+
+    // The closing quote is consumed before the terminator is written over the output.
+    if (c == '"') {
+      _cursor++;
+      *write = '\0';
+      return start;
+    }
+
+    // Control characters must be escaped.
+    if ((uint8_t)c < 0x20) {
+      return nullptr;
+    }
+
+    if (c != '\\') {
+      *write++ = c;
+      _cursor++;
+      continue;
+    }
+
+    if (_end - _cursor < 2) {
+      return nullptr;
+    }
+
+    switch (_cursor[1]) {
+      case '"': *write++ = '"'; break;
+      case '\\': *write++ = '\\'; break;
+      case '/': *write++ = '/'; break;
+      case 'b': *write++ = '\b'; break;
+      case 'f': *write++ = '\f'; break;
+      case 'n': *write++ = '\n'; break;
+      case 'r': *write++ = '\r'; break;
+      case 't': *write++ = '\t'; break;
+
+      case 'u':
+        {
+          uint16_t code;
+
+          if (_end - _cursor < 6 || !parseHex(_cursor + 2, code) || code == 0) {
+            return nullptr;
+          }
+
+          // Encode the code unit as UTF-8, which takes at most as many bytes as its escape.
+          // Surrogate pairs are not combined, keys and values are expected to be mostly ASCII.
+          if (code < 0x80) {
+            *write++ = code;
+          } else if (code < 0x800) {
+            *write++ = 0xc0 | (code >> 6);
+            *write++ = 0x80 | (code & 0x3f);
+          } else {
+            *write++ = 0xe0 | (code >> 12);
+            *write++ = 0x80 | ((code >> 6) & 0x3f);
+            *write++ = 0x80 | (code & 0x3f);
+          }
+
+          _cursor += 4;
+        }
+        break;
+
+      default:
+        return nullptr;
+    }
+
+    _cursor += 2;
+  }
+
+  // The string is not terminated.
+  return nullptr;
+}
+
+/**
+* @brief Parse a member value at the current position.
+*
+* @param member The member receiving the value.
+* @return true if the value is valid.
+*/
+bool JsonObjectParser::parseValue(Member& member) {
+  if (_cursor == _end) {
+    return false;
+  }
+
+  if (*_cursor == '"') {
+    member.type = JSON_STRING;
+    member.string = parseString();
+    return member.string != nullptr;
+  }
+
+  // Literals are compared without copying.
+  if (_end - _cursor >= 4 && strncmp(_cursor, "true", 4) == 0) {
+    member.type = JSON_BOOLEAN;
+    member.boolean = true;
+    _cursor += 4;
+    return true;
+  }
+
+  if (_end - _cursor >= 5 && strncmp(_cursor, "false", 5) == 0) {
+    member.type = JSON_BOOLEAN;
+    member.boolean = false;
+    _cursor += 5;
+    return true;
+  }
+
+  if (_end - _cursor >= 4 && strncmp(_cursor, "null", 4) == 0) {
+    member.type = JSON_NULL;
+    _cursor += 4;
+    return true;
+  }
+
+  // Integers are converted while parsing, so the text does not need to be terminated.
+  bool isNegative = _cursor < _end && *_cursor == '-';
+
+  if (isNegative) {
+    _cursor++;
+  }
+
+  if (_cursor == _end || !isdigit(*_cursor)) {
+    return false;
+  }
+
+  int64_t value = 0;
+
+  while (_cursor < _end && isdigit(*_cursor)) {
+    value = value * 10 + (*_cursor++ - '0');
+
+    if (value > INT32_MAX) {
+      return false;
+    }
+  }
+
+  member.type = JSON_NUMBER;
+  member.number = isNegative ? -value : value;
+
+  // Fractions and exponents are not supported.
+  return _cursor == _end || (*_cursor != '.' && *_cursor != 'e' && *_cursor != 'E');
+}
+
+/**
+* @brief Parse the four hexadecimal digits of a unicode escape.
+*
+* @param digits Pointer to the first digit.
+* @param value Set to the parsed code unit.
+* @return true if all four characters are hexadecimal digits.
+*/
+bool JsonObjectParser::parseHex(const char* digits, uint16_t& value) {
+  value = 0;
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    char c = digits[i];
+    value <<= 4;
+
+    if ('0' <= c && c <= '9') {
+      value |= c - '0';
+    } else if ('a' <= c && c <= 'f') {
+      value |= c - 'a' + 10;
+    } else if ('A' <= c && c <= 'F') {
+      value |= c - 'A' + 10;
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/**
+* @file JsonObjectParser.h
+* @brief Declaration of the JsonObjectParser class for in-place parsing of flat JSON objects.
+*
+* This file contains the declaration of the JsonObjectParser class, a minimal parser for
+* flat JSON objects such as configuration updates. It parses the object in place in
+* the request buffer: strings are unescaped where they are and null-terminated, and
+* numbers and booleans are converted while parsing, so no memory is allocated. Nested
+* objects and arrays, and numbers with fractions or exponents, are not supported.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef JSON_OBJECT_PARSER_H
+#define JSON_OBJECT_PARSER_H
+
+#include "Arduino.h"
+
+// Define the maximum number of members of a parsed object.
+#define JSON_MAX_MEMBERS 16
+
+// Enum to represent the type of a member value.
+enum JsonValueTypeEnum : byte {
+  JSON_STRING,
+  JSON_NUMBER,
+  JSON_BOOLEAN,
+  JSON_NULL
+};
+
+class JsonObjectParser {
+public:
+  /**
+  * @brief Parse a flat JSON object in place.
+  *
+  * @param data The JSON text, overwritten by the unescaped strings.
+  * @param length Length of the JSON text in bytes.
+  * @return true if the text is a valid flat JSON object, false otherwise.
+  */
+  bool parse(char* data, size_t length);
+
+  /**
+  * @brief Get the number of members of the parsed object.
+  *
+  * @return The number of members.
+  */
+  uint8_t count();
+
+  /**
+  * @brief Get the key of a member.
+  *
+  * @param index Index of the member.
+  * @return Null-terminated, unescaped key.
+  */
+  const char* key(uint8_t index);
+
+  /**
+  * @brief Get the value type of a member.
+  *
+  * @param index Index of the member.
+  * @return The value type.
+  */
+  JsonValueTypeEnum type(uint8_t index);
+
+  /**
+  * @brief Get the value of a string member.
+  *
+  * @param index Index of the member.
+  * @return Null-terminated, unescaped value, or an empty string for other types.
+  */
+  const char* string(uint8_t index);
+
+  /**
+  * @brief Get the value of a number member.
+  *
+  * @param index Index of the member.
+  * @return The integer value, or 0 for other types.
+  */
+  int32_t number(uint8_t index);
+
+  /**
+  * @brief Get the value of a boolean member.
+  *
+  * @param index Index of the member.
+  * @return The boolean value, or false for other types.
+  */
+  bool boolean(uint8_t index);
+
+  /**
+  * @brief Find a member by key.
+  *
+  * @param key The member key.
+  * @return Index of the member, or -1 if the object has no such member.
+  */
+  int8_t indexOf(const char* key);
+
+  /**
+  * @brief Get the position of a syntax error.
+  *
+  * @return Offset in bytes of the character where parsing failed.
+  */
+  size_t errorOffset();
+
+private:
+  // Structure to represent a parsed object member.
+  struct Member {
+    const char* key;
+    JsonValueTypeEnum type;
+    const char* string;
+    int32_t number;
+    bool boolean;
+  };
+
+  char* _data = nullptr;
+  char* _cursor = nullptr;  // Next character to parse.
+  char* _end = nullptr;     // End of the JSON text.
+  Member _members[JSON_MAX_MEMBERS];
+  uint8_t _count = 0;
+
+  /**
+  * @brief Advance past whitespace characters.
+  */
+  void skipWhitespace();
+
+  /**
+  * @brief Parse a string at the current position and unescape it in place.
+  *
+  * Unescaping never grows the string, so the result is written over the input and
+  * null-terminated at most at the position of the closing quote.
+  *
+  * @return Start of the unescaped string, or nullptr on a syntax error.
+  */
+  char* parseString();
+
+  /**
+  * @brief Parse a member value at the current position.
+  *
+  * @param member The member receiving the value.
+  * @return true if the value is valid.
+  */
+  bool parseValue(Member& member);
+
+  /**
+  * @brief Parse the four hexadecimal digits of a unicode escape.
+  *
+  * @param digits Pointer to the first digit.
+  * @param value Set to the parsed code unit.
+  * @return true if all four characters are hexadecimal digits.
+  */
+  static bool parseHex(const char* digits, uint16_t& value);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,273 @@
+/**
+* @file LedAnimator.cpp
+* @brief Implementation of the LedAnimator class for keyframe LED animations.
+*
+* This file contains the implementation of the LedAnimator class, which plays constant keyframe
+* tables on the NeoPixel strip. Frames are rendered from a one-shot system timer callback that
+* is armed only for the next color change, so no task waits in delay() between frames.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "LedAnimator.h"
+
+/**
+* @brief Ease the progress of a keyframe.
+*
+* @param easing The easing of the keyframe.
+* @param progress Progress through the keyframe, from 0 to 255.
+* @return The eased progress, from 0 to 255.
+*/
+static uint8_t easeProgress(LedEasingEnum easing, uint8_t progress) {
+  switch (easing) {
+    case LED_EASING_LINEAR:
+      return progress;
+    case LED_EASING_EASE_IN_OUT:
+      // Smoothstep, 3p^2 - 2p^3 scaled to 0-255.
+      return (uint8_t)((uint32_t)progress * progress * (765 - 2 * progress) / 65025);
+    default:
+      return 255;
+  }
+}
+
+/**
+* @brief Blend two packed colors.
+*
+* @param from The color at progress 0.
+* @param to The color at progress 255.
+* @param progress Progress from one color to the other, from 0 to 255.
+* @return The packed 0xRRGGBB blended color.
+*/
+static uint32_t blendColor(uint32_t from, uint32_t to, uint8_t progress) {
+  uint32_t color = 0;
+
+  for (uint8_t shift = 0; shift <= 16; shift += 8) {
+    int32_t start = (from >> shift) & 0xFF;
+    int32_t end = (to >> shift) & 0xFF;
+    color |= (uint32_t)(start + (end - start) * progress / 255) << shift;
+  }
+
+  return color;
+}
+
+/**
+* @brief Constructs an instance of the LedAnimator class.
+*
+* @param neoPixel The NeoPixel strip to animate. It must be initialized before playing.
+*/
+LedAnimator::LedAnimator(Adafruit_NeoPixel& neoPixel)
+  : _neoPixel(neoPixel) {
+}
+
+/**
+* @brief Create the frame timer.
+*
+* Must be called once before playing animations.
+*
+* @return true if the animator is ready, false if the timer or its lock could not be created.
+*/
+bool LedAnimator::begin() {
+  if (_timer != nullptr) {
+    return true;
+  }
+
+  _lock = xSemaphoreCreateMutex();
+
+  if (_lock == nullptr) {
+    return false;
+  }
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = onFrame;
+  timerArgs.arg = this;
+  timerArgs.dispatch_method = ESP_TIMER_TASK;
+  timerArgs.name = "LedAnimator";
+
+  return esp_timer_create(&timerArgs, &_timer) == ESP_OK;
+}
+
+/**
+* @brief Play an animation.
+*
+* Replaces the animation playing at the moment. Its first frame is shown before
+* returning, fading from the colors shown right now, and the next frames are
+* rendered by the frame timer. May be called from any task.
+*
+* @param animation The animation to play. Its keyframe table must outlive the playback.
+*/
+void LedAnimator::play(const LedAnimation& animation) {
+  if (_timer == nullptr) {
+    return;
+  }
+
+  // A looping animation without any duration would never finish a frame.
+  uint32_t duration = 0;
+
+  for (uint8_t i = 0; i < animation.keyframeCount; ++i) {
+    duration += animation.keyframes[i].duration;
+  }
+
+  if (animation.keyframeCount == 0 || (animation.isLooping && duration == 0)) {
+    stop();
+    return;
+  }
+
+  xSemaphoreTake(_lock, portMAX_DELAY);
+
+  int64_t now = esp_timer_get_time();
+
+  _animation = animation;
+  _isPlaying = true;
+  _keyframe = 0;
+  _keyframeStartedAt = now;
+  memcpy(_startColors, _colors, sizeof(_startColors));
+
+  renderFrame(now);
+
+  xSemaphoreGive(_lock);
+}
+
+/**
+* @brief Stop the animation and turn all pixels off.
+*/
+void LedAnimator::stop() {
+  if (_lock != nullptr) {
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    _isPlaying = false;
+    esp_timer_stop(_timer);
+  }
+
+  memset(_colors, 0, sizeof(_colors));
+  _neoPixel.clear();
+  _neoPixel.show();
+
+  if (_lock != nullptr) {
+    xSemaphoreGive(_lock);
+  }
+}
+
+/**
+* @brief Check if an animation is playing.
+*
+* @return true while an animation is playing, false once it stopped or ended.
+*/
+bool LedAnimator::isPlaying() {
+  return _isPlaying;
+}
+
+/**
+* @brief Frame timer callback.
+*
+* Called from the system timer task when the next frame is due.
+*
+* @param arg The LedAnimator instance.
+*/
+void LedAnimator::onFrame(void* arg) {
+  LedAnimator* animator = (LedAnimator*)arg;
+
+  xSemaphoreTake(animator->_lock, portMAX_DELAY);
+  animator->renderFrame(esp_timer_get_time());
+  xSemaphoreGive(animator->_lock);
+}
+
+/**
+* @brief Render the frame due now and arm the timer for the next one.
+*
+* Moves on to the keyframe due now, shows its colors if they changed and arms the
+* timer for the end of a held keyframe, or for the next frame of a fading one.
+* The lock must be held.
+*
+* @param now Monotonic time in microseconds.
+*/
+void LedAnimator::renderFrame(int64_t now) {
+  // A frame already due when the animation was stopped or replaced is skipped.
+  if (!_isPlaying) {
+    return;
+  }
+
+  // Move past finished keyframes, catching up if the timer task was late.
+  int64_t duration = _animation.keyframes[_keyframe].duration * 1000LL;
+
+  while (now - _keyframeStartedAt >= duration) {
+    const LedKeyframe& finished = _animation.keyframes[_keyframe];
+
+    memcpy(_startColors, finished.colors, sizeof(_startColors));
+    _keyframeStartedAt += duration;
+
+    if (++_keyframe == _animation.keyframeCount) {
+      if (!_animation.isLooping) {
+        // Hold the colors of the last keyframe.
+        _isPlaying = false;
+        showColors(finished.colors);
+        return;
+      }
+
+      _keyframe = 0;
+    }
+
+    duration = _animation.keyframes[_keyframe].duration * 1000LL;
+  }
+
+  const LedKeyframe& keyframe = _animation.keyframes[_keyframe];
+  int64_t elapsed = now - _keyframeStartedAt;
+  uint8_t progress = easeProgress(keyframe.easing, (uint8_t)(elapsed * 255 / duration));
+  uint32_t colors[LED_ANIMATION_PIXELS];
+
+  for (uint8_t i = 0; i < LED_ANIMATION_PIXELS; ++i) {
+    colors[i] = blendColor(_startColors[i], keyframe.colors[i], progress);
+  }
+
+  showColors(colors);
+
+  // Held colors need no frame until the keyframe ends.
+  int64_t nextFrame = duration - elapsed;
+
+  if (keyframe.easing != LED_EASING_STEP && nextFrame > LED_FRAME_INTERVAL * 1000LL) {
+    nextFrame = LED_FRAME_INTERVAL * 1000LL;
+  }
+
+  esp_timer_stop(_timer);
+  esp_timer_start_once(_timer, nextFrame);
+}
+
+/**
+* @brief Show colors on the strip.
+*
+* Only pixels whose color changed are set, and nothing is sent if none did.
+*
+* @param colors Packed 0xRRGGBB color of each pixel.
+*/
+void LedAnimator::showColors(const uint32_t* colors) {
+  bool isChanged = false;
+
+  for (uint8_t i = 0; i < LED_ANIMATION_PIXELS; ++i) {
+    if (colors[i] != _colors[i]) {
+      _colors[i] = colors[i];
+      _neoPixel.setPixelColor(i, colors[i]);
+      isChanged = true;
+    }
+  }
+
+  if (isChanged) {
+    _neoPixel.show();
+  }
+}
\ No newline at end of file
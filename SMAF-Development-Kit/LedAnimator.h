@@ -0,0 +1,166 @@
+/**
+* @file LedAnimator.h
+* @brief Declaration of the LedAnimator class for keyframe LED animations.
+*
+* This file contains the declaration of the LedAnimator class, which plays constant keyframe
+* tables on the NeoPixel strip. Frames are rendered from a one-shot system timer callback that
+* is armed only for the next color change, so no task waits in delay() between frames.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef LED_ANIMATOR_H
+#define LED_ANIMATOR_H
+
+#include "Arduino.h"
+#include "Adafruit_NeoPixel.h"
+#include "esp_timer.h"
+
+// Define the animation limits.
+#define LED_ANIMATION_PIXELS 2  // Number of pixels a keyframe sets the color of.
+#define LED_FRAME_INTERVAL 20   // Time between frames while fading, in milliseconds.
+
+// Enum to represent how a keyframe reaches its colors.
+enum LedEasingEnum : byte {
+  LED_EASING_STEP,        // Switch to the colors at once and hold them.
+  LED_EASING_LINEAR,      // Fade to the colors at a constant rate.
+  LED_EASING_EASE_IN_OUT  // Fade to the colors, slowly at the start and the end.
+};
+
+// Structure to store one step of an animation.
+struct LedKeyframe {
+  uint32_t colors[LED_ANIMATION_PIXELS];  // Packed 0xRRGGBB color of each pixel at the end of the keyframe.
+  uint16_t duration;                      // Duration of the keyframe, in milliseconds.
+  LedEasingEnum easing;                   // How the colors of the previous keyframe change to these.
+};
+
+// Structure to store an animation, a constant table of keyframes.
+struct LedAnimation {
+  const LedKeyframe* keyframes;  // Keyframes in playing order.
+  uint8_t keyframeCount;         // Number of keyframes.
+  bool isLooping;                // True to start over after the last keyframe, false to hold its colors.
+};
+
+/**
+* @brief Create an animation repeating a keyframe table.
+*
+* @param keyframes The keyframe table, kept for as long as the animation plays.
+* @return The looping animation.
+*/
+template<size_t N>
+constexpr LedAnimation loopingAnimation(const LedKeyframe (&keyframes)[N]) {
+  return LedAnimation{ keyframes, (uint8_t)N, true };
+}
+
+/**
+* @brief Create an animation playing a keyframe table once.
+*
+* @param keyframes The keyframe table, kept for as long as the animation plays.
+* @return The animation, holding the colors of the last keyframe when done.
+*/
+template<size_t N>
+constexpr LedAnimation singleAnimation(const LedKeyframe (&keyframes)[N]) {
+  return LedAnimation{ keyframes, (uint8_t)N, false };
+}
+
+class LedAnimator {
+public:
+  /**
+  * @brief Constructs an instance of the LedAnimator class.
+  *
+  * @param neoPixel The NeoPixel strip to animate. It must be initialized before playing.
+  */
+  LedAnimator(Adafruit_NeoPixel& neoPixel);
+
+  /**
+  * @brief Create the frame timer.
+  *
+  * Must be called once before playing animations.
+  *
+  * @return true if the animator is ready, false if the timer or its lock could not be created.
+  */
+  bool begin();
+
+  /**
+  * @brief Play an animation.
+  *
+  * Replaces the animation playing at the moment. Its first frame is shown before
+  * returning, fading from the colors shown right now, and the next frames are
+  * rendered by the frame timer. May be called from any task.
+  *
+  * @param animation The animation to play. Its keyframe table must outlive the playback.
+  */
+  void play(const LedAnimation& animation);
+
+  /**
+  * @brief Stop the animation and turn all pixels off.
+  */
+  void stop();
+
+  /**
+  * @brief Check if an animation is playing.
+  *
+  * @return true while an animation is playing, false once it stopped or ended.
+  */
+  bool isPlaying();
+
+private:
+  /**
+  * @brief Frame timer callback.
+  *
+  * Called from the system timer task when the next frame is due.
+  *
+  * @param arg The LedAnimator instance.
+  */
+  static void onFrame(void* arg);
+
+  /**
+  * @brief Render the frame due now and arm the timer for the next one.
+  *
+  * Moves on to the keyframe due now, shows its colors if they changed and arms the
+  * timer for the end of a held keyframe, or for the next frame of a fading one.
+  * The lock must be held.
+  *
+  * @param now Monotonic time in microseconds.
+  */
+  void renderFrame(int64_t now);
+
+  /**
+  * @brief Show colors on the strip.
+  *
+  * Only pixels whose color changed are set, and nothing is sent if none did.
+  *
+  * @param colors Packed 0xRRGGBB color of each pixel.
+  */
+  void showColors(const uint32_t* colors);
+
+  Adafruit_NeoPixel& _neoPixel;                      // Animated NeoPixel strip.
+  esp_timer_handle_t _timer = nullptr;               // One-shot timer for the next frame.
+  SemaphoreHandle_t _lock = nullptr;                 // Guards the playback state against the timer task.
+  LedAnimation _animation = {};                      // Playing animation.
+  bool _isPlaying = false;                           // True while the animation plays.
+  uint8_t _keyframe = 0;                             // Index of the playing keyframe.
+  int64_t _keyframeStartedAt = 0;                    // Time the keyframe started, in microseconds.
+  uint32_t _startColors[LED_ANIMATION_PIXELS] = {};  // Colors the keyframe fades from.
+  uint32_t _colors[LED_ANIMATION_PIXELS] = {};       // Colors shown on the strip.
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+* @file NetworkScanner.cpp
+* @brief Implementation of the NetworkScanner class for background Wi-Fi scans.
+*
+* This file contains the implementation of the NetworkScanner class, which scans for Wi-Fi
+* networks asynchronously in the background and keeps the results in a fixed-size cache.
+* Cached results are deduplicated by SSID, sorted by signal strength and time-stamped,
+* so the configuration page can list networks instantly without waiting for a scan.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "NetworkScanner.h"
+#include "Helpers.h"
+
+/**
+* @brief Start an asynchronous Wi-Fi scan.
+*
+* Does nothing if a scan is already running. Results are collected by update().
+*/
+void NetworkScanner::startScan() {
+  if (_isScanning) {
+    return;
+  }
+
+  // Start the scan without blocking, results are collected in update().
+  if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+    debug(ERR, "Starting Wi-Fi scan failed.");
+    return;
+  }
+
+  _isScanning = true;
+  debug(CMD, "Scanning for Wi-Fi networks.");
+}
+
+/**
+* @brief Collect the results of a finished scan.
+*
+* Must be called periodically. When the running scan has finished, its results are
+* deduplicated by SSID (keeping the strongest signal), sorted by RSSI and stored in
+* the cache, and the scan memory is released.
+*/
+void NetworkScanner::update() {
+  if (!_isScanning) {
+    return;
+  }
+
+  int16_t networksFound = WiFi.scanComplete();
+
+  // Keep waiting while the scan is running.
+  if (networksFound == WIFI_SCAN_RUNNING) {
+    return;
+  }
+
+  _isScanning = false;
+
+  if (networksFound == WIFI_SCAN_FAILED) {
+    debug(ERR, "Wi-Fi scan failed.");
+    return;
+  }
+
+  // Replace the cache with the new results.
+  _count = 0;
+
+  for (int16_t i = 0; i < networksFound; ++i) {
+    addNetwork(WiFi.SSID(i).c_str(), WiFi.RSSI(i));
+  }
+
+  // Delete the scan result to free memory.
+  WiFi.scanDelete();
+
+  _hasResults = true;
+  _scannedAt = millis();
+
+  debug(SCS, "Wi-Fi scan found %d networks, %d unique.", networksFound, _count);
+}
+
+/**
+* @brief Check if a scan is running.
+*
+* @return true if a scan has been started and its results are not collected yet.
+*/
+bool NetworkScanner::isScanning() {
+  return _isScanning;
+}
+
+/**
+* @brief Get the number of cached networks.
+*
+* @return The number of networks in the cache.
+*/
+uint8_t NetworkScanner::count() {
+  return _count;
+}
+
+/**
+* @brief Get the SSID of a cached network.
+*
+* @param index Index of the network, networks are sorted by signal strength.
+* @return The SSID of the network.
+*/
+const char* NetworkScanner::ssid(uint8_t index) {
+  return _networks[index].ssid;
+}
+
+/**
+* @brief Get the signal strength of a cached network.
+*
+* @param index Index of the network, networks are sorted by signal strength.
+* @return The RSSI of the network in dBm.
+*/
+int32_t NetworkScanner::rssi(uint8_t index) {
+  return _networks[index].rssi;
+}
+
+/**
+* @brief Get the age of the cached results.
+*
+* @return Milliseconds since the cache was last updated, or -1 if no scan has completed yet.
+*/
+int32_t NetworkScanner::age() {
+  if (!_hasResults) {
+    return -1;
+  }
+
+  return millis() - _scannedAt;
+}
+
+/**
+* @brief Add a network to the cache, keeping the strongest signal per SSID.
+*
+* @param ssid The SSID of the network.
+* @param rssi The RSSI of the network in dBm.
+*/
+void NetworkScanner::addNetwork(const char* ssid, int32_t rssi) {
+  // Skip hidden networks.
+  if (isEmpty(ssid)) {
+    return;
+  }
+
+  // Find an existing entry with the same SSID.
+  uint8_t index = 0;
+
+  while (index < _count && strcmp(_networks[index].ssid, ssid) != 0) {
+    index++;
+  }
+
+  if (index < _count) {
+    // Keep the existing entry if it has the stronger signal.
+    if (_networks[index].rssi >= rssi) {
+      return;
+    }
+  } else if (_count < NETWORK_SCANNER_MAX_NETWORKS) {
+    // Append a new entry.
+    index = _count++;
+    strncpy(_networks[index].ssid, ssid, NETWORK_SCANNER_SSID_LENGTH);
+    _networks[index].ssid[NETWORK_SCANNER_SSID_LENGTH] = '\0';
+  } else if (_networks[_count - 1].rssi < rssi) {
+    // Replace the weakest entry when the cache is full.
+    index = _count - 1;
+    strncpy(_networks[index].ssid, ssid, NETWORK_SCANNER_SSID_LENGTH);
+    _networks[index].ssid[NETWORK_SCANNER_SSID_LENGTH] = '\0';
+  } else {
+    return;
+  }
+
+  _networks[index].rssi = rssi;
+
+  // Move the entry up until the cache is sorted by RSSI again.
+  while (index > 0 && _networks[index - 1].rssi < _networks[index].rssi) {
+    Network network = _networks[index - 1];
+    _networks[index - 1] = _networks[index];
+    _networks[index] = network;
+    index--;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+* @file NetworkScanner.h
+* @brief Declaration of the NetworkScanner class for background Wi-Fi scans.
+*
+* This file contains the declaration of the NetworkScanner class, which scans for Wi-Fi
+* networks asynchronously in the background and keeps the results in a fixed-size cache.
+* Cached results are deduplicated by SSID, sorted by signal strength and time-stamped,
+* so the configuration page can list networks instantly without waiting for a scan.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef NETWORK_SCANNER_H
+#define NETWORK_SCANNER_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+// Define the maximum number of cached networks.
+#define NETWORK_SCANNER_MAX_NETWORKS 24
+
+// Define the maximum SSID length, as defined by IEEE 802.11.
+#define NETWORK_SCANNER_SSID_LENGTH 32
+
+class NetworkScanner {
+public:
+  /**
+  * @brief Start an asynchronous Wi-Fi scan.
+  *
+  * Does nothing if a scan is already running. Results are collected by update().
+  */
+  void startScan();
+
+  /**
+  * @brief Collect the results of a finished scan.
+  *
+  * Must be called periodically. When the running scan has finished, its results are
+  * deduplicated by SSID (keeping the strongest signal), sorted by RSSI and stored in
+  * the cache, and the scan memory is released.
+  */
+  void update();
+
+  /**
+  * @brief Check if a scan is running.
+  *
+  * @return true if a scan has been started and its results are not collected yet.
+  */
+  bool isScanning();
+
+  /**
+  * @brief Get the number of cached networks.
+  *
+  * @return The number of networks in the cache.
+  */
+  uint8_t count();
+
+  /**
+  * @brief Get the SSID of a cached network.
+  *
+  * @param index Index of the network, networks are sorted by signal strength.
+  * @return The SSID of the network.
+  */
+  const char* ssid(uint8_t index);
+
+  /**
+  * @brief Get the signal strength of a cached network.
+  *
+  * @param index Index of the network, networks are sorted by signal strength.
+  * @return The RSSI of the network in dBm.
+  */
+  int32_t rssi(uint8_t index);
+
+  /**
+  * @brief Get the age of the cached results.
+  *
+  * @return Milliseconds since the cache was last updated, or -1 if no scan has completed yet.
+  */
+  int32_t age();
+
+private:
+  // Structure to store a cached network.
+  struct Network {
+    char ssid[NETWORK_SCANNER_SSID_LENGTH + 1];  // Null-terminated SSID.
+    int32_t rssi;                                // Signal strength in dBm.
+  };
+
+  Network _networks[NETWORK_SCANNER_MAX_NETWORKS];
+  uint8_t _count = 0;             // Number of cached networks.
+  bool _isScanning = false;       // True while a scan is running.
+  bool _hasResults = false;       // True once a scan has completed.
+  unsigned long _scannedAt = 0;   // Time of the last completed scan in milliseconds.
+
+  /**
+  * @brief Add a network to the cache, keeping the strongest signal per SSID.
+  *
+  * @param ssid The SSID of the network.
+  * @param rssi The RSSI of the network in dBm.
+  */
+  void addNetwork(const char* ssid, int32_t rssi);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+* @file OtaPartitionWriter.cpp
+* @brief Implementation of the OtaPartitionWriter class for writing firmware to flash.
+*
+* This file contains the implementation of the OtaPartitionWriter class, which writes a
+* firmware image into the inactive OTA app partition with the ESP-IDF OTA API and
+* switches the boot partition once the image is complete.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "OtaPartitionWriter.h"
+
+/**
+* @brief Prepare the inactive OTA partition for a new firmware image.
+*
+* Erases as much of the partition as the image needs.
+*
+* @param size Size of the image in bytes.
+* @return true if the image fits the partition and the partition was prepared.
+*/
+bool OtaPartitionWriter::begin(size_t size) {
+  abort();
+
+  // The partition after the running one, the running firmware is never overwritten.
+  const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+
+  if (partition == nullptr) {
+    debug(ERR, "No OTA partition available for the firmware update.");
+    return false;
+  }
+
+  if (size > partition->size) {
+    debug(ERR, "Firmware of %u bytes does not fit partition '%s' of %u bytes.", (unsigned)size, partition->label, (unsigned)partition->size);
+    return false;
+  }
+
+  esp_err_t error = esp_ota_begin(partition, size, &_handle);
+
+  if (error != ESP_OK) {
+    debug(ERR, "Preparing partition '%s' failed: %s.", partition->label, esp_err_to_name(error));
+    return false;
+  }
+
+  _partition = partition;
+  debug(CMD, "Writing firmware of %u bytes to partition '%s'.", (unsigned)size, partition->label);
+
+  return true;
+}
+
+/**
+* @brief Write the next part of the image to the partition.
+*
+* @param data The image data.
+* @param length Length of the data in bytes.
+* @return true if the data was written.
+*/
+bool OtaPartitionWriter::write(const uint8_t* data, size_t length) {
+  if (_partition == nullptr) {
+    return false;
+  }
+
+  esp_err_t error = esp_ota_write(_handle, data, length);
+
+  if (error != ESP_OK) {
+    debug(ERR, "Writing firmware to partition '%s' failed: %s.", _partition->label, esp_err_to_name(error));
+    return false;
+  }
+
+  return true;
+}
+
+/**
+* @brief Validate the image and set its partition as the boot partition.
+*
+* The new firmware boots pending verification. Unless it calls
+* confirmRunningFirmware(), the bootloader rolls back to the previous firmware
+* on the next reset.
+*
+* @return true if the image is valid and will be booted next.
+*/
+bool OtaPartitionWriter::end() {
+  if (_partition == nullptr) {
+    return false;
+  }
+
+  const esp_partition_t* partition = _partition;
+  _partition = nullptr;
+
+  // Checks the image header and the checksum of the written image.
+  esp_err_t error = esp_ota_end(_handle);
+
+  if (error != ESP_OK) {
+    debug(ERR, "Firmware in partition '%s' is not valid: %s.", partition->label, esp_err_to_name(error));
+    return false;
+  }
+
+  error = esp_ota_set_boot_partition(partition);
+
+  if (error != ESP_OK) {
+    debug(ERR, "Selecting boot partition '%s' failed: %s.", partition->label, esp_err_to_name(error));
+    return false;
+  }
+
+  debug(SCS, "Firmware written, partition '%s' boots next.", partition->label);
+
+  return true;
+}
+
+/**
+* @brief Discard the image written since begin().
+*/
+void OtaPartitionWriter::abort() {
+  if (_partition != nullptr) {
+    esp_ota_abort(_handle);
+    _partition = nullptr;
+  }
+}
+
+/**
+* @brief Confirm the running firmware after an update.
+*
+* Cancels the rollback of firmware booted pending verification. Call it once the
+* firmware has proven to work, e.g. after setup and joining the network.
+* Does nothing for firmware that is already confirmed.
+*/
+void OtaPartitionWriter::confirmRunningFirmware() {
+  esp_ota_img_states_t state;
+
+  if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) != ESP_OK || state != ESP_OTA_IMG_PENDING_VERIFY) {
+    return;
+  }
+
+  if (esp_ota_mark_app_valid_cancel_rollback() == ESP_OK) {
+    debug(SCS, "Updated firmware confirmed, rollback cancelled.");
+  }
+}
\ No newline at end of file
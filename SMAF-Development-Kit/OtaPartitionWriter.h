@@ -0,0 +1,90 @@
+/**
+* @file OtaPartitionWriter.h
+* @brief Declaration of the OtaPartitionWriter class for writing firmware to flash.
+*
+* This file contains the declaration of the OtaPartitionWriter class, which writes a
+* firmware image into the inactive OTA app partition with the ESP-IDF OTA API and
+* switches the boot partition once the image is complete. The running partition is
+* never touched, so a failed update leaves the current firmware in place.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef OTA_PARTITION_WRITER_H
+#define OTA_PARTITION_WRITER_H
+
+#include "Arduino.h"
+#include "esp_ota_ops.h"
+#include "FirmwareWriter.h"
+#include "Helpers.h"
+
+class OtaPartitionWriter : public FirmwareWriter {
+public:
+  /**
+  * @brief Prepare the inactive OTA partition for a new firmware image.
+  *
+  * Erases as much of the partition as the image needs.
+  *
+  * @param size Size of the image in bytes.
+  * @return true if the image fits the partition and the partition was prepared.
+  */
+  bool begin(size_t size) override;
+
+  /**
+  * @brief Write the next part of the image to the partition.
+  *
+  * @param data The image data.
+  * @param length Length of the data in bytes.
+  * @return true if the data was written.
+  */
+  bool write(const uint8_t* data, size_t length) override;
+
+  /**
+  * @brief Validate the image and set its partition as the boot partition.
+  *
+  * The new firmware boots pending verification. Unless it calls
+  * confirmRunningFirmware(), the bootloader rolls back to the previous firmware
+  * on the next reset.
+  *
+  * @return true if the image is valid and will be booted next.
+  */
+  bool end() override;
+
+  /**
+  * @brief Discard the image written since begin().
+  */
+  void abort() override;
+
+  /**
+  * @brief Confirm the running firmware after an update.
+  *
+  * Cancels the rollback of firmware booted pending verification. Call it once the
+  * firmware has proven to work, e.g. after setup and joining the network.
+  * Does nothing for firmware that is already confirmed.
+  */
+  static void confirmRunningFirmware();
+
+private:
+  const esp_partition_t* _partition = nullptr;  // Partition being written, nullptr if none.
+  esp_ota_handle_t _handle = 0;                  // OTA handle of the partition being written.
+};
+
+#endif
\ No newline at end of file
@@ -28,6 +28,9 @@
 #include "PubSubClient.h"
 #include "AudioVisualNotifications.h"
 #include "Helpers.h"
+#include "ConnectionRetry.h"
+#include "TimeService.h"
+#include "OtaPartitionWriter.h"
 #include "Wire.h"
 #include "time.h"
 #include "Adafruit_SHT4x.h"
@@ -48,8 +51,21 @@ enum DeviceStatusEnum : byte {
 // Variable to store the current device status.
 DeviceStatusEnum deviceStatus = NONE;  // Initial state is set to NOT_READY.
 
-// Function prototype for the DeviceStatusThread function.
-void DeviceStatusThread(void* pvParameters);
+// Function prototypes for the sketch functions.
+// Declared explicitly so the sketch does not rely on Arduino prototype generation.
+void setDeviceStatus(DeviceStatusEnum status);
+void showDeviceStatus();
+void serverResponse(char* topic, byte* payload, unsigned int length);
+void connectToNetwork();
+void connectToMqttBroker();
+void loadPreferenceVariables();
+void applyConfigurationChanges();
+void measureSampleJitter(int64_t timestamp);
+void bufferSample(int64_t timestamp, float temperature, float humidity);
+void publishBufferedSamples();
+void handleSerialCommands();
+void runSerialCommand(const char* command);
+String configurationTopic(const char* topic);
 
 // SoftAP configurationuration parameters.
 const char* configurationNetworkName = "SMAF-DK-SAP-configuration";
@@ -74,6 +90,7 @@ static const char* mqttTopic;
 static uint16_t mqttServerPort;
 static bool audioNotifications;
 static bool visualNotifications;
+static bool mqttImport;
 
 /**
 * @brief WiFiClient and PubSubClient instances for establishing MQTT communication.
@@ -108,6 +125,44 @@ const char* ntpServer = "europe.pool.ntp.org";  // Global - pool.ntp.org
 const long gmtOffset = 0;
 const int dstOffset = 0;
 
+// Time service for monotonic sample timestamps and SNTP sync tracking.
+TimeService timeService;
+
+// Define the number of samples kept while waiting for time sync or the MQTT broker.
+#define SAMPLE_BUFFER_SIZE 8
+
+// Structure to store a sensor sample with its monotonic timestamp.
+struct Sample {
+  int64_t timestamp;  // Monotonic timestamp in microseconds.
+  float temperature;  // Temperature in degrees celsius.
+  float humidity;     // Relative humidity in percent.
+};
+
+// Ring buffer for samples waiting to be published.
+Sample sampleBuffer[SAMPLE_BUFFER_SIZE];
+uint8_t sampleBufferHead = 0;   // Index of the oldest buffered sample.
+uint8_t sampleBufferCount = 0;  // Number of buffered samples.
+
+// Sample cadence measurement, to verify background work does not delay sampling.
+int64_t previousSampleTimestamp = 0;  // Monotonic timestamp of the previous sample in microseconds.
+int64_t previousSampleInterval = 0;   // Interval between the two previous samples in microseconds.
+
+// Define the suffix of the MQTT topic receiving exported configurations to import.
+#define MQTT_CONFIG_TOPIC_SUFFIX "/config"
+
+// Define the size of a serial command line, it fits an exported configuration.
+#define SERIAL_COMMAND_SIZE (CONFIG_BLOB_SIZE + 16)
+
+// Serial command line received so far.
+char serialCommand[SERIAL_COMMAND_SIZE];
+size_t serialCommandLength = 0;
+
+// Pace of the Wi-Fi and MQTT reconnects.
+// The MQTT upper bound stays below the watchdog timeout, so the device retries before
+// the watchdog resets it during a broker outage.
+ConnectionRetry networkRetry(NETWORK_RETRY_DELAY);
+ConnectionRetry mqttRetry(MQTT_RETRY_DELAY, MQTT_RETRY_MAX_DELAY);
+
 /**
 * @brief Initializes the SMAF-Development-Kit and runs once at the beginning.
 *
@@ -117,18 +172,9 @@ const int dstOffset = 0;
 *
 */
 void setup() {
-  // Create a new task (DeviceStatusThread) and assign it to the primary core (ESP32_CORE_PRIMARY).
-  xTaskCreatePinnedToCore(
-    DeviceStatusThread,    // Function to implement the task.
-    "DeviceStatusThread",  // Name of the task.
-    8000,                  // Stack size in words.
-    NULL,                  // Task input parameter (e.g., delay).
-    1,                     // Priority of the task.
-    NULL,                  // Task handle.
-    ESP32_CORE_SECONDARY   // Core where the task should run.
-  );
-
   // Initialize serial communication at a baud rate of 115200.
+  // The receive buffer holds a whole command, as the loop reads it between samples.
+  Serial.setRxBufferSize(SERIAL_COMMAND_SIZE);
   Serial.begin(115200);
 
   // Set Wire library custom I2C pins.
@@ -140,21 +186,15 @@ void setup() {
   pinMode(configurationurationButton, INPUT);
 
   // Load all preferences to variables.
-  networkName = configuration.getNetworkName();
-  networkPass = configuration.getNetworkPass();
-  mqttServerAddress = configuration.getMqttServerAddress();
-  mqttUsername = configuration.getMqttUsername();
-  mqttPass = configuration.getMqttPass();
-  mqttClientId = configuration.getMqttClientId();
-  mqttTopic = configuration.getMqttTopic();
-  mqttServerPort = configuration.getMqttServerPort();
-  audioNotifications = configuration.getAudioNotificationsStatus();
-  visualNotifications = configuration.getVisualNotificationsStatus();
+  loadPreferenceVariables();
 
   // Initialize visualization library neo pixels.
   // This does not light up neo pixels.
   notifications.initializeVisualNotifications();
 
+  // Show the initial device status, the animation plays on a timer from here on.
+  showDeviceStatus();
+
   // Play intro melody on speaker if enabled in preferences.
   if (audioNotifications) {
     notifications.introAudioNotification();
@@ -166,7 +206,7 @@ void setup() {
   // Print a formatted welcome message with build information.
   String buildVersion = "v0.002";
   String buildDate = "Q2, 2024.";
-  Serial.printf("\n\rSMAF-DEVELOPMENT-KIT, Crafted with love in Europe.\n\rBuild version: %s\n\rBuild date: %s\n\r\n\r", buildVersion, buildDate);
+  Serial.printf("\n\rSMAF-DEVELOPMENT-KIT, Crafted with love in Europe.\n\rBuild version: %s\n\rBuild date: %s\n\r\n\r", buildVersion.c_str(), buildDate.c_str());
 
   bool isConfigurationValid = configuration.loadPreferences();
 
@@ -176,7 +216,7 @@ void setup() {
     configuration.startConfiguration();
 
     // Set device status to Maintenance Mode.
-    deviceStatus = MAINTENANCE_MODE;
+    setDeviceStatus(MAINTENANCE_MODE);
 
     // Play configuration melody notification on speaker.
     if (audioNotifications) {
@@ -184,36 +224,54 @@ void setup() {
     }
 
     // Render the configurationuration page in maintenance mode.
+    // Once a valid configuration is saved, continue starting up without a restart.
     while (true) {
       configuration.renderConfigurationPage();
-    }
-  } else {
-    // Set device status to Not Ready Mode.
-    deviceStatus = NOT_READY;
+      handleSerialCommands();
+
+      if (configuration.hasPendingChanges()) {
+        applyConfigurationChanges();
 
-    // Start SHT4x module.
-    while (!sht4.begin()) {
-      debug(ERR, "SHT4x module not detected on I2C lines.");
-      delay(800);
+        if (configuration.loadPreferences()) {
+          break;
+        }
+      }
     }
 
-    // Log successful SHT4x module initialization.
-    debug(SCS, "SHT4x module detected on I2C lines.");
+    // Leave maintenance mode.
+    configuration.stopConfiguration();
+  }
 
-    // Set SHT4x precision and heater settings.
-    sht4.setPrecision(SHT4X_HIGH_PRECISION);
-    sht4.setHeater(SHT4X_NO_HEATER);
+  // Set device status to Not Ready Mode.
+  setDeviceStatus(NOT_READY);
 
-    // Initialize NTP server time configuration.
-    configTime(gmtOffset, dstOffset, ntpServer);
+  // Start SHT4x module.
+  while (!sht4.begin()) {
+    debug(ERR, "SHT4x module not detected on I2C lines.");
+    delay(800);
+  }
 
-    // MQTT Client message buffer size.
-    // Default is set to 256.
-    mqtt.setBufferSize(1024);
+  // Log successful SHT4x module initialization.
+  debug(SCS, "SHT4x module detected on I2C lines.");
 
-    // Setup hardware Watchdog timer. Bark Bark.
-    initWatchdog(30, true);
-  }
+  // Set SHT4x precision and heater settings.
+  sht4.setPrecision(SHT4X_HIGH_PRECISION);
+  sht4.setHeater(SHT4X_NO_HEATER);
+
+  // Initialize NTP server time configuration.
+  // Synchronization completes in the background and never blocks the loop.
+  timeService.begin(ntpServer, gmtOffset, dstOffset);
+
+  // MQTT Client message buffer size.
+  // Default is set to 256.
+  mqtt.setBufferSize(MQTT_BUFFER_SIZE);
+
+  // Serve the configuration page on the station interface alongside telemetry.
+  // The server runs on the primary core, away from the loop task.
+  configuration.startServerTask(ESP32_CORE_PRIMARY);
+
+  // Setup hardware Watchdog timer. Bark Bark.
+  initWatchdog(30, true);
 }
 
 /**
@@ -225,6 +283,14 @@ void setup() {
 *
 */
 void loop() {
+  // Run commands received over the serial port, such as a configuration import.
+  handleSerialCommands();
+
+  // Apply saved configuration changes without a restart.
+  if (configuration.hasPendingChanges()) {
+    applyConfigurationChanges();
+  }
+
   // Attempt to connect to the Wi-Fi network.
   connectToNetwork();
 
@@ -235,28 +301,28 @@ void loop() {
   sensors_event_t humidity, temp;
   sht4.getEvent(&humidity, &temp);
 
-  debug(LOG, "Enviroment sensor reads temperature of %s degrees celsius with relative humidity at %s percent.", String(temp.temperature, 2), String(humidity.relative_humidity, 2));
+  debug(LOG, "Enviroment sensor reads temperature of %s degrees celsius with relative humidity at %s percent.", String(temp.temperature, 2).c_str(), String(humidity.relative_humidity, 2).c_str());
 
-  // Store MQTT data here.
-  String mqttData = String();
+  // Stamp the sample with the monotonic clock and buffer it until it can be published.
+  int64_t sampleTimestamp = timeService.now();
+  measureSampleJitter(sampleTimestamp);
+  bufferSample(sampleTimestamp, temp.temperature, humidity.relative_humidity);
 
-  // String constructMqttMessage(int32_t longitude, int32_t latitude, int32_t speed, int32_t altitude, String time)
-  mqttData = constructMqttMessage(
-    temp.temperature,
-    humidity.relative_humidity,
-    getUtcTimeString());
+  // Push the sample to browsers watching the live readings.
+  char event[64];
+  snprintf(event, sizeof(event), "{\"temperature\":%.2f,\"humidity\":%.2f}", temp.temperature, humidity.relative_humidity);
+  configuration.publishEvent(event);
 
-  // If the device is ready to send, publish a message to the MQTT broker.
+  // If the device is ready to send, publish buffered samples to the MQTT broker.
   if (deviceStatus == READY_TO_SEND) {
     debug(SCS, "Device is ready to post data.");
-    debug(CMD, "Posting data package to MQTT broker '%s' on topic '%s'.", mqttServerAddress, mqttTopic);
-    mqtt.publish(mqttTopic, mqttData.c_str(), true);
+    publishBufferedSamples();
   } else {
     debug(ERR, "Device is not ready to post data.");
   }
 
   // Delay between data publish.
-  delay(1600);
+  delay(LOOP_INTERVAL);
 
   // Check for incoming data on defined MQTT topic.
   // This is hard core connection check.
@@ -264,11 +330,27 @@ void loop() {
   mqtt.loop();
 }
 
+/**
+* @brief Defer the confirmation of updated firmware.
+*
+* Called by the Arduino core at start-up. Returning true keeps firmware booted after
+* an update pending verification, instead of confirming it before it ran. It is
+* confirmed once setup() finished and the device joined the Wi-Fi network; if it
+* resets before that, the bootloader rolls back to the previous firmware.
+*
+* @return Always true.
+*/
+extern "C" bool verifyRollbackLater() {
+  return true;
+}
+
 /**
 * @brief Handles the server response received on a specific MQTT topic.
 *
 * This function logs the server response using debug output. If the device status is not
 * in maintenance mode, it also resets the watchdog timer to prevent system reset.
+* Messages on the configuration topic are imported as configuration if the import is
+* enabled, and then cleared, so a retained configuration is imported only once.
 *
 * @param topic The MQTT topic on which the server response was received.
 * @param payload Pointer to the payload data received from the server.
@@ -277,6 +359,22 @@ void loop() {
 void serverResponse(char* topic, byte* payload, unsigned int length) {
   debug(SCS, "Server '%s' responded.", mqttServerAddress);
 
+  // Import a configuration exported by another device, it is applied on the next loop.
+  // An empty message is the cleared retained configuration.
+  String importTopic = configurationTopic(mqttTopic);
+
+  if (mqttImport && length > 0 && importTopic.equals(topic)) {
+    const char* error = configuration.importConfiguration((const char*)payload, length);
+
+    if (error != nullptr) {
+      debug(ERR, "Importing configuration failed: %s", error);
+    }
+
+    // PubSubClient does not report the retain flag, so clear a retained configuration
+    // instead, it must not overwrite later changes when the device subscribes again.
+    mqtt.publish(importTopic.c_str(), "", true);
+  }
+
   // Reset WDT.
   if (deviceStatus != MAINTENANCE_MODE) {
     resetWatchdog();
@@ -295,7 +393,7 @@ void serverResponse(char* topic, byte* payload, unsigned int length) {
 void connectToNetwork() {
   if (WiFi.status() != WL_CONNECTED) {
     // Set initial device status.
-    deviceStatus = NOT_READY;
+    setDeviceStatus(NOT_READY);
 
     // Disable auto-reconnect and set Wi-Fi mode to station mode.
     WiFi.setAutoReconnect(false);
@@ -310,12 +408,23 @@ void connectToNetwork() {
 
       // Attempt to connect to the Wi-Fi network using configurationured credentials.
       WiFi.begin(networkName, networkPass);
-      delay(6400);
+      delay(networkRetry.nextDelay());
     }
 
+    networkRetry.reset();
+
     // Log successful connection and set device status.
     debug(SCS, "Device connected to '%s'.", networkName);
   }
+
+  // Setup finished and the network joined, so updated firmware passed its self-test
+  // and is kept. A broker outage must not roll back firmware that works.
+  static bool isFirmwareConfirmed = false;
+
+  if (!isFirmwareConfirmed) {
+    OtaPartitionWriter::confirmRunningFirmware();
+    isFirmwareConfirmed = true;
+  }
 }
 
 /**
@@ -333,7 +442,7 @@ void connectToNetwork() {
 void connectToMqttBroker() {
   if (!mqtt.connected()) {
     // Set initial device status.
-    deviceStatus = NOT_READY;
+    setDeviceStatus(NOT_READY);
 
     // Set MQTT server and connection parameters.
     mqtt.setServer(mqttServerAddress, mqttServerPort);
@@ -345,111 +454,292 @@ void connectToMqttBroker() {
     debug(ERR, "Device not connected to MQTT broker '%s'.", mqttServerAddress);
 
     // Keep attempting to connect until successful.
+    // Retries back off exponentially with jitter to avoid reconnect storms on the broker.
     while (!mqtt.connected()) {
       debug(CMD, "Connecting device to MQTT broker '%s'.", mqttServerAddress);
 
       if (mqtt.connect(mqttClientId, mqttUsername, mqttPass)) {
         // Log successful connection and set device status.
         debug(SCS, "Device connected to MQTT broker '%s'.", mqttServerAddress);
+        mqttRetry.reset();
+
+        // Feed the watchdog only once connected, a broker that stays unreachable still resets the device.
+        resetWatchdog();
 
-        // Subscribe to MQTT topic.
+        // Subscribe to MQTT topic, and to its configuration topic if the import is enabled.
         mqtt.subscribe(mqttTopic);
 
-        // deviceStatus = WAITING_GNSS;
-        deviceStatus = READY_TO_SEND;
+        if (mqttImport) {
+          mqtt.subscribe(configurationTopic(mqttTopic).c_str());
+        }
+
+        // setDeviceStatus(WAITING_GNSS);
+        setDeviceStatus(READY_TO_SEND);
       } else {
         // Retry after a delay if connection failed.
-        delay(4000);
+        delay(mqttRetry.nextDelay());
       }
     }
   }
 }
 
 /**
-* @brief Retrieves the current UTC time as a formatted string.
+* @brief Load all preferences from the WiFiConfig instance into the sketch variables.
 *
-* This function retrieves the current UTC time using the system time. If successful,
-* it formats the time into a UTC date time string (e.g., "2024-06-20T20:56:59Z").
-* If the UTC time cannot be obtained, it returns "Unknown".
+* Must be called again after the preferences are reloaded, to take over changed numbers
+* and flags. The strings are updated in place.
+*/
+void loadPreferenceVariables() {
+  networkName = configuration.getNetworkName();
+  networkPass = configuration.getNetworkPass();
+  mqttServerAddress = configuration.getMqttServerAddress();
+  mqttUsername = configuration.getMqttUsername();
+  mqttPass = configuration.getMqttPass();
+  mqttClientId = configuration.getMqttClientId();
+  mqttTopic = configuration.getMqttTopic();
+  mqttServerPort = configuration.getMqttServerPort();
+  audioNotifications = configuration.getAudioNotificationsStatus();
+  visualNotifications = configuration.getVisualNotificationsStatus();
+  mqttImport = configuration.getMqttImportStatus();
+}
+
+/**
+* @brief Reload saved preferences and apply only what changed.
 *
-* @return A String containing the current UTC time in the specified format, or "Unknown" if the time cannot be retrieved.
+* Instead of restarting the device, only the affected connections are dropped. The
+* Wi-Fi and MQTT connect functions then reconnect with the new settings on the next
+* loop. A new MQTT topic or configuration import is resubscribed on the open connection,
+* and notification settings take effect immediately.
 */
-String getUtcTimeString() {
-  struct tm timeinfo;
+void applyConfigurationChanges() {
+  // Keep the current topic, its subscription has to be moved if it changes.
+  String previousTopic = mqttTopic != nullptr ? mqttTopic : "";
+
+  uint8_t changes = configuration.reloadPreferences();
+  loadPreferenceVariables();
+
+  if (changes & CONFIG_CHANGED_NETWORK) {
+    // Reconnecting to another network also reconnects the MQTT broker.
+    debug(CMD, "Network settings changed, reconnecting to '%s'.", networkName);
+    mqtt.disconnect();
+    WiFi.disconnect();
+  } else if (changes & CONFIG_CHANGED_MQTT_BROKER) {
+    debug(CMD, "MQTT broker settings changed, reconnecting to '%s'.", mqttServerAddress);
+    mqtt.disconnect();
+  } else if ((changes & CONFIG_CHANGED_MQTT_TOPIC) && mqtt.connected()) {
+    debug(CMD, "MQTT topic changed, subscribing to '%s'.", mqttTopic);
+    mqtt.unsubscribe(previousTopic.c_str());
+    mqtt.unsubscribe(configurationTopic(previousTopic.c_str()).c_str());
+    mqtt.subscribe(mqttTopic);
+
+    if (mqttImport) {
+      mqtt.subscribe(configurationTopic(mqttTopic).c_str());
+    }
+  }
+
+  if (changes & CONFIG_CHANGED_NOTIFICATIONS) {
+    debug(LOG, "Audio notifications %s, visual notifications %s.", audioNotifications ? "enabled" : "disabled", visualNotifications ? "enabled" : "disabled");
+    showDeviceStatus();
+  }
+}
+
+/**
+* @brief Get the MQTT topic receiving configurations to import.
+*
+* @param topic The configured MQTT topic.
+* @return The topic with MQTT_CONFIG_TOPIC_SUFFIX appended.
+*/
+String configurationTopic(const char* topic) {
+  return String(topic) + MQTT_CONFIG_TOPIC_SUFFIX;
+}
+
+/**
+* @brief Read commands from the serial port without blocking.
+*
+* Collects received characters until a line break and runs the completed line.
+* Longer lines than SERIAL_COMMAND_SIZE are cut off, so they fail as a command.
+*/
+void handleSerialCommands() {
+  while (Serial.available() > 0) {
+    char character = Serial.read();
+
+    if (character == '\r') {
+      continue;
+    }
+
+    if (character != '\n') {
+      if (serialCommandLength < SERIAL_COMMAND_SIZE - 1) {
+        serialCommand[serialCommandLength++] = character;
+      }
+      continue;
+    }
 
-  if (!getLocalTime(&timeinfo)) {
-    return "Unknown";
+    serialCommand[serialCommandLength] = '\0';
+    serialCommandLength = 0;
+    runSerialCommand(serialCommand);
   }
+}
 
-  // Create a buffer to hold the formatted time string
-  char buffer[80];
-  strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &timeinfo);
-  return String(buffer);
+/**
+* @brief Run a command received over the serial port.
+*
+* "export" prints the configuration blob, "import <blob>" imports a blob printed by
+* another device. The imported configuration is applied on the next loop.
+*
+* @param command The null-terminated command line.
+*/
+void runSerialCommand(const char* command) {
+  if (strcmp(command, "export") == 0) {
+    char blob[CONFIG_BLOB_SIZE];
+
+    if (configuration.exportConfiguration(blob, sizeof(blob))) {
+      Serial.println(blob);
+    } else {
+      debug(ERR, "Exporting configuration failed.");
+    }
+  } else if (strncmp(command, "import ", 7) == 0) {
+    const char* error = configuration.importConfiguration(command + 7, strlen(command + 7));
+
+    if (error != nullptr) {
+      debug(ERR, "Importing configuration failed: %s", error);
+    }
+  } else if (command[0] != '\0') {
+    debug(ERR, "Unknown serial command '%s'.", command);
+  }
 }
 
 /**
-* @brief Constructs an MQTT message string containing temperature, humidity, and timestamp data.
+* @brief Logs the interval between samples and its change since the previous sample.
 *
-* Constructs a JSON-formatted MQTT message string containing temperature and humidity data 
-* (read from SHT4x) and a timestamp.
+* The jitter is the difference between two consecutive sample intervals. It shows
+* whether background work, such as the configuration server task under load,
+* delays the sample cadence.
 *
+* @param timestamp Monotonic timestamp of the current sample in microseconds.
+*/
+void measureSampleJitter(int64_t timestamp) {
+  if (previousSampleTimestamp != 0) {
+    int64_t interval = timestamp - previousSampleTimestamp;
+
+    if (previousSampleInterval != 0) {
+      int64_t jitter = interval - previousSampleInterval;
+      debug(LOG, "Sample interval %ld ms, jitter %ld us.", (long)(interval / 1000), (long)jitter);
+    }
+
+    previousSampleInterval = interval;
+  }
+
+  previousSampleTimestamp = timestamp;
+}
+
+/**
+* @brief Stores a sensor sample in the sample buffer.
+*
+* Samples are stamped with the monotonic clock, so they can be taken before SNTP
+* sync completes. If the buffer is full, the oldest sample is overwritten.
+*
+* @param timestamp Monotonic timestamp in microseconds.
 * @param temperature Temperature read from SHT4x.
 * @param humidity Humidity read from SHT4x.
-* @param timestamp Human-readable timestamp in UTC format.
-* @return A String containing the constructed MQTT message in JSON format.
 */
-String constructMqttMessage(float temperature, float humidity, String timestamp) {
-  String message;
-
-  message += "{";
-  message += quotation("timestamp") + ":" + quotation(timestamp) + ",";
-  message += quotation("temperature") + ":";
-  message += "{";
-  message += quotation("value") + ":" + String(temperature, 2) + ",";
-  message += quotation("unit") + ":" + quotation("C");
-  message += "},";
-  message += quotation("humidity") + ":";
-  message += "{";
-  message += quotation("value") + ":" + String(humidity, 2) + ",";
-  message += quotation("unit") + ":" + quotation("%");
-  message += "}";
-  message += "}";
-
-  return message;
+void bufferSample(int64_t timestamp, float temperature, float humidity) {
+  if (sampleBufferCount == SAMPLE_BUFFER_SIZE) {
+    // Drop the oldest sample to make room.
+    sampleBufferHead = (sampleBufferHead + 1) % SAMPLE_BUFFER_SIZE;
+    sampleBufferCount--;
+  }
+
+  Sample& sample = sampleBuffer[(sampleBufferHead + sampleBufferCount) % SAMPLE_BUFFER_SIZE];
+  sample.timestamp = timestamp;
+  sample.temperature = temperature;
+  sample.humidity = humidity;
+  sampleBufferCount++;
 }
 
 /**
-* @brief Thread function for handling device status indications through an RGB LED.
-*
-* This thread continuously updates the RGB LED status based on the current device status.
-* It uses the DeviceStatusEnum values to determine the appropriate LED indication.
+* @brief Publishes buffered samples to the MQTT broker, oldest first.
 *
-* @param pvParameters Pointer to task parameters (not used in this function).
+* Sample timestamps are converted to UTC at publish time, so samples taken before
+* SNTP sync are backfilled with their real UTC time. While the clock is not
+* synchronized, samples are held back; only when the buffer is full is the oldest
+* sample published with an "Unknown" timestamp, keeping the broker heartbeat alive.
 */
-void DeviceStatusThread(void* pvParameters) {
-  for (;;) {
-    // Clear the NeoPixel LED strip.
-    notifications.clearAllVisualNotifications();
+void publishBufferedSamples() {
+  char timestamp[24];
 
-    if (visualNotifications) {
-      // Update LED status based on the current device status.
-      switch (deviceStatus) {
-        case NONE:
-          notifications.loadingVisualNotification();
-          break;
-        case NOT_READY:
-          notifications.notReadyVisualNotification();
-          break;
-        case READY_TO_SEND:
-          notifications.readyToSendVisualNotification();
-          break;
-        case WAITING_GNSS:
-          notifications.waitingGnssFixVisualNotification();
-          break;
-        case MAINTENANCE_MODE:
-          notifications.maintenanceVisualNotification();
-          break;
+  while (sampleBufferCount > 0) {
+    Sample& sample = sampleBuffer[sampleBufferHead];
+
+    if (!timeService.toUtcString(sample.timestamp, timestamp, sizeof(timestamp))) {
+      // Hold samples until the clock is synchronized, unless the buffer is full.
+      if (sampleBufferCount < SAMPLE_BUFFER_SIZE) {
+        debug(LOG, "Waiting for time sync, %d samples buffered.", sampleBufferCount);
+        return;
       }
+
+      strcpy(timestamp, "Unknown");
     }
+
+    debug(CMD, "Posting data package to MQTT broker '%s' on topic '%s'.", mqttServerAddress, mqttTopic);
+    String mqttData = constructMqttMessage(sample.temperature, sample.humidity, timestamp);
+
+    // Keep the sample buffered if publishing fails.
+    if (!mqtt.publish(mqttTopic, mqttData.c_str(), true)) {
+      debug(ERR, "Posting data package to MQTT broker '%s' failed.", mqttServerAddress);
+      return;
+    }
+
+    sampleBufferHead = (sampleBufferHead + 1) % SAMPLE_BUFFER_SIZE;
+    sampleBufferCount--;
+  }
+}
+
+/**
+* @brief Set the device status and show it on the RGB LED.
+*
+* The animation of the previous status is replaced right away. Setting the status
+* it already has keeps its animation running.
+*
+* @param status The new device status.
+*/
+void setDeviceStatus(DeviceStatusEnum status) {
+  if (status == deviceStatus) {
+    return;
+  }
+
+  deviceStatus = status;
+  showDeviceStatus();
+}
+
+/**
+* @brief Show the current device status on the RGB LED.
+*
+* Starts the animation of the current device status, or turns the LED off if visual
+* notifications are disabled. The animation is played by a timer, so this returns
+* immediately and no task is kept busy with the LED.
+*/
+void showDeviceStatus() {
+  if (!visualNotifications) {
+    notifications.clearAllVisualNotifications();
+    return;
+  }
+
+  // Update LED status based on the current device status.
+  switch (deviceStatus) {
+    case NONE:
+      notifications.loadingVisualNotification();
+      break;
+    case NOT_READY:
+      notifications.notReadyVisualNotification();
+      break;
+    case READY_TO_SEND:
+      notifications.readyToSendVisualNotification();
+      break;
+    case WAITING_GNSS:
+      notifications.waitingGnssFixVisualNotification();
+      break;
+    case MAINTENANCE_MODE:
+      notifications.maintenanceVisualNotification();
+      break;
   }
 }
\ No newline at end of file
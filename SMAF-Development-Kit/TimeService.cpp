@@ -0,0 +1,134 @@
+/**
+* @file TimeService.cpp
+* @brief Implementation of the TimeService class for non-blocking timestamps.
+*
+* This file contains the implementation of the TimeService class, which stamps samples with
+* the monotonic system timer and converts those stamps to UTC once SNTP has synchronized
+* the clock. Sync state and offset are tracked through the SNTP notification callback,
+* so no call ever blocks waiting for the network time.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "TimeService.h"
+#include "Helpers.h"
+#include "esp_timer.h"
+#include "esp_sntp.h"
+#include "time.h"
+
+// Define the static members.
+int64_t TimeService::_utcOffset = 0;
+bool TimeService::_isSynced = false;
+portMUX_TYPE TimeService::_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+* @brief Start SNTP time synchronization.
+*
+* Registers the SNTP sync notification callback and configures the NTP server.
+* Synchronization runs in the background; this method returns immediately.
+*
+* @param ntpServer The NTP server host name.
+* @param gmtOffset The GMT offset in seconds.
+* @param dstOffset The daylight saving offset in seconds.
+*/
+void TimeService::begin(const char* ntpServer, long gmtOffset, int dstOffset) {
+  // Register the callback before starting SNTP so the first sync is not missed.
+  sntp_set_time_sync_notification_cb(onTimeSync);
+
+  // Initialize NTP server time configuration.
+  configTime(gmtOffset, dstOffset, ntpServer);
+}
+
+/**
+* @brief Get the current monotonic timestamp.
+*
+* @return Microseconds since boot, as reported by esp_timer_get_time().
+*/
+int64_t TimeService::now() {
+  return esp_timer_get_time();
+}
+
+/**
+* @brief Check if the clock has been synchronized by SNTP.
+*
+* @return true once at least one SNTP sync has completed, false otherwise.
+*/
+bool TimeService::isSynced() {
+  portENTER_CRITICAL(&_lock);
+  bool isSynced = _isSynced;
+  portEXIT_CRITICAL(&_lock);
+
+  return isSynced;
+}
+
+/**
+* @brief Convert a monotonic timestamp to a UTC date time string.
+*
+* Formats the timestamp as a UTC date time string (e.g., "2024-06-20T20:56:59Z")
+* using the offset captured at the last SNTP sync. Timestamps taken before the
+* sync are converted the same way, which backfills samples stamped at boot.
+*
+* @param timestamp Monotonic timestamp in microseconds, as returned by now().
+* @param buffer Buffer receiving the formatted string.
+* @param length Size of the buffer in bytes. 21 bytes fit the full string.
+* @return true if the string was written, false if the clock is not synchronized yet.
+*/
+bool TimeService::toUtcString(int64_t timestamp, char* buffer, size_t length) {
+  portENTER_CRITICAL(&_lock);
+  bool isSynced = _isSynced;
+  int64_t utcOffset = _utcOffset;
+  portEXIT_CRITICAL(&_lock);
+
+  if (!isSynced) {
+    return false;
+  }
+
+  // Shift the monotonic timestamp to wall-clock UTC and format it.
+  time_t seconds = (timestamp + utcOffset) / 1000000LL;
+  struct tm timeinfo;
+  gmtime_r(&seconds, &timeinfo);
+
+  return strftime(buffer, length, "%Y-%m-%dT%H:%M:%SZ", &timeinfo) > 0;
+}
+
+/**
+* @brief SNTP sync notification callback.
+*
+* Called by the SNTP client after each time sync. Captures the offset between
+* wall-clock UTC and the monotonic timer and marks the clock as synchronized.
+*
+* @param tv The synchronized time.
+*/
+void TimeService::onTimeSync(struct timeval* tv) {
+  int64_t utcOffset = ((int64_t)tv->tv_sec * 1000000LL + tv->tv_usec) - esp_timer_get_time();
+
+  portENTER_CRITICAL(&_lock);
+  bool wasSynced = _isSynced;
+  _utcOffset = utcOffset;
+  _isSynced = true;
+  portEXIT_CRITICAL(&_lock);
+
+  // Log only the first sync, later syncs just correct the drift.
+  if (!wasSynced) {
+    debug(SCS, "Time synchronized with NTP server.");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+* @file TimeService.h
+* @brief Declaration of the TimeService class for non-blocking timestamps.
+*
+* This file contains the declaration of the TimeService class, which stamps samples with
+* the monotonic system timer and converts those stamps to UTC once SNTP has synchronized
+* the clock. Sync state and offset are tracked through the SNTP notification callback,
+* so no call ever blocks waiting for the network time.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include "Arduino.h"
+
+class TimeService {
+public:
+  /**
+  * @brief Start SNTP time synchronization.
+  *
+  * Registers the SNTP sync notification callback and configures the NTP server.
+  * Synchronization runs in the background; this method returns immediately.
+  *
+  * @param ntpServer The NTP server host name.
+  * @param gmtOffset The GMT offset in seconds.
+  * @param dstOffset The daylight saving offset in seconds.
+  */
+  void begin(const char* ntpServer, long gmtOffset, int dstOffset);
+
+  /**
+  * @brief Get the current monotonic timestamp.
+  *
+  * @return Microseconds since boot, as reported by esp_timer_get_time().
+  */
+  int64_t now();
+
+  /**
+  * @brief Check if the clock has been synchronized by SNTP.
+  *
+  * @return true once at least one SNTP sync has completed, false otherwise.
+  */
+  bool isSynced();
+
+  /**
+  * @brief Convert a monotonic timestamp to a UTC date time string.
+  *
+  * Formats the timestamp as a UTC date time string (e.g., "2024-06-20T20:56:59Z")
+  * using the offset captured at the last SNTP sync. Timestamps taken before the
+  * sync are converted the same way, which backfills samples stamped at boot.
+  *
+  * @param timestamp Monotonic timestamp in microseconds, as returned by now().
+  * @param buffer Buffer receiving the formatted string.
+  * @param length Size of the buffer in bytes. 21 bytes fit the full string.
+  * @return true if the string was written, false if the clock is not synchronized yet.
+  */
+  bool toUtcString(int64_t timestamp, char* buffer, size_t length);
+
+private:
+  /**
+  * @brief SNTP sync notification callback.
+  *
+  * Called by the SNTP client after each time sync. Captures the offset between
+  * wall-clock UTC and the monotonic timer and marks the clock as synchronized.
+  *
+  * @param tv The synchronized time.
+  */
+  static void onTimeSync(struct timeval* tv);
+
+  // Offset between UTC and the monotonic timer in microseconds, and sync state.
+  // Written from the SNTP task, so access is guarded by a spinlock.
+  static int64_t _utcOffset;
+  static bool _isSynced;
+  static portMUX_TYPE _lock;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+/**
+* @file WebAssets.h
+* @brief Gzip compressed web assets for the SoftAP configuration server.
+*
+* This file is generated by tools/embed_web_assets.py from the sources in the
+* web directory. Do not edit it by hand; edit the sources and run the script again.
+*/
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include "Arduino.h"
+
+// configuration.html, 3069 bytes, 2847 bytes minified, 1351 bytes compressed.
+const char CONFIGURATION_HTML_ETAG[] = "\"e5fbbebfe5a6f3c4\"";
+const size_t CONFIGURATION_HTML_GZIP_LENGTH = 1351;
+const uint8_t CONFIGURATION_HTML_GZIP[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x56, 0xdb, 0x6e, 0xdb, 0x46,
+  0x10, 0xfd, 0x95, 0x09, 0x81, 0x56, 0x2d, 0x60, 0x59, 0x35, 0x10, 0x04, 0x45, 0x22, 0x29, 0x48,
+  0xed, 0xb8, 0x0d, 0x9a, 0xb4, 0x8e, 0xe5, 0x34, 0xc8, 0xe3, 0x8a, 0x5c, 0x9a, 0x1b, 0x93, 0xbb,
+  0xec, 0x5e, 0x44, 0xc8, 0x7f, 0xd2, 0xa7, 0xbe, 0xf4, 0x03, 0xfa, 0x0d, 0xfd, 0xa2, 0x7e, 0x42,
+  0xcf, 0x0c, 0x49, 0xd9, 0x74, 0xe1, 0xbc, 0xd8, 0xda, 0xe5, 0xec, 0x5c, 0xce, 0x99, 0x33, 0xbb,
+  0xcb, 0x27, 0x67, 0xbf, 0x9e, 0x5e, 0x7d, 0xba, 0x78, 0x4d, 0x55, 0x6c, 0xea, 0xf5, 0x92, 0xff,
+  0x52, 0xad, 0xec, 0xf5, 0x2a, 0xd3, 0x36, 0xc3, 0x5a, 0xab, 0x62, 0xbd, 0x6c, 0x74, 0x54, 0x94,
+  0x57, 0xca, 0x07, 0x1d, 0x57, 0xd9, 0x87, 0xab, 0xf3, 0xf9, 0xf7, 0xd9, 0xb0, 0x6b, 0x55, 0xa3,
+  0x57, 0xd9, 0xce, 0xe8, 0xae, 0x75, 0x3e, 0x66, 0x94, 0x3b, 0x1b, 0xb5, 0x85, 0x55, 0x67, 0x8a,
+  0x58, 0xad, 0x0a, 0xbd, 0x33, 0xb9, 0x9e, 0xcb, 0xe2, 0x88, 0x8c, 0x35, 0xd1, 0xa8, 0x7a, 0x1e,
+  0x72, 0x55, 0xeb, 0xd5, 0xc9, 0xf1, 0x77, 0x47, 0x94, 0x82, 0xf6, 0xb2, 0x56, 0x5b, 0x6c, 0x59,
+  0x07, 0xbf, 0xd1, 0xc4, 0x5a, 0xaf, 0x37, 0xef, 0x5e, 0x9d, 0xcf, 0xcf, 0x7e, 0x9e, 0x6f, 0x5e,
+  0x5d, 0x2c, 0x17, 0xfd, 0xd6, 0xb2, 0x36, 0xf6, 0x86, 0xbc, 0xae, 0x57, 0x59, 0x88, 0xfb, 0x5a,
+  0x87, 0x4a, 0x6b, 0x84, 0xac, 0xbc, 0x2e, 0x57, 0xd9, 0x02, 0x91, 0x4b, 0x73, 0x9d, 0xbc, 0x8a,
+  0xc6, 0xd9, 0xe3, 0x3c, 0x04, 0xb8, 0x0a, 0xb9, 0x37, 0x6d, 0xa4, 0xe0, 0xf3, 0xff, 0x19, 0x7c,
+  0xe6, 0xef, 0x8b, 0xde, 0x00, 0x3f, 0xfa, 0x42, 0xb7, 0xae, 0xd8, 0xaf, 0x97, 0xa5, 0xf3, 0x0d,
+  0xa9, 0x9c, 0xcd, 0x56, 0xb3, 0xe9, 0xb1, 0x19, 0xa1, 0xea, 0xca, 0x15, 0xab, 0x59, 0xeb, 0x42,
+  0x9c, 0x01, 0xa0, 0x93, 0xf5, 0xbf, 0x7f, 0xfe, 0xf5, 0x07, 0x1c, 0x9c, 0xf0, 0x82, 0xf2, 0x5a,
+  0x85, 0xb0, 0xca, 0xaa, 0x93, 0xb9, 0xdb, 0x69, 0xef, 0x4d, 0xa1, 0xb3, 0xf5, 0x25, 0x7c, 0xef,
+  0x29, 0x3a, 0x4a, 0x6d, 0xa1, 0xa2, 0x5e, 0x6e, 0xfd, 0x7a, 0xef, 0x92, 0x27, 0xa0, 0x19, 0x8d,
+  0xbd, 0x0e, 0x2f, 0xfb, 0xd3, 0xed, 0xfa, 0xa3, 0xae, 0x73, 0xd7, 0x68, 0x36, 0xe5, 0xf2, 0xe9,
+  0x54, 0x42, 0xd3, 0x4f, 0x69, 0xfb, 0x84, 0xde, 0x27, 0x93, 0xdf, 0xd4, 0x7b, 0x3e, 0x04, 0x3f,
+  0x24, 0x0e, 0xc4, 0xa8, 0x87, 0x98, 0xcf, 0x20, 0x53, 0xab, 0xf3, 0x48, 0x3b, 0xa3, 0xe8, 0xa3,
+  0x39, 0x37, 0xa4, 0x6c, 0x41, 0xd1, 0x2b, 0x1b, 0x1a, 0x13, 0x09, 0xa1, 0x15, 0xe0, 0x46, 0x40,
+  0x7a, 0xf7, 0xfe, 0xea, 0xea, 0x78, 0xb9, 0x68, 0x01, 0x90, 0x96, 0x32, 0xc9, 0xa0, 0xa2, 0xda,
+  0xec, 0xf4, 0x8c, 0x04, 0xd9, 0x55, 0x56, 0x98, 0xd0, 0xd6, 0x6a, 0xff, 0x9c, 0xac, 0xb3, 0xfa,
+  0x05, 0x77, 0xc2, 0xb3, 0xf5, 0x5b, 0x18, 0x00, 0x7e, 0x55, 0x70, 0xd2, 0xc8, 0xf9, 0x19, 0xe7,
+  0xbc, 0x0c, 0xad, 0xea, 0xcf, 0x47, 0xdd, 0xb4, 0x1a, 0x30, 0x25, 0xaf, 0x67, 0x0c, 0x2d, 0xf6,
+  0xd7, 0xf4, 0xcf, 0xdf, 0xa7, 0x47, 0x74, 0x67, 0x53, 0xa5, 0xc6, 0x14, 0x26, 0xee, 0xef, 0x0c,
+  0xbe, 0x62, 0x42, 0x81, 0x2d, 0x5c, 0x8f, 0x1f, 0x25, 0xb3, 0xc5, 0x90, 0xda, 0x34, 0xc7, 0x90,
+  0xf2, 0x5c, 0x87, 0x30, 0x1b, 0x70, 0xbe, 0x5b, 0x7f, 0x21, 0xed, 0x4d, 0x6f, 0xf3, 0x64, 0xcc,
+  0xf8, 0xd3, 0x43, 0xe8, 0x2a, 0x15, 0x68, 0x70, 0x54, 0xa6, 0x1a, 0x18, 0xab, 0x6d, 0x70, 0x7e,
+  0xab, 0x01, 0x5e, 0xa5, 0xc9, 0xea, 0x8e, 0xa6, 0xad, 0x43, 0x6f, 0xe2, 0x2c, 0x20, 0x42, 0x47,
+  0xaa, 0xae, 0x85, 0x10, 0x80, 0xef, 0x5d, 0x7e, 0x23, 0x80, 0x7b, 0x87, 0xcd, 0xce, 0xc4, 0x4a,
+  0x4e, 0xf7, 0x94, 0x17, 0x07, 0xae, 0x8f, 0x1f, 0x14, 0x57, 0x3d, 0x5d, 0x0b, 0x55, 0xde, 0xa5,
+  0xa8, 0x3d, 0xb7, 0xc6, 0x24, 0x16, 0x72, 0x7e, 0xca, 0x39, 0x6f, 0x74, 0x0e, 0x58, 0x47, 0x86,
+  0xcd, 0x0e, 0x28, 0xd1, 0x76, 0x4f, 0x50, 0x9a, 0xf6, 0xcc, 0xa8, 0xb4, 0x83, 0x38, 0x2a, 0xa0,
+  0x4a, 0x53, 0x07, 0x9a, 0xd3, 0x66, 0xf3, 0xe6, 0x4c, 0x32, 0x6a, 0x01, 0x55, 0xe7, 0x7c, 0x71,
+  0xdc, 0x57, 0x1d, 0xa2, 0xda, 0x07, 0x62, 0x2d, 0x71, 0x85, 0x6e, 0x28, 0x32, 0xc2, 0xe2, 0x86,
+  0xd0, 0xfa, 0x48, 0x55, 0x35, 0x10, 0x57, 0x20, 0x27, 0x74, 0x72, 0xc5, 0x92, 0x74, 0xcb, 0x0c,
+  0x64, 0xd0, 0xaa, 0xdd, 0x44, 0xd4, 0x94, 0x8d, 0xbd, 0x5e, 0xaa, 0x1b, 0x3d, 0x67, 0x77, 0x19,
+  0x39, 0x9b, 0xd7, 0x68, 0xd3, 0x55, 0x06, 0x49, 0x7a, 0xe8, 0x73, 0x03, 0xe3, 0x6f, 0xbe, 0x65,
+  0x05, 0xc8, 0xf2, 0x10, 0xa6, 0x36, 0x21, 0x8a, 0xcf, 0xc2, 0xec, 0x84, 0xd7, 0xe1, 0xc3, 0xec,
+  0xe0, 0xd3, 0x63, 0xae, 0xb0, 0x40, 0x61, 0x20, 0x20, 0x71, 0xcb, 0x22, 0x33, 0xbf, 0xfb, 0x02,
+  0x48, 0x57, 0xc9, 0x32, 0x44, 0x4d, 0x93, 0xac, 0xc9, 0xe5, 0x4b, 0xcf, 0xc3, 0xbd, 0xb3, 0x77,
+  0x3c, 0xd0, 0x6b, 0xc6, 0x4e, 0x8a, 0xdf, 0x7a, 0x77, 0xa3, 0x3d, 0x28, 0x55, 0x45, 0x81, 0x34,
+  0xc3, 0x11, 0xf1, 0x2c, 0x3b, 0x12, 0xec, 0x54, 0x82, 0x85, 0x8d, 0xa3, 0xbf, 0x11, 0x5d, 0xc6,
+  0x49, 0x81, 0xb4, 0x6d, 0x0a, 0xf1, 0xc0, 0xca, 0x08, 0xd4, 0x58, 0xd4, 0xe0, 0xf7, 0xcb, 0x35,
+  0x01, 0x30, 0xf8, 0xa7, 0xaf, 0xc1, 0x44, 0x6b, 0xf2, 0x47, 0x6b, 0xbb, 0xd0, 0x3e, 0x38, 0xab,
+  0x6a, 0x73, 0xab, 0xc7, 0x7a, 0xfa, 0x42, 0x24, 0x15, 0xe1, 0x15, 0xfd, 0x50, 0xe8, 0x12, 0x33,
+  0x16, 0xfd, 0x30, 0x78, 0x0d, 0xad, 0xce, 0x4d, 0x69, 0xf2, 0x20, 0xb5, 0xe4, 0x95, 0x73, 0xa2,
+  0x7f, 0x88, 0xd1, 0xb5, 0xd1, 0x34, 0xaa, 0xee, 0xa3, 0xa2, 0x31, 0x46, 0xce, 0xa7, 0xf0, 0x99,
+  0x40, 0x9f, 0xb9, 0x42, 0x45, 0xc2, 0x2b, 0xa9, 0x4e, 0xed, 0xa7, 0x35, 0xf6, 0x81, 0x1e, 0xaf,
+  0xf1, 0x55, 0x2a, 0x8c, 0x5b, 0xfc, 0x66, 0x42, 0x52, 0x35, 0x17, 0x67, 0x5d, 0xe4, 0x84, 0xc4,
+  0x7d, 0x18, 0x8b, 0x13, 0x45, 0x0e, 0x62, 0x44, 0x48, 0xfd, 0x7b, 0x32, 0x6d, 0x8b, 0xe6, 0x14,
+  0xf6, 0x14, 0x6d, 0xd3, 0xed, 0x2d, 0xa8, 0x92, 0x69, 0xd6, 0x39, 0xba, 0xfc, 0xf1, 0x07, 0x7a,
+  0xfb, 0xfa, 0x2c, 0x70, 0xef, 0x86, 0x0a, 0x2a, 0xdc, 0x29, 0x6f, 0x5c, 0x0a, 0xdc, 0xd8, 0x11,
+  0xf7, 0x09, 0x1a, 0xb7, 0xbc, 0xcf, 0x09, 0xc1, 0x3d, 0xa1, 0x11, 0xa1, 0x16, 0xbe, 0x64, 0x08,
+  0x78, 0x61, 0x4c, 0xc8, 0x4f, 0x8c, 0xf2, 0x80, 0x90, 0x25, 0xeb, 0x87, 0x14, 0x04, 0x66, 0x30,
+  0xb2, 0xa3, 0x08, 0x16, 0x68, 0x72, 0x6f, 0xb4, 0xae, 0x43, 0x68, 0x38, 0xe4, 0x85, 0x44, 0x75,
+  0x7d, 0xd3, 0x04, 0x97, 0x90, 0xcf, 0xf0, 0xa1, 0xcf, 0x70, 0x8a, 0xcc, 0xa4, 0xd2, 0xc7, 0x01,
+  0x3a, 0x93, 0xb2, 0x19, 0x1a, 0x25, 0x13, 0xe8, 0x4e, 0xf1, 0x91, 0x79, 0x52, 0x45, 0x63, 0xec,
+  0x41, 0xc1, 0x5c, 0x32, 0x54, 0x69, 0x11, 0x14, 0x38, 0xb5, 0xea, 0x5a, 0x53, 0xe9, 0x5d, 0xd3,
+  0xcb, 0x7f, 0x14, 0x57, 0x57, 0x19, 0x94, 0x26, 0x2d, 0x01, 0x23, 0x9f, 0x2c, 0x77, 0x04, 0x28,
+  0x36, 0xd7, 0x20, 0x14, 0x1e, 0x03, 0x65, 0xe2, 0x35, 0x1b, 0xa7, 0x94, 0xb8, 0x1a, 0x47, 0xc4,
+  0x47, 0xec, 0x61, 0x16, 0x41, 0xca, 0xfa, 0xa8, 0x47, 0x80, 0xa3, 0xc0, 0xc4, 0x59, 0x9e, 0x8c,
+  0x3b, 0xb4, 0xbf, 0x40, 0x07, 0x4f, 0x93, 0x46, 0xa5, 0xc6, 0x15, 0xfa, 0x98, 0xce, 0x8d, 0x6f,
+  0x3a, 0x41, 0x72, 0x38, 0x31, 0x0e, 0xc0, 0xc3, 0x44, 0x9c, 0x56, 0xd4, 0xab, 0x4c, 0x2c, 0x0b,
+  0xd7, 0xd9, 0xda, 0xa9, 0x02, 0xc6, 0x52, 0x14, 0x1b, 0x97, 0xa3, 0xbb, 0x5e, 0xbe, 0x18, 0xbd,
+  0x0d, 0x6b, 0x53, 0x5a, 0xfc, 0x7e, 0x74, 0x54, 0x90, 0xb6, 0x98, 0x2a, 0x95, 0x66, 0x67, 0x72,
+  0xb4, 0x57, 0xd7, 0x24, 0x45, 0x69, 0x76, 0xc9, 0xac, 0x2c, 0x29, 0x59, 0x69, 0x78, 0x66, 0x7e,
+  0x68, 0x0c, 0x13, 0xa7, 0x0c, 0xf6, 0x1d, 0xf9, 0x38, 0x75, 0xe7, 0xd0, 0x5a, 0xa8, 0x1e, 0x95,
+  0xec, 0xe1, 0xda, 0xe7, 0x1b, 0xe1, 0x25, 0x9d, 0x8a, 0x82, 0xb2, 0x0f, 0x2d, 0xd7, 0x38, 0x5c,
+  0xed, 0xc3, 0x89, 0x8c, 0xad, 0x54, 0xdb, 0x02, 0x04, 0xbc, 0xb2, 0xec, 0xb5, 0x0e, 0x3d, 0x2c,
+  0xc2, 0x61, 0x67, 0xe4, 0x92, 0xe9, 0xf5, 0xc9, 0x0f, 0x00, 0x20, 0x99, 0x57, 0xe3, 0xe0, 0x7e,
+  0x78, 0xbf, 0x08, 0xce, 0xcc, 0x1f, 0xa6, 0x93, 0x86, 0x20, 0x7c, 0x9c, 0x5e, 0xf4, 0xc3, 0xbd,
+  0x69, 0x6c, 0xe9, 0x66, 0x9c, 0xe4, 0x2f, 0x2e, 0xea, 0xe7, 0x98, 0x85, 0x81, 0xaf, 0x17, 0xbe,
+  0xce, 0xa0, 0x1a, 0xc4, 0x51, 0x7e, 0xdf, 0x3f, 0x18, 0x58, 0x8e, 0x3c, 0x28, 0x11, 0x22, 0x77,
+  0xde, 0xc3, 0x4b, 0xbd, 0x7f, 0x31, 0x24, 0x86, 0xe7, 0xd0, 0x61, 0xf8, 0x89, 0x2c, 0x26, 0x4f,
+  0x0d, 0xa8, 0x2a, 0x38, 0x7e, 0x2d, 0x31, 0x59, 0x07, 0xf6, 0x47, 0xa7, 0x9d, 0x77, 0x68, 0xca,
+  0x07, 0x97, 0x21, 0x03, 0x3f, 0x3e, 0xa0, 0x9c, 0x37, 0xb7, 0x78, 0x4b, 0xe2, 0xb5, 0x38, 0xe2,
+  0x6e, 0x6c, 0x8b, 0xba, 0xe2, 0xbe, 0xd5, 0x7c, 0xbf, 0x04, 0x7e, 0xfa, 0xed, 0x54, 0x9d, 0xb0,
+  0xba, 0xe4, 0x15, 0x0f, 0xc2, 0xe6, 0x81, 0x59, 0x48, 0x5b, 0xe4, 0x73, 0xb0, 0x1b, 0xb0, 0x9f,
+  0xb0, 0x75, 0x20, 0x74, 0xc1, 0xe7, 0xf1, 0xaf, 0x7f, 0x03, 0x2e, 0xe4, 0x3d, 0xfc, 0x1f, 0xcc,
+  0xb1, 0xcd, 0xf7, 0x1f, 0x0b, 0x00, 0x00,
+};
+
+// configuration.css, 4613 bytes, 4166 bytes minified, 1200 bytes compressed.
+const char CONFIGURATION_CSS_ETAG[] = "\"22dd73bd4cd67f3e\"";
+const size_t CONFIGURATION_CSS_GZIP_LENGTH = 1200;
+const uint8_t CONFIGURATION_CSS_GZIP[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x57, 0xeb, 0x8e, 0xab, 0x36,
+  0x10, 0x7e, 0x95, 0xfc, 0x59, 0x9d, 0x93, 0x36, 0x46, 0x40, 0x42, 0xb2, 0x0b, 0xea, 0x93, 0x54,
+  0xfd, 0x61, 0xc0, 0x04, 0x37, 0x80, 0x91, 0x6d, 0x36, 0xc9, 0x41, 0xbc, 0x7b, 0xc7, 0x17, 0x12,
+  0xae, 0x39, 0xbb, 0x52, 0xb5, 0xda, 0x24, 0x78, 0xc6, 0x33, 0xdf, 0xdc, 0x87, 0x90, 0x33, 0x26,
+  0x5b, 0x84, 0x4a, 0x56, 0xb1, 0x24, 0xe7, 0xac, 0x24, 0xc8, 0x73, 0xdd, 0x30, 0x17, 0xc5, 0x4f,
+  0xdf, 0x73, 0x77, 0x9e, 0xfb, 0xa6, 0xfe, 0xb7, 0xd1, 0x98, 0xc3, 0x0f, 0x46, 0x1c, 0xc1, 0x9c,
+  0x23, 0x18, 0xcb, 0x38, 0xcd, 0x38, 0xfc, 0x89, 0x96, 0xf7, 0x60, 0xc6, 0x31, 0x91, 0xf1, 0x31,
+  0xe3, 0xd8, 0x5b, 0x19, 0xee, 0x4e, 0xc3, 0x34, 0x3a, 0x68, 0x95, 0x31, 0x34, 0xba, 0x0a, 0x44,
+  0x7f, 0x40, 0x3b, 0x05, 0x63, 0xda, 0x3e, 0x78, 0xd2, 0xc6, 0xb6, 0x3f, 0x4d, 0xd3, 0x44, 0x7f,
+  0x4a, 0xb4, 0x88, 0x44, 0x93, 0x24, 0x44, 0x88, 0x5e, 0xa9, 0xb7, 0xb7, 0x64, 0x6f, 0x4c, 0xb6,
+  0x7a, 0x1f, 0x64, 0x7f, 0x4c, 0xee, 0x55, 0x3f, 0xe8, 0x07, 0x77, 0x44, 0xf7, 0xa7, 0x74, 0xab,
+  0x9d, 0x70, 0xce, 0x78, 0xaf, 0xbb, 0x17, 0x7d, 0x18, 0x90, 0xac, 0xde, 0xb1, 0xb5, 0x86, 0xe4,
+  0xb9, 0xa3, 0x6b, 0x47, 0x77, 0x40, 0xf3, 0xc7, 0xb4, 0x8f, 0xd3, 0xdb, 0xb6, 0xfb, 0xa3, 0xcd,
+  0x58, 0x25, 0x51, 0x86, 0x4b, 0x5a, 0xdc, 0x43, 0x71, 0x17, 0x92, 0x94, 0xa8, 0xa1, 0x3b, 0x81,
+  0x2b, 0x81, 0x04, 0xe1, 0x34, 0x8b, 0x34, 0x83, 0xa0, 0xbf, 0x48, 0xe8, 0x1d, 0xeb, 0x5b, 0x54,
+  0xd0, 0x8a, 0xa0, 0x9c, 0xd0, 0x73, 0x2e, 0x43, 0xcf, 0x09, 0xa2, 0x84, 0x15, 0x8c, 0x87, 0x9f,
+  0x98, 0xff, 0x9c, 0xe6, 0xdc, 0x36, 0x2a, 0x31, 0x3f, 0xd3, 0x2a, 0x74, 0xa3, 0x1a, 0xa7, 0x29,
+  0xad, 0xce, 0xf0, 0x2b, 0x66, 0x37, 0x25, 0x4c, 0x3d, 0xc4, 0x8c, 0xa7, 0x84, 0x23, 0x38, 0x89,
+  0x58, 0x23, 0x95, 0xdc, 0xb0, 0x62, 0x15, 0x01, 0x0d, 0x02, 0x14, 0xca, 0x7b, 0x61, 0x9f, 0xaf,
+  0xc0, 0x87, 0xae, 0x1c, 0xd7, 0x61, 0xcc, 0x09, 0xbe, 0x20, 0xf5, 0x2c, 0xa2, 0xa4, 0xe1, 0x02,
+  0x14, 0xa7, 0x24, 0xc3, 0x4d, 0x21, 0xbb, 0x98, 0xa5, 0xf7, 0x36, 0xa5, 0xa2, 0x2e, 0xf0, 0x3d,
+  0xcc, 0x0a, 0x72, 0x8b, 0xd4, 0x07, 0x4a, 0x29, 0x27, 0x89, 0xa4, 0xac, 0x0a, 0x01, 0x67, 0x53,
+  0x56, 0xe6, 0x54, 0x0b, 0xab, 0x98, 0xfa, 0x8a, 0x70, 0x41, 0xcf, 0x15, 0xa2, 0x60, 0xb7, 0x08,
+  0x13, 0x52, 0x49, 0xc2, 0x1f, 0x68, 0xc1, 0x3c, 0x4e, 0xca, 0x8d, 0xfd, 0x7a, 0x87, 0x8f, 0x2e,
+  0xf7, 0x76, 0xb9, 0xbf, 0xcb, 0xf7, 0xbb, 0xfc, 0xb0, 0xcb, 0x83, 0x5d, 0x7e, 0x6c, 0x8d, 0xfd,
+  0xb4, 0xca, 0xc1, 0x59, 0x72, 0xe2, 0x1d, 0x2f, 0xb0, 0x2e, 0x40, 0x92, 0xd5, 0xe1, 0x5e, 0xcb,
+  0xe9, 0x4f, 0x62, 0x26, 0x25, 0x2b, 0x43, 0x4f, 0x1d, 0x69, 0x17, 0x5f, 0xcd, 0xad, 0x93, 0xeb,
+  0x46, 0x05, 0x91, 0x80, 0x03, 0x89, 0x1a, 0x27, 0x0a, 0x07, 0x72, 0x1d, 0xbf, 0xbe, 0x81, 0xee,
+  0xf6, 0x19, 0x0b, 0xdf, 0x71, 0xfd, 0xd3, 0xc2, 0xdd, 0x2e, 0xf7, 0x07, 0x5c, 0x9e, 0xf3, 0xee,
+  0xfa, 0x1a, 0xf7, 0x7e, 0x74, 0x7a, 0xb4, 0xa7, 0x87, 0xd1, 0xe9, 0xc1, 0x3f, 0xe8, 0xd3, 0x60,
+  0x74, 0xea, 0x1f, 0x8f, 0x73, 0xd8, 0xae, 0xb6, 0xa5, 0x03, 0xfb, 0x87, 0xac, 0xd0, 0x46, 0x56,
+  0x59, 0xeb, 0x89, 0xa7, 0x06, 0x8e, 0xf1, 0x96, 0xdd, 0xd2, 0x15, 0x38, 0x26, 0x45, 0x3b, 0x34,
+  0x30, 0x00, 0x03, 0x33, 0xc6, 0xcb, 0xb6, 0xc4, 0x10, 0x45, 0x9a, 0xca, 0x3c, 0x3c, 0x1c, 0x5d,
+  0xf0, 0x0d, 0xad, 0xea, 0x46, 0xfe, 0x2d, 0xef, 0x35, 0xf9, 0xeb, 0x87, 0x24, 0x37, 0xf9, 0xe3,
+  0x9f, 0xdd, 0xf0, 0x48, 0x34, 0x71, 0x49, 0xa7, 0x87, 0x9c, 0x08, 0xa2, 0xce, 0x04, 0x29, 0x20,
+  0x47, 0x46, 0xa4, 0x24, 0x27, 0xc9, 0x05, 0x12, 0x13, 0xa8, 0x71, 0x03, 0x80, 0xaa, 0x16, 0x17,
+  0x45, 0xd8, 0x54, 0x70, 0x61, 0x49, 0x95, 0x91, 0x30, 0x2a, 0x25, 0x55, 0x0a, 0x2a, 0x7e, 0x64,
+  0x58, 0x4a, 0x8f, 0x32, 0x70, 0x4e, 0x26, 0xb3, 0x94, 0xe1, 0xba, 0x22, 0x72, 0x9c, 0xb2, 0x6b,
+  0xe8, 0x6e, 0xd4, 0x9f, 0x57, 0xdf, 0x36, 0xb3, 0x7a, 0x82, 0xe2, 0xdd, 0x6e, 0xa8, 0x02, 0xd0,
+  0x67, 0xbe, 0xd2, 0xbd, 0x00, 0x26, 0xcc, 0xd9, 0x27, 0xe1, 0x16, 0x92, 0x79, 0x68, 0x67, 0x2a,
+  0xfc, 0xd7, 0x2a, 0x96, 0xc4, 0x66, 0x2c, 0x69, 0x44, 0x2f, 0x56, 0x3f, 0xbc, 0x12, 0xdb, 0xf7,
+  0xde, 0x25, 0x81, 0x2f, 0x83, 0x61, 0xdd, 0x3d, 0x09, 0x7a, 0x6f, 0x73, 0xcd, 0xe8, 0xb8, 0x42,
+  0x9f, 0xf5, 0x69, 0x2a, 0xfb, 0xcc, 0x01, 0x8c, 0x1f, 0x29, 0xcc, 0x48, 0x57, 0xb6, 0xad, 0xe9,
+  0x45, 0x00, 0x6d, 0x8c, 0x93, 0x0b, 0xdc, 0x68, 0xaa, 0x34, 0x9c, 0xc0, 0x5e, 0x6b, 0x6b, 0x30,
+  0xa0, 0xb6, 0xdd, 0x0b, 0xdc, 0xdf, 0x0e, 0xa6, 0x46, 0x2d, 0x72, 0x4e, 0xab, 0x0b, 0xe0, 0x7e,
+  0xda, 0xe0, 0x2d, 0x22, 0xee, 0xe3, 0xb9, 0x88, 0xfb, 0x14, 0x6c, 0x97, 0x2f, 0x61, 0xe8, 0x80,
+  0x9f, 0x64, 0xe5, 0x56, 0xb0, 0x6c, 0x90, 0x4d, 0x23, 0x63, 0xd6, 0xff, 0x91, 0x46, 0xbd, 0x5c,
+  0x03, 0xa6, 0x17, 0xdc, 0x43, 0xfb, 0xa6, 0xe4, 0x68, 0x66, 0xcb, 0x78, 0xcd, 0xd8, 0x76, 0x4e,
+  0xce, 0x38, 0xfd, 0x05, 0x59, 0x84, 0x0b, 0x94, 0x71, 0x5c, 0x92, 0x85, 0xe1, 0xa0, 0xc7, 0x80,
+  0x1e, 0x02, 0x93, 0x59, 0x01, 0x01, 0x88, 0xce, 0x40, 0xf3, 0x1c, 0x77, 0xd0, 0x9a, 0x74, 0xab,
+  0xd2, 0x27, 0x9d, 0x30, 0x8c, 0xad, 0x1d, 0x61, 0x05, 0xc9, 0x64, 0xb8, 0x07, 0xc8, 0x82, 0x15,
+  0x34, 0x9d, 0x96, 0x40, 0xb4, 0xec, 0x78, 0x7f, 0x9a, 0x66, 0x7d, 0x38, 0xa6, 0xd9, 0x3d, 0x6c,
+  0xaa, 0xfd, 0x4c, 0x1a, 0xa2, 0x70, 0xec, 0x42, 0xf1, 0x12, 0xcd, 0x60, 0x29, 0x59, 0x00, 0x34,
+  0x58, 0x49, 0xc6, 0x98, 0x9e, 0x9b, 0xd0, 0xb6, 0x57, 0xb7, 0xa9, 0xdb, 0xf9, 0x5c, 0x7f, 0x10,
+  0x61, 0x22, 0x0c, 0xdc, 0xe5, 0x76, 0xce, 0x9a, 0xf3, 0x67, 0x93, 0xd9, 0x38, 0x3c, 0x98, 0x39,
+  0x5c, 0x4f, 0x0f, 0x47, 0xa7, 0x12, 0xfa, 0x96, 0x30, 0xd7, 0x78, 0xae, 0x73, 0xfa, 0x6e, 0xfe,
+  0x85, 0xeb, 0x2a, 0xf2, 0xff, 0x36, 0x42, 0xd2, 0xec, 0x8e, 0x12, 0xc8, 0x1e, 0x68, 0x1e, 0xa1,
+  0x6e, 0xe3, 0x28, 0x26, 0xf2, 0x4a, 0x48, 0x65, 0xf7, 0x85, 0x9e, 0x66, 0x37, 0x86, 0x85, 0x25,
+  0xc2, 0x20, 0x30, 0x00, 0xc4, 0x95, 0xca, 0x24, 0x6f, 0x6b, 0x26, 0xa8, 0xd1, 0x42, 0x0a, 0xac,
+  0xf2, 0x3e, 0x9a, 0x43, 0xb1, 0xad, 0xc0, 0x8d, 0xec, 0x74, 0x83, 0xe1, 0x16, 0xd9, 0x7d, 0xc2,
+  0x3f, 0xc0, 0xa0, 0x73, 0x24, 0x87, 0xe0, 0xb5, 0x93, 0x7e, 0x38, 0x92, 0x33, 0xc5, 0x6f, 0xe4,
+  0x4a, 0xcc, 0xe5, 0x12, 0xce, 0x67, 0x2e, 0xa0, 0x95, 0x9e, 0xa7, 0x93, 0x62, 0x56, 0xa1, 0xfb,
+  0xb5, 0x0a, 0xb5, 0xc8, 0xd5, 0x8e, 0xd9, 0x23, 0xd7, 0xbf, 0x6d, 0x76, 0x72, 0x9c, 0xd2, 0x46,
+  0xa8, 0xa3, 0x87, 0x35, 0xb3, 0xae, 0xb6, 0x86, 0xc4, 0x0b, 0xbe, 0x8c, 0xc4, 0xd3, 0x4d, 0xc0,
+  0x88, 0x9f, 0xf5, 0xbf, 0x55, 0xf9, 0x7e, 0xf0, 0x65, 0xf9, 0xc0, 0x0a, 0xf2, 0xf3, 0xa6, 0x8c,
+  0xdb, 0x97, 0xde, 0x5f, 0xcf, 0x10, 0xe3, 0x27, 0x15, 0xd5, 0x61, 0x84, 0x23, 0x1b, 0x53, 0x44,
+  0x3e, 0x81, 0x4d, 0x98, 0x15, 0x78, 0xe6, 0xbb, 0xb7, 0x39, 0xcc, 0x0f, 0x27, 0x58, 0x02, 0xba,
+  0x9f, 0xb4, 0xe3, 0x50, 0x57, 0x03, 0x49, 0x37, 0x7f, 0x6e, 0x6c, 0x2e, 0xad, 0xf8, 0x65, 0xd0,
+  0xbf, 0xd6, 0x3d, 0xf2, 0x64, 0x5a, 0xcc, 0x3a, 0x52, 0xa5, 0x2b, 0x5a, 0x5f, 0xc7, 0xbc, 0x9f,
+  0x67, 0xbf, 0x55, 0xfd, 0x98, 0x79, 0x73, 0x05, 0xaf, 0xa3, 0xfe, 0x68, 0xb6, 0xbf, 0xd3, 0x60,
+  0x86, 0x89, 0x87, 0x14, 0x5c, 0x4e, 0x53, 0xd2, 0xce, 0x9a, 0xd3, 0x74, 0x75, 0xb5, 0x45, 0x9f,
+  0xe1, 0x0b, 0x41, 0xf0, 0x3e, 0x70, 0x69, 0xf5, 0x36, 0x92, 0x92, 0x84, 0x71, 0xac, 0xcb, 0x1f,
+  0xb0, 0x10, 0xae, 0xde, 0x14, 0xa2, 0x65, 0x7f, 0xbf, 0x5e, 0x7e, 0x3a, 0x52, 0x3e, 0xb7, 0xd1,
+  0x91, 0x84, 0xc7, 0x2b, 0xe0, 0x4c, 0x44, 0xe7, 0x68, 0x5a, 0x3b, 0xe7, 0x56, 0x4e, 0x7e, 0xae,
+  0xf0, 0xae, 0xf3, 0xae, 0x37, 0xd3, 0xee, 0x3f, 0x41, 0x9f, 0xfb, 0xa0, 0x46, 0x10, 0x00, 0x00,
+};
+
+// configuration.js, 6825 bytes, 4880 bytes minified, 1595 bytes compressed.
+const char CONFIGURATION_JS_ETAG[] = "\"3da1d89e037126f3\"";
+const size_t CONFIGURATION_JS_GZIP_LENGTH = 1595;
+const uint8_t CONFIGURATION_JS_GZIP[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x57, 0x4b, 0x73, 0x13, 0x39,
+  0x10, 0xbe, 0xfb, 0x57, 0x08, 0x0e, 0x68, 0x86, 0x35, 0x83, 0x77, 0x6f, 0x8b, 0x49, 0xb6, 0x20,
+  0x24, 0xb5, 0x6c, 0x85, 0x84, 0xc2, 0x61, 0x2f, 0xa9, 0x1c, 0xe4, 0x99, 0xb6, 0x3d, 0x89, 0x66,
+  0x64, 0x24, 0x4d, 0x1c, 0x17, 0xf0, 0xdf, 0xb7, 0x5b, 0x1a, 0xcd, 0x23, 0x9e, 0x98, 0x40, 0xed,
+  0xc5, 0x0f, 0xb5, 0xd4, 0x8f, 0x4f, 0x5f, 0x7f, 0x92, 0x24, 0x58, 0x66, 0xc4, 0x2d, 0x64, 0x67,
+  0x60, 0x37, 0x4a, 0xdf, 0xb0, 0x03, 0xc6, 0xf9, 0x74, 0x24, 0x69, 0x18, 0xac, 0xcd, 0xcb, 0xa5,
+  0xc1, 0xa1, 0xcb, 0xab, 0xe9, 0x68, 0x51, 0x95, 0xa9, 0xcd, 0x55, 0xc9, 0x34, 0x2c, 0x34, 0x98,
+  0xd5, 0x2c, 0x15, 0x65, 0x14, 0xb3, 0xaf, 0xa3, 0x05, 0xd8, 0x74, 0x15, 0xf1, 0x97, 0x06, 0x07,
+  0x78, 0x3c, 0x4a, 0xec, 0x0a, 0xca, 0x28, 0xc2, 0x29, 0x6b, 0x55, 0x1a, 0x88, 0xd9, 0xc1, 0x21,
+  0x0b, 0x7f, 0x92, 0x6b, 0xa3, 0x70, 0x51, 0x98, 0xa4, 0xa1, 0xcc, 0x40, 0xd7, 0x91, 0x4d, 0x3c,
+  0x1d, 0x7d, 0x6f, 0xa3, 0x48, 0x25, 0x42, 0x4e, 0xa6, 0x17, 0xa6, 0xac, 0x07, 0xff, 0xbf, 0x50,
+  0x7d, 0x5b, 0x44, 0x75, 0x50, 0xc0, 0x14, 0xdd, 0x58, 0x16, 0xc2, 0x21, 0x0a, 0x99, 0x4a, 0xab,
+  0x02, 0x4a, 0x9b, 0x2c, 0xc1, 0x1e, 0x4b, 0xa0, 0x9f, 0x6f, 0xb7, 0xef, 0xb3, 0x88, 0xe3, 0x9c,
+  0x33, 0x51, 0x00, 0x47, 0xb7, 0x7e, 0x91, 0x01, 0x09, 0xa9, 0x85, 0x0c, 0x17, 0x85, 0xf5, 0xc9,
+  0xad, 0x90, 0x15, 0xb0, 0x6f, 0xdf, 0x7a, 0x70, 0x4f, 0x47, 0x8d, 0x5d, 0x42, 0xb9, 0xb4, 0x2b,
+  0x5c, 0x31, 0x99, 0x8e, 0x28, 0x85, 0xa4, 0xb1, 0x2c, 0x94, 0x3e, 0x16, 0x58, 0x7b, 0x54, 0x8f,
+  0xb8, 0x3a, 0x1b, 0xab, 0xc8, 0x32, 0x34, 0x6c, 0xd8, 0xf9, 0x9a, 0x8a, 0x09, 0x73, 0x12, 0x63,
+  0xf2, 0x8c, 0xfd, 0xc6, 0x38, 0x8b, 0x38, 0x7e, 0x85, 0x51, 0x8d, 0xc3, 0x6e, 0x34, 0x7b, 0x5b,
+  0xc4, 0x7c, 0xcc, 0xba, 0xb3, 0xe3, 0x18, 0xf3, 0xcf, 0x17, 0x2c, 0x6a, 0xb2, 0x7f, 0xf6, 0x8c,
+  0x3d, 0xe9, 0xa7, 0x62, 0x54, 0x01, 0x83, 0x79, 0xf8, 0x78, 0x07, 0x07, 0x07, 0x4d, 0xed, 0x31,
+  0x61, 0xf8, 0x50, 0x96, 0x61, 0xd2, 0xb8, 0x33, 0x9d, 0xf6, 0xe4, 0x1e, 0x5a, 0xad, 0xb7, 0xe9,
+  0xe8, 0x41, 0xf4, 0x29, 0xc3, 0x99, 0x15, 0x16, 0xf1, 0x4f, 0x2c, 0xdc, 0xd9, 0x23, 0x55, 0x5a,
+  0x34, 0xd2, 0x62, 0xca, 0x9d, 0x3e, 0x4a, 0xe4, 0x31, 0xfb, 0x8b, 0xf1, 0x59, 0xf8, 0x8d, 0x90,
+  0xb6, 0x08, 0x26, 0x09, 0x67, 0xaf, 0x18, 0xff, 0xe4, 0x79, 0x1d, 0xc6, 0x99, 0xcc, 0x8d, 0xe5,
+  0x35, 0x22, 0x5d, 0x47, 0x54, 0x17, 0xf6, 0xc6, 0x45, 0x5e, 0x80, 0xaa, 0x6c, 0xd4, 0x25, 0xea,
+  0x98, 0xfd, 0x3e, 0x99, 0x4c, 0x5c, 0x25, 0x3b, 0xfc, 0x9a, 0x6d, 0x72, 0x22, 0xf0, 0x42, 0x23,
+  0x53, 0xc6, 0x4c, 0x8a, 0x39, 0xc8, 0x31, 0xcb, 0x11, 0x81, 0x12, 0x07, 0x5a, 0xbe, 0x59, 0xb5,
+  0x5c, 0x4a, 0xe8, 0xb2, 0x2d, 0xd5, 0x80, 0xc5, 0xd5, 0x25, 0x47, 0xdc, 0xad, 0x6c, 0xa9, 0x96,
+  0x97, 0xeb, 0xca, 0xee, 0x99, 0xee, 0xec, 0x34, 0xdd, 0xfd, 0x48, 0x68, 0x93, 0x30, 0x6a, 0xf8,
+  0x6b, 0xb7, 0x6b, 0x8a, 0xc5, 0xd3, 0x15, 0xa4, 0x37, 0x73, 0x75, 0xc7, 0x83, 0x21, 0xe0, 0xcf,
+  0xad, 0xae, 0xa0, 0x46, 0x21, 0x24, 0xea, 0x67, 0xd0, 0x3f, 0xe2, 0x37, 0x7e, 0x51, 0xbd, 0x3e,
+  0xef, 0x24, 0x95, 0xc2, 0x98, 0x33, 0x6f, 0xe2, 0xc6, 0x95, 0x8c, 0xab, 0x6b, 0xa3, 0x58, 0xaf,
+  0x11, 0x8a, 0xa3, 0x55, 0x2e, 0xb3, 0xc8, 0x39, 0x89, 0x1b, 0x53, 0x8e, 0x2d, 0xab, 0xed, 0x9b,
+  0xec, 0x5a, 0xa4, 0x98, 0xf6, 0xdf, 0x17, 0x1f, 0x4e, 0x23, 0x3e, 0x07, 0xdc, 0x26, 0xc0, 0x15,
+  0x48, 0x54, 0xfe, 0x3a, 0xcb, 0x6f, 0x99, 0xf3, 0x7e, 0xf0, 0xd4, 0x6a, 0x91, 0xde, 0x3c, 0x3d,
+  0xec, 0x0d, 0xad, 0xaa, 0x62, 0x8e, 0x43, 0x2f, 0x71, 0xac, 0xfe, 0xa4, 0xa2, 0x1d, 0xda, 0xfd,
+  0xa4, 0x42, 0xa9, 0x2f, 0x9c, 0x8d, 0x87, 0x39, 0x3e, 0xb7, 0xa8, 0xde, 0x17, 0x9f, 0xd5, 0x90,
+  0x4c, 0x9c, 0xe4, 0x20, 0x33, 0x12, 0x89, 0x15, 0x14, 0xa2, 0xa6, 0x42, 0x90, 0x49, 0x3f, 0x48,
+  0xed, 0x4b, 0xdf, 0x6d, 0xdf, 0x2e, 0x68, 0x8d, 0xeb, 0x96, 0xb0, 0xcb, 0x2e, 0xe6, 0x9e, 0x5d,
+  0xc3, 0xfc, 0xdb, 0x2d, 0x76, 0x39, 0x3d, 0x86, 0x11, 0xee, 0x47, 0xb2, 0xb2, 0x85, 0x3c, 0x41,
+  0x7e, 0x1f, 0x30, 0x17, 0x37, 0xb9, 0x81, 0x6d, 0x30, 0xf5, 0xdb, 0xc3, 0x9b, 0x9d, 0xc5, 0x6f,
+  0xb0, 0x1f, 0xf0, 0x9c, 0xc0, 0x4e, 0xe6, 0x73, 0xa5, 0x24, 0x90, 0xa8, 0x63, 0xde, 0x7b, 0x48,
+  0xdc, 0x84, 0xe9, 0xfc, 0x24, 0xe8, 0x18, 0x48, 0x03, 0x4d, 0xc9, 0x3f, 0x20, 0x6a, 0xb3, 0xd2,
+  0x87, 0x0e, 0x92, 0x4a, 0x5d, 0xeb, 0x35, 0xc0, 0xf5, 0xe8, 0x10, 0x9b, 0x3b, 0x55, 0xf6, 0x98,
+  0xb9, 0x33, 0xae, 0xe1, 0x4b, 0x95, 0x6b, 0x68, 0xd7, 0x84, 0x81, 0xe1, 0xea, 0x4b, 0x64, 0x14,
+  0x68, 0xde, 0x32, 0x3e, 0x34, 0x0b, 0xa1, 0xd8, 0x34, 0x8a, 0xfb, 0xfc, 0xa0, 0x32, 0x67, 0xc1,
+  0x25, 0xa0, 0xf3, 0xb4, 0x31, 0xae, 0x85, 0xb5, 0xa0, 0x4b, 0x32, 0x5d, 0x4e, 0x5e, 0xfc, 0x79,
+  0xf5, 0x9c, 0x37, 0xb0, 0x50, 0xc4, 0xda, 0xad, 0x58, 0x7a, 0x6e, 0x52, 0xd0, 0xf7, 0x67, 0x1f,
+  0x3f, 0x5f, 0xec, 0xc6, 0xf4, 0xb9, 0x19, 0x40, 0xcc, 0x2c, 0x41, 0xb2, 0x46, 0x42, 0xa3, 0xe2,
+  0x64, 0x0e, 0x94, 0x5e, 0x3e, 0x45, 0x5e, 0x9e, 0x86, 0x93, 0xc4, 0xaf, 0xc2, 0x91, 0xbc, 0xa8,
+  0x8a, 0x66, 0x82, 0xb8, 0xbb, 0x3f, 0x41, 0xdc, 0xd5, 0x13, 0x1a, 0x14, 0x7c, 0xa4, 0x36, 0x8d,
+  0xb5, 0xc4, 0xbe, 0x5c, 0x29, 0x89, 0x14, 0xa0, 0x62, 0x3e, 0x97, 0xe9, 0x4a, 0x94, 0x4b, 0x84,
+  0x12, 0x97, 0x48, 0x58, 0x58, 0x06, 0xc5, 0xda, 0x6e, 0xb9, 0x17, 0xbe, 0xd6, 0x4d, 0x00, 0x98,
+  0x1c, 0x79, 0x06, 0xfe, 0xb8, 0xcf, 0xa1, 0x38, 0x7c, 0xfe, 0xfa, 0x25, 0x7e, 0x72, 0xd7, 0x7e,
+  0x9e, 0x3c, 0xa0, 0xb5, 0x63, 0xf4, 0x43, 0x2d, 0x60, 0x0a, 0x21, 0x5d, 0x0b, 0xb8, 0x89, 0xf7,
+  0x78, 0x41, 0x07, 0xde, 0x31, 0x8d, 0xf3, 0x60, 0xef, 0x09, 0x02, 0xd4, 0xa6, 0x01, 0xad, 0x70,
+  0xc5, 0xef, 0x15, 0x0a, 0x37, 0x63, 0xec, 0xf3, 0x73, 0xf9, 0x3e, 0x74, 0x4c, 0x35, 0xb8, 0x92,
+  0x96, 0xc4, 0x3d, 0x29, 0x74, 0x7e, 0xe3, 0x61, 0xf8, 0x7d, 0xf9, 0x29, 0xb6, 0xa1, 0x3e, 0xf9,
+  0x19, 0xcd, 0x70, 0x2b, 0x4e, 0x1f, 0x2b, 0x1c, 0xed, 0xec, 0x21, 0xf5, 0x20, 0xfc, 0x8e, 0x68,
+  0x06, 0xef, 0xcd, 0xec, 0x8b, 0x89, 0x9f, 0xe1, 0x2f, 0x37, 0x8c, 0xae, 0x1c, 0x1d, 0x75, 0x49,
+  0xac, 0x3a, 0x55, 0x1b, 0xd0, 0x47, 0xc2, 0x40, 0x84, 0xe1, 0x7a, 0x5a, 0xd2, 0xd6, 0x36, 0xee,
+  0x64, 0x3d, 0x1e, 0x0a, 0x1f, 0x4f, 0x7f, 0x05, 0xde, 0x36, 0x80, 0x3f, 0x98, 0x87, 0x54, 0xfd,
+  0x5f, 0x3a, 0xee, 0x4c, 0xe4, 0x4e, 0x3d, 0xe3, 0x54, 0xbd, 0x7f, 0x27, 0xf6, 0x86, 0xa4, 0x56,
+  0xa5, 0x69, 0x23, 0xfa, 0xfb, 0x34, 0x7e, 0x47, 0xf0, 0x06, 0x53, 0xf6, 0x5a, 0xd9, 0x6e, 0xfd,
+  0x8e, 0x02, 0x7a, 0xf1, 0xb5, 0x95, 0x2e, 0xa7, 0xbd, 0xde, 0x1a, 0x96, 0x69, 0xdf, 0xae, 0xee,
+  0x8c, 0x73, 0x42, 0xe7, 0x13, 0xbf, 0x6c, 0x7c, 0x5f, 0xf5, 0x04, 0x68, 0xc7, 0xca, 0x9e, 0xa0,
+  0xc3, 0xb2, 0x92, 0xb2, 0xf5, 0x15, 0x6e, 0x02, 0x43, 0x9e, 0xee, 0x83, 0x49, 0x77, 0xa1, 0x1a,
+  0xca, 0xfe, 0xcb, 0x80, 0xce, 0xc3, 0x9f, 0xbb, 0xb0, 0x37, 0x27, 0xac, 0x43, 0x74, 0xe8, 0xec,
+  0x9d, 0xd6, 0xb0, 0xb0, 0x10, 0xc6, 0x67, 0xf8, 0x2b, 0xef, 0x02, 0x9f, 0x73, 0x18, 0xeb, 0xde,
+  0xe8, 0xa8, 0xbe, 0x7e, 0x8d, 0xc4, 0x8c, 0xba, 0x46, 0xb8, 0xc5, 0xbd, 0x6c, 0xbb, 0x14, 0xb9,
+  0x50, 0x20, 0x50, 0x6e, 0x14, 0x55, 0x5d, 0xe3, 0x7e, 0x87, 0x76, 0x9c, 0xab, 0x6c, 0xeb, 0x1e,
+  0x03, 0x1b, 0xf6, 0xf9, 0xd3, 0xe9, 0x0c, 0x09, 0x99, 0xae, 0x3e, 0x0a, 0xe4, 0xa4, 0x71, 0xb7,
+  0x62, 0x6c, 0xb8, 0xe2, 0x9d, 0xb0, 0x22, 0x22, 0x17, 0x71, 0xbf, 0x89, 0xdd, 0x36, 0xb6, 0x7c,
+  0xcb, 0x25, 0x9e, 0x28, 0x5d, 0xba, 0xf5, 0x8e, 0x06, 0xbc, 0xb1, 0xff, 0x90, 0x6e, 0x9d, 0x7e,
+  0x0a, 0x44, 0xa9, 0x19, 0x58, 0xc7, 0x0b, 0x4f, 0x91, 0x43, 0x36, 0xa1, 0xe2, 0x28, 0x77, 0xf4,
+  0x8f, 0x7a, 0xe1, 0xec, 0x7c, 0x1c, 0xf2, 0xc2, 0x83, 0x63, 0xbd, 0x9b, 0x09, 0x11, 0x3a, 0xb9,
+  0x56, 0x79, 0x19, 0xf1, 0x31, 0xf7, 0xb7, 0x7a, 0x8f, 0xc8, 0x5a, 0xbb, 0xef, 0x77, 0xb0, 0x10,
+  0x95, 0xb4, 0x51, 0xb7, 0x99, 0xbf, 0x54, 0xa0, 0xb7, 0x33, 0x77, 0xcc, 0x2b, 0xfd, 0x46, 0xca,
+  0x88, 0x27, 0x5e, 0x95, 0xe3, 0xb6, 0xc1, 0xbc, 0xc4, 0x52, 0x1c, 0xff, 0xf3, 0xbe, 0xfe, 0xb8,
+  0x58, 0x0f, 0x3f, 0x12, 0xaa, 0x34, 0x05, 0x83, 0xe4, 0x48, 0x8c, 0xdd, 0xe2, 0x7d, 0x33, 0xcb,
+  0x0d, 0x9e, 0x69, 0x5b, 0x77, 0x68, 0xab, 0xd2, 0xa9, 0xbb, 0x63, 0x11, 0x6d, 0x40, 0x22, 0xdc,
+  0x4e, 0x8f, 0xd9, 0x57, 0x56, 0x80, 0x5d, 0xa9, 0x0c, 0xcf, 0xd8, 0x8f, 0xe7, 0xb3, 0x0b, 0xac,
+  0x9c, 0xb0, 0x78, 0xe5, 0x77, 0xf3, 0xfb, 0x30, 0xcf, 0xbe, 0x3a, 0x24, 0x1b, 0xb6, 0xa9, 0x1b,
+  0x82, 0xf0, 0x57, 0xd2, 0x9a, 0x4b, 0x95, 0xde, 0x60, 0x5e, 0x9b, 0xbc, 0xcc, 0xd4, 0x06, 0x5f,
+  0x1f, 0x5a, 0x49, 0x79, 0xa1, 0xa2, 0xc9, 0x98, 0x4d, 0x1a, 0xee, 0x13, 0xba, 0x75, 0x17, 0xdc,
+  0x23, 0x78, 0x9b, 0x1b, 0x82, 0x5d, 0x67, 0x76, 0x3e, 0xbf, 0x46, 0x84, 0x69, 0x87, 0x4c, 0x6d,
+  0xf0, 0x30, 0x9b, 0x0e, 0xcc, 0xb4, 0x7d, 0x0e, 0xe4, 0x87, 0x72, 0xee, 0x1d, 0xa8, 0xf7, 0x5f,
+  0x5c, 0x3d, 0xaf, 0x97, 0xa4, 0x12, 0xfb, 0x76, 0xe5, 0xe1, 0x7c, 0x2e, 0x27, 0x57, 0x94, 0x53,
+  0x5a, 0x99, 0x28, 0x74, 0x60, 0xbf, 0x0b, 0x37, 0x02, 0x77, 0xeb, 0x13, 0x88, 0x8c, 0xba, 0x22,
+  0x6a, 0x7b, 0xd0, 0x51, 0xcc, 0xd4, 0xad, 0x76, 0x4c, 0x7f, 0x66, 0xaa, 0xd2, 0x29, 0xa0, 0x3c,
+  0x78, 0x93, 0xbb, 0x24, 0xb8, 0x5f, 0x89, 0x2a, 0x0b, 0xc4, 0x5e, 0x2c, 0x49, 0xdd, 0x42, 0x2f,
+  0x77, 0xf4, 0xdb, 0x88, 0x62, 0xed, 0x5e, 0x62, 0xff, 0xcc, 0xce, 0xcf, 0xf0, 0x2a, 0xa7, 0xf1,
+  0xf0, 0xf2, 0x4c, 0xce, 0xb0, 0x55, 0xf7, 0x91, 0xcd, 0xe2, 0x6d, 0x08, 0xb4, 0xc0, 0x6d, 0x19,
+  0x78, 0x93, 0x3a, 0xaf, 0x49, 0x67, 0x0a, 0x9e, 0x8e, 0x27, 0xf9, 0x1d, 0x64, 0xd1, 0x1f, 0xfb,
+  0x7c, 0xe2, 0xfb, 0x26, 0xcf, 0x72, 0xbc, 0x63, 0x3d, 0xe0, 0x30, 0xd8, 0x1f, 0xe7, 0x4d, 0xe6,
+  0xb7, 0xb0, 0x8f, 0x74, 0xdf, 0x7b, 0x57, 0x19, 0x7c, 0xbc, 0x3b, 0x28, 0x4f, 0xf1, 0x45, 0x0c,
+  0x25, 0xca, 0x0f, 0x7f, 0x77, 0xfe, 0xa1, 0xce, 0xe0, 0x14, 0xc5, 0x12, 0xe8, 0xe6, 0xd6, 0x6a,
+  0x7f, 0x37, 0xf0, 0xa3, 0x96, 0x46, 0x0e, 0xf7, 0x61, 0x35, 0x88, 0x38, 0xb5, 0x24, 0xe6, 0xba,
+  0xeb, 0xc9, 0x54, 0xf3, 0x22, 0xb7, 0xb8, 0xbe, 0x95, 0xe4, 0xf8, 0xa7, 0x63, 0xf7, 0x88, 0x14,
+  0x4f, 0xff, 0x03, 0x13, 0xd2, 0x6e, 0x3e, 0x10, 0x13, 0x00, 0x00,
+};
+
+#endif
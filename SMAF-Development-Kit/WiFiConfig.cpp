@@ -36,289 +36,1385 @@
 #include "WiFiServer.h"
 #include "Preferences.h"
 #include "WiFiConfig.h"
+#include "WebAssets.h"
+#include "HttpResponseWriter.h"
+#include "FormDecoder.h"
+#include "HTTPClient.h"
 #include "Helpers.h"
+#include "esp_rom_crc.h"
+#include "mbedtls/base64.h"
+
+// Index lists, to expand the configuration schema into tables at compile time.
+template <size_t... Indices>
+struct SettingIndexList {};
+
+template <size_t Count, size_t... Indices>
+struct MakeSettingIndexList : MakeSettingIndexList<Count - 1, Count - 1, Indices...> {};
+
+template <size_t... Indices>
+struct MakeSettingIndexList<0, Indices...> {
+  typedef SettingIndexList<Indices...> Type;
+};
+
+// Tables derived from the configuration schema, one entry per setting.
+template <typename List>
+struct SettingTables;
+
+template <size_t... Indices>
+struct SettingTables<SettingIndexList<Indices...>> {
+  static constexpr const char* keys[] = { CONFIGURATION_SCHEMA[Indices].key... };                               // Keys of the settings.
+  static constexpr const char* formFields[] = { CONFIGURATION_SCHEMA[Indices].key..., CONFIG_FORM_CLEAR_FIELD };  // Fields of the configuration form.
+  static constexpr uint16_t offsets[] = { settingOffset(Indices)... };                                          // Offsets of the stored values.
+};
+
+template <size_t... Indices>
+constexpr const char* SettingTables<SettingIndexList<Indices...>>::keys[];
+
+template <size_t... Indices>
+constexpr const char* SettingTables<SettingIndexList<Indices...>>::formFields[];
+
+template <size_t... Indices>
+constexpr uint16_t SettingTables<SettingIndexList<Indices...>>::offsets[];
+
+typedef SettingTables<MakeSettingIndexList<CONFIGURATION_FIELD_COUNT>::Type> ConfigurationTables;
+
+// Error of an import that could not be saved, a failure of the device rather than of the blob.
+static const char* const CONFIGURATION_SAVE_ERROR = "Saving the configuration failed.";
+
+static_assert(CONFIGURATION_FIELD_COUNT + 1 <= FORM_DECODER_MAX_FIELDS, "The configuration form has more fields than FormDecoder collects.");
+
+// Get the stored bytes of a setting.
+static uint8_t* settingData(ConfigurationValues& values, size_t setting) {
+  uint8_t* area = isStringSetting(setting) ? (uint8_t*)values.strings : values.numbers;
+  return area + ConfigurationTables::offsets[setting];
+}
+
+// Get the value of a number or boolean setting.
+static uint16_t settingNumber(ConfigurationValues& values, size_t setting) {
+  uint16_t number = 0;
+  memcpy(&number, settingData(values, setting), settingSize(setting));
+  return number;
+}
+
+// Set the value of a string setting, longer values are truncated.
+static void setSettingString(ConfigurationValues& values, size_t setting, const char* value) {
+  // Pad the rest of the slot with zeros, slots are compared and checksummed whole.
+  char* slot = (char*)settingData(values, setting);
+  strncpy(slot, value, CONFIGURATION_SCHEMA[setting].maximum);
+  slot[CONFIGURATION_SCHEMA[setting].maximum] = '\0';
+}
+
+// Make an imported value of a device specific setting unique to this device, by
+// appending "-" and the device part of its MAC address, e.g. "SMAF-DK-a1b2c3".
+static void setDeviceSuffix(ConfigurationValues& values, size_t setting) {
+  static const size_t SUFFIX_LENGTH = 7;
+
+  char* slot = (char*)settingData(values, setting);
+  size_t length = min(strlen(slot), (size_t)CONFIGURATION_SCHEMA[setting].maximum - SUFFIX_LENGTH);
+  uint32_t device = (ESP.getEfuseMac() >> 24) & 0xFFFFFF;
+
+  snprintf(slot + length, SUFFIX_LENGTH + 1, "-%06x", (unsigned)device);
+}
+
+// Set the value of a number or boolean setting.
+static void setSettingNumber(ConfigurationValues& values, size_t setting, uint16_t value) {
+  memcpy(settingData(values, setting), &value, settingSize(setting));
+}
+
+// Indexes of the device access settings.
+static constexpr size_t ADMIN_PASS_SETTING = settingIndex(ADMIN_PASS);
+static constexpr size_t FIRMWARE_HOST_SETTING = settingIndex(FIRMWARE_HOST);
+
+// Compare a submitted password with the saved one, in a time that does not depend on where they differ.
+static bool isSamePassword(const char* submitted, const char* saved) {
+  size_t submittedLength = strlen(submitted);
+  size_t length = strlen(saved);
+  uint8_t difference = submittedLength != length;
+
+  for (size_t i = 0; i < length; ++i) {
+    difference |= (i < submittedLength ? submitted[i] : 0) ^ saved[i];
+  }
+
+  return difference == 0;
+}
+
+// Check if a key is in a comma-separated list of keys.
+static bool isListed(const char* list, const char* key) {
+  while (*list != '\0') {
+    size_t length = strcspn(list, ",");
+
+    if (length == strlen(key) && strncmp(list, key, length) == 0) {
+      return true;
+    }
+
+    list += length + (list[length] == ',');
+  }
+
+  return false;
+}
+
+// Keep a saved secret if its form field was left empty, unless none was saved yet or
+// the secret is listed to be cleared.
+static bool isKeptSecret(const ConfigurationField& field, const char* value, const char* saved, const char* cleared) {
+  return field.isSecret && *value == '\0' && strcmp(saved, field.defaultString) != 0 && !isListed(cleared, field.key);
+}
+
+// Find a setting by a key received at runtime.
+static size_t findSetting(const char* key) {
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    if (strcmp(key, CONFIGURATION_SCHEMA[i].key) == 0) {
+      return i;
+    }
+  }
+
+  return CONFIGURATION_FIELD_COUNT;
+}
+
+/**
+* @brief Constructor for WiFiConfig class.
+*
+* Initializes an instance of the WiFiConfig class with the provided configuration parameters.
+*
+* @param configNetworkName The Wi-Fi network name for configuration.
+* @param configNetworkPass The Wi-Fi network password for configuration.
+* @param configServerPort The port for the SoftAP configuration server.
+* @param preferencesNamespace The namespace for storing configuration preferences.
+*/
+WiFiConfig::WiFiConfig(const char* configNetworkName, const char* configNetworkPass, uint16_t configServerPort, const char* preferencesNamespace)
+  : _configServerInstance(configServerPort),
+    _configNetworkName(configNetworkName),
+    _configNetworkPass(configNetworkPass),
+    _configServerPort(configServerPort),
+    _preferencesNamespace(preferencesNamespace) {
+  // The configuration server task saves preferences while the caller reloads them.
+  // Recursive, as the getters reload the preferences on first use.
+  _preferencesLock = xSemaphoreCreateRecursiveMutex();
+
+  // Firmware images are larger than the receive buffer and are read by the handler.
+  for (uint8_t i = 0; i < CONFIG_SERVER_MAX_CONNECTIONS; ++i) {
+    _connections[i].request().setStreamedPath(CONFIG_FIRMWARE_PATH);
+  }
+}
+
+/**
+* @brief Start the Wi-Fi configuration process.
+*
+* This method initiates the Wi-Fi configuration process by setting up a SoftAP
+* (Access Point) with the specified network name and password. It introduces a delay
+* for SoftAP initialization and then begins the SoftAP configuration server instance
+* and the captive portal DNS responder.
+*
+* @note Ensure that the SoftAP configuration server instance has been initialized
+*       before calling this method.
+*/
+void WiFiConfig::startConfiguration() {
+  // Start SoftAP with the specified network name and password.
+  WiFi.softAP(_configNetworkName, _configNetworkPass);
+
+  // Introduce a delay for SoftAP initialization.
+  delay(800);
+
+  // Begin the configuration server instance.
+  _configServerInstance.begin();
+
+  // Remember the portal address, the port is only part of it if it is not the default.
+  if (_configServerPort == 80) {
+    snprintf(_portalHost, sizeof(_portalHost), "%s", getConfigServerIp());
+  } else {
+    snprintf(_portalHost, sizeof(_portalHost), "%s:%u", getConfigServerIp(), _configServerPort);
+  }
+
+  snprintf(_portalUrl, sizeof(_portalUrl), "http://%s/", _portalHost);
+
+  // Answer every DNS query with the SoftAP IP address, so clients detect the captive portal.
+  _dnsServer.start(CONFIG_DNS_PORT, "*", WiFi.softAPIP());
+
+  // Start the first background scan, so the network list is ready when the page opens.
+  _networkScanner.startScan();
+
+  // Display SoftAP information.
+  debug(CMD, "Starting configuration server.");
+  debug(SCS, "SoftAP configuration server started. Use the credentials below to enter configuration mode.");
+  debug(LOG, "SoftAP Name: '%s'.", getConfigNetworkName());
+  debug(LOG, "SoftAP Password: '%s'.", getConfigNetworkPass());
+  debug(LOG, "SoftAP Server IP address: '%s'.", getConfigServerIp());
+  debug(LOG, "SoftAP Server port: '%d'.", getConfigServerPort());
+  debug(LOG, "SoftAP captive portal: '%s'.", _portalUrl);
+}
+
+/**
+* @brief Render the configuration page for device setup.
+* 
+* This function polls the configuration server without blocking. It accepts new
+* clients into a fixed pool of connections, reads their requests as data arrives
+* and serves every complete request. Clients that do not send a complete request
+* in time are closed, so several clients can be served at once.
+* 
+* @note Call this function repeatedly. The page is served pre-compressed from flash
+*       (see WebAssets.h) and fills in its form fields from the JSON served at /values.
+*/
+void WiFiConfig::renderConfigurationPage() {
+  // Restart into updated firmware once the client received the result.
+  if (_isFirmwareUpdated && millis() - _firmwareUpdatedAt > CONFIG_APPLY_DELAY) {
+    debug(CMD, "Restarting into the updated firmware.");
+    ESP.restart();
+  }
+
+  // Answer pending captive portal DNS queries.
+  if (_portalHost[0] != '\0') {
+    _dnsServer.processNextRequest();
+  }
+
+  // Collect background scan results, if any.
+  _networkScanner.update();
+
+  // Send the latest event to its subscribers.
+  _events.update();
+
+  // Check if a client has connected and assign it to a free connection.
+  WiFiClient client = _configServerInstance.accept();
+
+  if (client) {
+    HttpConnection* connection = nullptr;
+
+    // Keep heap for the rest of the firmware, new clients wait until it is available again.
+    bool isHeapAvailable = ESP.getFreeHeap() >= CONFIG_SERVER_MIN_FREE_HEAP;
+
+    for (uint8_t i = 0; i < CONFIG_SERVER_MAX_CONNECTIONS && connection == nullptr && isHeapAvailable; ++i) {
+      if (_connections[i].isIdle()) {
+        connection = &_connections[i];
+      }
+    }
+
+    // Free a slot held by an idle persistent connection if all slots are taken.
+    for (uint8_t i = 0; i < CONFIG_SERVER_MAX_CONNECTIONS && connection == nullptr && isHeapAvailable; ++i) {
+      if (_connections[i].isBetweenRequests()) {
+        connection = &_connections[i];
+        connection->close();
+      }
+    }
+
+    if (connection != nullptr) {
+      connection->open(client);
+    } else {
+      // Reject the client if all connections are busy or the heap is low.
+      HttpResponseWriter response(client);
+      response.send(503, "text/plain", nullptr, 0);
+      client.stop();
+    }
+  }
+
+  // Advance every open connection.
+  for (uint8_t i = 0; i < CONFIG_SERVER_MAX_CONNECTIONS; ++i) {
+    HttpConnection& connection = _connections[i];
+
+    switch (connection.poll()) {
+      case REQUEST_PENDING:
+        break;
+
+      case REQUEST_COMPLETE:
+        handleRequest(connection);
+
+        // Nothing is left to do if the handler took over the client.
+        if (connection.isIdle()) {
+          break;
+        }
+
+        // Keep persistent connections open for further, possibly pipelined, requests.
+        // A streamed body may not have been read completely, so its connection is closed.
+        if (connection.request().keepAlive() && !connection.request().isBodyStreamed()) {
+          connection.finishRequest();
+        } else {
+          connection.close();
+        }
+        break;
+
+      case REQUEST_INVALID:
+        {
+          HttpResponseWriter response(connection.client());
+          response.send(connection.request().errorStatus(), "text/plain", nullptr, 0);
+          connection.close();
+        }
+        break;
+
+      case REQUEST_TIMEOUT:
+        {
+          HttpResponseWriter response(connection.client());
+          response.send(408, "text/plain", nullptr, 0);
+          connection.close();
+        }
+        break;
+
+      case REQUEST_CLOSED:
+        connection.close();
+        break;
+    }
+  }
+}
+
+/**
+* @brief Stop the Wi-Fi configuration process.
+*
+* Closes all configuration server connections, stops the captive portal DNS
+* responder and the configuration server, and turns off the SoftAP.
+*/
+void WiFiConfig::stopConfiguration() {
+  for (uint8_t i = 0; i < CONFIG_SERVER_MAX_CONNECTIONS; ++i) {
+    if (!_connections[i].isIdle()) {
+      _connections[i].close();
+    }
+  }
+
+  _events.closeAll();
+  _dnsServer.stop();
+  _configServerInstance.end();
+  WiFi.softAPdisconnect(true);
+
+  // Without a portal, requests are no longer redirected.
+  _portalHost[0] = '\0';
+
+  debug(SCS, "SoftAP configuration server stopped.");
+}
+
+/**
+* @brief Serve the configuration page during normal operation.
+*
+* Starts a low-priority task that serves the configuration server on the station
+* interface once the device is connected to the Wi-Fi network. The task sleeps
+* between polls to stay within CONFIG_SERVER_CPU_BUDGET, and new clients are
+* rejected while the free heap is below CONFIG_SERVER_MIN_FREE_HEAP. Saved
+* preferences are applied by the caller, see hasPendingChanges().
+*
+* @param core The core the task runs on.
+*/
+void WiFiConfig::startServerTask(BaseType_t core) {
+  if (_serverTask != nullptr) {
+    return;
+  }
+
+  xTaskCreatePinnedToCore(
+    serverTask,                     // Function to implement the task.
+    "ConfigServerThread",           // Name of the task.
+    CONFIG_SERVER_TASK_STACK_SIZE,  // Stack size of the task.
+    this,                           // Task input parameter.
+    CONFIG_SERVER_TASK_PRIORITY,    // Priority of the task.
+    &_serverTask,                   // Task handle.
+    core                            // Core where the task should run.
+  );
+}
+
+/**
+* @brief Push an event to the browsers watching /events.
+*
+* The event is sent by the configuration server as a server-sent event, so this
+* never waits for the network and may be called from another task.
+*
+* @param data The event data, a single line such as a JSON object.
+*/
+void WiFiConfig::publishEvent(const char* data) {
+  _events.publish(data);
+}
+
+/**
+* @brief Export the saved configuration to clone it to other devices.
+*
+* The blob is the base64 encoded configuration record with its version and checksum,
+* including the passwords.
+*
+* @param blob Buffer receiving the null-terminated blob.
+* @param size Size of the buffer, at least CONFIG_BLOB_SIZE.
+* @return true if the blob was written.
+*/
+bool WiFiConfig::exportConfiguration(char* blob, size_t size) {
+  Preferences preferences;
+  ConfigurationRecord record;
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  preferences.begin(_preferencesNamespace, READ_ONLY_MODE);
+  loadRecord(preferences, record);
+  preferences.end();
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  // Preferences of earlier firmware were never saved as a record.
+  record.checksum = recordChecksum(record);
+
+  size_t length = 0;
+  return mbedtls_base64_encode((unsigned char*)blob, size, &length, (const unsigned char*)&record, sizeof(record)) == 0;
+}
+
+/**
+* @brief Import a configuration exported by exportConfiguration().
+*
+* The blob is verified before anything is saved, and all settings are saved in one
+* record write. Device specific settings, such as the MQTT client ID, keep the value
+* of this device, so clones do not take over the identity of the original. If this
+* device has none yet, the imported value is made unique with a suffix of its MAC
+* address. The imported settings are applied like a submitted configuration page,
+* see hasPendingChanges().
+*
+* @param blob The base64 encoded blob, trailing whitespace is ignored.
+* @param length Length of the blob, it does not need to be null-terminated.
+* @return nullptr if the configuration was imported, otherwise the reason it was not.
+*/
+const char* WiFiConfig::importConfiguration(const char* blob, size_t length) {
+  ConfigurationRecord imported;
+  size_t importedLength = 0;
+
+  while (length > 0 && isspace((unsigned char)blob[length - 1])) {
+    length--;
+  }
+
+  if (mbedtls_base64_decode((unsigned char*)&imported, sizeof(imported), &importedLength, (const unsigned char*)blob, length) != 0 || importedLength != sizeof(imported)) {
+    return "Configuration is not a blob of this firmware.";
+  }
+
+  if (!isValidRecord(imported)) {
+    return "Configuration blob is corrupted or of another version.";
+  }
+
+  // Save the imported values as the next record of this device, in one write.
+  Preferences preferences;
+  ConfigurationRecord record;
+  const char* error = nullptr;
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
+    loadRecord(preferences, record);
+    ConfigurationValues loaded = record.values;
+    record.values = imported.values;
+
+    for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+      const ConfigurationField& field = CONFIGURATION_SCHEMA[i];
+      const char* own = (const char*)settingData(loaded, i);
+
+      if (!field.isDeviceSpecific) {
+        continue;
+      }
+
+      if (!field.isRequired || strcmp(own, field.defaultString) != 0) {
+        setSettingString(record.values, i, own);
+      } else {
+        setDeviceSuffix(record.values, i);
+      }
+    }
+
+    if (!saveRecord(preferences, record, loaded)) {
+      error = CONFIGURATION_SAVE_ERROR;
+    }
+
+    preferences.end();
+  } else {
+    error = CONFIGURATION_SAVE_ERROR;
+  }
+
+  if (error == nullptr) {
+    debug(SCS, "Configuration imported to '%s' namespace.", _preferencesNamespace);
+
+    // Apply after a short delay, like a submitted configuration page.
+    _savedAt = millis();
+    _hasPendingChanges = true;
+  }
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  return error;
+}
+
+/**
+* @brief Task function serving the configuration server in normal operation.
+*
+* Starts listening once the station interface is connected, then polls the
+* configuration server and sleeps after every poll in proportion to the time
+* spent, keeping the task within CONFIG_SERVER_CPU_BUDGET. The pause is capped at
+* CONFIG_SERVER_MAX_PAUSE, so a long request such as a firmware upload does not
+* leave the server unresponsive afterwards.
+*
+* @param parameter Pointer to the WiFiConfig instance.
+*/
+void WiFiConfig::serverTask(void* parameter) {
+  WiFiConfig* configuration = static_cast<WiFiConfig*>(parameter);
+
+  for (;;) {
+    if (!configuration->_isServerListening) {
+      if (WiFi.status() == WL_CONNECTED) {
+        configuration->_configServerInstance.begin();
+        configuration->_isServerListening = true;
+
+        debug(SCS, "Configuration server started on 'http://%s:%d/'.", WiFi.localIP().toString().c_str(), configuration->getConfigServerPort());
+      }
+
+      vTaskDelay(pdMS_TO_TICKS(CONFIG_SERVER_TASK_INTERVAL));
+      continue;
+    }
+
+    unsigned long startedAt = micros();
+    configuration->renderConfigurationPage();
+    unsigned long busy = (micros() - startedAt) / 1000;
+
+    // Sleep at least the poll interval, and long enough to stay within the CPU budget,
+    // but never longer than the maximum pause, however long the poll took.
+    unsigned long pause = busy * (100 - CONFIG_SERVER_CPU_BUDGET) / CONFIG_SERVER_CPU_BUDGET;
+    pause = min(pause, (unsigned long)CONFIG_SERVER_MAX_PAUSE);
+    vTaskDelay(pdMS_TO_TICKS(max(pause, (unsigned long)CONFIG_SERVER_TASK_INTERVAL)));
+  }
+}
+
+/**
+* @brief Check if saved preferences are waiting to be applied.
+*
+* Saved preferences are reported only after CONFIG_APPLY_DELAY, so the confirmation
+* page can load before the caller acts on them.
+*
+* @return true if preferences were saved and reloadPreferences() was not called since.
+*/
+bool WiFiConfig::hasPendingChanges() {
+  return _hasPendingChanges && millis() - _savedAt > CONFIG_APPLY_DELAY;
+}
+
+/**
+* @brief Reload all preferences from non-volatile storage.
+*
+* All preferences are read in one read-only session into the preference cache.
+* Strings are copied into their fixed slots of the arena, so pointers returned by
+* the getters stay valid. Clears the pending changes.
+*
+* @return CONFIG_CHANGED_* flags for the preferences whose values changed.
+*/
+uint8_t WiFiConfig::reloadPreferences() {
+  uint8_t changes = 0;
+
+  // Wait for a request of the configuration server task that saves preferences.
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  unsigned long startedAt = micros();
+
+  // Read the latest record in one session. Without one, the defaults are loaded,
+  // as the namespace does not exist before the first save.
+  Preferences preferences;
+  ConfigurationRecord record;
+
+  if (!preferences.begin(_preferencesNamespace, READ_ONLY_MODE)) {
+    debug(ERR, "Loading preferences from '%s' namespace failed. Will use default values.", _preferencesNamespace);
+  }
+
+  loadRecord(preferences, record);
+  _recordSequence = record.sequence;
+  _saved = record.values;
+
+  // End preferences session.
+  preferences.end();
+
+  // Compare every value with the cached one and keep the flags of the changed groups.
+  // The record and the cache store the values in the same slots.
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    uint8_t* cached = settingData(_cache, i);
+    const uint8_t* loaded = settingData(record.values, i);
+
+    if (memcmp(cached, loaded, settingSize(i)) != 0) {
+      memcpy(cached, loaded, settingSize(i));
+      changes |= CONFIGURATION_SCHEMA[i].changed;
+    }
+  }
+
+  debug(LOG, "Preferences loaded from '%s' namespace in %lu us.", _preferencesNamespace, micros() - startedAt);
+
+  _isLoaded = true;
+  _hasPendingChanges = false;
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  return changes;
+}
+
+/**
+* @brief Handle a complete request on a configuration server connection.
+*
+* Routes the request to the matching endpoint and sends the response. Outside
+* configuration mode, every request must be authorized with the admin password,
+* and firmware updates need it in configuration mode as well. Requests that change
+* the device are rejected if a browser sent them from another site. A form posted
+* to /configuration saves the submitted settings to be applied by the caller.
+*
+* @param connection The connection with a complete request.
+*/
+void WiFiConfig::handleRequest(HttpConnection& connection) {
+  // Parsed request, routed on views into the request buffer.
+  HttpRequestParser& request = connection.request();
+  HttpView path = request.path();
+
+  // Response writer with a fixed-size buffer for this client.
+  HttpResponseWriter response(connection.client());
+  response.setKeepAlive(request.keepAlive() && !request.isBodyStreamed());
+
+  // Send captive portal probes and requests for other sites to the configuration page.
+  if (redirectToPortal(request, response)) {
+    return;
+  }
+
+  // Outside configuration mode, the device is only managed with the admin password.
+  if (!authorize(request, response)) {
+    return;
+  }
+
+  // Only the configuration page itself may change the device from a browser.
+  if (!request.method().equals("GET") && !isSameOrigin(request)) {
+    response.send(403, "text/plain", nullptr, 0);
+    return;
+  }
+
+  // Read or update the whole configuration as JSON.
+  if (path.equals("/api/config")) {
+    if (request.method().equals("GET")) {
+      renderConfigurationValues(response);
+    } else if (request.method().equals("PUT")) {
+      updateConfiguration(request, response);
+    } else {
+      response.addHeader("Allow", "GET, PUT");
+      response.send(405, "text/plain", nullptr, 0);
+    }
+    return;
+  }
+
+  // Import the whole configuration as one blob. The blob includes the passwords, so
+  // it is only exported over the serial port.
+  if (path.equals(CONFIG_BLOB_PATH)) {
+    if (request.method().equals("PUT")) {
+      importConfigurationBlob(request, response);
+    } else {
+      response.addHeader("Allow", "PUT");
+      response.send(405, "text/plain", nullptr, 0);
+    }
+    return;
+  }
+
+  // Update the firmware, uploaded with the request or downloaded from a server. The
+  // SoftAP password does not protect the firmware, it is known to anyone near the device.
+  if (path.equals(CONFIG_FIRMWARE_PATH) || path.equals(CONFIG_FIRMWARE_PULL_PATH)) {
+    if (!authorizeAdmin(request, response)) {
+      return;
+    }
+
+    if (!request.method().equals("POST")) {
+      response.addHeader("Allow", "POST");
+      response.send(405, "text/plain", nullptr, 0);
+    } else if (path.equals(CONFIG_FIRMWARE_PATH)) {
+      uploadFirmware(connection, response);
+    } else {
+      pullFirmware(request, response);
+    }
+    return;
+  }
+
+  // Save the submitted configuration page.
+  if (path.equals("/configuration") && request.method().equals("POST")) {
+    saveConfigurationForm(request, response);
+    return;
+  }
+
+  // Only the GET method is served.
+  if (!request.method().equals("GET")) {
+    response.send(405, "text/plain", nullptr, 0);
+    return;
+  }
+
+  // Serve current configuration values to the page script.
+  if (path.equals("/values")) {
+    renderConfigurationValues(response);
+    return;
+  }
+
+  // Serve the flash write statistics of the preferences.
+  if (path.equals(CONFIG_STORAGE_PATH)) {
+    renderStorageStatistics(response);
+    return;
+  }
+
+  // Serve the settings the page script builds its form fields from.
+  if (path.equals("/schema")) {
+    renderConfigurationSchema(response);
+    return;
+  }
+
+  // Start a new background scan and serve the current scan state.
+  if (path.equals("/scan")) {
+    _networkScanner.startScan();
+    renderNetworks(response);
+    return;
+  }
+
+  // Serve the cached network list.
+  if (path.equals("/networks")) {
+    renderNetworks(response);
+    return;
+  }
+
+  // Stream live events, the broadcaster takes over the client.
+  if (path.equals("/events")) {
+    if (_events.subscriberCount() == EVENT_MAX_SUBSCRIBERS) {
+      response.send(503, "text/plain", nullptr, 0);
+      return;
+    }
+
+    response.addHeader("Cache-Control", "no-store");
+    response.beginStream(200, "text/event-stream");
+    _events.subscribe(connection.client());
+    connection.detach();
+    return;
+  }
+
+  // Serve the stylesheet and script of the configuration page.
+  if (path.equals("/configuration.css")) {
+    serveAsset(request, response, "text/css", CONFIGURATION_CSS_GZIP, CONFIGURATION_CSS_GZIP_LENGTH, CONFIGURATION_CSS_ETAG);
+    return;
+  }
+
+  if (path.equals("/configuration.js")) {
+    serveAsset(request, response, "application/javascript", CONFIGURATION_JS_GZIP, CONFIGURATION_JS_GZIP_LENGTH, CONFIGURATION_JS_ETAG);
+    return;
+  }
+
+  // Serve the static configuration page.
+  serveAsset(request, response, "text/html", CONFIGURATION_HTML_GZIP, CONFIGURATION_HTML_GZIP_LENGTH, CONFIGURATION_HTML_ETAG);
+}
+
+/**
+* @brief Check the Basic authentication of a request outside configuration mode.
+*
+* In configuration mode, the SoftAP password already limits who can reach the
+* server, so every request is authorized. Otherwise see authorizeAdmin().
+*
+* @param request The parsed request.
+* @param response The response writer to send the rejection with.
+* @return true if the request is authorized, otherwise 401 or 403 was sent.
+*/
+bool WiFiConfig::authorize(HttpRequestParser& request, HttpResponseWriter& response) {
+  return _portalHost[0] != '\0' || authorizeAdmin(request, response);
+}
+
+/**
+* @brief Check the Basic authentication of a request with the admin password.
+*
+* The request must carry the CONFIG_ADMIN_USER user and the ADMIN_PASS setting as
+* password. Without an admin password, such requests are rejected.
+*
+* @param request The parsed request.
+* @param response The response writer to send the rejection with.
+* @return true if the request is authorized, otherwise 401 or 403 was sent.
+*/
+bool WiFiConfig::authorizeAdmin(HttpRequestParser& request, HttpResponseWriter& response) {
+  char password[CONFIGURATION_SCHEMA[ADMIN_PASS_SETTING].maximum + 1];
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  strlcpy(password, (const char*)settingData(_cache, ADMIN_PASS_SETTING), sizeof(password));
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  if (*password == '\0') {
+    static const char message[] = "Set an admin password in configuration mode to manage the device over the network.";
+    response.send(403, "text/plain", (const uint8_t*)message, sizeof(message) - 1);
+    return false;
+  }
+
+  // Decode "Basic <base64 of user:password>", longer credentials can not match.
+  HttpView authorization = request.header("Authorization");
+  char credentials[sizeof(CONFIG_ADMIN_USER) + CONFIGURATION_SCHEMA[ADMIN_PASS_SETTING].maximum + 1];
+  size_t length = 0;
+  bool isAuthorized = authorization.length > 6 && strncasecmp(authorization.data, "Basic ", 6) == 0
+                      && mbedtls_base64_decode((unsigned char*)credentials, sizeof(credentials) - 1, &length, (const unsigned char*)authorization.data + 6, authorization.length - 6) == 0;
+
+  if (isAuthorized) {
+    credentials[length] = '\0';
+    const char* separator = strchr(credentials, ':');
+
+    isAuthorized = separator != nullptr && (size_t)(separator - credentials) == strlen(CONFIG_ADMIN_USER)
+                   && strncmp(credentials, CONFIG_ADMIN_USER, separator - credentials) == 0 && isSamePassword(separator + 1, password);
+  }
+
+  if (!isAuthorized) {
+    response.addHeader("WWW-Authenticate", CONFIG_AUTH_CHALLENGE);
+    response.send(401, "text/plain", nullptr, 0);
+  }
+
+  return isAuthorized;
+}
+
+/**
+* @brief Check if a browser sent the request from the configuration page itself.
+*
+* Browsers send the Origin header with requests that may change data. A page of
+* another site could otherwise make the browser of a signed in user submit the
+* configuration form or the JSON API in their name.
+*
+* @param request The parsed request.
+* @return true if the request has no Origin header, or the origin of this server.
+*/
+bool WiFiConfig::isSameOrigin(HttpRequestParser& request) {
+  HttpView origin = request.header("Origin");
+  HttpView host = request.header("Host");
+
+  // Tools such as the provisioning script send no Origin.
+  if (origin.length == 0) {
+    return true;
+  }
+
+  return host.length > 0 && origin.length == 7 + host.length && strncasecmp(origin.data, "http://", 7) == 0
+         && strncasecmp(origin.data + 7, host.data, host.length) == 0;
+}
+
+/**
+* @brief Redirect requests for other hosts to the configuration page.
+*
+* With every name resolving to the SoftAP, operating system captive portal probes
+* such as /generate_204 or /hotspot-detect.html arrive here with their own Host
+* header. Answering them with a redirect makes the device open the configuration
+* page on its own after joining the SoftAP.
+*
+* @param request The parsed request.
+* @param response The response writer to send the redirect with.
+* @return true if the request was redirected.
+*/
+bool WiFiConfig::redirectToPortal(HttpRequestParser& request, HttpResponseWriter& response) {
+  HttpView host = request.header("Host");
+
+  // Without a portal, requests without a Host header, or addressed to the portal itself are served normally.
+  if (_portalHost[0] == '\0' || host.length == 0 || host.equalsIgnoreCase(_portalHost)) {
+    return false;
+  }
+
+  response.addHeader("Location", _portalUrl);
+  response.addHeader("Cache-Control", "no-store");
+  response.send(302, "text/plain", nullptr, 0);
+
+  return true;
+}
+
+/**
+* @brief Serve a static asset stored pre-compressed in flash.
+*
+* The asset is sent as-is without building it in RAM, with a strong ETag so the
+* browser can revalidate its cached copy. The ETag is generated together with the
+* asset data, so nothing is hashed per request. If the copy is still current, only a
+* 304 Not Modified response without a body is sent.
+*
+* @param request The parsed request.
+* @param response The response writer to send the asset with.
+* @param contentType The value of the Content-Type header.
+* @param data The gzip compressed asset.
+* @param length Length of the compressed asset in bytes.
+* @param etag The quoted ETag generated with the asset.
+*/
+void WiFiConfig::serveAsset(HttpRequestParser& request, HttpResponseWriter& response, const char* contentType, const uint8_t* data, size_t length, const char* etag) {
+  // Browsers revalidate on every use, which costs one small round trip on a persistent connection.
+  response.addHeader("ETag", etag);
+  response.addHeader("Cache-Control", "no-cache");
+
+  // If-None-Match may list several tags, or "*" for any.
+  HttpView ifNoneMatch = request.header("If-None-Match");
+
+  if (ifNoneMatch.length > 0 && (strstr(ifNoneMatch.data, etag) != nullptr || ifNoneMatch.equals("*"))) {
+    response.send(304, nullptr, nullptr, 0);
+    return;
+  }
+
+  response.send(200, contentType, data, length, "gzip");
+}
+
+/**
+* @brief Render the current configuration values as JSON.
+*
+* Sends all configuration values to the client, with null for the secret ones, so
+* passwords never leave the device. The configuration page fetches this endpoint to
+* fill in its form fields. The values are the saved ones, even before they are applied.
+*
+* @param response The response writer to send the JSON with.
+*/
+void WiFiConfig::renderConfigurationValues(HttpResponseWriter& response) {
+  // The values describe the device and its network, so they must never be cached.
+  response.addHeader("Cache-Control", "no-store");
+
+  // Copy the values, so the lock is not held while the client receives them.
+  ConfigurationValues values;
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  // The cache keeps the applied values until the caller applies the saved ones.
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  values = _saved;
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  // Stream the JSON in chunks, RAM use is bounded by the response buffer.
+  response.begin(200, "application/json");
+  response.beginJsonObject();
+
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    const char* key = CONFIGURATION_SCHEMA[i].key;
+
+    switch (CONFIGURATION_SCHEMA[i].type) {
+      case CONFIG_TYPE_STRING:
+        if (CONFIGURATION_SCHEMA[i].isSecret) {
+          response.printJsonKey(key);
+          response.print("null");
+        } else {
+          response.printJsonField(key, (const char*)settingData(values, i));
+        }
+        break;
+
+      case CONFIG_TYPE_NUMBER:
+        response.printJsonField(key, (int32_t)settingNumber(values, i));
+        break;
+
+      case CONFIG_TYPE_BOOLEAN:
+        response.printJsonField(key, settingNumber(values, i) != 0);
+        break;
+    }
+  }
+
+  response.endJsonObject();
+
+  response.end();
+}
+
+/**
+* @brief Render the configuration schema as JSON.
+*
+* Sends the key, type, label, page section, bounds and flags of every setting.
+* The configuration page fetches this endpoint to build its form fields.
+*
+* @param response The response writer to send the JSON with.
+*/
+void WiFiConfig::renderConfigurationSchema(HttpResponseWriter& response) {
+  static const char* const types[] = { "string", "number", "boolean" };
+
+  // The schema changes with the firmware, which may be updated while the page is cached.
+  response.addHeader("Cache-Control", "no-cache");
+  response.begin(200, "application/json");
+  response.print("[");
+
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    const ConfigurationField& field = CONFIGURATION_SCHEMA[i];
+
+    if (i > 0) {
+      response.print(",");
+    }
+
+    response.beginJsonObject();
+    response.printJsonField("key", field.key);
+    response.printJsonField("type", types[field.type]);
+    response.printJsonField("label", field.label);
+    response.printJsonField("section", field.section);
+    response.printJsonField("minimum", (int32_t)field.minimum);
+    response.printJsonField("maximum", (int32_t)field.maximum);
+    response.printJsonField("required", field.isRequired);
+    response.printJsonField("secret", field.isSecret);
+    response.endJsonObject();
+  }
+
+  response.print("]");
+  response.end();
+}
+
+/**
+* @brief Update the configuration from a JSON object.
+*
+* Parses the request body in place and validates every field before saving any,
+* so a rejected update changes nothing. Fields missing from the object keep their
+* values. Responds with the effective configuration, or with 400 and an error
+* message for every invalid field.
+*
+* @param request The parsed request with the JSON body.
+* @param response The response writer to send the result with.
+*/
+void WiFiConfig::updateConfiguration(HttpRequestParser& request, HttpResponseWriter& response) {
+  // The body views the connection's writable buffer, where strings are unescaped in place.
+  HttpView body = request.body();
+  JsonObjectParser update;
+
+  if (!update.parse(const_cast<char*>(body.data), body.length)) {
+    response.begin(400, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", "Request body is not a flat JSON object.");
+    response.printJsonField("offset", (int32_t)update.errorOffset());
+    response.endJsonObject();
+    response.end();
+    return;
+  }
+
+  // Validate all fields first.
+  char message[48];
+  bool isValid = true;
+
+  for (uint8_t i = 0; i < update.count() && isValid; ++i) {
+    isValid = validateConfigurationField(update, i, message, sizeof(message)) == nullptr;
+  }
+
+  if (!isValid) {
+    // Report every invalid field at once.
+    response.begin(400, "application/json");
+    response.beginJsonObject();
+    response.printJsonKey("errors");
+    response.beginJsonObject();
+
+    for (uint8_t i = 0; i < update.count(); ++i) {
+      const char* error = validateConfigurationField(update, i, message, sizeof(message));
+
+      if (error != nullptr) {
+        response.printJsonField(update.key(i), error);
+      }
+    }
+
+    response.endJsonObject();
+    response.endJsonObject();
+    response.end();
+    return;
+  }
+
+  // Show debug message.
+  debug(CMD, "Saving preferences to '%s' namespace.", _preferencesNamespace);
+
+  // Change the latest record and save it at once, validation guarantees each field
+  // has the type of its key.
+  Preferences preferences;
+  ConfigurationRecord record;
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  bool isSaved = preferences.begin(_preferencesNamespace, READ_WRITE_MODE);
+
+  if (isSaved) {
+    loadRecord(preferences, record);
+    ConfigurationValues loaded = record.values;
+
+    for (uint8_t i = 0; i < update.count(); ++i) {
+      size_t setting = findSetting(update.key(i));
+
+      switch (update.type(i)) {
+        case JSON_STRING:
+          setSettingString(record.values, setting, update.string(i));
+          break;
+
+        case JSON_NUMBER:
+          setSettingNumber(record.values, setting, update.number(i));
+          break;
+
+        case JSON_BOOLEAN:
+          setSettingNumber(record.values, setting, update.boolean(i));
+          break;
+
+        case JSON_NULL:
+          break;
+      }
+    }
+
+    isSaved = saveRecord(preferences, record, loaded);
+
+    // End preferences session.
+    preferences.end();
+  }
+
+  // Apply the configuration like a submission of the configuration page.
+  if (isSaved && update.count() > 0) {
+    _savedAt = millis();
+    _hasPendingChanges = true;
+  }
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  if (!isSaved) {
+    debug(ERR, "Saving preferences to '%s' namespace failed.", _preferencesNamespace);
+
+    response.begin(500, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", "Saving the configuration failed.");
+    response.endJsonObject();
+    response.end();
+    return;
+  }
+
+  // Show debug message.
+  debug(SCS, "Saving preferences to '%s' namespace done.", _preferencesNamespace);
+
+  renderConfigurationValues(response);
+}
+
+/**
+* @brief Save the settings of the submitted configuration page.
+*
+* Decodes the URL-encoded form in the request body in place, validates every field
+* and saves all settings in one record write. Secrets are never sent to the page, so
+* an empty secret field keeps the saved secret, unless the secret is listed in the
+* CONFIG_FORM_CLEAR_FIELD field. Responds with the configuration page, or with 400
+* and an error message for every invalid field, and nothing saved.
+*
+* @param request The parsed request with the form as body.
+* @param response The response writer to send the result with.
+*/
+void WiFiConfig::saveConfigurationForm(HttpRequestParser& request, HttpResponseWriter& response) {
+  // Move the body back over the line feed ending the header section, which makes room
+  // for the terminator without overwriting a pipelined request behind the body.
+  HttpView body = request.body();
+  char* data = const_cast<char*>(body.data) - 1;
+  memmove(data, body.data, body.length);
+  data[body.length] = '\0';
+
+  // Decode the submitted fields in a single pass, in place in the request buffer.
+  FormDecoder form(ConfigurationTables::formFields, CONFIGURATION_FIELD_COUNT + 1);
+  form.decode(data);
+
+  const char* cleared = form.value(CONFIG_FORM_CLEAR_FIELD);
+
+  // Show debug message.
+  debug(CMD, "Saving preferences to '%s' namespace.", _preferencesNamespace);
+
+  // Change the latest record and save it at once, once every field is valid.
+  Preferences preferences;
+  ConfigurationRecord record;
+  ConfigurationValues loaded;
+  char message[48];
+  bool isValid = true;
+
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
+
+  bool isSaved = preferences.begin(_preferencesNamespace, READ_WRITE_MODE);
+
+  if (isSaved) {
+    loadRecord(preferences, record);
+    loaded = record.values;
+
+    for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT && isValid; ++i) {
+      isValid = validateFormField(i, form.value(CONFIGURATION_SCHEMA[i].key), loaded, cleared, message, sizeof(message)) == nullptr;
+    }
+  }
+
+  if (isSaved && isValid) {
+    uint16_t number = 0;
+
+    for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+      const ConfigurationField& field = CONFIGURATION_SCHEMA[i];
+      const char* value = form.value(field.key);
+
+      switch (field.type) {
+        case CONFIG_TYPE_STRING:
+          if (!isKeptSecret(field, value, (const char*)settingData(loaded, i), cleared)) {
+            setSettingString(record.values, i, value);
+          }
+          break;
+
+        case CONFIG_TYPE_NUMBER:
+          // Validation guarantees the number parses.
+          parseFormNumber(value, number);
+          setSettingNumber(record.values, i, number);
+          break;
+
+        case CONFIG_TYPE_BOOLEAN:
+          // Checkboxes are only submitted with a value when checked.
+          setSettingNumber(record.values, i, *value != '\0');
+          break;
+      }
+    }
+
+    isSaved = saveRecord(preferences, record, loaded);
+  }
+
+  // End preferences session.
+  preferences.end();
+
+  // Apply after a short delay, keep serving the confirmation page meanwhile.
+  if (isSaved && isValid) {
+    _savedAt = millis();
+    _hasPendingChanges = true;
+  }
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  if (isSaved && !isValid) {
+    // Report every invalid field at once.
+    response.begin(400, "application/json");
+    response.beginJsonObject();
+    response.printJsonKey("errors");
+    response.beginJsonObject();
+
+    for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+      const char* error = validateFormField(i, form.value(CONFIGURATION_SCHEMA[i].key), loaded, cleared, message, sizeof(message));
+
+      if (error != nullptr) {
+        response.printJsonField(CONFIGURATION_SCHEMA[i].key, error);
+      }
+    }
+
+    response.endJsonObject();
+    response.endJsonObject();
+    response.end();
+    return;
+  }
+
+  if (!isSaved) {
+    debug(ERR, "Saving preferences to '%s' namespace failed.", _preferencesNamespace);
+    response.send(500, "text/plain", (const uint8_t*)CONFIGURATION_SAVE_ERROR, strlen(CONFIGURATION_SAVE_ERROR));
+    return;
+  }
+
+  // Show debug message.
+  debug(SCS, "Saving preferences to '%s' namespace done.", _preferencesNamespace);
+
+  serveAsset(request, response, "text/html", CONFIGURATION_HTML_GZIP, CONFIGURATION_HTML_GZIP_LENGTH, CONFIGURATION_HTML_ETAG);
+}
 
 /**
-* @brief Constructor for WiFiConfig class.
-*
-* Initializes an instance of the WiFiConfig class with the provided configuration parameters.
+* @brief Import an exported configuration sent in the request body.
 *
-* @param configNetworkName The Wi-Fi network name for configuration.
-* @param configNetworkPass The Wi-Fi network password for configuration.
-* @param configServerPort The port for the SoftAP configuration server.
-* @param preferencesNamespace The namespace for storing configuration preferences.
+* @param request The parsed request with the blob as body.
+* @param response The response writer to send the result with.
 */
-WiFiConfig::WiFiConfig(const char* configNetworkName, const char* configNetworkPass, uint16_t configServerPort, const char* preferencesNamespace)
-  : _configNetworkName(configNetworkName),
-    _configNetworkPass(configNetworkPass),
-    _configServerPort(configServerPort),
-    _configServerInstance(configServerPort),
-    _preferencesNamespace(preferencesNamespace) {
-  // Constructor implementation goes here
+void WiFiConfig::importConfigurationBlob(HttpRequestParser& request, HttpResponseWriter& response) {
+  HttpView body = request.body();
+  const char* error = importConfiguration(body.data, body.length);
+
+  response.begin(error == nullptr ? 200 : error == CONFIGURATION_SAVE_ERROR ? 500 : 400, "application/json");
+  response.beginJsonObject();
+
+  if (error == nullptr) {
+    response.printJsonField("imported", true);
+  } else {
+    response.printJsonField("error", error);
+  }
+
+  response.endJsonObject();
+  response.end();
 }
 
 /**
-* @brief Start the Wi-Fi configuration process.
-*
-* This method initiates the Wi-Fi configuration process by setting up a SoftAP
-* (Access Point) with the specified network name and password. It introduces a delay
-* for SoftAP initialization and then begins the SoftAP configuration server instance.
+* @brief Validate one field of a configuration update.
 *
-* @note Ensure that the SoftAP configuration server instance has been initialized
-*       before calling this method.
+* @param update The parsed configuration update.
+* @param index Index of the field in the update.
+* @param message Buffer for error messages that include the bounds of the setting.
+* @param size Size of the message buffer.
+* @return An error message for the field, or nullptr if it is valid.
 */
-void WiFiConfig::startConfiguration() {
-  // Start SoftAP with the specified network name and password.
-  WiFi.softAP(_configNetworkName, _configNetworkPass);
+const char* WiFiConfig::validateConfigurationField(JsonObjectParser& update, uint8_t index, char* message, size_t size) {
+  const char* key = update.key(index);
+  size_t setting = findSetting(key);
 
-  // Introduce a delay for SoftAP initialization.
-  delay(800);
+  // A repeated key would make the saved value depend on the order.
+  if (update.indexOf(key) != index) {
+    return "Field is repeated.";
+  }
 
-  // Begin the configuration server instance.
-  _configServerInstance.begin();
+  if (setting == CONFIGURATION_FIELD_COUNT) {
+    return "Unknown field.";
+  }
 
-  // Display SoftAP information.
-  debug(CMD, "Starting configuration server.");
-  debug(SCS, "SoftAP configuration server started. Use the credentials below to enter configuration mode.");
-  debug(LOG, "SoftAP Name: '%s'.", getConfigNetworkName());
-  debug(LOG, "SoftAP Password: '%s'.", getConfigNetworkPass());
-  debug(LOG, "SoftAP Server IP address: '%s'.", getConfigServerIp());
-  debug(LOG, "SoftAP Server port: '%d'.", getConfigServerPort());
+  static const JsonValueTypeEnum types[] = { JSON_STRING, JSON_NUMBER, JSON_BOOLEAN };
+  static const char* const typeErrors[] = { "Must be a string.", "Must be a number.", "Must be a boolean." };
+
+  ConfigurationTypeEnum type = CONFIGURATION_SCHEMA[setting].type;
+
+  if (update.type(index) != types[type]) {
+    return typeErrors[type];
+  }
+
+  if (type == CONFIG_TYPE_STRING) {
+    return validateSetting(setting, update.string(index), 0, message, size);
+  }
+
+  return validateSetting(setting, nullptr, type == CONFIG_TYPE_NUMBER ? update.number(index) : 0, message, size);
 }
 
 /**
-* @brief Render the configuration page for device setup.
-* 
-* This function serves an HTML configuration page to the connected client.
-* It processes the form submission and saves the configuration settings.
-* 
-* @note The HTML structure and styling are included for presentation purposes.
+* @brief Validate a value against the bounds of its setting.
+*
+* @param setting Index of the setting in the schema.
+* @param string The value of a string setting.
+* @param number The value of a number setting.
+* @param message Buffer for error messages that include the bounds of the setting.
+* @param size Size of the message buffer.
+* @return An error message for the value, or nullptr if it is valid.
 */
-void WiFiConfig::renderConfigurationPage() {
-  // Check if a client has connected.
-  WiFiClient client = _configServerInstance.accept();
+const char* WiFiConfig::validateSetting(size_t setting, const char* string, int32_t number, char* message, size_t size) {
+  const ConfigurationField& field = CONFIGURATION_SCHEMA[setting];
 
-  if (!client) {
-    return;  // No client, exit the loop.
-  }
-
-  // Wait until the client sends some data.
-  while (!client.available()) {
-    delay(10);
-  }
-
-  // Read the first line of the request.
-  String request = client.readStringUntil('\r');
-  //client.flush();
-
-  /**
-  * @note THIS WILL BE UPDATED IN FUTURE VERSION.
-  */
-  // Serve the HTML page.
-  String html = String();
-
-  html += "<!DOCTYPE html>";
-  html += "<html lang=\"en\">";
-  html += "<head>";
-  html += "<meta charset=\"UTF-8\"><meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0, user-scalable=no\">";
-  html += "<title>SMAF-DK-SAP</title>";
-  html += "<script> function refreshScan() {window.location.href = '/refresh';} </script>";
-  html += "<style>";
-  html += ":root {";
-  html += "--monochrome-100: hsl(210, 10%, 10%); --monochrome-125: hsl(210, 10%, 50%); --monochrome-150: hsl(210, 10%, 70%); --monochrome-200: hsl(210, 10%, 85%); --monochrome-250: hsl(210, 10%, 95%); --monochrome-300: hsl(0, 0%, 100%);";
-  html += "--info-50: hsl(210, 100%, 20%); --info-75: hsl(210, 100%, 35%); --info-100: hsl(210, 100%, 50%); --info-200: hsl(210, 100%, 95%);";
-  html += "--success-50: hsl(130, 100%, 15%); --success-75: hsl(130, 100%, 25%); --success-100: hsl(130, 100%, 40%); --success-200: hsl(130, 100%, 95%);";
-  html += "--error-50: hsl(0, 100%, 24%); --error-75: hsl(0, 100%, 35%); --error-100: hsl(0, 100%, 60%); --error-200: hsl(0, 100%, 97%);";
-  html += "}";
-  html += "* {font-family: system-ui, sans-serif; font-size: 16px; line-height: 1.5; color: var(--monochrome-100); margin: 0; padding: 0; box-sizing: border-box; outline: none; list-style: none; word-wrap: break-words; cursor: default;}";
-  html += "body {display: flex;flex-direction: column;flex-wrap: nowrap;align-items: center;padding: 1.5rem 1.5rem 8rem;}";
-  html += "h1, h2, h3, h4, h5, h6 {color: inherit; line-height: 1.15; margin-top: 3.5rem; margin-bottom: 1rem; font-weight: 700; letter-spacing: -0.2px}";
-  html += "h1 {font-size: 2.027rem; font-weight: 700;}";
-  html += "h2 {font-size: 1.802rem;}";
-  html += "h3 {font-size: 1.602rem;}";
-  html += "h4 {font-size: 1.424rem;}";
-  html += "h5 {font-size: 1.266rem; margin-bottom: 0.5rem;}";
-  html += "h6 {font-size: 1.125rem; margin-bottom: 0.5rem;}";
-  html += "p {color: inherit; margin-top: 1rem; margin-bottom: 1rem;}";
-  html += "label {font-weight: 500;}";
-  html += "form {max-width: 460px;}";
-  html += "input[type='text'], input[type='submit'], input[type='reset'], select, input[type='checkbox'], button {all: unset;}";
-  html += "input[type='text'], select {font-family: monospace, sans-serif; padding: 0.75rem 1rem; box-shadow: 0 0 0 1px var(--monochrome-200) inset; cursor: text;}";
-  html += "input[type='text']:hover, select:hover {box-shadow: 0 0 0 2px var(--monochrome-200) inset;}";
-  html += "input[type='text']:focus, select:focus {box-shadow: 0 0 0 2px var(--info-100) inset;}";
-  html += "input[type='submit'], input[type='reset'], button {font-weight: 500; cursor: pointer; padding: 1rem 1.5rem; flex-grow: 2; text-align: center;}";
-  html += "input[type='submit'] {background: var(--info-100); color: var(--monochrome-300);}";
-  html += "input[type='reset'], button {box-shadow: 0 0 0 1px var(--monochrome-200) inset; flex-shrink: 2; flex-grow: 1;}";
-  html += "input[type='submit']:hover {background: var(--info-75);}";
-  html += "input[type='submit']:active {background: var(--info-50);}";
-  html += "input[type='reset']:hover, button:hover {box-shadow: 0 0 0 2px var(--monochrome-200) inset;}";
-  html += "input[type='reset']:active, button:active {box-shadow: 0 0 0 2px var(--monochrome-200) inset; background: var(--monochrome-250);}";
-  html += ".horizontal-frame {display: flex; flex-wrap: wrap; flex-direction: row; gap: 1.0rem; margin-top: 1.0rem;}";
-  html += "section {border-left: 3px solid var(--info-100); background: var(--info-200); color: var(--info-50); padding: 1rem 1.25rem; margin: 1.5rem 0rem;}";
-  html += "section.success {border-left: 3px solid var(--success-100); background: var(--success-200); color: var(--success-50);}";
-  html += "section p {margin: 0; padding: 0;}";
-  html += "section h6 {margin-top: 0;}";
-  html += ".frame {display: flex; flex-direction: column; gap: 1.5rem; margin-top: 1.5rem;}";
-  html += ".input-frame {display: flex; flex-direction: column; gap: 0.25rem;}";
-  html += ".checkbox-frame {display: flex; flex-direction: row; justify-content: space-between; align-content: center; align-items: center; gap: 0.5rem;}";
-  html += ".switch {position: relative; display: flex; flex-shrink: 0; width: 40px; height: 24px;}";
-  html += ".track {cursor: pointer; display: flex; justify-content: flex-start; align-items: center; background-color: var(--monochrome-200); box-shadow: 0 0 0 3px var(--monochrome-200); width: 100%; height: 100%; border-radius: 100px;}";
-  html += ".track:hover {background-color: var(--monochrome-150); box-shadow: 0 0 0 3px var(--monochrome-150);}";
-  html += ".track:active {background-color: var(--monochrome-125); box-shadow: 0 0 0 3px var(--monochrome-125);}";
-  html += ".thumb {display: flex; justify-content: center; align-items: center; width: 24px; height: 24px; pointer-events: none; border-radius: 100%; box-shadow: 0 0 0 9.5px var(--monochrome-300) inset;}";
-  html += "input:checked + .track {background-color: var(--info-100); box-shadow: 0 0 0 3px var(--info-100); justify-content: flex-end;}";
-  html += "input:checked + .track:hover {background-color: var(--info-75); box-shadow: 0 0 0 3px var(--info-75);}";
-  html += "input:checked + .track:active {background-color: var(--info-50); box-shadow: 0 0 0 3px var(--info-50);}";
-  html += ".h1-override {margin-top: 1.5rem; margin-bottom: 1.5rem;}";
-  html += ".fake-link {text-decoration: underline; color: var(--info-100); font-weight: 500; cursor: pointer;}";
-  html += "em {all: unset; color: var(--error-100); font-weight: 500;}";
-  html += "</style>";
-  html += "</head>";
-  html += "<body>";
-
-  html += "<form action='/configuration' method='get'>";
-  html += "<h1>🤙</h1>";
-  html += "<h1 class=\"h1-override\">Ready to update<br>your settings?</h1>";
-  html += "<p>Welcome to SMAF Config Hub! Quickly set up your SMAF device to connect via WiFi and transmit data using MQTT.</p>";
-
-  // Check if the request is a form submission and save preferences.
-  if (request.indexOf("/configuration") != -1) {
-    // Display a success message with the saved configuration.
-    html += "<section class='success' style=\"display: block;\">";
-    html += "<h6>Success!</h6>";
-    html += "<p>Your SMAF device has successfully absorbed the new configuration. It's now all set to rock and roll with the updated settings.</p>";
-    html += "</section>";
-  }
-
-  html += "<h4>WiFi router<br>configuration</h4>";
-  html += "<p>Secure connectivity by entering your WiFi details - SSID and password. SMAF stays linked to the network for seamless operation.</p>";
-  html += "<p class=\"fake-link\" onclick=\"refreshScan()\">Refresh network list</p>";
-  html += "<div class=\"frame\">";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(NETWORK_NAME) + "'>Select SSID<em>*</em></label>";
-  html += "<select id='" + String(NETWORK_NAME) + "' type='text' name='" + String(NETWORK_NAME) + "' required>";
-
-  html += scanNetworks();
-
-  html += "</select>";
-  html += "</div>";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(NETWORK_PASS) + "'>SSID Password<em>*</em></label>";
-  html += "<input id='" + String(NETWORK_PASS) + "' type='text' name='" + String(NETWORK_PASS) + "' value='" + getNetworkPass() + "' required>";
-  html += "</div>";
-  html += "</div>";
-  html += "<h4>MQTT server<br>configuration</h4>";
-  html += "<p>Tune communication with MQTT server settings. Enter the broker's address, port, and authentication details for a robust connection.</p>";
-  html += "<div class=\"frame\">";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_SERVER_ADDRESS) + "'>MQTT Server<em>*</em></label>";
-  html += "<input id='" + String(MQTT_SERVER_ADDRESS) + "' type='text' name='" + String(MQTT_SERVER_ADDRESS) + "' value='" + getMqttServerAddress() + "' required>";
-  html += "</div>";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_SERVER_PORT) + "'>MQTT Port<em>*</em></label>";
-  html += "<input id='" + String(MQTT_SERVER_PORT) + "' type='text' inputmode='numeric' pattern='[0-9]*' name='" + String(MQTT_SERVER_PORT) + "' value='" + String(getMqttServerPort()) + "' required>";
-  html += "</div>";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_USERNAME) + "'>MQTT Username<em>*</em></label>";
-  html += "<input id='" + String(MQTT_USERNAME) + "' type='text' name='" + String(MQTT_USERNAME) + "' value='" + getMqttUsername() + "' required>";
-  html += "</div>";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_PASS) + "'>MQTT Password<em>*</em></label>";
-  html += "<input id='" + String(MQTT_PASS) + "' type='text' name='" + String(MQTT_PASS) + "' value='" + getMqttPass() + "' required>";
-  html += "</div>";
-  html += "</div>";
-  html += "<h4>MQTT client & topic<br>configuration</h4>";
-  html += "<p>Personalize MQTT settings for SMAF by defining client specifics and choosing an optimal topic. Seamless communication is just a click away.</p>";
-  html += "<div class=\"frame\">";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_CLIENT_ID) + "'>MQTT Client ID<em>*</em></label>";
-  html += "<input id='" + String(MQTT_CLIENT_ID) + "' type='text' name='" + String(MQTT_CLIENT_ID) + "' value='" + getMqttClientId() + "' required>";
-  html += "</div>";
-  html += "<div class=\"input-frame\">";
-  html += "<label for='" + String(MQTT_TOPIC) + "'>MQTT Topic<em>*</em></label>";
-  html += "<input id='" + String(MQTT_TOPIC) + "' type='text' name='" + String(MQTT_TOPIC) + "' value='" + getMqttTopic() + "' required>";
-  html += "</div>";
-  html += "</div>";
-  html += "<h4>Audio/Visual<br>notifications</h4>";
-  html += "<p>Your device is equipped with a buzzer and two RGB LEDs to show various statuses of connection. You can enable or disable those if you are irritated by the power of the LEDs or the sound of the buzzer.</p>";
-  html += "<div class=\"frame\">";
-  html += "<div class=\"checkbox-frame\">";
-  html += "<label for='" + String(AUDIO_NOTIFICATIONS) + "'>Enable audio notifications</label>";
-  html += "<label class=\"switch\">";
-  html += "<input id='" + String(AUDIO_NOTIFICATIONS) + "' type=\"checkbox\" name='" + String(AUDIO_NOTIFICATIONS) + "' value=\"true\"" + (getAudioNotificationsStatus() ? "Checked" : "") + ">";
-  html += "<div class=\"track\">";
-  html += "<div class=\"thumb\"></div>";
-  html += "</div>";
-  html += "</label>";
-  html += "</div>";
-  html += "<div class=\"checkbox-frame\">";
-  html += "<label for='" + String(VISUAL_NOTIFICATIONS) + "'>Enable visual notifications</label>";
-  html += "<label class=\"switch\">";
-  html += "<input id='" + String(VISUAL_NOTIFICATIONS) + "' type=\"checkbox\" name='" + String(VISUAL_NOTIFICATIONS) + "' value=\"true\"" + (getVisualNotificationsStatus() ? "Checked" : "") + ">";
-  html += "<div class=\"track\">";
-  html += "<div class=\"thumb\"></div>";
-  html += "</div>";
-  html += "</label>";
-  html += "</div>";
-  html += "</div>";
-  html += "<h4>Finish<br>configuration</h4>";
-  html += "<p>Ready to roll? Click \"Upload Configuration\" to apply changes, and SMAF will initiate its own reset to seamlessly implement the updated settings.</p>";
-  html += "<section class='info'>";
-  html += "<p>Note: Ensure all necessary data is entered correctly; SMAF won't connect or transmit data if something with the data is wrong.</p>";
-  html += "</section>";
-  html += "<div class=\"horizontal-frame\">";
-  html += "<input type=\"reset\" value=\"Reset form\">";
-  html += "<input type=\"submit\" value=\"Upload configuration\">";
-  html += "</div>";
-  html += "</form>";
-  html += "</body>";
-  html += "</html>";
-
-  // Send the response to the client.
-  client.println("HTTP/1.1 200 OK");
-  client.println("Content-Type: text/html");
-  client.println("Connection: close");
-  client.println();
-  client.println(html);
-
-
-  // Check if the request is a form submission and save preferences.
-  if (request.indexOf("/configuration") != -1) {
-    // Show debug message.
-    debug(CMD, "Saving preferences to '%s' namespace.", _preferencesNamespace);
-
-    // Save preferences.
-    saveString(NETWORK_NAME, parseFieldValue(request, NETWORK_NAME));
-    saveString(NETWORK_PASS, parseFieldValue(request, NETWORK_PASS));
-    saveString(MQTT_SERVER_ADDRESS, parseFieldValue(request, MQTT_SERVER_ADDRESS));
-    saveInt(MQTT_SERVER_PORT, stringToUint16(parseFieldValue(request, MQTT_SERVER_PORT)));
-    saveString(MQTT_USERNAME, parseFieldValue(request, MQTT_USERNAME));
-    saveString(MQTT_PASS, parseFieldValue(request, MQTT_PASS));
-    saveString(MQTT_CLIENT_ID, parseFieldValue(request, MQTT_CLIENT_ID));
-    saveString(MQTT_TOPIC, parseFieldValue(request, MQTT_TOPIC));
-
-    if (parseFieldValue(request, AUDIO_NOTIFICATIONS).isEmpty()) {
-      saveBool(AUDIO_NOTIFICATIONS, false);
-    } else {
-      saveBool(AUDIO_NOTIFICATIONS, true);
-    }
+  switch (field.type) {
+    case CONFIG_TYPE_STRING: {
+      size_t length = strlen(string);
 
-    if (parseFieldValue(request, VISUAL_NOTIFICATIONS).isEmpty()) {
-      saveBool(VISUAL_NOTIFICATIONS, false);
-    } else {
-      saveBool(VISUAL_NOTIFICATIONS, true);
+      if (length == 0) {
+        return field.isRequired ? "Must not be empty." : nullptr;
+      }
+
+      if (length > field.maximum) {
+        return "Is too long.";
+      }
+
+      if (length < field.minimum) {
+        snprintf(message, size, field.isRequired ? "Must have at least %u characters." : "Must be empty or have at least %u characters.", field.minimum);
+        return message;
+      }
+
+      return nullptr;
     }
 
-    // Show debug message.
-    debug(SCS, "Saving preferences to '%s' namespace done.", _preferencesNamespace);
-    debug(CMD, "Restarting device to apply preferences.");
+    case CONFIG_TYPE_NUMBER:
+      if (number < field.minimum || number > field.maximum) {
+        snprintf(message, size, "Must be between %u and %u.", field.minimum, field.maximum);
+        return message;
+      }
+
+      return nullptr;
 
-    // Short delay before restart.
-    delay(2400);
+    case CONFIG_TYPE_BOOLEAN:
+      return nullptr;
+  }
 
-    // Uncomment the following line if a device restart is desired after saving preferences.
-    ESP.restart();
+  return nullptr;
+}
+
+/**
+* @brief Validate one field of the submitted configuration page.
+*
+* @param setting Index of the setting in the schema.
+* @param value The decoded value of the field, empty if it was not submitted.
+* @param saved The saved values, an empty secret field keeps the saved secret.
+* @param cleared The comma-separated keys of the secrets to clear instead.
+* @param message Buffer for error messages that include the bounds of the setting.
+* @param size Size of the message buffer.
+* @return An error message for the field, or nullptr if it is valid.
+*/
+const char* WiFiConfig::validateFormField(size_t setting, const char* value, ConfigurationValues& saved, const char* cleared, char* message, size_t size) {
+  const ConfigurationField& field = CONFIGURATION_SCHEMA[setting];
+  uint16_t number = 0;
+
+  switch (field.type) {
+    case CONFIG_TYPE_STRING:
+      if (isKeptSecret(field, value, (const char*)settingData(saved, setting), cleared)) {
+        return nullptr;
+      }
+
+      return validateSetting(setting, value, 0, message, size);
+
+    case CONFIG_TYPE_NUMBER:
+      if (!parseFormNumber(value, number)) {
+        return "Must be a number.";
+      }
+
+      return validateSetting(setting, nullptr, number, message, size);
+
+    case CONFIG_TYPE_BOOLEAN:
+      return nullptr;
   }
+
+  return nullptr;
 }
 
 /**
@@ -334,62 +1430,37 @@ bool WiFiConfig::loadPreferences() {
   // Show debug message.
   debug(CMD, "Loading preferences from '%s' namespace.", _preferencesNamespace);
 
-  // Load all preferences to variables.
-  static const char* networkName = getNetworkName();
-  static const char* networkPass = getNetworkPass();
-  static const char* mqttServerAddress = getMqttServerAddress();
-  static const char* mqttUsername = getMqttUsername();
-  static const char* mqttPass = getMqttPass();
-  static const char* mqttClientId = getMqttClientId();
-  static const char* mqttTopic = getMqttTopic();
-  static uint16_t mqttServerPort = getMqttServerPort();
-  static bool audioNotifications = getAudioNotificationsStatus();
-  static bool visualNotifications = getVisualNotificationsStatus();
-
-  // Log preferences information to console.
-  debug(LOG, "Network Name: '%s'.", networkName);
-  debug(LOG, "Network Password: '%s'.", networkPass);
-  debug(LOG, "MQTT Server address: '%s'.", mqttServerAddress);
-  debug(LOG, "MQTT Server port: '%d'.", mqttServerPort);
-  debug(LOG, "MQTT Username: '%s'.", mqttUsername);
-  debug(LOG, "MQTT Password: '%s'.", mqttPass);
-  debug(LOG, "MQTT Client ID: '%s'.", mqttClientId);
-  debug(LOG, "MQTT Topic: '%s'.", mqttTopic);
-  debug(LOG, "Audio notifications %s.", audioNotifications ? "enabled" : "disabled");
-  debug(LOG, "Visual notifications %s.", visualNotifications ? "enabled" : "disabled");
-
-  bool isDataValid = true;
-
-  if (isEmpty(networkName) || networkName == "Unknown") {
-    isDataValid = false;
+  // Make sure the cache holds the current values.
+  if (!_isLoaded) {
+    reloadPreferences();
   }
 
-  if (isEmpty(networkPass) || networkPass == "Unknown") {
-    isDataValid = false;
-  }
+  bool isDataValid = true;
+  char message[48];
 
-  if (isEmpty(mqttServerAddress) || mqttServerAddress == "Unknown") {
-    isDataValid = false;
-  }
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    const ConfigurationField& field = CONFIGURATION_SCHEMA[i];
+    const char* error;
 
-  if (isEmpty(mqttUsername) || mqttUsername == "Unknown") {
-    isDataValid = false;
-  }
+    // Log preferences information to console, without the secrets.
+    if (field.type == CONFIG_TYPE_STRING) {
+      const char* value = (const char*)settingData(_cache, i);
 
-  if (isEmpty(mqttPass) || mqttPass == "Unknown") {
-    isDataValid = false;
-  }
+      debug(LOG, "%s: '%s'.", field.key, field.isSecret && !isEmpty(value) ? "********" : value);
 
-  if (isEmpty(mqttClientId) || mqttClientId == "Unknown") {
-    isDataValid = false;
-  }
+      // Strings that were never saved are not sufficient to connect, unless empty by default.
+      error = *field.defaultString != '\0' && strcmp(value, field.defaultString) == 0 ? "Is not set." : validateSetting(i, value, 0, message, sizeof(message));
+    } else {
+      uint16_t number = settingNumber(_cache, i);
 
-  if (isEmpty(mqttTopic) || mqttTopic == "Unknown") {
-    isDataValid = false;
-  }
+      debug(LOG, "%s: '%u'.", field.key, number);
+      error = validateSetting(i, nullptr, number, message, sizeof(message));
+    }
 
-  if (mqttServerPort == 0) {
-    isDataValid = false;
+    if (error != nullptr) {
+      debug(ERR, "%s: %s", field.key, error);
+      isDataValid = false;
+    }
   }
 
   // Show debug message.
@@ -429,98 +1500,112 @@ void WiFiConfig::clearPreferences() {
 * @brief Get the configured Wi-Fi network name.
 * 
 * @return const char* representing the Wi-Fi network name.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the Wi-Fi network name.
+* @note The returned pointer stays valid, reloadPreferences() updates the Wi-Fi network name in place.
 */
 const char* WiFiConfig::getNetworkName() {
-  static String data = loadString(NETWORK_NAME);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(NETWORK_NAME));
 }
 
 /**
 * @brief Get the configured Wi-Fi network password.
 * 
 * @return const char* representing the Wi-Fi network password.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the Wi-Fi network password.
+* @note The returned pointer stays valid, reloadPreferences() updates the Wi-Fi network password in place.
 */
 const char* WiFiConfig::getNetworkPass() {
-  static String data = loadString(NETWORK_PASS);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(NETWORK_PASS));
 }
 
 /**
 * @brief Get the configured MQTT server address.
 * 
 * @return const char* representing the MQTT server address.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the MQTT server address.
+* @note The returned pointer stays valid, reloadPreferences() updates the MQTT server address in place.
 */
 const char* WiFiConfig::getMqttServerAddress() {
-  static String data = loadString(MQTT_SERVER_ADDRESS);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(MQTT_SERVER_ADDRESS));
 }
 
 /**
 * @brief Get the configured MQTT username.
 * 
 * @return const char* representing the MQTT username.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the MQTT username.
+* @note The returned pointer stays valid, reloadPreferences() updates the MQTT username in place.
 */
 const char* WiFiConfig::getMqttUsername() {
-  static String data = loadString(MQTT_USERNAME);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(MQTT_USERNAME));
 }
 
 /**
 * @brief Get the configured MQTT password.
 * 
 * @return const char* representing the MQTT password.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the MQTT password.
+* @note The returned pointer stays valid, reloadPreferences() updates the MQTT password in place.
 */
 const char* WiFiConfig::getMqttPass() {
-  static String data = loadString(MQTT_PASS);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(MQTT_PASS));
 }
 
 /**
 * @brief Get the configured MQTT client ID.
 * 
 * @return const char* representing the MQTT client ID.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the MQTT client ID.
+* @note The returned pointer stays valid, reloadPreferences() updates the MQTT client ID in place.
 */
 const char* WiFiConfig::getMqttClientId() {
-  static String data = loadString(MQTT_CLIENT_ID);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(MQTT_CLIENT_ID));
 }
 
 /**
 * @brief Get the configured MQTT topic.
 * 
 * @return const char* representing the MQTT topic.
-*         If empty, returns "NULL".
+*         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
 * 
-* @note The returned pointer is valid until the class instance is destroyed,
-*       or until the next call to a function that modifies the MQTT topic.
+* @note The returned pointer stays valid, reloadPreferences() updates the MQTT topic in place.
 */
 const char* WiFiConfig::getMqttTopic() {
-  static String data = loadString(MQTT_TOPIC);
-  return data.c_str();
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return (const char*)settingData(_cache, settingIndex(MQTT_TOPIC));
 }
 
 /**
@@ -529,11 +1614,14 @@ const char* WiFiConfig::getMqttTopic() {
 * @return bool representing the status of audio notifications.
 *         Returns true if audio notifications are enabled, false otherwise.
 * 
-* @note The returned value is cached after the first call and remains the same for subsequent calls.
+* @note The value is loaded on the first call and updated by reloadPreferences().
 */
 bool WiFiConfig::getAudioNotificationsStatus() {
-  static bool data = loadBool(AUDIO_NOTIFICATIONS);
-  return data;
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return settingNumber(_cache, settingIndex(AUDIO_NOTIFICATIONS)) != 0;
 }
 
 /**
@@ -542,11 +1630,30 @@ bool WiFiConfig::getAudioNotificationsStatus() {
 * @return bool representing the status of visual notifications.
 *         Returns true if visual notifications are enabled, false otherwise.
 * 
-* @note The returned value is cached after the first call and remains the same for subsequent calls.
+* @note The value is loaded on the first call and updated by reloadPreferences().
 */
 bool WiFiConfig::getVisualNotificationsStatus() {
-  static bool data = loadBool(VISUAL_NOTIFICATIONS);
-  return data;
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return settingNumber(_cache, settingIndex(VISUAL_NOTIFICATIONS)) != 0;
+}
+
+/**
+* @brief Get the status of the configuration import over MQTT.
+* 
+* @return bool representing the status of the configuration import.
+*         Returns true if configurations published on the configuration topic are imported, false otherwise.
+* 
+* @note The value is loaded on the first call and updated by reloadPreferences().
+*/
+bool WiFiConfig::getMqttImportStatus() {
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return settingNumber(_cache, settingIndex(MQTT_IMPORT)) != 0;
 }
 
 /**
@@ -555,11 +1662,14 @@ bool WiFiConfig::getVisualNotificationsStatus() {
 * @return uint16_t representing the MQTT server port.
 *         If not configured, returns a default value.
 * 
-* @note The returned value is cached after the first call and remains the same for subsequent calls.
+* @note The value is loaded on the first call and updated by reloadPreferences().
 */
 uint16_t WiFiConfig::getMqttServerPort() {
-  static uint16_t data = loadInt(MQTT_SERVER_PORT);
-  return data;
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
+
+  return settingNumber(_cache, settingIndex(MQTT_SERVER_PORT));
 }
 
 /**
@@ -647,414 +1757,419 @@ uint16_t WiFiConfig::getConfigServerPort() {
 }
 
 /**
-* @brief Scan for available Wi-Fi networks and return them in HTML option format.
+* @brief Render the cached list of available Wi-Fi networks as JSON.
 * 
-* @return String containing the HTML option elements for each available network.
-*         If no networks are found, an empty string is returned.
+* Sends the networks from the last background scan, sorted by signal strength,
+* together with the scan state and the age of the results. The configuration page
+* polls this endpoint while a scan is running.
 * 
-* @note The function scans for Wi-Fi networks, formats them as HTML option elements,
-*       and returns the resulting string. It also frees memory used for the scan results
-*       after processing.
+* @param response The response writer to send the JSON with.
 */
-String WiFiConfig::scanNetworks() {
-  int networksFound = WiFi.scanNetworks();
-  String networks = String();
-
-  if (networksFound != 0) {
-    for (int i = 0; i < networksFound; ++i) {
-      String network = String(WiFi.SSID(i).c_str());
-      networks += "<option value=\"" + network + "\">" + network + "</option>";
+void WiFiConfig::renderNetworks(HttpResponseWriter& response) {
+  // Scan results change while the page polls, so they must not be cached.
+  response.addHeader("Cache-Control", "no-store");
+  response.begin(200, "application/json");
+
+  response.beginJsonObject();
+  response.printJsonField("scanning", _networkScanner.isScanning());
+  response.printJsonField("age", _networkScanner.age());
+  response.printJsonKey("networks");
+  response.print("[");
+
+  for (uint8_t i = 0; i < _networkScanner.count(); ++i) {
+    if (i > 0) {
+      response.print(",");
     }
 
-    // delay(10);
+    response.beginJsonObject();
+    response.printJsonField("ssid", _networkScanner.ssid(i));
+    response.printJsonField("rssi", _networkScanner.rssi(i));
+    response.endJsonObject();
   }
 
-  // Delete the scan result to free memory for code below.
-  WiFi.scanDelete();
+  response.print("]");
+  response.endJsonObject();
 
-  return networks;
+  response.end();
 }
 
 /**
-* @brief Load a string value from the preferences storage.
-* 
-* @param key The key associated with the string value to be loaded.
-* 
-* @return String containing the value associated with the specified key.
-*         If the key does not exist, "Unknown" is stored and returned.
-*         If the loading fails, a default value is returned.
-* 
-* @note The function initializes a Preferences instance with the specified namespace,
-*       checks if the key exists, stores a default value if it does not, loads the value,
-*       and ends the preferences session. If loading fails, an error message is logged
-*       and a default value is returned.
+* @brief Render the preferences storage statistics as JSON.
+*
+* Sends the saves over the device lifetime, the flash writes of every record slot
+* and the skipped saves since startup, and the free entries of the storage.
+*
+* @param response The response writer to send the JSON with.
 */
-String WiFiConfig::loadString(const char* key) {
-  // Create a Preferences instance with the specified namespace.
+void WiFiConfig::renderStorageStatistics(HttpResponseWriter& response) {
   Preferences preferences;
-  static String data;
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Check if key exists and store default value if FALSE.
-    if (!preferences.isKey(key)) {
-      preferences.putString(key, "Unknown");
-    }
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
 
-    // Load value from key.
-    data = preferences.getString(key);
+  // Reading the free entries never writes, unlike opening a missing namespace for writing.
+  size_t freeEntries = preferences.begin(_preferencesNamespace, READ_ONLY_MODE) ? preferences.freeEntries() : 0;
+  preferences.end();
 
-    // End preferences session.
-    preferences.end();
-  } else {
-    // Return a default value if loading fails
-    debug(ERR, "Loading '%s' key from '%s' namespace failed. Will use default value.", key, _preferencesNamespace);
+  if (!_isLoaded) {
+    reloadPreferences();
   }
 
-  return data.c_str();
+  // Copy the counters, so the lock is not held while the client receives them.
+  uint32_t saves = _recordSequence;
+  uint32_t writes[] = { _recordWrites[0], _recordWrites[1] };
+  uint32_t legacyRemovals = _legacyRemovals;
+  uint32_t skipped = _skippedWrites;
+
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  response.addHeader("Cache-Control", "no-store");
+  response.begin(200, "application/json");
+
+  response.beginJsonObject();
+  response.printJsonField("saves", (int32_t)saves);
+  response.printJsonKey("writes");
+  response.beginJsonObject();
+  response.printJsonField(CONFIG_RECORD_SLOT_ODD, (int32_t)writes[0]);
+  response.printJsonField(CONFIG_RECORD_SLOT_EVEN, (int32_t)writes[1]);
+  response.endJsonObject();
+  response.printJsonField("legacyRemovals", (int32_t)legacyRemovals);
+  response.printJsonField("skipped", (int32_t)skipped);
+  response.printJsonField("freeEntries", (int32_t)freeEntries);
+  response.endJsonObject();
+
+  response.end();
 }
 
 /**
-* @brief Save a string value to the specified key in the preferences namespace.
-* 
-* @param key The key to which the string value will be saved.
-* @param value The string value to save.
-* 
-* @note This function creates a Preferences instance, attempts to save the value associated 
-*       with the given key, and ensures the Preferences session is properly ended. If saving 
-*       fails, an error message is logged.
+* @brief Upload a firmware image and make it bootable.
+*
+* The request body is the firmware image, streamed from the client into the inactive
+* app partition in fixed-size chunks without buffering the image. The expected SHA-256
+* hash is sent in the CONFIG_FIRMWARE_HASH_HEADER header. On success the device
+* restarts into the new firmware after CONFIG_APPLY_DELAY.
+*
+* @param connection The connection with the request headers and the start of the image.
+* @param response The response writer to send the result with.
 */
-void WiFiConfig::saveString(const char* key, String value) {
-  // Create a Preferences instance with the specified namespace.
-  Preferences preferences;
+void WiFiConfig::uploadFirmware(HttpConnection& connection, HttpResponseWriter& response) {
+  HttpRequestParser& request = connection.request();
+  HttpView received = request.body();
+  FirmwareUpdate update(_firmwareWriter);
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Save the value to the specified key.
-    preferences.putString(key, value);
+  debug(CMD, "Receiving firmware of %u bytes.", (unsigned)request.contentLength());
 
-    // End preferences session.
-    preferences.end();
+  // The start of the image arrived with the headers, the rest is read from the client.
+  bool isUpdated = update.begin(request.contentLength(), request.header(CONFIG_FIRMWARE_HASH_HEADER).data)
+                   && update.write((const uint8_t*)received.data, received.length)
+                   && update.writeFrom(connection.client())
+                   && update.finish();
 
-    // Show success message.
-    debug(SCS, "Data saved to '%s' key in '%s' namespace.", key, _preferencesNamespace);
-  } else {
-    // Log an error message if saving fails.
-    debug(ERR, "Saving data to '%s' key in '%s' namespace failed.", key, _preferencesNamespace);
-  }
+  renderFirmwareResult(response, update, isUpdated);
 }
 
 /**
-* @brief Load an integer value from the specified key in the preferences namespace.
-* 
-* @param key The key for the integer value to load.
-* 
-* @return uint16_t containing the value associated with the key.
-*         If the key does not exist, initializes it with a default value of 0 and returns 0.
-*         If loading fails, returns 0.
-* 
-* @note This function creates a Preferences instance, attempts to load the value associated 
-*       with the given key, and ensures the Preferences session is properly ended. If the key 
-*       does not exist, it initializes the key with a default value of 0.
+* @brief Download a firmware image from an HTTP server and make it bootable.
+*
+* The request body is a JSON object with the "url" of the image, e.g. on a local
+* HTTP server, and its expected "sha256" hash. Only URLs on the FIRMWARE_HOST server
+* are downloaded. The image is streamed into the inactive app partition like an
+* upload. On success the device restarts into the new firmware after CONFIG_APPLY_DELAY.
+*
+* @param request The parsed request.
+* @param response The response writer to send the result with.
 */
-uint16_t WiFiConfig::loadInt(const char* key) {
-  // Create a Preferences instance with the specified namespace.
-  Preferences preferences;
-  static int data;
+void WiFiConfig::pullFirmware(HttpRequestParser& request, HttpResponseWriter& response) {
+  // The body views the connection's writable buffer, where strings are unescaped in place.
+  HttpView body = request.body();
+  JsonObjectParser source;
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Check if key exists and store default value if FALSE.
-    if (preferences.isKey(key) == false) {
-      preferences.putInt(key, 0);
-    }
+  int8_t url = -1;
+  int8_t sha256 = -1;
 
-    // Load value from key.
-    data = preferences.getInt(key);
+  if (source.parse(const_cast<char*>(body.data), body.length)) {
+    url = source.indexOf("url");
+    sha256 = source.indexOf("sha256");
+  }
 
-    // End preferences session.
-    preferences.end();
-  } else {
-    // Log an error message and return a default value if loading fails.
-    debug(ERR, "Loading '%s' key from '%s' namespace failed. Will use default value.", key, _preferencesNamespace);
-    data = 0;
+  if (url < 0 || sha256 < 0 || source.type(url) != JSON_STRING || source.type(sha256) != JSON_STRING) {
+    response.begin(400, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", "Request body must be a JSON object with \"url\" and \"sha256\" strings.");
+    response.endJsonObject();
+    response.end();
+    return;
   }
 
-  return data;
-}
+  char firmwareHost[CONFIGURATION_SCHEMA[FIRMWARE_HOST_SETTING].maximum + 1];
 
-/**
-* @brief Save an integer value to the specified key in the preferences namespace.
-* 
-* @param key The key to which the integer value will be saved.
-* @param value The integer value to save.
-* 
-* @note This function creates a Preferences instance, attempts to save the value associated 
-*       with the given key, and ensures the Preferences session is properly ended. If saving 
-*       fails, an error message is logged.
-*/
-void WiFiConfig::saveInt(const char* key, uint16_t value) {
-  // Create a Preferences instance with the specified namespace.
-  Preferences preferences;
+  xSemaphoreTakeRecursive(_preferencesLock, portMAX_DELAY);
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Save the value to the specified key.
-    preferences.putInt(key, value);
+  if (!_isLoaded) {
+    reloadPreferences();
+  }
 
-    // End preferences session.
-    preferences.end();
+  strlcpy(firmwareHost, (const char*)settingData(_cache, FIRMWARE_HOST_SETTING), sizeof(firmwareHost));
 
-    // Show success message.
-    debug(SCS, "Data saved to '%s' key in '%s' namespace.", key, _preferencesNamespace);
-  } else {
-    // Log an error message if saving fails.
-    debug(ERR, "Saving data to '%s' key in '%s' namespace failed.", key, _preferencesNamespace);
+  xSemaphoreGiveRecursive(_preferencesLock);
+
+  // The host ends at the port, path, query or fragment, so user information in front
+  // of another host never matches.
+  const char* address = source.string(url);
+  const char* host = strncasecmp(address, "http://", 7) == 0 ? address + 7 : strncasecmp(address, "https://", 8) == 0 ? address + 8 : nullptr;
+  size_t hostLength = host != nullptr ? strcspn(host, ":/?#") : 0;
+
+  if (*firmwareHost == '\0' || hostLength != strlen(firmwareHost) || strncasecmp(host, firmwareHost, hostLength) != 0) {
+    debug(ERR, "Firmware download from '%s' rejected.", address);
+
+    response.begin(403, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", *firmwareHost == '\0' ? "No firmware server is configured." : "Firmware is only downloaded from the firmware server.");
+    response.endJsonObject();
+    response.end();
+    return;
   }
-}
 
-/**
-* @brief Load a boolean value from the specified key in the preferences namespace.
-* 
-* @param key The key for the boolean value to load.
-* 
-* @return bool containing the value associated with the key.
-*         If the key does not exist, initializes it with a default value of true and returns true.
-*         If loading fails, returns false.
-* 
-* @note This function creates a Preferences instance, attempts to load the value associated 
-*       with the given key, and ensures the Preferences session is properly ended. If the key 
-*       does not exist, it initializes the key with a default value of true.
-*/
-bool WiFiConfig::loadBool(const char* key) {
-  // Create a Preferences instance with the specified namespace.
-  Preferences preferences;
-  static bool data;
+  debug(CMD, "Downloading firmware from '%s'.", address);
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Check if key exists and store default value if FALSE.
-    if (preferences.isKey(key) == false) {
-      preferences.putBool(key, true);
+  HTTPClient http;
+  http.setTimeout(FIRMWARE_READ_TIMEOUT);
+
+  int status = http.begin(source.string(url)) ? http.GET() : -1;
+  int size = status == HTTP_CODE_OK ? http.getSize() : -1;
+
+  if (status != HTTP_CODE_OK || size <= 0) {
+    http.end();
+
+    // Pass on why the download could not start.
+    char error[80];
+
+    if (status == HTTP_CODE_OK) {
+      snprintf(error, sizeof(error), "Firmware server did not send a Content-Length.");
+    } else if (status > 0) {
+      snprintf(error, sizeof(error), "Firmware server responded with status %d.", status);
+    } else {
+      snprintf(error, sizeof(error), "Firmware server is not reachable.");
     }
 
-    // Load value from key.
-    data = preferences.getBool(key);
+    debug(ERR, "%s", error);
 
-    // End preferences session.
-    preferences.end();
-  } else {
-    // Log an error message and return a default value if loading fails.
-    debug(ERR, "Loading '%s' key from '%s' namespace failed. Will use default value.", key, _preferencesNamespace);
-    data = false;
+    response.begin(502, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", error);
+    response.endJsonObject();
+    response.end();
+    return;
   }
 
-  return data;
+  FirmwareUpdate update(_firmwareWriter);
+
+  bool isUpdated = update.begin(size, source.string(sha256))
+                   && update.writeFrom(*http.getStreamPtr())
+                   && update.finish();
+
+  http.end();
+
+  renderFirmwareResult(response, update, isUpdated);
 }
 
 /**
-* @brief Save a boolean value to the specified key in the preferences namespace.
-* 
-* @param key The key to which the boolean value will be saved.
-* @param value The boolean value to save.
-* 
-* @note This function creates a Preferences instance, attempts to save the value associated 
-*       with the given key, and ensures the Preferences session is properly ended. If saving 
-*       fails, an error message is logged.
+* @brief Send the result of a firmware update as JSON.
+*
+* Schedules the restart into the new firmware if the update succeeded.
+*
+* @param response The response writer to send the result with.
+* @param update The finished or failed update.
+* @param isUpdated true if the update succeeded.
 */
-void WiFiConfig::saveBool(const char* key, bool value) {
-  // Create a Preferences instance with the specified namespace.
-  Preferences preferences;
+void WiFiConfig::renderFirmwareResult(HttpResponseWriter& response, FirmwareUpdate& update, bool isUpdated) {
+  if (!isUpdated) {
+    response.begin(400, "application/json");
+    response.beginJsonObject();
+    response.printJsonField("error", update.error() != nullptr ? update.error() : "Firmware update failed.");
+    response.endJsonObject();
+    response.end();
+    return;
+  }
 
-  if (preferences.begin(_preferencesNamespace, READ_WRITE_MODE)) {
-    // Save the value to the specified key.
-    preferences.putBool(key, value);
+  response.begin(200, "application/json");
+  response.beginJsonObject();
+  response.printJsonField("restart", true);
+  response.endJsonObject();
+  response.end();
 
-    // End preferences session.
-    preferences.end();
+  // Restart once the response is sent, the new firmware boots pending verification.
+  _firmwareUpdatedAt = millis();
+  _isFirmwareUpdated = true;
+}
 
-    // Show success message.
-    debug(SCS, "Data saved to '%s' key in '%s' namespace.", key, _preferencesNamespace);
-  } else {
-    // Log an error message if saving fails.
-    debug(ERR, "Saving data to '%s' key in '%s' namespace failed.", key, _preferencesNamespace);
+/**
+* @brief Load a string value from an open preferences session.
+*
+* @param preferences The open preferences session, may have failed to begin.
+* @param key The key of the string value to load.
+* @param value Buffer receiving the value.
+* @param size Size of the buffer, values that do not fit are truncated.
+* @param defaultValue The value loaded if the key does not exist, without storing it.
+*/
+void WiFiConfig::loadString(Preferences& preferences, const char* key, char* value, size_t size, const char* defaultValue) {
+  if (!preferences.isKey(key)) {
+    strlcpy(value, defaultValue, size);
+    return;
+  }
+
+  // Values stored before the limits existed may not fit, keep their start.
+  if (preferences.getString(key, value, size) == 0) {
+    strlcpy(value, preferences.getString(key).c_str(), size);
   }
 }
 
 /**
-* @brief Parse and extract the value of a field from a URL-encoded String.
+* @brief Load the latest configuration record.
 *
-* This function takes a URL-encoded String containing field-value pairs and
-* extracts the value associated with the specified field ID. The field ID should
-* be provided as a parameter. The extracted value is then URL-decoded and leading
-* and trailing spaces are removed. If the field is not found or the extracted value
-* is empty, an empty String is returned.
+* Reads both record slots and keeps the valid one with the higher sequence number.
+* Without a valid record, the preferences saved under their own keys by earlier
+* firmware are loaded, or the defaults if there are none.
 *
-* @param data The URL-encoded String containing field-value pairs.
-* @param fieldId The field ID for which to extract the value.
-* @return The extracted and decoded value of the specified field, or an empty String if not found.
-*
-* @see decodeResponse()
-* @see removeSpaces()
+* @param preferences The open preferences session, may have failed to begin.
+* @param record The record to load into.
 */
-String WiFiConfig::parseFieldValue(String data, String fieldId) {
-  // Find the index of the specified field ID in the data String.
-  int startIndex = data.indexOf(fieldId + "=");
-
-  // If the field ID is not found, return an empty String.
-  if (startIndex == -1) {
-    return String();
+void WiFiConfig::loadRecord(Preferences& preferences, ConfigurationRecord& record) {
+  ConfigurationRecord other;
+  bool isOddValid = readRecord(preferences, CONFIG_RECORD_SLOT_ODD, record);
+  bool isEvenValid = readRecord(preferences, CONFIG_RECORD_SLOT_EVEN, other);
+
+  // Compare the difference, so the order holds when the sequence number wraps.
+  if (isEvenValid && (!isOddValid || (int32_t)(other.sequence - record.sequence) > 0)) {
+    record = other;
+  } else if (!isOddValid) {
+    loadLegacyRecord(preferences, record);
   }
+}
 
-  // Adjust the startIndex to the position of the value after '='
-  startIndex += fieldId.length() + 1;
-  String value = String();
-
-  // Find the indices of the next ampersand (&) and " HTTP" in the data String.
-  int ampIndex = data.indexOf("&", startIndex);
-  int httpIndex = data.indexOf(" HTTP", startIndex);
-
-  // Determine the end index based on the minimum of ampIndex and httpIndex, or the end of the data String.
-  int endIndex = data.length();
+/**
+* @brief Read and verify one slot of the configuration record.
+*
+* @param preferences The open preferences session.
+* @param key The key of the record slot.
+* @param record The record to read into.
+* @return true if the slot holds a record of this version with a valid checksum.
+*/
+bool WiFiConfig::readRecord(Preferences& preferences, const char* key, ConfigurationRecord& record) {
+  if (!preferences.isKey(key) || preferences.getBytesLength(key) != sizeof(record)) {
+    return false;
+  }
 
-  if (ampIndex != -1 && (ampIndex < httpIndex || httpIndex == -1)) {
-    endIndex = ampIndex;
-  } else if (httpIndex != -1) {
-    endIndex = httpIndex;
+  if (preferences.getBytes(key, &record, sizeof(record)) != sizeof(record)) {
+    return false;
   }
 
-  // Extract the value substring based on the determined indices.
-  value = data.substring(startIndex, endIndex);
+  if (!isValidRecord(record)) {
+    debug(ERR, "Configuration record '%s' is not valid.", key);
+    return false;
+  }
 
-  // Return an empty String if the extracted value is empty, otherwise, URL-decode and remove spaces.
-  return value.isEmpty() ? String() : removeSpaces(decodeResponse(value));
+  return true;
 }
 
 /**
-* @brief Decode a URL-encoded String.
+* @brief Check the version, size and checksum of a configuration record.
 *
-* This function takes a URL-encoded String as input and decodes it, replacing
-* percent-encoded characters with their corresponding ASCII characters. It also
-* replaces the plus sign (+) with a space (' '). The decoded String is returned.
-*
-* @param input The URL-encoded String to decode.
-* @return The decoded String.
+* @param record The record.
+* @return true if the record has this version and a valid checksum.
 */
-String WiFiConfig::decodeResponse(String input) {
-  // Initialize an empty String to store the decoded result.
-  String decoded = String();
-
-  // Temporary variables to store hexadecimal characters during decoding.
-  char a, b;
-
-  // Iterate through the characters in the input String.
-  for (size_t i = 0; i < input.length(); i++) {
-    // If a percent sign (%) is encountered, extract the two hexadecimal characters
-    // following it, convert them to a byte, and append the corresponding ASCII character
-    // to the decoded String. Increment the loop index accordingly.
-    if (input[i] == '%') {
-      a = input[i + 1];
-      b = input[i + 2];
-
-      decoded += char(hexToByte(a) * 16 + hexToByte(b));
-
-      // Skip the next two characters since they have been processed.
-      i += 2;
-    }
-    // If a plus sign (+) is encountered, append a space to the decoded String.
-    else if (input[i] == '+') {
-      decoded += ' ';
-    }
-    // If neither percent sign nor plus sign is encountered, append the character
-    // unchanged to the decoded String.
-    else {
-      decoded += input[i];
-    }
-  }
-
-  // Return the final decoded String.
-  return decoded;
+bool WiFiConfig::isValidRecord(const ConfigurationRecord& record) {
+  return record.version == CONFIG_RECORD_VERSION && record.size == sizeof(record) && record.checksum == recordChecksum(record);
 }
 
 /**
-* @brief Remove spaces from a String.
+* @brief Load the preferences saved under their own keys by earlier firmware.
 *
-* This function takes a String as input and removes leading and trailing spaces.
-* If the input String has no spaces, it is returned unchanged. If the input String
-* has leading or trailing spaces, those spaces are removed, and the modified String
-* is returned.
-*
-* @param str The input String from which to remove spaces.
-* @return The modified String with leading and trailing spaces removed.
+* @param preferences The open preferences session, may have failed to begin.
+* @param record The record to load into, with sequence number 0.
 */
-String WiFiConfig::removeSpaces(String str) {
-  // Check if the input String has a length greater than 0.
-  if (str.length() > 0) {
-    // Iterate through the characters in the String.
-    for (size_t i = 0; i < str.length(); ++i) {
-      // If a non-space character is encountered, return the original String.
-      if (str[i] != ' ') {
-        return str;
-      }
+void WiFiConfig::loadLegacyRecord(Preferences& preferences, ConfigurationRecord& record) {
+  // Zero the padding and the unused part of every slot, they are part of the checksum.
+  memset(&record, 0, sizeof(record));
+  record.version = CONFIG_RECORD_VERSION;
+  record.size = sizeof(record);
+
+  for (size_t i = 0; i < CONFIGURATION_FIELD_COUNT; ++i) {
+    const ConfigurationField& field = CONFIGURATION_SCHEMA[i];
+
+    switch (field.type) {
+      case CONFIG_TYPE_STRING:
+        loadString(preferences, field.key, (char*)settingData(record.values, i), field.maximum + 1, field.defaultString);
+        break;
+
+      case CONFIG_TYPE_NUMBER:
+        setSettingNumber(record.values, i, preferences.getInt(field.key, field.defaultNumber));
+        break;
+
+      case CONFIG_TYPE_BOOLEAN:
+        setSettingNumber(record.values, i, preferences.getBool(field.key, field.defaultNumber != 0));
+        break;
     }
-
-    // If the entire String consists of spaces, return an empty String.
-    return String();
   }
-
-  // Return the original String if it has no length.
-  return str;
 }
 
 /**
-* @brief Convert a hexadecimal character to a byte.
-*
-* This function takes a single character and converts it to a byte based on its
-* hexadecimal representation. If the character is a digit ('0' to '9'), the
-* corresponding decimal value is returned. If the character is a lowercase
-* hexadecimal digit ('a' to 'f'), the corresponding decimal value (10 to 15) is
-* returned. If the character is an uppercase hexadecimal digit ('A' to 'F'),
-* the corresponding decimal value (10 to 15) is returned. If the input character
-* is not a valid hexadecimal digit, 0 is returned.
-*
-* @param c The hexadecimal character to convert.
-* @return The decimal value of the hexadecimal character or 0 if not a valid digit.
+* @brief Save a configuration record.
+*
+* Writes the record with the next sequence number into the slot that does not hold
+* the record it was loaded from, so a power loss while writing leaves the previous
+* record intact. Preferences migrated from their own keys are removed afterwards.
+* A record without changes is not written, saving flash wear. The written values are
+* served by renderConfigurationValues() until the caller applies them.
+*
+* @param preferences The preferences session opened for writing.
+* @param record The record to save, as loaded by loadRecord() and changed since.
+* @param loaded The values of the record as loaded.
+* @return true if the record was written or had no changes.
 */
-byte WiFiConfig::hexToByte(char c) {
-  // Check if the character is a digit ('0' to '9').
-  if ('0' <= c && c <= '9') {
-    return c - '0';
+bool WiFiConfig::saveRecord(Preferences& preferences, ConfigurationRecord& record, const ConfigurationValues& loaded) {
+  bool isMigrated = record.sequence == 0;
+
+  // Preferences of earlier firmware are always written, to migrate them.
+  if (!isMigrated && memcmp(&record.values, &loaded, sizeof(loaded)) == 0) {
+    _skippedWrites++;
+    debug(LOG, "Configuration did not change, skipped writing it.");
+    return true;
   }
 
-  // Check if the character is a lowercase hexadecimal digit ('a' to 'f').
-  if ('a' <= c && c <= 'f') {
-    return c - 'a' + 10;
+  record.sequence++;
+  record.checksum = recordChecksum(record);
+
+  uint8_t slot = record.sequence % 2 ? 0 : 1;
+  const char* key = slot == 0 ? CONFIG_RECORD_SLOT_ODD : CONFIG_RECORD_SLOT_EVEN;
+
+  if (preferences.putBytes(key, &record, sizeof(record)) != sizeof(record)) {
+    debug(ERR, "Saving configuration record '%s' failed.", key);
+    return false;
   }
 
-  // Check if the character is an uppercase hexadecimal digit ('A' to 'F').
-  if ('A' <= c && c <= 'F') {
-    return c - 'A' + 10;
+  _recordWrites[slot]++;
+  _recordSequence = record.sequence;
+  _saved = record.values;
+  debug(LOG, "Configuration record '%s' written, %lu saves in total.", key, (unsigned long)record.sequence);
+
+  // The record now holds the preferences of earlier firmware.
+  if (isMigrated) {
+    for (const char* legacyKey : ConfigurationTables::keys) {
+      if (preferences.isKey(legacyKey) && preferences.remove(legacyKey)) {
+        _legacyRemovals++;
+      }
+    }
   }
 
-  // Return 0 if the input character is not a valid hexadecimal digit.
-  return 0;
+  return true;
 }
 
 /**
-* @brief Convert a String to a uint16_t.
-*
-* This function converts the provided String to an integer and checks if it
-* falls within the valid range for a uint16_t (0 to 65535). If the value is
-* within the range, it is cast to uint16_t and returned; otherwise, 0 is returned.
+* @brief Calculate the checksum of a configuration record.
 *
-* @param str The String to convert to uint16_t.
-* @return The converted uint16_t value or 0 if the conversion is out of range.
+* @param record The record.
+* @return CRC-32 of all fields before the checksum.
 */
-uint16_t WiFiConfig::stringToUint16(String str) {
-  // Convert the String to an integer.
-  int intValue = str.toInt();
-
-  // Check if the converted value is within the valid range for uint16_t.
-  if (intValue >= 0 && intValue <= UINT16_MAX) {
-    // Cast the integer value to uint16_t and return it.
-    return static_cast<uint16_t>(intValue);
-  } else {
-    // Return 0 if the conversion is out of range.
-    return 0;
-  }
+uint32_t WiFiConfig::recordChecksum(const ConfigurationRecord& record) {
+  return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(ConfigurationRecord, checksum));
 }
\ No newline at end of file
@@ -37,27 +37,76 @@
 #include "Arduino.h"
 #include "WiFi.h"
 #include "WiFiServer.h"
+#include "DNSServer.h"
 #include "Preferences.h"
+#include "HttpConnection.h"
+#include "HttpResponseWriter.h"
+#include "JsonObjectParser.h"
+#include "NetworkScanner.h"
+#include "EventBroadcaster.h"
+#include "FirmwareUpdate.h"
+#include "OtaPartitionWriter.h"
+#include "ConfigurationSchema.h"
 #include "Helpers.h"
 
-// Define constant strings for Wi-Fi network configuration.
-#define NETWORK_NAME "netName"  // Wi-Fi network name.
-#define NETWORK_PASS "netPass"  // Wi-Fi network password.
+// Define the number of clients the configuration server serves at once.
+#define CONFIG_SERVER_MAX_CONNECTIONS 4
 
-// Define constant strings for MQTT configuration.
-#define MQTT_SERVER_ADDRESS "mqttSrvAdr"    // MQTT server address.
-#define MQTT_SERVER_PORT "mqttSrvPort"      // MQTT server port.
-#define MQTT_USERNAME "mqttUser"            // MQTT username.
-#define MQTT_PASS "mqttPass"                // MQTT password.
-#define MQTT_CLIENT_ID "mqttClient"         // MQTT client ID.
-#define MQTT_TOPIC "mqttTopic"              // MQTT topic.
-#define AUDIO_NOTIFICATIONS "audioNotif"    // Audio Notifications status.
-#define VISUAL_NOTIFICATIONS "visualNotif"  // Visual Notifications status.
+// Define the port of the captive portal DNS responder.
+#define CONFIG_DNS_PORT 53
+
+// Define the configuration server task settings for normal operation.
+#define CONFIG_SERVER_TASK_STACK_SIZE 8192    // Stack size of the task.
+#define CONFIG_SERVER_TASK_PRIORITY 1         // Lowest priority above the idle task.
+#define CONFIG_SERVER_TASK_INTERVAL 20        // Minimum pause between polls in milliseconds.
+#define CONFIG_SERVER_CPU_BUDGET 20           // Maximum share of CPU time in percent.
+#define CONFIG_SERVER_MAX_PAUSE 200           // Maximum pause between polls in milliseconds.
+#define CONFIG_SERVER_MIN_FREE_HEAP 40960     // Free heap in bytes below which new clients are rejected.
+
+// Define the paths and header of the firmware update endpoints.
+#define CONFIG_FIRMWARE_PATH "/api/firmware"             // Upload, the request body is the image.
+#define CONFIG_FIRMWARE_PULL_PATH "/api/firmware/pull"   // Download from a URL sent as JSON.
+#define CONFIG_FIRMWARE_HASH_HEADER "X-Firmware-SHA256"  // Expected SHA-256 hash of an uploaded image.
+
+// Define the path of the preferences storage statistics.
+#define CONFIG_STORAGE_PATH "/api/storage"
+
+// Define the path of the configuration import, a blob exported over the serial port sent with PUT.
+#define CONFIG_BLOB_PATH "/api/config/blob"
+
+// Define the configuration form field listing the secrets to clear, e.g. "netPass,mqttPass".
+// An empty secret field keeps the saved secret, so clearing one must be explicit.
+#define CONFIG_FORM_CLEAR_FIELD "clear"
+
+// Define the Basic authentication of the configuration server outside configuration mode.
+#define CONFIG_ADMIN_USER "admin"                                          // User name, the password is the ADMIN_PASS setting.
+#define CONFIG_AUTH_CHALLENGE "Basic realm=\"SMAF-DK\", charset=\"UTF-8\""  // WWW-Authenticate header of rejected requests.
+
+// Define the delay in milliseconds between saving the configuration and applying it.
+#define CONFIG_APPLY_DELAY 2400
 
 // Define read/write modes for preferences.
 #define READ_WRITE_MODE false
 #define READ_ONLY_MODE true
 
+// Define the keys of the two configuration record slots and the record layout version.
+// Saves alternate between the slots, so one always holds a complete record.
+#define CONFIG_RECORD_SLOT_ODD "cfgA"   // Slot of records with an odd sequence number.
+#define CONFIG_RECORD_SLOT_EVEN "cfgB"  // Slot of records with an even sequence number.
+#define CONFIG_RECORD_VERSION 1         // Increase when the layout of ConfigurationRecord changes.
+
+// Structure of all preferences as saved in one piece to non-volatile storage.
+struct ConfigurationRecord {
+  uint16_t version;            // CONFIG_RECORD_VERSION of the layout.
+  uint16_t size;               // Size of the record in bytes.
+  uint32_t sequence;           // Incremented on every save, the higher one is the latest.
+  ConfigurationValues values;  // Values of all settings, laid out by the schema.
+  uint32_t checksum;           // CRC-32 of all fields before.
+};
+
+// Define the size of an exported configuration, the base64 encoded record and the terminator.
+#define CONFIG_BLOB_SIZE (4 * ((sizeof(ConfigurationRecord) + 2) / 3) + 1)
+
 class WiFiConfig {
 public:
   /**
@@ -87,13 +136,96 @@ public:
   /**
   * @brief Render the configuration page for device setup.
   * 
-  * This function serves an HTML configuration page to the connected client.
-  * It processes the form submission and saves the configuration settings.
+  * This function polls the configuration server without blocking. It accepts new
+  * clients into a fixed pool of connections, reads their requests as data arrives
+  * and serves every complete request. Clients that do not send a complete request
+  * in time are closed, so several clients can be served at once.
   * 
-  * @note The HTML structure and styling are included for presentation purposes.
+  * @note Call this function repeatedly. The page is served pre-compressed from flash
+  *       (see WebAssets.h) and fills in its form fields from the JSON served at /values.
   */
   void renderConfigurationPage();
 
+  /**
+  * @brief Stop the Wi-Fi configuration process.
+  *
+  * Closes all configuration server connections, stops the captive portal DNS
+  * responder and the configuration server, and turns off the SoftAP.
+  */
+  void stopConfiguration();
+
+  /**
+  * @brief Serve the configuration page during normal operation.
+  *
+  * Starts a low-priority task that serves the configuration server on the station
+  * interface once the device is connected to the Wi-Fi network. The task sleeps
+  * between polls to stay within CONFIG_SERVER_CPU_BUDGET, and new clients are
+  * rejected while the free heap is below CONFIG_SERVER_MIN_FREE_HEAP. Saved
+  * preferences are applied by the caller, see hasPendingChanges().
+  *
+  * @param core The core the task runs on.
+  */
+  void startServerTask(BaseType_t core);
+
+  /**
+  * @brief Push an event to the browsers watching /events.
+  *
+  * The event is sent by the configuration server as a server-sent event, so this
+  * never waits for the network and may be called from another task.
+  *
+  * @param data The event data, a single line such as a JSON object.
+  */
+  void publishEvent(const char* data);
+
+  /**
+  * @brief Export the saved configuration to clone it to other devices.
+  *
+  * The blob is the base64 encoded configuration record with its version and checksum,
+  * including the passwords.
+  *
+  * @param blob Buffer receiving the null-terminated blob.
+  * @param size Size of the buffer, at least CONFIG_BLOB_SIZE.
+  * @return true if the blob was written.
+  */
+  bool exportConfiguration(char* blob, size_t size);
+
+  /**
+  * @brief Import a configuration exported by exportConfiguration().
+  *
+  * The blob is verified before anything is saved, and all settings are saved in one
+  * record write. Device specific settings, such as the MQTT client ID, keep the value
+  * of this device, so clones do not take over the identity of the original. If this
+  * device has none yet, the imported value is made unique with a suffix of its MAC
+  * address. The imported settings are applied like a submitted configuration page,
+  * see hasPendingChanges().
+  *
+  * @param blob The base64 encoded blob, trailing whitespace is ignored.
+  * @param length Length of the blob, it does not need to be null-terminated.
+  * @return nullptr if the configuration was imported, otherwise the reason it was not.
+  */
+  const char* importConfiguration(const char* blob, size_t length);
+
+  /**
+  * @brief Check if saved preferences are waiting to be applied.
+  *
+  * Saved preferences are reported only after CONFIG_APPLY_DELAY, so the confirmation
+  * page can load before the caller acts on them.
+  *
+  * @return true if preferences were saved and reloadPreferences() was not called since.
+  */
+  bool hasPendingChanges();
+
+  /**
+  * @brief Reload all preferences from non-volatile storage.
+  *
+  * All preferences are read in one read-only session into the preference cache.
+  * Strings are copied into their fixed slots of the arena, so pointers returned by
+  * the getters stay valid. Clears the pending changes.
+  *
+  * @return CONFIG_CHANGED_* flags for the preferences whose values changed.
+  */
+  uint8_t reloadPreferences();
+
   /**
   * @brief Load Wi-Fi and MQTT configuration preferences.
   *
@@ -116,10 +248,9 @@ public:
   * @brief Get the configured Wi-Fi network name.
   * 
   * @return const char* representing the Wi-Fi network name.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the Wi-Fi network name.
+  * @note The returned pointer stays valid, reloadPreferences() updates the Wi-Fi network name in place.
   */
   const char* getNetworkName();
 
@@ -127,10 +258,9 @@ public:
   * @brief Get the configured Wi-Fi network password.
   * 
   * @return const char* representing the Wi-Fi network password.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the Wi-Fi network password.
+  * @note The returned pointer stays valid, reloadPreferences() updates the Wi-Fi network password in place.
   */
   const char* getNetworkPass();
 
@@ -138,10 +268,9 @@ public:
   * @brief Get the configured MQTT server address.
   * 
   * @return const char* representing the MQTT server address.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the MQTT server address.
+  * @note The returned pointer stays valid, reloadPreferences() updates the MQTT server address in place.
   */
   const char* getMqttServerAddress();
 
@@ -149,10 +278,9 @@ public:
   * @brief Get the configured MQTT username.
   * 
   * @return const char* representing the MQTT username.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the MQTT username.
+  * @note The returned pointer stays valid, reloadPreferences() updates the MQTT username in place.
   */
   const char* getMqttUsername();
 
@@ -160,10 +288,9 @@ public:
   * @brief Get the configured MQTT password.
   * 
   * @return const char* representing the MQTT password.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the MQTT password.
+  * @note The returned pointer stays valid, reloadPreferences() updates the MQTT password in place.
   */
   const char* getMqttPass();
 
@@ -171,10 +298,9 @@ public:
   * @brief Get the configured MQTT client ID.
   * 
   * @return const char* representing the MQTT client ID.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the MQTT client ID.
+  * @note The returned pointer stays valid, reloadPreferences() updates the MQTT client ID in place.
   */
   const char* getMqttClientId();
 
@@ -182,10 +308,9 @@ public:
   * @brief Get the configured MQTT topic.
   * 
   * @return const char* representing the MQTT topic.
-  *         If empty, returns "NULL".
+  *         If never saved, returns CONFIG_UNSET_STRING ("Unknown"), if saved empty, "".
   * 
-  * @note The returned pointer is valid until the class instance is destroyed,
-  *       or until the next call to a function that modifies the MQTT topic.
+  * @note The returned pointer stays valid, reloadPreferences() updates the MQTT topic in place.
   */
   const char* getMqttTopic();
 
@@ -195,7 +320,7 @@ public:
   * @return bool representing the status of audio notifications.
   *         Returns true if audio notifications are enabled, false otherwise.
   * 
-  * @note The returned value is cached after the first call and remains the same for subsequent calls.
+  * @note The value is loaded on the first call and updated by reloadPreferences().
   */
   bool getAudioNotificationsStatus();
 
@@ -205,10 +330,20 @@ public:
   * @return bool representing the status of visual notifications.
   *         Returns true if visual notifications are enabled, false otherwise.
   * 
-  * @note The returned value is cached after the first call and remains the same for subsequent calls.
+  * @note The value is loaded on the first call and updated by reloadPreferences().
   */
   bool getVisualNotificationsStatus();
 
+  /**
+  * @brief Get the status of the configuration import over MQTT.
+  * 
+  * @return bool representing the status of the configuration import.
+  *         Returns true if configurations published on the configuration topic are imported, false otherwise.
+  * 
+  * @note The value is loaded on the first call and updated by reloadPreferences().
+  */
+  bool getMqttImportStatus();
+
   /**
   * @brief Get the MQTT server port.
   *
@@ -220,6 +355,52 @@ private:
   // Server instance for handling SoftAP configuration.
   WiFiServer _configServerInstance;
 
+  // Fixed pool of client connections for the configuration server.
+  HttpConnection _connections[CONFIG_SERVER_MAX_CONNECTIONS];
+
+  // Background Wi-Fi scanner with cached results for the configuration page.
+  NetworkScanner _networkScanner;
+
+  // Server-sent event subscribers of /events.
+  EventBroadcaster _events;
+
+  // Captive portal DNS responder, resolving every name to the SoftAP IP address.
+  DNSServer _dnsServer;
+
+  // Configuration server task for normal operation.
+  TaskHandle_t _serverTask = nullptr;
+  bool _isServerListening = false;
+
+  // Firmware update storage, and the time a successful update finished.
+  OtaPartitionWriter _firmwareWriter;
+  unsigned long _firmwareUpdatedAt = 0;
+  bool _isFirmwareUpdated = false;
+
+  // Guards the preferences shared by the configuration server task and the caller.
+  // Held only while they are read or saved, never while a request streams a firmware image.
+  SemaphoreHandle_t _preferencesLock;
+
+  // Flash writes of the preferences since startup, to track the wear of the storage.
+  uint32_t _recordWrites[2] = {};  // Writes of the odd and the even record slot.
+  uint32_t _legacyRemovals = 0;    // Preferences of earlier firmware removed after migrating them.
+  uint32_t _skippedWrites = 0;     // Saves without changes, not written.
+  uint32_t _recordSequence = 0;    // Sequence number of the latest record, the saves over the device lifetime.
+
+  // Captive portal address, e.g. "192.168.4.1" and "http://192.168.4.1/".
+  char _portalHost[24] = "";  // Expected Host header, with the port if it is not 80.
+  char _portalUrl[40] = "";   // Redirect target for requests to any other host.
+
+  // Saved preferences waiting to be applied.
+  unsigned long _savedAt = 0;       // Time the preferences were saved, in milliseconds.
+  bool _hasPendingChanges = false;  // True once preferences were saved, until they are reloaded.
+
+  // Preference values, loaded on first use and updated in place by reloadPreferences().
+  ConfigurationValues _cache = {};
+  bool _isLoaded = false;  // True once the preferences were loaded.
+
+  // Values of the latest record, ahead of the cache while saved changes wait to be applied.
+  ConfigurationValues _saved = {};
+
   // SoftAP SSID name, password, port and IP.
   const char* _configNetworkName;  // Name of the SoftAP (Access Point).
   const char* _configNetworkPass;  // Password for the SoftAP.
@@ -273,169 +454,320 @@ private:
   uint16_t getConfigServerPort();
 
   /**
-  * @brief Scan for available Wi-Fi networks and return them in HTML option format.
-  * 
-  * @return String containing the HTML option elements for each available network.
-  *         If no networks are found, an empty string is returned.
-  * 
-  * @note The function scans for Wi-Fi networks, formats them as HTML option elements,
-  *       and returns the resulting string. It also frees memory used for the scan results
-  *       after processing.
+  * @brief Handle a complete request on a configuration server connection.
+  *
+  * Routes the request to the matching endpoint and sends the response. Outside
+  * configuration mode, every request must be authorized with the admin password,
+  * and firmware updates need it in configuration mode as well. Requests that change
+  * the device are rejected if a browser sent them from another site. A form posted
+  * to /configuration saves the submitted settings to be applied by the caller.
+  *
+  * @param connection The connection with a complete request.
   */
-  String scanNetworks();
+  void handleRequest(HttpConnection& connection);
 
   /**
-  * @brief Load a string value from the preferences storage.
-  * 
-  * @param key The key associated with the string value to be loaded.
-  * 
-  * @return String containing the value associated with the specified key.
-  *         If the key does not exist, "Unknown" is stored and returned.
-  *         If the loading fails, a default value is returned.
-  * 
-  * @note The function initializes a Preferences instance with the specified namespace,
-  *       checks if the key exists, stores a default value if it does not, loads the value,
-  *       and ends the preferences session. If loading fails, an error message is logged
-  *       and a default value is returned.
+  * @brief Check the Basic authentication of a request outside configuration mode.
+  *
+  * In configuration mode, the SoftAP password already limits who can reach the
+  * server, so every request is authorized. Otherwise see authorizeAdmin().
+  *
+  * @param request The parsed request.
+  * @param response The response writer to send the rejection with.
+  * @return true if the request is authorized, otherwise 401 or 403 was sent.
   */
-  String loadString(const char* key);
+  bool authorize(HttpRequestParser& request, HttpResponseWriter& response);
 
   /**
-  * @brief Save a string value to the specified key in the preferences namespace.
-  * 
-  * @param key The key to which the string value will be saved.
-  * @param value The string value to save.
-  * 
-  * @note This function creates a Preferences instance, attempts to save the value associated 
-  *       with the given key, and ensures the Preferences session is properly ended. If saving 
-  *       fails, an error message is logged.
+  * @brief Check the Basic authentication of a request with the admin password.
+  *
+  * The request must carry the CONFIG_ADMIN_USER user and the ADMIN_PASS setting as
+  * password. Without an admin password, such requests are rejected.
+  *
+  * @param request The parsed request.
+  * @param response The response writer to send the rejection with.
+  * @return true if the request is authorized, otherwise 401 or 403 was sent.
   */
-  void saveString(const char* key, String value);
+  bool authorizeAdmin(HttpRequestParser& request, HttpResponseWriter& response);
 
   /**
-  * @brief Load an integer value from the specified key in the preferences namespace.
-  * 
-  * @param key The key for the integer value to load.
-  * 
-  * @return uint16_t containing the value associated with the key.
-  *         If the key does not exist, initializes it with a default value of 0 and returns 0.
-  *         If loading fails, returns 0.
-  * 
-  * @note This function creates a Preferences instance, attempts to load the value associated 
-  *       with the given key, and ensures the Preferences session is properly ended. If the key 
-  *       does not exist, it initializes the key with a default value of 0.
+  * @brief Check if a browser sent the request from the configuration page itself.
+  *
+  * Browsers send the Origin header with requests that may change data. A page of
+  * another site could otherwise make the browser of a signed in user submit the
+  * configuration form or the JSON API in their name.
+  *
+  * @param request The parsed request.
+  * @return true if the request has no Origin header, or the origin of this server.
   */
-  uint16_t loadInt(const char* key);
+  static bool isSameOrigin(HttpRequestParser& request);
 
   /**
-  * @brief Save an integer value to the specified key in the preferences namespace.
-  * 
-  * @param key The key to which the integer value will be saved.
-  * @param value The integer value to save.
-  * 
-  * @note This function creates a Preferences instance, attempts to save the value associated 
-  *       with the given key, and ensures the Preferences session is properly ended. If saving 
-  *       fails, an error message is logged.
+  * @brief Task function serving the configuration server in normal operation.
+  *
+  * Starts listening once the station interface is connected, then polls the
+  * configuration server and sleeps after every poll in proportion to the time
+  * spent, keeping the task within CONFIG_SERVER_CPU_BUDGET. The pause is capped at
+  * CONFIG_SERVER_MAX_PAUSE, so a long request such as a firmware upload does not
+  * leave the server unresponsive afterwards.
+  *
+  * @param parameter Pointer to the WiFiConfig instance.
   */
-  void saveInt(const char* key, uint16_t value);
+  static void serverTask(void* parameter);
 
   /**
-  * @brief Load a boolean value from the specified key in the preferences namespace.
-  * 
-  * @param key The key for the boolean value to load.
-  * 
-  * @return bool containing the value associated with the key.
-  *         If the key does not exist, initializes it with a default value of true and returns true.
-  *         If loading fails, returns false.
-  * 
-  * @note This function creates a Preferences instance, attempts to load the value associated 
-  *       with the given key, and ensures the Preferences session is properly ended. If the key 
-  *       does not exist, it initializes the key with a default value of true.
+  * @brief Redirect requests for other hosts to the configuration page.
+  *
+  * With every name resolving to the SoftAP, operating system captive portal probes
+  * such as /generate_204 or /hotspot-detect.html arrive here with their own Host
+  * header. Answering them with a redirect makes the device open the configuration
+  * page on its own after joining the SoftAP.
+  *
+  * @param request The parsed request.
+  * @param response The response writer to send the redirect with.
+  * @return true if the request was redirected.
+  */
+  bool redirectToPortal(HttpRequestParser& request, HttpResponseWriter& response);
+
+  /**
+  * @brief Serve a static asset stored pre-compressed in flash.
+  *
+  * The asset is sent as-is without building it in RAM, with a strong ETag so the
+  * browser can revalidate its cached copy. The ETag is generated together with the
+  * asset data, so nothing is hashed per request. If the copy is still current, only a
+  * 304 Not Modified response without a body is sent.
+  *
+  * @param request The parsed request.
+  * @param response The response writer to send the asset with.
+  * @param contentType The value of the Content-Type header.
+  * @param data The gzip compressed asset.
+  * @param length Length of the compressed asset in bytes.
+  * @param etag The quoted ETag generated with the asset.
   */
-  bool loadBool(const char* key);
+  void serveAsset(HttpRequestParser& request, HttpResponseWriter& response, const char* contentType, const uint8_t* data, size_t length, const char* etag);
 
   /**
-  * @brief Save a boolean value to the specified key in the preferences namespace.
+  * @brief Render the current configuration values as JSON.
+  *
+  * Sends all configuration values to the client, with null for the secret ones, so
+  * passwords never leave the device. The configuration page fetches this endpoint to
+  * fill in its form fields. The values are the saved ones, even before they are applied.
+  *
+  * @param response The response writer to send the JSON with.
+  */
+  void renderConfigurationValues(HttpResponseWriter& response);
+
+  /**
+  * @brief Render the configuration schema as JSON.
+  *
+  * Sends the key, type, label, page section, bounds and flags of every setting.
+  * The configuration page fetches this endpoint to build its form fields.
+  *
+  * @param response The response writer to send the JSON with.
+  */
+  void renderConfigurationSchema(HttpResponseWriter& response);
+
+  /**
+  * @brief Update the configuration from a JSON object.
+  *
+  * Parses the request body in place and validates every field before saving any,
+  * so a rejected update changes nothing. Fields missing from the object keep their
+  * values. Responds with the effective configuration, or with 400 and an error
+  * message for every invalid field.
+  *
+  * @param request The parsed request with the JSON body.
+  * @param response The response writer to send the result with.
+  */
+  void updateConfiguration(HttpRequestParser& request, HttpResponseWriter& response);
+
+  /**
+  * @brief Save the settings of the submitted configuration page.
+  *
+  * Decodes the URL-encoded form in the request body in place, validates every field
+  * and saves all settings in one record write. Secrets are never sent to the page, so
+  * an empty secret field keeps the saved secret, unless the secret is listed in the
+  * CONFIG_FORM_CLEAR_FIELD field. Responds with the configuration page, or with 400
+  * and an error message for every invalid field, and nothing saved.
+  *
+  * @param request The parsed request with the form as body.
+  * @param response The response writer to send the result with.
+  */
+  void saveConfigurationForm(HttpRequestParser& request, HttpResponseWriter& response);
+
+  /**
+  * @brief Import an exported configuration sent in the request body.
+  *
+  * @param request The parsed request with the blob as body.
+  * @param response The response writer to send the result with.
+  */
+  void importConfigurationBlob(HttpRequestParser& request, HttpResponseWriter& response);
+
+  /**
+  * @brief Validate one field of a configuration update.
+  *
+  * @param update The parsed configuration update.
+  * @param index Index of the field in the update.
+  * @param message Buffer for error messages that include the bounds of the setting.
+  * @param size Size of the message buffer.
+  * @return An error message for the field, or nullptr if it is valid.
+  */
+  const char* validateConfigurationField(JsonObjectParser& update, uint8_t index, char* message, size_t size);
+
+  /**
+  * @brief Validate a value against the bounds of its setting.
+  *
+  * @param setting Index of the setting in the schema.
+  * @param string The value of a string setting.
+  * @param number The value of a number setting.
+  * @param message Buffer for error messages that include the bounds of the setting.
+  * @param size Size of the message buffer.
+  * @return An error message for the value, or nullptr if it is valid.
+  */
+  static const char* validateSetting(size_t setting, const char* string, int32_t number, char* message, size_t size);
+
+  /**
+  * @brief Validate one field of the submitted configuration page.
+  *
+  * @param setting Index of the setting in the schema.
+  * @param value The decoded value of the field, empty if it was not submitted.
+  * @param saved The saved values, an empty secret field keeps the saved secret.
+  * @param cleared The comma-separated keys of the secrets to clear instead.
+  * @param message Buffer for error messages that include the bounds of the setting.
+  * @param size Size of the message buffer.
+  * @return An error message for the field, or nullptr if it is valid.
+  */
+  static const char* validateFormField(size_t setting, const char* value, ConfigurationValues& saved, const char* cleared, char* message, size_t size);
+
+  /**
+  * @brief Render the cached list of available Wi-Fi networks as JSON.
   * 
-  * @param key The key to which the boolean value will be saved.
-  * @param value The boolean value to save.
+  * Sends the networks from the last background scan, sorted by signal strength,
+  * together with the scan state and the age of the results. The configuration page
+  * polls this endpoint while a scan is running.
   * 
-  * @note This function creates a Preferences instance, attempts to save the value associated 
-  *       with the given key, and ensures the Preferences session is properly ended. If saving 
-  *       fails, an error message is logged.
+  * @param response The response writer to send the JSON with.
   */
-  void saveBool(const char* key, bool value);
+  void renderNetworks(HttpResponseWriter& response);
 
   /**
-  * @brief Parse and extract the value of a field from a URL-encoded String.
+  * @brief Render the preferences storage statistics as JSON.
+  *
+  * Sends the saves over the device lifetime, the flash writes of every record slot
+  * and the skipped saves since startup, and the free entries of the storage.
   *
-  * This function takes a URL-encoded String containing field-value pairs and
-  * extracts the value associated with the specified field ID. The field ID should
-  * be provided as a parameter. The extracted value is then URL-decoded and leading
-  * and trailing spaces are removed. If the field is not found or the extracted value
-  * is empty, an empty String is returned.
+  * @param response The response writer to send the JSON with.
+  */
+  void renderStorageStatistics(HttpResponseWriter& response);
+
+  /**
+  * @brief Upload a firmware image and make it bootable.
   *
-  * @param data The URL-encoded String containing field-value pairs.
-  * @param fieldId The field ID for which to extract the value.
-  * @return The extracted and decoded value of the specified field, or an empty String if not found.
+  * The request body is the firmware image, streamed from the client into the inactive
+  * app partition in fixed-size chunks without buffering the image. The expected SHA-256
+  * hash is sent in the CONFIG_FIRMWARE_HASH_HEADER header. On success the device
+  * restarts into the new firmware after CONFIG_APPLY_DELAY.
   *
-  * @see decodeResponse()
-  * @see removeSpaces()
+  * @param connection The connection with the request headers and the start of the image.
+  * @param response The response writer to send the result with.
   */
-  String parseFieldValue(String data, String fieldId);
+  void uploadFirmware(HttpConnection& connection, HttpResponseWriter& response);
 
   /**
-  * @brief Decode a URL-encoded String.
+  * @brief Download a firmware image from an HTTP server and make it bootable.
   *
-  * This function takes a URL-encoded String as input and decodes it, replacing
-  * percent-encoded characters with their corresponding ASCII characters. It also
-  * replaces the plus sign (+) with a space (' '). The decoded String is returned.
+  * The request body is a JSON object with the "url" of the image, e.g. on a local
+  * HTTP server, and its expected "sha256" hash. Only URLs on the FIRMWARE_HOST server
+  * are downloaded. The image is streamed into the inactive app partition like an
+  * upload. On success the device restarts into the new firmware after CONFIG_APPLY_DELAY.
   *
-  * @param input The URL-encoded String to decode.
-  * @return The decoded String.
+  * @param request The parsed request.
+  * @param response The response writer to send the result with.
   */
-  String decodeResponse(String input);
+  void pullFirmware(HttpRequestParser& request, HttpResponseWriter& response);
 
   /**
-  * @brief Remove spaces from a String.
+  * @brief Send the result of a firmware update as JSON.
   *
-  * This function takes a String as input and removes leading and trailing spaces.
-  * If the input String has no spaces, it is returned unchanged. If the input String
-  * has leading or trailing spaces, those spaces are removed, and the modified String
-  * is returned.
+  * Schedules the restart into the new firmware if the update succeeded.
   *
-  * @param str The input String from which to remove spaces.
-  * @return The modified String with leading and trailing spaces removed.
+  * @param response The response writer to send the result with.
+  * @param update The finished or failed update.
+  * @param isUpdated true if the update succeeded.
   */
-  String removeSpaces(String str);
+  void renderFirmwareResult(HttpResponseWriter& response, FirmwareUpdate& update, bool isUpdated);
 
   /**
-  * @brief Convert a hexadecimal character to a byte.
+  * @brief Load a string value from an open preferences session.
   *
-  * This function takes a single character and converts it to a byte based on its
-  * hexadecimal representation. If the character is a digit ('0' to '9'), the
-  * corresponding decimal value is returned. If the character is a lowercase
-  * hexadecimal digit ('a' to 'f'), the corresponding decimal value (10 to 15) is
-  * returned. If the character is an uppercase hexadecimal digit ('A' to 'F'),
-  * the corresponding decimal value (10 to 15) is returned. If the input character
-  * is not a valid hexadecimal digit, 0 is returned.
+  * @param preferences The open preferences session, may have failed to begin.
+  * @param key The key of the string value to load.
+  * @param value Buffer receiving the value.
+  * @param size Size of the buffer, values that do not fit are truncated.
+  * @param defaultValue The value loaded if the key does not exist, without storing it.
+  */
+  static void loadString(Preferences& preferences, const char* key, char* value, size_t size, const char* defaultValue);
+
+  /**
+  * @brief Load the latest configuration record.
+  *
+  * Reads both record slots and keeps the valid one with the higher sequence number.
+  * Without a valid record, the preferences saved under their own keys by earlier
+  * firmware are loaded, or the defaults if there are none.
+  *
+  * @param preferences The open preferences session, may have failed to begin.
+  * @param record The record to load into.
+  */
+  static void loadRecord(Preferences& preferences, ConfigurationRecord& record);
+
+  /**
+  * @brief Read and verify one slot of the configuration record.
+  *
+  * @param preferences The open preferences session.
+  * @param key The key of the record slot.
+  * @param record The record to read into.
+  * @return true if the slot holds a record of this version with a valid checksum.
+  */
+  static bool readRecord(Preferences& preferences, const char* key, ConfigurationRecord& record);
+
+  /**
+  * @brief Check the version, size and checksum of a configuration record.
+  *
+  * @param record The record.
+  * @return true if the record has this version and a valid checksum.
+  */
+  static bool isValidRecord(const ConfigurationRecord& record);
+
+  /**
+  * @brief Load the preferences saved under their own keys by earlier firmware.
   *
-  * @param c The hexadecimal character to convert.
-  * @return The decimal value of the hexadecimal character or 0 if not a valid digit.
+  * @param preferences The open preferences session, may have failed to begin.
+  * @param record The record to load into, with sequence number 0.
   */
-  byte hexToByte(char c);
+  static void loadLegacyRecord(Preferences& preferences, ConfigurationRecord& record);
 
   /**
-  * @brief Convert a String to a uint16_t.
+  * @brief Save a configuration record.
+  *
+  * Writes the record with the next sequence number into the slot that does not hold
+  * the record it was loaded from, so a power loss while writing leaves the previous
+  * record intact. Preferences migrated from their own keys are removed afterwards.
+  * A record without changes is not written, saving flash wear. The written values are
+  * served by renderConfigurationValues() until the caller applies them.
   *
-  * This function converts the provided String to an integer and checks if it
-  * falls within the valid range for a uint16_t (0 to 65535). If the value is
-  * within the range, it is cast to uint16_t and returned; otherwise, 0 is returned.
+  * @param preferences The preferences session opened for writing.
+  * @param record The record to save, as loaded by loadRecord() and changed since.
+  * @param loaded The values of the record as loaded.
+  * @return true if the record was written or had no changes.
+  */
+  bool saveRecord(Preferences& preferences, ConfigurationRecord& record, const ConfigurationValues& loaded);
+
+  /**
+  * @brief Calculate the checksum of a configuration record.
   *
-  * @param str The String to convert to uint16_t.
-  * @return The converted uint16_t value or 0 if the conversion is out of range.
+  * @param record The record.
+  * @return CRC-32 of all fields before the checksum.
   */
-  uint16_t stringToUint16(String str);
+  static uint32_t recordChecksum(const ConfigurationRecord& record);
 };
 
 #endif
\ No newline at end of file
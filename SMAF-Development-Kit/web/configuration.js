@@ -0,0 +1,209 @@
+// Network saved in the device configuration, kept selected in the network list.
+let savedNetwork = '';
+
+// Settings of the device, as described by its schema.
+let settings = [];
+
+// Start a new background scan on the device and poll for its results.
+function refreshScan() {
+  fetch('/scan')
+    .then((response) => response.json())
+    .then(renderNetworks);
+}
+
+// Load the cached network list from the device.
+function loadNetworks() {
+  fetch('/networks')
+    .then((response) => response.json())
+    .then(renderNetworks);
+}
+
+// Fill the network list and keep polling while the device is scanning.
+function renderNetworks(scan) {
+  const networks = document.getElementById('netName');
+  const selected = networks.value || savedNetwork;
+
+  networks.length = 0;
+  scan.networks.forEach((network) => networks.add(new Option(network.ssid + ' (' + network.rssi + ' dBm)', network.ssid)));
+
+  // Keep the saved network selectable even if it is out of range.
+  if (selected && !scan.networks.some((network) => network.ssid === selected)) {
+    networks.add(new Option(selected, selected));
+  }
+
+  networks.value = selected;
+  document.getElementById('scanState').textContent = scan.scanning ? 'Scanning for networks...' : 'Refresh network list';
+
+  if (scan.scanning) {
+    setTimeout(loadNetworks, 1000);
+  }
+}
+
+// Build a switch row, named to be submitted with the form or unnamed for the script only.
+function renderSwitch(frame, label, id, name) {
+  const toggle = document.createElement('label');
+  const input = document.createElement('input');
+
+  input.id = id;
+  input.type = 'checkbox';
+  input.value = 'true';
+
+  if (name) {
+    input.name = name;
+  }
+
+  toggle.className = 'switch';
+  toggle.appendChild(input);
+  toggle.insertAdjacentHTML('beforeend', '<div class="track"><div class="thumb"></div></div>');
+
+  frame.className = 'checkbox-frame';
+  frame.append(label, toggle);
+}
+
+// Build the form fields of all settings in their page sections.
+function renderFields(schema) {
+  settings = schema;
+
+  schema.forEach((field) => {
+    const frame = document.createElement('div');
+    const label = document.createElement('label');
+
+    label.htmlFor = field.key;
+    label.textContent = field.label;
+
+    if (field.type === 'boolean') {
+      renderSwitch(frame, label, field.key, field.key);
+    } else {
+      // The network name is picked from the scanned networks.
+      const input = document.createElement(field.key === 'netName' ? 'select' : 'input');
+
+      input.id = field.key;
+      input.name = field.key;
+      input.required = field.required;
+
+      if (field.type === 'number') {
+        input.type = 'text';
+        input.inputMode = 'numeric';
+        input.pattern = '[0-9]*';
+      } else if (input.tagName === 'INPUT') {
+        input.type = field.secret ? 'password' : 'text';
+        input.minLength = field.minimum;
+        input.maxLength = field.maximum;
+
+        // The device never sends secrets, an empty field keeps the saved one.
+        if (field.secret) {
+          input.placeholder = 'Unchanged if left empty';
+        }
+      }
+
+      if (field.required) {
+        label.insertAdjacentHTML('beforeend', '<em>*</em>');
+      }
+
+      // The device rejects invalid values, the reason is shown below the field.
+      const error = document.createElement('small');
+
+      error.id = field.key + 'Error';
+      error.className = 'error';
+
+      frame.className = 'input-frame';
+      frame.append(label, input, error);
+    }
+
+    document.getElementById(field.section).appendChild(frame);
+
+    // An empty secret field keeps the saved secret, so clearing it takes its own switch.
+    if (field.secret) {
+      const clearFrame = document.createElement('div');
+      const clearLabel = document.createElement('label');
+
+      clearLabel.htmlFor = field.key + 'Clear';
+      clearLabel.textContent = 'Clear saved ' + field.label.toLowerCase();
+
+      renderSwitch(clearFrame, clearLabel, field.key + 'Clear');
+      document.getElementById(field.section).appendChild(clearFrame);
+    }
+  });
+}
+
+// Fill the form fields with the current configuration served by the device.
+function renderValues(values) {
+  savedNetwork = values.netName;
+
+  settings.forEach((field) => {
+    const input = document.getElementById(field.key);
+
+    // The network list selects the saved network once it is loaded.
+    if (field.key === 'netName') {
+      return;
+    }
+
+    if (field.type === 'boolean') {
+      input.checked = values[field.key];
+    } else if (values[field.key] !== null) {
+      input.value = values[field.key];
+    }
+  });
+}
+
+// Build the form and fill it with the current configuration.
+function loadValues() {
+  fetch('/schema')
+    .then((response) => response.json())
+    .then((schema) => {
+      renderFields(schema);
+
+      return fetch('/values')
+        .then((response) => response.json())
+        .then(renderValues)
+        .then(loadNetworks);
+    });
+}
+
+// Submit the form, the device saves it only if every field is valid.
+function saveValues(event) {
+  const form = event.target;
+  const body = new URLSearchParams(new FormData(form));
+  const cleared = settings.filter((field) => field.secret && document.getElementById(field.key + 'Clear').checked);
+
+  // The device clears the listed secrets instead of keeping them.
+  if (cleared.length > 0) {
+    body.set('clear', cleared.map((field) => field.key).join(','));
+  }
+
+  event.preventDefault();
+  document.querySelectorAll('.error').forEach((error) => (error.textContent = ''));
+  document.getElementById('success').style.display = 'none';
+
+  fetch(form.action, { method: 'POST', body: body })
+    .then((response) => {
+      // The device applies the saved configuration, so only confirm it.
+      if (response.ok) {
+        document.getElementById('success').style.display = 'block';
+        window.scrollTo(0, 0);
+        return;
+      }
+
+      return response.json().then((result) => {
+        Object.keys(result.errors).forEach((key) => (document.getElementById(key + 'Error').textContent = result.errors[key]));
+        document.getElementById(Object.keys(result.errors)[0]).focus();
+      });
+    });
+}
+
+// Show the sensor readings pushed by the device while it is sending data.
+function watchReadings() {
+  const events = new EventSource('/events');
+
+  events.onmessage = (event) => {
+    const sample = JSON.parse(event.data);
+
+    document.getElementById('temperature').textContent = sample.temperature.toFixed(2);
+    document.getElementById('humidity').textContent = sample.humidity.toFixed(2);
+    document.getElementById('live').style.display = 'block';
+  };
+}
+
+document.addEventListener('DOMContentLoaded', loadValues);
+document.addEventListener('DOMContentLoaded', () => document.querySelector('form').addEventListener('submit', saveValues));
+document.addEventListener('DOMContentLoaded', watchReadings);
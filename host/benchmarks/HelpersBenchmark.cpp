@@ -0,0 +1,245 @@
+/**
+* @file HelpersBenchmark.cpp
+* @brief Benchmarks the string helpers that run on every message or request.
+*
+* Measures nanoseconds, heap allocations and allocated bytes per call of
+* constructMqttMessage(), parseFormNumber(), debug() and FormDecoder::decode()
+* across realistic inputs, and writes the results as JSON. FormDecoder replaced
+* parseFieldValue(), decodeResponse() and removeSpaces(), and parseFormNumber()
+* replaced stringToUint16(). Allocations are counted through the global operator
+* new, which the host String also uses.
+*
+* Usage: helpers_benchmark [--min-time MS] [--output FILE]
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "FormDecoder.h"
+#include "Helpers.h"
+#include "HostRuntime.h"
+
+// Allocation counters, only counted while a benchmark runs.
+static std::atomic<bool> isCounting(false);
+static std::atomic<uint64_t> allocations(0);
+static std::atomic<uint64_t> allocatedBytes(0);
+
+void* operator new(size_t size) {
+  if (isCounting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  void* pointer = malloc(size > 0 ? size : 1);
+
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer, size_t size) noexcept {
+  free(pointer);
+}
+
+// Structure of the result of one benchmark.
+struct BenchmarkResult {
+  std::string name;         // Benchmarked function.
+  std::string input;        // Description of the input.
+  uint64_t iterations;      // Number of measured calls.
+  double nsPerOp;           // Time per call in nanoseconds.
+  double allocationsPerOp;  // Heap allocations per call.
+  double bytesPerOp;        // Allocated bytes per call.
+};
+
+static std::vector<BenchmarkResult> results;
+static uint32_t minTime = 200;
+
+// Keeps results alive, so the compiler cannot drop the benchmarked calls.
+static volatile size_t sink;
+
+/**
+* @brief Run a function until the minimum time passed and record its cost per call.
+*/
+template <typename Function>
+static void benchmark(const char* name, const std::string& input, Function function) {
+  // Warm up caches and the allocator.
+  for (int i = 0; i < 1000; i++) {
+    function();
+  }
+
+  uint64_t iterations = 0;
+  uint64_t batch = 1000;
+  auto startedAt = std::chrono::steady_clock::now();
+  std::chrono::nanoseconds elapsed(0);
+  allocations = 0;
+  allocatedBytes = 0;
+  isCounting = true;
+
+  while (elapsed < std::chrono::milliseconds(minTime)) {
+    for (uint64_t i = 0; i < batch; i++) {
+      function();
+    }
+
+    iterations += batch;
+    elapsed = std::chrono::steady_clock::now() - startedAt;
+  }
+
+  isCounting = false;
+  results.push_back(BenchmarkResult{ name, input, iterations, (double)elapsed.count() / iterations,
+                                     (double)allocations / iterations, (double)allocatedBytes / iterations });
+}
+
+// Build URL-encoded form data with the given number of fields and value length.
+static std::string formData(size_t fields, size_t valueLength, bool isEncoded) {
+  std::string data;
+
+  for (size_t field = 0; field < fields; field++) {
+    data += (field > 0 ? "&field" : "field") + std::to_string(field) + "=";
+
+    for (size_t i = 0; i < valueLength; i++) {
+      data += isEncoded && i % 3 == 0 ? "%2F" : (i % 7 == 0 ? "+" : "a");
+    }
+  }
+
+  return data;
+}
+
+static void benchmarkMqttMessage() {
+  const char* timestamps[] = { "Unknown", "2024-06-01T12:00:00Z" };
+
+  for (const char* timestamp : timestamps) {
+    benchmark("constructMqttMessage", timestamp, [&]() {
+      sink = constructMqttMessage(21.53f, 45.27f, timestamp).length();
+    });
+  }
+}
+
+static void benchmarkFormNumber() {
+  const char* values[] = { "1883", "65535", "65536", "88x3" };
+
+  for (const char* value : values) {
+    benchmark("parseFormNumber", value, [&]() {
+      uint16_t number = 0;
+      sink = parseFormNumber(value, number) ? number : 0;
+    });
+  }
+}
+
+static void benchmarkDebug() {
+  benchmark("debug", "literal", []() {
+    debug(LOG, "Watchdog reset.");
+  });
+
+  benchmark("debug", "3 arguments", []() {
+    debug(CMD, "Posting data package to MQTT broker '%s' on topic '%s' with %d bytes.", "broker.example.com", "smaf/device/00042", 118);
+  });
+}
+
+static void benchmarkFormDecoder() {
+  static const char* const names[] = { "field0", "field1", "field2", "field3", "field4", "field5", "field6", "field7", "field8", "field9" };
+  struct FormInput {
+    size_t fields;
+    size_t valueLength;
+    bool isEncoded;
+  };
+  const FormInput inputs[] = { { 4, 8, false }, { 10, 16, false }, { 10, 64, true } };
+
+  for (const FormInput& input : inputs) {
+    std::string data = formData(input.fields, input.valueLength, input.isEncoded);
+    std::vector<char> buffer(data.size() + 1);
+    std::string description = std::to_string(input.fields) + " fields, " + std::to_string(data.size()) + " bytes" + (input.isEncoded ? ", percent-encoded" : "");
+
+    benchmark("FormDecoder::decode", description, [&]() {
+      // Decoding is in place, so every call starts from a fresh copy of the form.
+      memcpy(buffer.data(), data.c_str(), data.size() + 1);
+      FormDecoder decoder(names, 10);
+      decoder.decode(buffer.data());
+      sink = strlen(decoder.value("field1"));
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* outputPath = nullptr;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--min-time") == 0) {
+      minTime = atol(argv[i + 1]);
+    } else if (strcmp(argv[i], "--output") == 0) {
+      outputPath = argv[i + 1];
+    }
+  }
+
+  // Format debug() output as on the device, but do not print it.
+  hostSetSerialOutput(nullptr);
+
+  benchmarkMqttMessage();
+  benchmarkFormNumber();
+  benchmarkDebug();
+  benchmarkFormDecoder();
+
+  FILE* output = outputPath != nullptr ? fopen(outputPath, "w") : stdout;
+
+  if (output == nullptr) {
+    fprintf(stderr, "Opening '%s' failed.\n", outputPath);
+    return 1;
+  }
+
+  fprintf(output, "{\n  \"benchmarks\": [\n");
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult& result = results[i];
+    fprintf(output, "    { \"name\": \"%s\", \"input\": \"%s\", \"iterations\": %llu, \"nsPerOp\": %.1f, \"allocationsPerOp\": %.2f, \"bytesPerOp\": %.1f }%s\n",
+            result.name.c_str(), result.input.c_str(), (unsigned long long)result.iterations, result.nsPerOp,
+            result.allocationsPerOp, result.bytesPerOp, i + 1 < results.size() ? "," : "");
+  }
+
+  fprintf(output, "  ]\n}\n");
+
+  if (output != stdout) {
+    fclose(output);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+* @file ParserBenchmark.cpp
+* @brief Benchmarks the incremental HTTP request parser.
+*
+* Measures nanoseconds per request and throughput of HttpRequestParser::parse() for
+* the requests the configuration server receives, delivered in one piece and in TCP-like
+* segments, and writes the results as JSON. Each request is copied into the receive
+* buffer before parsing, as parsing overwrites delimiters in place; the copy is included.
+*
+* Usage: parser_benchmark [--min-time MS] [--output FILE]
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "HttpConnection.h"
+#include "HttpRequestParser.h"
+
+// Structure of the result of one benchmark.
+struct BenchmarkResult {
+  std::string name;     // Benchmarked request.
+  std::string input;    // Description of the delivery.
+  uint64_t iterations;  // Number of parsed requests.
+  double nsPerOp;       // Time per request in nanoseconds.
+  double mbPerSecond;   // Parsed request bytes per second, in megabytes.
+};
+
+static std::vector<BenchmarkResult> results;
+static uint32_t minTime = 200;
+
+// Keeps results alive, so the compiler cannot drop the benchmarked calls.
+static volatile size_t sink;
+
+/**
+* @brief Parse a request until the minimum time passed and record its cost per request.
+*
+* @param name Name of the request in the results.
+* @param request The raw request.
+* @param segmentSize Number of bytes delivered per parse() call, 0 for the whole request.
+*/
+static void benchmark(const char* name, const std::string& request, size_t segmentSize) {
+  static char buffer[HTTP_REQUEST_BUFFER_SIZE];
+  HttpRequestParser parser;
+  size_t step = segmentSize > 0 ? segmentSize : request.size();
+
+  auto parseOnce = [&]() {
+    memcpy(buffer, request.data(), request.size());
+    parser.reset(buffer, sizeof(buffer));
+    HttpParseResultEnum result = HTTP_PARSE_INCOMPLETE;
+
+    for (size_t length = step; result == HTTP_PARSE_INCOMPLETE; length += step) {
+      result = parser.parse(min(length, request.size()));
+    }
+
+    sink = parser.header("Host").length + result;
+  };
+
+  // Warm up caches.
+  for (int i = 0; i < 1000; i++) {
+    parseOnce();
+  }
+
+  uint64_t iterations = 0;
+  uint64_t batch = 1000;
+  auto startedAt = std::chrono::steady_clock::now();
+  std::chrono::nanoseconds elapsed(0);
+
+  while (elapsed < std::chrono::milliseconds(minTime)) {
+    for (uint64_t i = 0; i < batch; i++) {
+      parseOnce();
+    }
+
+    iterations += batch;
+    elapsed = std::chrono::steady_clock::now() - startedAt;
+  }
+
+  double nsPerOp = (double)elapsed.count() / iterations;
+  std::string input = segmentSize > 0 ? std::to_string(request.size()) + " bytes in " + std::to_string(segmentSize) + "-byte segments"
+                                      : std::to_string(request.size()) + " bytes at once";
+  results.push_back(BenchmarkResult{ name, input, iterations, nsPerOp, request.size() / nsPerOp * 1000.0 });
+}
+
+int main(int argc, char** argv) {
+  const char* outputPath = nullptr;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--min-time") == 0) {
+      minTime = atol(argv[i + 1]);
+    } else if (strcmp(argv[i], "--output") == 0) {
+      outputPath = argv[i + 1];
+    }
+  }
+
+  const std::string minimal = "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n";
+  const std::string browser = "GET /configuration.css HTTP/1.1\r\n"
+                              "Host: 192.168.4.1\r\n"
+                              "Connection: keep-alive\r\n"
+                              "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/126.0 Safari/537.36\r\n"
+                              "Accept: text/css,*/*;q=0.1\r\n"
+                              "Referer: http://192.168.4.1/configuration\r\n"
+                              "Accept-Encoding: gzip, deflate\r\n"
+                              "Accept-Language: en-US,en;q=0.9,de;q=0.8\r\n"
+                              "\r\n";
+  std::string form = "ssid=SMAF-Lab&password=secret-password&mqttServer=broker.example.com&mqttPort=1883&mqttTopic=smaf%2Fdevice";
+  const std::string save = "POST /configuration HTTP/1.1\r\n"
+                           "Host: 192.168.4.1\r\n"
+                           "Content-Type: application/x-www-form-urlencoded\r\n"
+                           "Content-Length: "
+                           + std::to_string(form.size()) + "\r\n\r\n" + form;
+
+  benchmark("minimal GET", minimal, 0);
+  benchmark("browser GET", browser, 0);
+  benchmark("browser GET", browser, 64);
+  benchmark("browser GET", browser, 1);
+  benchmark("form POST", save, 0);
+  benchmark("form POST", save, 64);
+
+  FILE* output = outputPath != nullptr ? fopen(outputPath, "w") : stdout;
+
+  if (output == nullptr) {
+    fprintf(stderr, "Opening '%s' failed.\n", outputPath);
+    return 1;
+  }
+
+  fprintf(output, "{\n  \"benchmarks\": [\n");
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult& result = results[i];
+    fprintf(output, "    { \"name\": \"%s\", \"input\": \"%s\", \"iterations\": %llu, \"nsPerOp\": %.1f, \"mbPerSecond\": %.1f }%s\n",
+            result.name.c_str(), result.input.c_str(), (unsigned long long)result.iterations, result.nsPerOp,
+            result.mbPerSecond, i + 1 < results.size() ? "," : "");
+  }
+
+  fprintf(output, "  ]\n}\n");
+
+  if (output != stdout) {
+    fclose(output);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+* @file Adafruit_NeoPixel.h
+* @brief Host implementation of the Adafruit NeoPixel library.
+*
+* Pixel colors are kept in memory, so tests can check what the LED shows.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef ADAFRUIT_NEOPIXEL_H
+#define ADAFRUIT_NEOPIXEL_H
+
+#include "Arduino.h"
+
+#define NEO_GRB 0x52
+#define NEO_KHZ800 0x0000
+
+// Define the number of pixels kept in memory.
+#define NEOPIXEL_HOST_MAX_PIXELS 16
+
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type = NEO_GRB + NEO_KHZ800);
+
+  void begin() {}
+  void show();
+  void clear();
+  void setBrightness(uint8_t brightness) { _brightness = brightness; }
+  void setPixelColor(uint16_t index, uint32_t color);
+  void setPixelColor(uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
+  void fill(uint32_t color = 0, uint16_t first = 0, uint16_t count = 0);
+  uint32_t getPixelColor(uint16_t index) const;
+  uint16_t numPixels() const { return _count; }
+  uint32_t shows() const { return _shows; }
+
+  static uint32_t Color(uint8_t red, uint8_t green, uint8_t blue) { return ((uint32_t)red << 16) | ((uint32_t)green << 8) | blue; }
+
+private:
+  uint16_t _count;                             // Number of pixels.
+  uint8_t _brightness = 255;                   // Brightness of all pixels.
+  uint32_t _pixels[NEOPIXEL_HOST_MAX_PIXELS];  // Colors of the pixels.
+  uint32_t _shows = 0;                         // Number of show() calls.
+};
+
+#endif
\ No newline at end of file
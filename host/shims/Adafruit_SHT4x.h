@@ -0,0 +1,51 @@
+/**
+* @file Adafruit_SHT4x.h
+* @brief Host implementation of the Adafruit SHT4x sensor library.
+*
+* Readings are synthetic and drift slowly around room conditions.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef ADAFRUIT_SHT4X_H
+#define ADAFRUIT_SHT4X_H
+
+#include "Arduino.h"
+
+#define SHT4X_HIGH_PRECISION 0
+#define SHT4X_MED_PRECISION 1
+#define SHT4X_LOW_PRECISION 2
+#define SHT4X_NO_HEATER 0
+
+typedef struct {
+  float temperature;        // Temperature in degrees celsius.
+  float relative_humidity;  // Relative humidity in percent.
+} sensors_event_t;
+
+class Adafruit_SHT4x {
+public:
+  bool begin() { return true; }
+  void setPrecision(int precision) {}
+  void setHeater(int heater) {}
+  bool getEvent(sensors_event_t* humidity, sensors_event_t* temperature);
+};
+
+#endif
\ No newline at end of file
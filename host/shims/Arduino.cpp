@@ -0,0 +1,569 @@
+/**
+* @file Arduino.cpp
+* @brief Host implementation of the Arduino core API used by the sketch.
+*
+* See Arduino.h and HostRuntime.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "Arduino.h"
+#include "HostRuntime.h"
+#include "esp_sntp.h"
+#include "esp_system.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// Start of the host clock, and the time tests moved it forward by.
+static const std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now();
+static std::atomic<int64_t> advancedTime(0);
+
+// Serial output, shared by all tasks.
+static std::mutex serialLock;
+static FILE* serialOutput = stdout;
+static bool isSerialOutputSet = false;
+
+// Command line of the host firmware, to run it again on restart.
+static char** savedArgv = nullptr;
+static void (*restartHandler)() = nullptr;
+
+// Levels of the input pins set by tests.
+static int pinLevels[64];
+static bool isPinLevelSet[64];
+
+// Callback of the SNTP client.
+static sntp_sync_time_cb_t timeSyncCallback = nullptr;
+
+// Random numbers, like the hardware random number generator.
+static std::mutex randomLock;
+static std::mt19937 randomGenerator(std::random_device{}());
+
+String::String(const char* value)
+  : _value(value != nullptr ? value : "") {
+}
+
+String::String(const std::string& value)
+  : _value(value) {
+}
+
+String::String(char value)
+  : _value(1, value) {
+}
+
+// Format an integer in the given base, like the Arduino core.
+static std::string formatInteger(unsigned long value, bool isNegative, unsigned char base) {
+  char digits[68];
+  size_t position = sizeof(digits);
+  digits[--position] = '\0';
+
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+
+  do {
+    unsigned long digit = value % base;
+    digits[--position] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value > 0);
+
+  if (isNegative) {
+    digits[--position] = '-';
+  }
+
+  return std::string(digits + position);
+}
+
+String::String(int value, unsigned char base)
+  : _value(base == 10 ? formatInteger(value < 0 ? -(unsigned long)(long)value : value, value < 0, base) : formatInteger((unsigned int)value, false, base)) {
+}
+
+String::String(unsigned int value, unsigned char base)
+  : _value(formatInteger(value, false, base)) {
+}
+
+String::String(long value, unsigned char base)
+  : _value(base == 10 ? formatInteger(value < 0 ? -(unsigned long)value : value, value < 0, base) : formatInteger((unsigned long)value, false, base)) {
+}
+
+String::String(unsigned long value, unsigned char base)
+  : _value(formatInteger(value, false, base)) {
+}
+
+String::String(float value, unsigned int decimals)
+  : String((double)value, decimals) {
+}
+
+String::String(double value, unsigned int decimals) {
+  char number[64];
+  snprintf(number, sizeof(number), "%.*f", decimals, value);
+  _value = number;
+}
+
+bool String::reserve(unsigned int size) {
+  _value.reserve(size);
+  return true;
+}
+
+int String::indexOf(char character, unsigned int from) const {
+  size_t position = _value.find(character, from);
+  return position == std::string::npos ? -1 : (int)position;
+}
+
+int String::indexOf(const String& value, unsigned int from) const {
+  size_t position = _value.find(value._value, from);
+  return position == std::string::npos ? -1 : (int)position;
+}
+
+String String::substring(unsigned int from) const {
+  return from < _value.size() ? String(_value.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    std::swap(from, to);
+  }
+
+  return from < _value.size() ? String(_value.substr(from, to - from)) : String();
+}
+
+bool String::startsWith(const String& prefix) const {
+  return _value.compare(0, prefix._value.size(), prefix._value) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  return _value.size() >= suffix._value.size() && _value.compare(_value.size() - suffix._value.size(), suffix._value.size(), suffix._value) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& value) const {
+  return _value.size() == value._value.size() && strcasecmp(_value.c_str(), value._value.c_str()) == 0;
+}
+
+void String::trim() {
+  size_t first = 0;
+  size_t last = _value.size();
+
+  while (first < last && isspace((unsigned char)_value[first])) {
+    first++;
+  }
+
+  while (last > first && isspace((unsigned char)_value[last - 1])) {
+    last--;
+  }
+
+  _value = _value.substr(first, last - first);
+}
+
+void String::toLowerCase() {
+  for (char& character : _value) {
+    character = tolower((unsigned char)character);
+  }
+}
+
+void String::toUpperCase() {
+  for (char& character : _value) {
+    character = toupper((unsigned char)character);
+  }
+}
+
+String& String::operator+=(const String& value) {
+  _value += value._value;
+  return *this;
+}
+
+String& String::operator+=(const char* value) {
+  _value += value != nullptr ? value : "";
+  return *this;
+}
+
+String& String::operator+=(char value) {
+  _value += value;
+  return *this;
+}
+
+String operator+(const String& a, const String& b) {
+  return String(a._value + b._value);
+}
+
+String operator+(const String& a, const char* b) {
+  return String(a._value + (b != nullptr ? b : ""));
+}
+
+String operator+(const char* a, const String& b) {
+  return String((a != nullptr ? a : "") + b._value);
+}
+
+size_t Print::write(const uint8_t* data, size_t length) {
+  size_t written = 0;
+
+  while (written < length && write(data[written]) == 1) {
+    written++;
+  }
+
+  return written;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buffer[256];
+  va_list args;
+
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+
+  if (length < 0) {
+    return 0;
+  }
+
+  if ((size_t)length < sizeof(buffer)) {
+    return write((const uint8_t*)buffer, length);
+  }
+
+  // Longer output is formatted again into a buffer that fits.
+  std::string text(length + 1, '\0');
+  va_start(args, format);
+  vsnprintf(&text[0], text.size(), format, args);
+  va_end(args);
+
+  return write((const uint8_t*)text.data(), length);
+}
+
+int Stream::timedRead() {
+  unsigned long startedAt = millis();
+
+  do {
+    int character = read();
+
+    if (character >= 0) {
+      return character;
+    }
+
+    delay(1);
+  } while (millis() - startedAt < _timeout);
+
+  return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+
+  while (count < length) {
+    int character = timedRead();
+
+    if (character < 0) {
+      break;
+    }
+
+    buffer[count++] = (char)character;
+  }
+
+  return count;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String text;
+  int character = timedRead();
+
+  while (character >= 0 && character != terminator) {
+    text += (char)character;
+    character = timedRead();
+  }
+
+  return text;
+}
+
+size_t HardwareSerial::write(uint8_t character) {
+  return write(&character, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+  std::lock_guard<std::mutex> guard(serialLock);
+
+  if (!isSerialOutputSet && getenv("SMAF_HOST_QUIET") != nullptr) {
+    serialOutput = nullptr;
+  }
+
+  isSerialOutputSet = true;
+
+  if (serialOutput != nullptr) {
+    fwrite(data, 1, length, serialOutput);
+    fflush(serialOutput);
+  }
+
+  return length;
+}
+
+int HardwareSerial::available() {
+  if (_peeked >= 0) {
+    return 1;
+  }
+
+  if (_isEnded) {
+    return 0;
+  }
+
+  struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+
+  if (poll(&input, 1, 0) <= 0 || (input.revents & (POLLIN | POLLHUP)) == 0) {
+    return 0;
+  }
+
+  // Reading tells data apart from the end of the input.
+  _peeked = read();
+
+  return _peeked >= 0 ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+  if (_peeked >= 0) {
+    int character = _peeked;
+    _peeked = -1;
+    return character;
+  }
+
+  if (_isEnded) {
+    return -1;
+  }
+
+  struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+
+  if (poll(&input, 1, 0) <= 0) {
+    return -1;
+  }
+
+  unsigned char character;
+
+  if (::read(STDIN_FILENO, &character, 1) != 1) {
+    _isEnded = true;
+    return -1;
+  }
+
+  return character;
+}
+
+int HardwareSerial::peek() {
+  if (_peeked < 0 && available() == 0) {
+    return -1;
+  }
+
+  return _peeked;
+}
+
+void HardwareSerial::flush() {
+  std::lock_guard<std::mutex> guard(serialLock);
+
+  if (serialOutput != nullptr) {
+    fflush(serialOutput);
+  }
+}
+
+void EspClass::restart() {
+  esp_restart();
+}
+
+uint32_t EspClass::getFreeHeap() {
+  return esp_get_free_heap_size();
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  return esp_get_free_heap_size();
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+  return esp_get_free_heap_size();
+}
+
+uint32_t EspClass::getHeapSize() {
+  return 327680;
+}
+
+uint64_t EspClass::getEfuseMac() {
+  return 0x0000A1B2C3D4E5F6ULL;
+}
+
+void esp_restart() {
+  fflush(nullptr);
+
+  if (restartHandler != nullptr) {
+    restartHandler();
+    return;
+  }
+
+  // Run the host firmware again, like the device boots again.
+  if (savedArgv != nullptr) {
+    execv("/proc/self/exe", savedArgv);
+  }
+
+  exit(0);
+}
+
+uint32_t esp_get_free_heap_size() {
+  // The host has no heap limit, report the heap of an idle device.
+  return 200000;
+}
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count() + advancedTime.load();
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < 64 && isPinLevelSet[pin] ? pinLevels[pin] : HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+}
+
+void noTone(uint8_t pin) {
+}
+
+uint32_t esp_random() {
+  std::lock_guard<std::mutex> guard(randomLock);
+  return randomGenerator();
+}
+
+void randomSeed(unsigned long seed) {
+  std::lock_guard<std::mutex> guard(randomLock);
+  randomGenerator.seed(seed);
+}
+
+long random(long max) {
+  return max > 0 ? esp_random() % max : 0;
+}
+
+long random(long min, long max) {
+  return max > min ? min + random(max - min) : min;
+}
+
+void configTime(long gmtOffset, int dstOffset, const char* server1, const char* server2, const char* server3) {
+  // The host clock is synchronized already, report it like a completed SNTP sync.
+  std::thread([]() {
+    delay(200);
+
+    if (timeSyncCallback != nullptr) {
+      struct timeval now;
+      gettimeofday(&now, nullptr);
+      timeSyncCallback(&now);
+    }
+  }).detach();
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return true;
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+  timeSyncCallback = callback;
+}
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* destination, const char* source, size_t size) {
+  size_t length = strlen(source);
+
+  if (size > 0) {
+    size_t count = length < size - 1 ? length : size - 1;
+    memcpy(destination, source, count);
+    destination[count] = '\0';
+  }
+
+  return length;
+}
+#endif
+
+IPAddress::IPAddress()
+  : IPAddress(0, 0, 0, 0) {
+}
+
+IPAddress::IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth)
+  : _bytes{ first, second, third, fourth } {
+}
+
+IPAddress::IPAddress(uint32_t address) {
+  memcpy(_bytes, &address, sizeof(_bytes));
+}
+
+String IPAddress::toString() const {
+  char text[16];
+  snprintf(text, sizeof(text), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+  return String(text);
+}
+
+IPAddress::operator uint32_t() const {
+  uint32_t address;
+  memcpy(&address, _bytes, sizeof(address));
+  return address;
+}
+
+void hostSetArguments(int argc, char** argv) {
+  savedArgv = argv;
+}
+
+void hostSetRestartHandler(void (*handler)()) {
+  restartHandler = handler;
+}
+
+void hostAdvanceTime(uint32_t ms) {
+  advancedTime += (int64_t)ms * 1000;
+}
+
+void hostSetSerialOutput(FILE* output) {
+  std::lock_guard<std::mutex> guard(serialLock);
+  serialOutput = output;
+  isSerialOutputSet = true;
+}
+
+void hostSetPinLevel(uint8_t pin, int level) {
+  if (pin < 64) {
+    pinLevels[pin] = level;
+    isPinLevelSet[pin] = true;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+/**
+* @file Arduino.h
+* @brief Host implementation of the Arduino core API used by the sketch.
+*
+* This file declares the subset of the ESP32 Arduino core the sketch uses, so its
+* sources build and run unchanged on a Linux host: String, Print, Stream, the
+* serial port, timing, random numbers and the ESP object. Time and serial output
+* can be controlled by tests, see HostRuntime.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+
+// Define the pin levels and modes.
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+// Define the emulated version of the ESP32 Arduino core.
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#define ESP_ARDUINO_VERSION_MINOR 0
+#define ESP_ARDUINO_VERSION_PATCH 0
+
+class String {
+public:
+  String(const char* value = "");
+  String(const std::string& value);
+  String(char value);
+  String(int value, unsigned char base = 10);
+  String(unsigned int value, unsigned char base = 10);
+  String(long value, unsigned char base = 10);
+  String(unsigned long value, unsigned char base = 10);
+  String(float value, unsigned int decimals = 2);
+  String(double value, unsigned int decimals = 2);
+
+  const char* c_str() const { return _value.c_str(); }
+  unsigned int length() const { return _value.size(); }
+  bool isEmpty() const { return _value.empty(); }
+  bool reserve(unsigned int size);
+
+  int indexOf(char character, unsigned int from = 0) const;
+  int indexOf(const String& value, unsigned int from = 0) const;
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+  bool startsWith(const String& prefix) const;
+  bool endsWith(const String& suffix) const;
+  bool equals(const String& value) const { return _value == value._value; }
+  bool equals(const char* value) const { return _value == (value != nullptr ? value : ""); }
+  bool equalsIgnoreCase(const String& value) const;
+  long toInt() const { return atol(_value.c_str()); }
+  float toFloat() const { return atof(_value.c_str()); }
+  void trim();
+  void toLowerCase();
+  void toUpperCase();
+
+  char operator[](unsigned int index) const { return index < _value.size() ? _value[index] : '\0'; }
+  String& operator+=(const String& value);
+  String& operator+=(const char* value);
+  String& operator+=(char value);
+  bool operator==(const String& value) const { return equals(value); }
+  bool operator==(const char* value) const { return equals(value); }
+  bool operator!=(const String& value) const { return !equals(value); }
+  bool operator!=(const char* value) const { return !equals(value); }
+
+  friend String operator+(const String& a, const String& b);
+  friend String operator+(const String& a, const char* b);
+  friend String operator+(const char* a, const String& b);
+
+private:
+  std::string _value;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t character) = 0;
+  virtual size_t write(const uint8_t* data, size_t length);
+  size_t write(const char* text) { return text != nullptr ? write((const uint8_t*)text, strlen(text)) : 0; }
+  size_t write(const char* data, size_t length) { return write((const uint8_t*)data, length); }
+
+  size_t print(const char* text) { return write(text); }
+  size_t print(const String& text) { return write(text.c_str()); }
+  size_t print(char character) { return write((uint8_t)character); }
+  size_t print(int value) { return printf("%d", value); }
+  size_t print(unsigned int value) { return printf("%u", value); }
+  size_t print(long value) { return printf("%ld", value); }
+  size_t print(unsigned long value) { return printf("%lu", value); }
+  size_t print(double value, int decimals = 2) { return printf("%.*f", decimals, value); }
+  size_t println() { return write("\r\n"); }
+
+  template <typename T>
+  size_t println(const T& value) {
+    size_t length = print(value);
+    return length + println();
+  }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+  String readStringUntil(char terminator);
+  void setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout() const { return _timeout; }
+
+protected:
+  unsigned long _timeout = 1000;  // Time in milliseconds readBytes() waits for data.
+
+  int timedRead();
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) {}
+  void end() {}
+  size_t setRxBufferSize(size_t size) { return size; }
+  operator bool() const { return true; }
+
+  using Print::write;
+  size_t write(uint8_t character) override;
+  size_t write(const uint8_t* data, size_t length) override;
+  int available() override;
+  int read() override;
+  int peek() override;
+  void flush() override;
+
+private:
+  int _peeked = -1;       // Character read ahead by peek().
+  bool _isEnded = false;  // True once the input reached its end.
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  void restart();
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getHeapSize();
+  uint64_t getEfuseMac();
+};
+
+extern EspClass ESP;
+
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+unsigned long millis();
+unsigned long micros();
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+uint32_t esp_random();
+void randomSeed(unsigned long seed);
+long random(long max);
+long random(long min, long max);
+
+void configTime(long gmtOffset, int dstOffset, const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "IPAddress.h"
+
+// Like the ESP32 core, both arguments must have the same type.
+using std::min;
+using std::max;
+
+#define constrain(amount, low, high) ((amount) < (low) ? (low) : ((amount) > (high) ? (high) : (amount)))
+
+// The C library provides strlcpy() from glibc 2.38 on.
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* destination, const char* source, size_t size);
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,456 @@
+/**
+* @file EspIdf.cpp
+* @brief Host implementation of the ESP-IDF timer, watchdog, OTA and CRC functions.
+*
+* See esp_timer.h, esp_task_wdt.h, esp_ota_ops.h and esp_rom_crc.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Arduino.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_task_wdt.h"
+#include "esp_ota_ops.h"
+#include "esp_rom_crc.h"
+#include "esp_system.h"
+
+// Structure of a timer of the timer thread.
+struct esp_timer {
+  esp_timer_cb_t callback;  // Function called when the timer expires.
+  void* arg;                // Argument passed to the callback.
+  int64_t expiresAt = 0;    // Time the timer expires, in microseconds.
+  uint64_t period = 0;      // Period of periodic timers, or 0.
+  bool isArmed = false;     // True while the timer is started.
+};
+
+// Timers share one thread, which sleeps until the next one expires.
+static std::mutex timerLock;
+static std::condition_variable timerChanged;
+static std::vector<esp_timer*> timers;
+static bool isTimerThreadStarted = false;
+
+// The longest sleep of the timer thread in microseconds, so moved time is noticed.
+#define TIMER_THREAD_MAX_SLEEP 50000
+
+// Subscribed threads of the watchdog and the time of their last reset in milliseconds.
+static std::mutex watchdogLock;
+static std::map<std::thread::id, unsigned long> watchdogTasks;
+static uint32_t watchdogTimeout = 5000;
+static bool isWatchdogPanic = false;
+static bool isWatchdogThreadStarted = false;
+
+// Structure of an emulated app partition.
+struct HostPartition {
+  esp_partition_t partition;    // Description of the partition.
+  std::vector<uint8_t> image;   // Written image.
+  esp_ota_img_states_t state;   // Verification state of the image.
+};
+
+// Define the first byte of an ESP app image.
+#define ESP_IMAGE_MAGIC 0xE9
+
+// The host firmware runs from the first partition.
+static std::mutex otaLock;
+static HostPartition partitions[2] = {
+  { { 0x10000, 0x140000, "app0" }, {}, ESP_OTA_IMG_VALID },
+  { { 0x150000, 0x140000, "app1" }, {}, ESP_OTA_IMG_UNDEFINED }
+};
+static uint8_t runningPartition = 0;
+static uint8_t bootPartition = 0;
+static esp_ota_handle_t otaHandle = 0;  // Handle of the update in progress, or 0.
+static uint8_t otaPartition = 0;        // Partition written by the update in progress.
+
+const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK:
+      return "ESP_OK";
+    case ESP_FAIL:
+      return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+      return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+      return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+      return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+      return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+      return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_OTA_VALIDATE_FAILED:
+      return "ESP_ERR_OTA_VALIDATE_FAILED";
+  }
+
+  return "UNKNOWN ERROR";
+}
+
+int64_t esp_timer_get_time() {
+  return (int64_t)micros();
+}
+
+// Run the callbacks of expired timers, until the program ends.
+static void runTimers() {
+  std::unique_lock<std::mutex> guard(timerLock);
+
+  for (;;) {
+    int64_t now = esp_timer_get_time();
+    int64_t sleep = TIMER_THREAD_MAX_SLEEP;
+    esp_timer* expired = nullptr;
+
+    for (esp_timer* timer : timers) {
+      if (!timer->isArmed) {
+        continue;
+      }
+
+      if (timer->expiresAt <= now) {
+        expired = timer;
+        break;
+      }
+
+      sleep = min(sleep, timer->expiresAt - now);
+    }
+
+    if (expired == nullptr) {
+      timerChanged.wait_for(guard, std::chrono::microseconds(sleep));
+      continue;
+    }
+
+    // Rearm periodic timers before the callback, which may stop them.
+    if (expired->period > 0) {
+      expired->expiresAt += expired->period;
+    } else {
+      expired->isArmed = false;
+    }
+
+    esp_timer_cb_t callback = expired->callback;
+    void* arg = expired->arg;
+
+    guard.unlock();
+    callback(arg);
+    guard.lock();
+  }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+  if (args == nullptr || args->callback == nullptr || handle == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  esp_timer* timer = new esp_timer();
+  timer->callback = args->callback;
+  timer->arg = args->arg;
+
+  std::lock_guard<std::mutex> guard(timerLock);
+  timers.push_back(timer);
+
+  if (!isTimerThreadStarted) {
+    std::thread(runTimers).detach();
+    isTimerThreadStarted = true;
+  }
+
+  *handle = timer;
+  return ESP_OK;
+}
+
+// Arm a timer, if it is not armed yet.
+static esp_err_t startTimer(esp_timer_handle_t timer, uint64_t timeout, uint64_t period) {
+  std::lock_guard<std::mutex> guard(timerLock);
+
+  if (timer->isArmed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  timer->expiresAt = esp_timer_get_time() + timeout;
+  timer->period = period;
+  timer->isArmed = true;
+  timerChanged.notify_all();
+
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout) {
+  return startTimer(timer, timeout, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+  return startTimer(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  std::lock_guard<std::mutex> guard(timerLock);
+
+  if (!timer->isArmed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  timer->isArmed = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  std::lock_guard<std::mutex> guard(timerLock);
+
+  for (size_t i = 0; i < timers.size(); ++i) {
+    if (timers[i] == timer) {
+      timers.erase(timers.begin() + i);
+      delete timer;
+      return ESP_OK;
+    }
+  }
+
+  return ESP_ERR_INVALID_ARG;
+}
+
+// Check the subscribed threads, and restart like the device if one missed its reset.
+static void runWatchdog() {
+  for (;;) {
+    delay(100);
+
+    std::unique_lock<std::mutex> guard(watchdogLock);
+    bool isTriggered = false;
+
+    for (const auto& task : watchdogTasks) {
+      if (millis() - task.second > watchdogTimeout) {
+        isTriggered = true;
+      }
+    }
+
+    if (!isTriggered) {
+      continue;
+    }
+
+    fprintf(stderr, "E task_wdt: Task watchdog got triggered. A task did not reset the watchdog within %u ms.\n", (unsigned)watchdogTimeout);
+    watchdogTasks.clear();
+    guard.unlock();
+
+    if (isWatchdogPanic) {
+      esp_restart();
+    }
+  }
+}
+
+esp_err_t esp_task_wdt_init(uint32_t timeout, bool panic) {
+  std::lock_guard<std::mutex> guard(watchdogLock);
+  watchdogTimeout = timeout * 1000;
+  isWatchdogPanic = panic;
+  return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_reconfigure(const esp_task_wdt_config_t* config) {
+  std::lock_guard<std::mutex> guard(watchdogLock);
+  watchdogTimeout = config->timeout_ms;
+  isWatchdogPanic = config->trigger_panic;
+  return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_add(void* task) {
+  // Only the calling task can be subscribed, tasks have no handles to threads.
+  if (task != nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  std::lock_guard<std::mutex> guard(watchdogLock);
+  watchdogTasks[std::this_thread::get_id()] = millis();
+
+  if (!isWatchdogThreadStarted) {
+    std::thread(runWatchdog).detach();
+    isWatchdogThreadStarted = true;
+  }
+
+  return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_reset() {
+  std::lock_guard<std::mutex> guard(watchdogLock);
+  auto task = watchdogTasks.find(std::this_thread::get_id());
+
+  if (task == watchdogTasks.end()) {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  task->second = millis();
+  return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_delete(void* task) {
+  if (task != nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  std::lock_guard<std::mutex> guard(watchdogLock);
+  return watchdogTasks.erase(std::this_thread::get_id()) > 0 ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+// Get the emulated partition of a partition description.
+static HostPartition* findPartition(const esp_partition_t* partition) {
+  for (HostPartition& candidate : partitions) {
+    if (&candidate.partition == partition) {
+      return &candidate;
+    }
+  }
+
+  return nullptr;
+}
+
+const esp_partition_t* esp_ota_get_running_partition() {
+  return &partitions[runningPartition].partition;
+}
+
+const esp_partition_t* esp_ota_get_boot_partition() {
+  std::lock_guard<std::mutex> guard(otaLock);
+  return &partitions[bootPartition].partition;
+}
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start) {
+  return &partitions[(runningPartition + 1) % 2].partition;
+}
+
+esp_err_t esp_ota_begin(const esp_partition_t* partition, size_t size, esp_ota_handle_t* handle) {
+  std::lock_guard<std::mutex> guard(otaLock);
+  HostPartition* target = findPartition(partition);
+
+  if (target == nullptr || target == &partitions[runningPartition]) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (size > partition->size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  // Erase the partition, an update in progress is replaced.
+  target->image.clear();
+  target->state = ESP_OTA_IMG_UNDEFINED;
+  otaPartition = target - partitions;
+  *handle = ++otaHandle;
+
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* data, size_t size) {
+  std::lock_guard<std::mutex> guard(otaLock);
+
+  if (handle == 0 || handle != otaHandle) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  HostPartition& target = partitions[otaPartition];
+
+  if (target.image.size() + size > target.partition.size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  // The device checks the magic byte with the first write.
+  if (target.image.empty() && size > 0 && *(const uint8_t*)data != ESP_IMAGE_MAGIC) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+
+  target.image.insert(target.image.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle) {
+  std::lock_guard<std::mutex> guard(otaLock);
+
+  if (handle == 0 || handle != otaHandle) {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  otaHandle++;
+  HostPartition& target = partitions[otaPartition];
+
+  if (target.image.empty() || target.image[0] != ESP_IMAGE_MAGIC) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+
+  target.state = ESP_OTA_IMG_NEW;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle) {
+  std::lock_guard<std::mutex> guard(otaLock);
+
+  if (handle == 0 || handle != otaHandle) {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  otaHandle++;
+  partitions[otaPartition].image.clear();
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition) {
+  std::lock_guard<std::mutex> guard(otaLock);
+  HostPartition* target = findPartition(partition);
+
+  if (target == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (target != &partitions[runningPartition] && target->state != ESP_OTA_IMG_NEW) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+
+  bootPartition = target - partitions;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* partition, esp_ota_img_states_t* state) {
+  std::lock_guard<std::mutex> guard(otaLock);
+  HostPartition* target = findPartition(partition);
+
+  if (target == nullptr || state == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (target->state == ESP_OTA_IMG_UNDEFINED) {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  *state = target->state;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() {
+  std::lock_guard<std::mutex> guard(otaLock);
+  partitions[runningPartition].state = ESP_OTA_IMG_VALID;
+  return ESP_OK;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* data, uint32_t length) {
+  // CRC-32 with the reflected polynomial, like the ROM function.
+  crc = ~crc;
+
+  for (uint32_t i = 0; i < length; ++i) {
+    crc ^= data[i];
+
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+
+  return ~crc;
+}
\ No newline at end of file
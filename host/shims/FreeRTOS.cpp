@@ -0,0 +1,169 @@
+/**
+* @file FreeRTOS.cpp
+* @brief Host implementation of the FreeRTOS task and semaphore API.
+*
+* See freertos/FreeRTOS.h and freertos/task.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "Arduino.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Structure of a task running on its own thread.
+struct HostTask {
+  TaskFunction_t function;  // Function of the task.
+  void* parameter;          // Parameter passed to the function.
+  int core;                 // Core the task is pinned to.
+};
+
+// Structure of a mutex, recursive or not.
+struct HostSemaphore {
+  bool isRecursive;
+  std::timed_mutex mutex;
+  std::recursive_timed_mutex recursiveMutex;
+};
+
+// Thrown by vTaskDelete() to end the calling task.
+struct HostTaskDeleted {};
+
+// The loop task of the Arduino core runs on core 1.
+static thread_local int currentCore = 1;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  HostTask* task = new HostTask{ function, parameter, core };
+
+  std::thread([task]() {
+    currentCore = task->core;
+
+    try {
+      task->function(task->parameter);
+    } catch (const HostTaskDeleted&) {
+    }
+  }).detach();
+
+  if (handle != nullptr) {
+    *handle = task;
+  }
+
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t ticks) {
+  *previousWakeTime += ticks;
+  TickType_t now = xTaskGetTickCount();
+
+  if ((int32_t)(*previousWakeTime - now) > 0) {
+    vTaskDelay(*previousWakeTime - now);
+  }
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)millis();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return 0;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  // Only a task can end itself, the host cannot stop another thread.
+  if (task == nullptr) {
+    throw HostTaskDeleted();
+  }
+}
+
+int xPortGetCoreID() {
+  return currentCore;
+}
+
+void portENTER_CRITICAL(portMUX_TYPE* lock) {
+  uint32_t unlocked = 0;
+
+  while (!__atomic_compare_exchange_n(&lock->owner, &unlocked, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    unlocked = 0;
+    std::this_thread::yield();
+  }
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE* lock) {
+  __atomic_store_n(&lock->owner, 0, __ATOMIC_RELEASE);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  HostSemaphore* semaphore = new HostSemaphore();
+  semaphore->isRecursive = false;
+  return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  HostSemaphore* semaphore = new HostSemaphore();
+  semaphore->isRecursive = true;
+  return semaphore;
+}
+
+// Take a mutex, waiting at most the given ticks.
+template <typename Mutex>
+static BaseType_t take(Mutex& mutex, TickType_t ticks) {
+  if (ticks == portMAX_DELAY) {
+    mutex.lock();
+    return pdTRUE;
+  }
+
+  return mutex.try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+  HostSemaphore* semaphore = static_cast<HostSemaphore*>(handle);
+  return semaphore->isRecursive ? take(semaphore->recursiveMutex, ticks) : take(semaphore->mutex, ticks);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+  HostSemaphore* semaphore = static_cast<HostSemaphore*>(handle);
+
+  if (semaphore->isRecursive) {
+    semaphore->recursiveMutex.unlock();
+  } else {
+    semaphore->mutex.unlock();
+  }
+
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t handle, TickType_t ticks) {
+  return xSemaphoreTake(handle, ticks);
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t handle) {
+  return xSemaphoreGive(handle);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t handle) {
+  delete static_cast<HostSemaphore*>(handle);
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+* @file HTTPClient.cpp
+* @brief Host implementation of the ESP32 HTTP client.
+*
+* See HTTPClient.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "HTTPClient.h"
+
+bool HTTPClient::begin(const String& url) {
+  end();
+
+  // Only plain HTTP URLs are supported, like http://host:port/path.
+  if (!url.startsWith("http://")) {
+    return false;
+  }
+
+  String rest = url.substring(7);
+  int pathStart = rest.indexOf('/');
+  String authority = pathStart >= 0 ? rest.substring(0, pathStart) : rest;
+  int portStart = authority.indexOf(':');
+
+  _path = pathStart >= 0 ? rest.substring(pathStart) : String("/");
+  _host = portStart >= 0 ? authority.substring(0, portStart) : authority;
+  _port = portStart >= 0 ? authority.substring(portStart + 1).toInt() : 80;
+
+  return !_host.isEmpty() && _port != 0;
+}
+
+int HTTPClient::GET() {
+  if (!_client.connect(_host.c_str(), _port, _timeout)) {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+
+  char request[512];
+  int length = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: %s\r\nUser-Agent: ESP32HTTPClient\r\nConnection: close\r\n\r\n", _path.c_str(), _host.c_str());
+
+  if (length <= 0 || (size_t)length >= sizeof(request) || _client.write((const uint8_t*)request, length) != (size_t)length) {
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+  }
+
+  unsigned long startedAt = millis();
+  char line[256];
+
+  if (!readLine(line, sizeof(line), startedAt)) {
+    return HTTPC_ERROR_READ_TIMEOUT;
+  }
+
+  int status = 0;
+
+  if (sscanf(line, "HTTP/1.%*d %d", &status) != 1) {
+    return HTTPC_ERROR_NOT_CONNECTED;
+  }
+
+  // Keep the Content-Length, the body is left in the stream.
+  _size = -1;
+
+  while (readLine(line, sizeof(line), startedAt)) {
+    if (line[0] == '\0') {
+      return status;
+    }
+
+    if (strncasecmp(line, "Content-Length:", 15) == 0) {
+      _size = atoi(line + 15);
+    }
+  }
+
+  return HTTPC_ERROR_READ_TIMEOUT;
+}
+
+bool HTTPClient::readLine(char* line, size_t size, unsigned long startedAt) {
+  size_t length = 0;
+
+  while (millis() - startedAt < _timeout) {
+    int character = _client.read();
+
+    if (character < 0) {
+      if (!_client.connected()) {
+        return false;
+      }
+
+      delay(1);
+      continue;
+    }
+
+    if (character == '\n') {
+      // Drop the carriage return of the line break.
+      if (length > 0 && line[length - 1] == '\r') {
+        length--;
+      }
+
+      line[length] = '\0';
+      return true;
+    }
+
+    if (length < size - 1) {
+      line[length++] = (char)character;
+    }
+  }
+
+  return false;
+}
+
+void HTTPClient::end() {
+  _client.stop();
+  _size = -1;
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED:
+      return String("connection refused");
+    case HTTPC_ERROR_SEND_HEADER_FAILED:
+      return String("send header failed");
+    case HTTPC_ERROR_NOT_CONNECTED:
+      return String("not connected");
+    case HTTPC_ERROR_READ_TIMEOUT:
+      return String("read Timeout");
+  }
+
+  return String();
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+* @file HTTPClient.h
+* @brief Host implementation of the ESP32 HTTP client.
+*
+* Sends GET requests over a WiFiClient and exposes the response body as a stream,
+* enough to download a firmware image from a local HTTP server.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTP_CODE_OK 200
+
+// Define the errors returned instead of a status code.
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+  bool begin(const String& url);
+  int GET();
+  int getSize() { return _size; }
+  WiFiClient* getStreamPtr() { return &_client; }
+  WiFiClient& getStream() { return _client; }
+  void setTimeout(uint16_t timeout) { _timeout = timeout; }
+  void end();
+  static String errorToString(int error);
+
+private:
+  WiFiClient _client;
+  String _host;
+  String _path;
+  uint16_t _port = 80;
+  uint16_t _timeout = 5000;  // Time in milliseconds to wait for the response headers.
+  int _size = -1;            // Content-Length of the response, or -1 if unknown.
+
+  bool readLine(char* line, size_t size, unsigned long startedAt);
+};
+
+#endif
\ No newline at end of file
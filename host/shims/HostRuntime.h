@@ -0,0 +1,89 @@
+/**
+* @file HostRuntime.h
+* @brief Controls of the host runtime for the host firmware, tests and benchmarks.
+*
+* The host firmware reads the same settings from the environment:
+* SMAF_HOST_PORT_OFFSET shifts the ports of all servers, e.g. 8000 serves port 80 on
+* 8080, SMAF_HOST_STORAGE names the file keeping the preferences across restarts
+* and SMAF_HOST_QUIET discards the serial output.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+* @brief Keep the command line, a restart runs the host firmware again with it.
+*/
+void hostSetArguments(int argc, char** argv);
+
+/**
+* @brief Replace the restart of the device, e.g. to end a test instead.
+*
+* @param handler Called by ESP.restart() and the watchdog, or nullptr to run the
+*                host firmware again.
+*/
+void hostSetRestartHandler(void (*handler)());
+
+/**
+* @brief Move millis(), micros() and esp_timer_get_time() forward.
+*
+* Lets tests pass timeouts without waiting for them.
+*/
+void hostAdvanceTime(uint32_t ms);
+
+/**
+* @brief Send the serial output to a file, or discard it with nullptr.
+*/
+void hostSetSerialOutput(FILE* output);
+
+/**
+* @brief Set the level digitalRead() reports for a pin, HIGH by default.
+*/
+void hostSetPinLevel(uint8_t pin, int level);
+
+/**
+* @brief Shift the port of every WiFiServer started from now on.
+*/
+void hostSetPortOffset(uint16_t offset);
+
+/**
+* @brief Get the offset added to the port of every WiFiServer.
+*/
+uint16_t hostPortOffset();
+
+/**
+* @brief Keep the preferences in a file, or only in memory with nullptr.
+*
+* Preferences saved in the file are loaded at once.
+*/
+void hostSetStorageFile(const char* path);
+
+/**
+* @brief Remove all preferences from memory, like erasing the NVS partition.
+*/
+void hostClearPreferences();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+* @file IPAddress.h
+* @brief Host implementation of the Arduino IPv4 address.
+*
+*
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef IP_ADDRESS_H
+#define IP_ADDRESS_H
+
+#include <stdint.h>
+
+class String;
+
+class IPAddress {
+public:
+  IPAddress();
+  IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth);
+  IPAddress(uint32_t address);
+
+  String toString() const;
+  uint8_t operator[](int index) const { return _bytes[index & 3]; }
+  operator uint32_t() const;
+  bool operator==(const IPAddress& other) const { return (uint32_t)*this == (uint32_t)other; }
+
+private:
+  uint8_t _bytes[4];  // Address bytes in network order.
+};
+
+#endif
\ No newline at end of file
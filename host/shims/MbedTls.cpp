@@ -0,0 +1,261 @@
+/**
+* @file MbedTls.cpp
+* @brief Host implementation of the mbed TLS base64 and SHA-256 functions.
+*
+* See mbedtls/base64.h and mbedtls/sha256.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "mbedtls/base64.h"
+#include "mbedtls/sha256.h"
+
+static const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int mbedtls_base64_encode(unsigned char* destination, size_t size, size_t* length, const unsigned char* source, size_t sourceLength) {
+  size_t needed = (sourceLength + 2) / 3 * 4;
+
+  // Like mbed TLS, the encoded data is null-terminated.
+  if (destination == nullptr || size < needed + 1) {
+    *length = needed + 1;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+
+  unsigned char* output = destination;
+
+  for (size_t i = 0; i < sourceLength; i += 3) {
+    uint32_t group = (uint32_t)source[i] << 16;
+    size_t count = sourceLength - i < 3 ? sourceLength - i : 3;
+
+    if (count > 1) {
+      group |= (uint32_t)source[i + 1] << 8;
+    }
+
+    if (count > 2) {
+      group |= source[i + 2];
+    }
+
+    *output++ = BASE64_ALPHABET[(group >> 18) & 0x3F];
+    *output++ = BASE64_ALPHABET[(group >> 12) & 0x3F];
+    *output++ = count > 1 ? BASE64_ALPHABET[(group >> 6) & 0x3F] : '=';
+    *output++ = count > 2 ? BASE64_ALPHABET[group & 0x3F] : '=';
+  }
+
+  *output = '\0';
+  *length = output - destination;
+
+  return 0;
+}
+
+// Get the value of a base64 character, or -1.
+static int base64Value(unsigned char character) {
+  const char* position = character != '\0' ? strchr(BASE64_ALPHABET, character) : nullptr;
+  return position != nullptr ? (int)(position - BASE64_ALPHABET) : -1;
+}
+
+int mbedtls_base64_decode(unsigned char* destination, size_t size, size_t* length, const unsigned char* source, size_t sourceLength) {
+  size_t characters = 0;
+  size_t padding = 0;
+
+  // Check the input first, line breaks are allowed between groups like in mbed TLS.
+  for (size_t i = 0; i < sourceLength; ++i) {
+    unsigned char character = source[i];
+
+    if (character == '\r' || character == '\n' || character == ' ') {
+      continue;
+    }
+
+    if (character == '=') {
+      if (++padding > 2) {
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+      }
+    } else if (padding > 0 || base64Value(character) < 0) {
+      return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+
+    characters++;
+  }
+
+  if (characters % 4 != 0) {
+    return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+  }
+
+  size_t needed = characters / 4 * 3 - padding;
+
+  if (destination == nullptr || size < needed) {
+    *length = needed;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+
+  uint32_t group = 0;
+  size_t count = 0;
+  size_t written = 0;
+
+  for (size_t i = 0; i < sourceLength; ++i) {
+    int value = source[i] == '=' ? 0 : base64Value(source[i]);
+
+    if (value < 0) {
+      continue;
+    }
+
+    group = (group << 6) | value;
+
+    if (++count == 4) {
+      unsigned char bytes[3] = { (unsigned char)(group >> 16), (unsigned char)(group >> 8), (unsigned char)group };
+
+      for (size_t j = 0; j < 3 && written < needed; ++j) {
+        destination[written++] = bytes[j];
+      }
+
+      group = 0;
+      count = 0;
+    }
+  }
+
+  *length = written;
+
+  return 0;
+}
+
+static const uint32_t SHA256_ROUND_CONSTANTS[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotateRight(uint32_t value, uint8_t count) {
+  return (value >> count) | (value << (32 - count));
+}
+
+// Hash one 64-byte block into the state.
+static void sha256Block(uint32_t state[8], const unsigned char block[64]) {
+  uint32_t words[64];
+
+  for (uint8_t i = 0; i < 16; ++i) {
+    words[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) | ((uint32_t)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+  }
+
+  for (uint8_t i = 16; i < 64; ++i) {
+    uint32_t s0 = rotateRight(words[i - 15], 7) ^ rotateRight(words[i - 15], 18) ^ (words[i - 15] >> 3);
+    uint32_t s1 = rotateRight(words[i - 2], 17) ^ rotateRight(words[i - 2], 19) ^ (words[i - 2] >> 10);
+    words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (uint8_t i = 0; i < 64; ++i) {
+    uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+    uint32_t choice = (e & f) ^ (~e & g);
+    uint32_t first = h + s1 + choice + SHA256_ROUND_CONSTANTS[i] + words[i];
+    uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+    uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t second = s0 + majority;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + first;
+    d = c;
+    c = b;
+    b = a;
+    a = first + second;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context* context) {
+  memset(context, 0, sizeof(*context));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* context) {
+  memset(context, 0, sizeof(*context));
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* context, int is224) {
+  static const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+  // Only SHA-256 is needed on the host.
+  if (is224 != 0) {
+    return -1;
+  }
+
+  memcpy(context->state, initialState, sizeof(initialState));
+  context->length = 0;
+
+  return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* context, const unsigned char* data, size_t length) {
+  size_t buffered = context->length % 64;
+  context->length += length;
+
+  while (length > 0) {
+    size_t count = 64 - buffered < length ? 64 - buffered : length;
+    memcpy(context->block + buffered, data, count);
+    buffered += count;
+    data += count;
+    length -= count;
+
+    if (buffered == 64) {
+      sha256Block(context->state, context->block);
+      buffered = 0;
+    }
+  }
+
+  return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* context, unsigned char output[32]) {
+  uint64_t bits = context->length * 8;
+  size_t buffered = context->length % 64;
+  unsigned char padding[72] = { 0x80 };
+  size_t paddingLength = (buffered < 56 ? 56 : 120) - buffered;
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    padding[paddingLength + i] = (unsigned char)(bits >> (56 - i * 8));
+  }
+
+  mbedtls_sha256_update(context, padding, paddingLength + 8);
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    output[i * 4] = (unsigned char)(context->state[i] >> 24);
+    output[i * 4 + 1] = (unsigned char)(context->state[i] >> 16);
+    output[i * 4 + 2] = (unsigned char)(context->state[i] >> 8);
+    output[i * 4 + 3] = (unsigned char)context->state[i];
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+/**
+* @file MqttPacket.cpp
+* @brief Encoding of the MQTT 3.1.1 packets used by the host MQTT client and broker.
+*
+* See MqttPacket.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "MqttPacket.h"
+
+// Define the largest remaining length MQTT can encode.
+#define MQTT_MAX_REMAINING_LENGTH 268435455
+
+// Write the fixed header and return its size, or 0 if the packet does not fit.
+static size_t writeHeader(uint8_t* buffer, size_t size, uint8_t type, size_t remainingLength) {
+  if (remainingLength > MQTT_MAX_REMAINING_LENGTH) {
+    return 0;
+  }
+
+  uint8_t header[MQTT_MAX_HEADER_SIZE];
+  size_t headerSize = 0;
+  header[headerSize++] = type;
+
+  do {
+    uint8_t digit = remainingLength % 128;
+    remainingLength /= 128;
+    header[headerSize++] = remainingLength > 0 ? digit | 0x80 : digit;
+  } while (remainingLength > 0);
+
+  if (headerSize > size) {
+    return 0;
+  }
+
+  memcpy(buffer, header, headerSize);
+  return headerSize;
+}
+
+// Append a length-prefixed string.
+static uint8_t* writeString(uint8_t* position, const char* value) {
+  size_t length = strlen(value);
+  *position++ = length >> 8;
+  *position++ = length & 0xFF;
+  memcpy(position, value, length);
+
+  return position + length;
+}
+
+// Return the encoded size of the fixed header for a remaining length.
+static size_t headerSize(size_t remainingLength) {
+  size_t size = 2;
+
+  while (remainingLength >= 128) {
+    remainingLength /= 128;
+    size++;
+  }
+
+  return size;
+}
+
+size_t mqttConnectPacket(uint8_t* buffer, size_t size, const char* id, const char* user, const char* pass, uint16_t keepAlive) {
+  static const uint8_t protocol[] = { 0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04 };
+  uint8_t flags = 0x02;  // Clean session.
+  size_t remainingLength = sizeof(protocol) + 3 + 2 + strlen(id);
+
+  if (user != nullptr) {
+    flags |= 0x80;
+    remainingLength += 2 + strlen(user);
+  }
+
+  if (pass != nullptr) {
+    flags |= 0x40;
+    remainingLength += 2 + strlen(pass);
+  }
+
+  if (headerSize(remainingLength) + remainingLength > size) {
+    return 0;
+  }
+
+  uint8_t* position = buffer + writeHeader(buffer, size, MQTT_PACKET_CONNECT, remainingLength);
+  memcpy(position, protocol, sizeof(protocol));
+  position += sizeof(protocol);
+  *position++ = flags;
+  *position++ = keepAlive >> 8;
+  *position++ = keepAlive & 0xFF;
+  position = writeString(position, id);
+
+  if (user != nullptr) {
+    position = writeString(position, user);
+  }
+
+  if (pass != nullptr) {
+    position = writeString(position, pass);
+  }
+
+  return position - buffer;
+}
+
+size_t mqttPublishPacket(uint8_t* buffer, size_t size, const char* topic, const uint8_t* payload, size_t length, bool isRetained) {
+  size_t remainingLength = 2 + strlen(topic) + length;
+
+  if (headerSize(remainingLength) + remainingLength > size) {
+    return 0;
+  }
+
+  uint8_t type = MQTT_PACKET_PUBLISH | (isRetained ? MQTT_PUBLISH_RETAIN : 0);
+  uint8_t* position = buffer + writeHeader(buffer, size, type, remainingLength);
+  position = writeString(position, topic);
+
+  if (length > 0) {
+    memcpy(position, payload, length);
+  }
+
+  return position + length - buffer;
+}
+
+size_t mqttSubscribePacket(uint8_t* buffer, size_t size, uint8_t type, uint16_t packetId, const char* topic) {
+  bool isSubscribe = type == MQTT_PACKET_SUBSCRIBE;
+  size_t remainingLength = 2 + 2 + strlen(topic) + (isSubscribe ? 1 : 0);
+
+  if (headerSize(remainingLength) + remainingLength > size) {
+    return 0;
+  }
+
+  // SUBSCRIBE and UNSUBSCRIBE have the reserved flags 0010.
+  uint8_t* position = buffer + writeHeader(buffer, size, type | 0x02, remainingLength);
+  *position++ = packetId >> 8;
+  *position++ = packetId & 0xFF;
+  position = writeString(position, topic);
+
+  if (isSubscribe) {
+    *position++ = 0x00;  // Requested QoS.
+  }
+
+  return position - buffer;
+}
+
+size_t mqttSimplePacket(uint8_t* buffer, size_t size, uint8_t type, const uint8_t* body, size_t length) {
+  if (headerSize(length) + length > size) {
+    return 0;
+  }
+
+  uint8_t* position = buffer + writeHeader(buffer, size, type, length);
+
+  if (length > 0) {
+    memcpy(position, body, length);
+  }
+
+  return position + length - buffer;
+}
+
+int mqttDecodeHeader(const uint8_t* data, size_t available, size_t* headerSize, size_t* remainingLength) {
+  size_t length = 0;
+  size_t multiplier = 1;
+
+  for (size_t index = 1; index < MQTT_MAX_HEADER_SIZE; index++) {
+    if (index >= available) {
+      return 0;
+    }
+
+    length += (data[index] & 0x7F) * multiplier;
+    multiplier *= 128;
+
+    if ((data[index] & 0x80) == 0) {
+      *headerSize = index + 1;
+      *remainingLength = length;
+      return 1;
+    }
+  }
+
+  return -1;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+* @file MqttPacket.h
+* @brief Encoding of the MQTT 3.1.1 packets used by the host MQTT client and broker.
+*
+* The functions write complete packets into a caller's buffer and return their
+* length, or 0 if the buffer is too small.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef MQTT_PACKET_H
+#define MQTT_PACKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Define the MQTT control packet types, in the upper four bits of the first byte.
+#define MQTT_PACKET_CONNECT 0x10
+#define MQTT_PACKET_CONNACK 0x20
+#define MQTT_PACKET_PUBLISH 0x30
+#define MQTT_PACKET_SUBSCRIBE 0x80
+#define MQTT_PACKET_SUBACK 0x90
+#define MQTT_PACKET_UNSUBSCRIBE 0xA0
+#define MQTT_PACKET_UNSUBACK 0xB0
+#define MQTT_PACKET_PINGREQ 0xC0
+#define MQTT_PACKET_PINGRESP 0xD0
+#define MQTT_PACKET_DISCONNECT 0xE0
+
+// Define the flag of retained PUBLISH packets.
+#define MQTT_PUBLISH_RETAIN 0x01
+
+// Define the largest size of the fixed header.
+#define MQTT_MAX_HEADER_SIZE 5
+
+/**
+* @brief Write a CONNECT packet with a clean session.
+*
+* @param user The user name, or nullptr to connect without credentials.
+* @param pass The password, or nullptr to send none.
+*/
+size_t mqttConnectPacket(uint8_t* buffer, size_t size, const char* id, const char* user, const char* pass, uint16_t keepAlive);
+
+/**
+* @brief Write a PUBLISH packet with QoS 0.
+*/
+size_t mqttPublishPacket(uint8_t* buffer, size_t size, const char* topic, const uint8_t* payload, size_t length, bool isRetained);
+
+/**
+* @brief Write a SUBSCRIBE packet for QoS 0, or an UNSUBSCRIBE packet.
+*/
+size_t mqttSubscribePacket(uint8_t* buffer, size_t size, uint8_t type, uint16_t packetId, const char* topic);
+
+/**
+* @brief Write a packet that has only a fixed header and an optional packet identifier.
+*
+* Used for CONNACK, SUBACK, UNSUBACK, PINGREQ, PINGRESP and DISCONNECT.
+*
+* @param body The variable header and payload, may be nullptr if length is 0.
+*/
+size_t mqttSimplePacket(uint8_t* buffer, size_t size, uint8_t type, const uint8_t* body, size_t length);
+
+/**
+* @brief Decode the fixed header at the start of received data.
+*
+* @param data The received data.
+* @param available Number of received bytes.
+* @param headerSize Receives the size of the fixed header.
+* @param remainingLength Receives the length of the rest of the packet.
+* @return 1 if the header is complete, 0 if more data is needed, -1 if it is malformed.
+*/
+int mqttDecodeHeader(const uint8_t* data, size_t available, size_t* headerSize, size_t* remainingLength);
+
+#endif
\ No newline at end of file
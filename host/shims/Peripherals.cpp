@@ -0,0 +1,76 @@
+/**
+* @file Peripherals.cpp
+* @brief Host implementation of the NeoPixel, SHT4x and I2C libraries.
+*
+* The peripherals keep their state in memory, so the firmware runs without hardware.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Adafruit_NeoPixel.h"
+#include "Adafruit_SHT4x.h"
+#include "Wire.h"
+
+TwoWire Wire;
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type)
+  : _count(min(count, (uint16_t)NEOPIXEL_HOST_MAX_PIXELS)) {
+  clear();
+}
+
+void Adafruit_NeoPixel::show() {
+  _shows++;
+}
+
+void Adafruit_NeoPixel::clear() {
+  memset(_pixels, 0, sizeof(_pixels));
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint32_t color) {
+  if (index < _count) {
+    _pixels[index] = color;
+  }
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint8_t red, uint8_t green, uint8_t blue) {
+  setPixelColor(index, Color(red, green, blue));
+}
+
+void Adafruit_NeoPixel::fill(uint32_t color, uint16_t first, uint16_t count) {
+  uint16_t last = count == 0 ? _count : min((uint16_t)(first + count), _count);
+
+  for (uint16_t index = first; index < last; index++) {
+    _pixels[index] = color;
+  }
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t index) const {
+  return index < _count ? _pixels[index] : 0;
+}
+
+bool Adafruit_SHT4x::getEvent(sensors_event_t* humidity, sensors_event_t* temperature) {
+  // Drift slowly around room conditions, with a little noise like a real sensor.
+  double minutes = millis() / 60000.0;
+  temperature->temperature = 21.5 + 0.8 * sin(minutes / 7.0) + random(-5, 6) / 100.0;
+  humidity->relative_humidity = 45.0 + 4.0 * cos(minutes / 11.0) + random(-10, 11) / 100.0;
+
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,371 @@
+/**
+* @file Preferences.cpp
+* @brief Host implementation of the ESP32 Preferences library.
+*
+* See Preferences.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "HostRuntime.h"
+#include "Preferences.h"
+
+// Define the longest key and namespace name of NVS.
+#define NVS_KEY_NAME_MAX_SIZE 15
+
+// Define the size of an NVS entry, longer strings and blobs span several.
+#define NVS_ENTRY_SIZE 32
+
+// Enumeration of the types of stored values, a value is only read with its own type.
+enum PreferenceTypeEnum : uint8_t {
+  PREFERENCE_STRING = 1,
+  PREFERENCE_INT,
+  PREFERENCE_UINT,
+  PREFERENCE_USHORT,
+  PREFERENCE_BOOL,
+  PREFERENCE_BYTES
+};
+
+// Structure of a stored value.
+struct PreferenceEntry {
+  uint8_t type;               // Type of the value.
+  std::vector<uint8_t> data;  // Value, strings without the terminator.
+};
+
+typedef std::map<std::string, PreferenceEntry> PreferenceNamespace;
+
+// Namespaces of all sessions, like the NVS partition.
+static std::recursive_mutex storageLock;
+static std::map<std::string, PreferenceNamespace> storage;
+static std::string storageFile;
+static bool isStorageLoaded = false;
+
+// Read a length-prefixed field of the storage file.
+static bool readField(FILE* file, std::string& value) {
+  uint32_t length;
+
+  if (fread(&length, sizeof(length), 1, file) != 1 || length > 65536) {
+    return false;
+  }
+
+  value.resize(length);
+  return length == 0 || fread(&value[0], 1, length, file) == length;
+}
+
+// Write a length-prefixed field of the storage file.
+static void writeField(FILE* file, const void* value, uint32_t length) {
+  fwrite(&length, sizeof(length), 1, file);
+  fwrite(value, 1, length, file);
+}
+
+// Load the storage file once, named by hostSetStorageFile() or SMAF_HOST_STORAGE.
+static void loadStorage() {
+  if (isStorageLoaded) {
+    return;
+  }
+
+  isStorageLoaded = true;
+
+  if (storageFile.empty() && getenv("SMAF_HOST_STORAGE") != nullptr) {
+    storageFile = getenv("SMAF_HOST_STORAGE");
+  }
+
+  FILE* file = storageFile.empty() ? nullptr : fopen(storageFile.c_str(), "rb");
+
+  if (file == nullptr) {
+    return;
+  }
+
+  std::string name;
+  std::string key;
+  std::string data;
+  uint8_t type;
+
+  while (readField(file, name) && readField(file, key) && fread(&type, 1, 1, file) == 1 && readField(file, data)) {
+    storage[name][key] = PreferenceEntry{ type, std::vector<uint8_t>(data.begin(), data.end()) };
+  }
+
+  fclose(file);
+}
+
+// Write all namespaces to the storage file, if there is one.
+static void saveStorage() {
+  if (storageFile.empty()) {
+    return;
+  }
+
+  // Replace the file at once, so a restart never sees a partial file.
+  std::string temporary = storageFile + ".tmp";
+  FILE* file = fopen(temporary.c_str(), "wb");
+
+  if (file == nullptr) {
+    return;
+  }
+
+  for (const auto& name : storage) {
+    for (const auto& entry : name.second) {
+      writeField(file, name.first.data(), name.first.size());
+      writeField(file, entry.first.data(), entry.first.size());
+      fwrite(&entry.second.type, 1, 1, file);
+      writeField(file, entry.second.data.data(), entry.second.data.size());
+    }
+  }
+
+  fclose(file);
+  rename(temporary.c_str(), storageFile.c_str());
+}
+
+void hostSetStorageFile(const char* path) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+  storage.clear();
+  storageFile = path != nullptr ? path : "";
+  isStorageLoaded = false;
+  loadStorage();
+}
+
+void hostClearPreferences() {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+  loadStorage();
+  storage.clear();
+  saveStorage();
+}
+
+bool Preferences::begin(const char* name, bool isReadOnly, const char* partition) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+  loadStorage();
+
+  if (_isStarted || name == nullptr || strlen(name) > NVS_KEY_NAME_MAX_SIZE) {
+    return false;
+  }
+
+  // Like NVS, a namespace that was never written cannot be opened read-only.
+  if (isReadOnly && storage.find(name) == storage.end()) {
+    return false;
+  }
+
+  if (!isReadOnly) {
+    storage[name];
+  }
+
+  _name = name;
+  _isReadOnly = isReadOnly;
+  _isStarted = true;
+
+  return true;
+}
+
+void Preferences::end() {
+  _isStarted = false;
+}
+
+bool Preferences::clear() {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || _isReadOnly) {
+    return false;
+  }
+
+  storage[_name.c_str()].clear();
+  saveStorage();
+
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || _isReadOnly || key == nullptr) {
+    return false;
+  }
+
+  bool isRemoved = storage[_name.c_str()].erase(key) > 0;
+  saveStorage();
+
+  return isRemoved;
+}
+
+bool Preferences::isKey(const char* key) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || key == nullptr) {
+    return false;
+  }
+
+  const PreferenceNamespace& entries = storage[_name.c_str()];
+  return entries.find(key) != entries.end();
+}
+
+size_t Preferences::freeEntries() {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+  size_t used = 0;
+
+  // Every value takes an entry, strings and blobs also the entries holding their data.
+  for (const auto& name : storage) {
+    for (const auto& entry : name.second) {
+      bool isVariable = entry.second.type == PREFERENCE_STRING || entry.second.type == PREFERENCE_BYTES;
+      used += 1 + (isVariable ? (entry.second.data.size() + NVS_ENTRY_SIZE) / NVS_ENTRY_SIZE : 0);
+    }
+  }
+
+  return used < PREFERENCES_HOST_ENTRIES ? PREFERENCES_HOST_ENTRIES - used : 0;
+}
+
+size_t Preferences::put(const char* key, uint8_t type, const void* value, size_t length) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || _isReadOnly || key == nullptr || strlen(key) > NVS_KEY_NAME_MAX_SIZE) {
+    return 0;
+  }
+
+  storage[_name.c_str()][key] = PreferenceEntry{ type, std::vector<uint8_t>((const uint8_t*)value, (const uint8_t*)value + length) };
+  saveStorage();
+
+  return length;
+}
+
+bool Preferences::get(const char* key, uint8_t type, void* value, size_t length) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || key == nullptr) {
+    return false;
+  }
+
+  const PreferenceNamespace& entries = storage[_name.c_str()];
+  auto entry = entries.find(key);
+
+  if (entry == entries.end() || entry->second.type != type || entry->second.data.size() != length) {
+    return false;
+  }
+
+  memcpy(value, entry->second.data.data(), length);
+  return true;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  return value != nullptr ? put(key, PREFERENCE_STRING, value, strlen(value)) : 0;
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t size) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || key == nullptr) {
+    return 0;
+  }
+
+  const PreferenceNamespace& entries = storage[_name.c_str()];
+  auto entry = entries.find(key);
+
+  // Like the ESP32, the length includes the terminator and a too small buffer reads nothing.
+  if (entry == entries.end() || entry->second.type != PREFERENCE_STRING || entry->second.data.size() + 1 > size) {
+    return 0;
+  }
+
+  memcpy(value, entry->second.data.data(), entry->second.data.size());
+  value[entry->second.data.size()] = '\0';
+
+  return entry->second.data.size() + 1;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || key == nullptr) {
+    return defaultValue;
+  }
+
+  const PreferenceNamespace& entries = storage[_name.c_str()];
+  auto entry = entries.find(key);
+
+  if (entry == entries.end() || entry->second.type != PREFERENCE_STRING) {
+    return defaultValue;
+  }
+
+  return String(std::string(entry->second.data.begin(), entry->second.data.end()));
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+  return put(key, PREFERENCE_INT, &value, sizeof(value));
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  int32_t value;
+  return get(key, PREFERENCE_INT, &value, sizeof(value)) ? value : defaultValue;
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+  return put(key, PREFERENCE_UINT, &value, sizeof(value));
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+  uint32_t value;
+  return get(key, PREFERENCE_UINT, &value, sizeof(value)) ? value : defaultValue;
+}
+
+size_t Preferences::putUShort(const char* key, uint16_t value) {
+  return put(key, PREFERENCE_USHORT, &value, sizeof(value));
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) {
+  uint16_t value;
+  return get(key, PREFERENCE_USHORT, &value, sizeof(value)) ? value : defaultValue;
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+  uint8_t stored = value ? 1 : 0;
+  return put(key, PREFERENCE_BOOL, &stored, sizeof(stored));
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+  uint8_t value;
+  return get(key, PREFERENCE_BOOL, &value, sizeof(value)) ? value != 0 : defaultValue;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+  return value != nullptr && length > 0 ? put(key, PREFERENCE_BYTES, value, length) : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* value, size_t size) {
+  size_t length = getBytesLength(key);
+
+  if (length == 0 || length > size) {
+    return 0;
+  }
+
+  return get(key, PREFERENCE_BYTES, value, length) ? length : 0;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  std::lock_guard<std::recursive_mutex> guard(storageLock);
+
+  if (!_isStarted || key == nullptr) {
+    return 0;
+  }
+
+  const PreferenceNamespace& entries = storage[_name.c_str()];
+  auto entry = entries.find(key);
+
+  return entry != entries.end() && entry->second.type == PREFERENCE_BYTES ? entry->second.data.size() : 0;
+}
\ No newline at end of file
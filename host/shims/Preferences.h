@@ -0,0 +1,76 @@
+/**
+* @file Preferences.h
+* @brief Host implementation of the ESP32 Preferences library.
+*
+* Namespaces are kept in memory and shared by all instances, like the NVS partition.
+* If HostRuntime.h names a storage file, every change is written to it, so the
+* preferences survive a restart of the host firmware.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include "Arduino.h"
+
+// Define the number of entries of the emulated NVS partition.
+#define PREFERENCES_HOST_ENTRIES 630
+
+class Preferences {
+public:
+  ~Preferences() { end(); }
+
+  bool begin(const char* name, bool isReadOnly = false, const char* partition = nullptr);
+  void end();
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+  size_t freeEntries();
+
+  size_t putString(const char* key, const char* value);
+  size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+  size_t getString(const char* key, char* value, size_t size);
+  String getString(const char* key, const String& defaultValue = String());
+
+  size_t putInt(const char* key, int32_t value);
+  int32_t getInt(const char* key, int32_t defaultValue = 0);
+  size_t putUInt(const char* key, uint32_t value);
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+  size_t putUShort(const char* key, uint16_t value);
+  uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+  size_t putBool(const char* key, bool value);
+  bool getBool(const char* key, bool defaultValue = false);
+
+  size_t putBytes(const char* key, const void* value, size_t length);
+  size_t getBytes(const char* key, void* value, size_t size);
+  size_t getBytesLength(const char* key);
+
+private:
+  String _name;              // Namespace of the session.
+  bool _isStarted = false;   // True between begin() and end().
+  bool _isReadOnly = false;  // True if the session may not write.
+
+  size_t put(const char* key, uint8_t type, const void* value, size_t length);
+  bool get(const char* key, uint8_t type, void* value, size_t length);
+};
+
+#endif
\ No newline at end of file
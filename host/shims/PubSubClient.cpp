@@ -0,0 +1,310 @@
+/**
+* @file PubSubClient.cpp
+* @brief Host implementation of the PubSubClient MQTT library.
+*
+* See PubSubClient.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "MqttPacket.h"
+#include "PubSubClient.h"
+
+PubSubClient::PubSubClient(Client& client)
+  : _client(client) {
+  setBufferSize(MQTT_MAX_PACKET_SIZE);
+}
+
+PubSubClient::~PubSubClient() {
+  free(_buffer);
+}
+
+PubSubClient& PubSubClient::setServer(const char* domain, uint16_t port) {
+  _domain = domain;
+  _port = port;
+  return *this;
+}
+
+PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
+  _callback = callback;
+  return *this;
+}
+
+PubSubClient& PubSubClient::setKeepAlive(uint16_t keepAlive) {
+  _keepAlive = keepAlive;
+  return *this;
+}
+
+PubSubClient& PubSubClient::setSocketTimeout(uint16_t timeout) {
+  _socketTimeout = timeout;
+  return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+  if (size == 0) {
+    return false;
+  }
+
+  uint8_t* buffer = (uint8_t*)realloc(_buffer, size);
+
+  if (buffer == nullptr) {
+    return false;
+  }
+
+  _buffer = buffer;
+  _bufferSize = size;
+
+  return true;
+}
+
+bool PubSubClient::connect(const char* id) {
+  return connect(id, nullptr, nullptr);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+  if (connected()) {
+    return true;
+  }
+
+  if (_client.connect(_domain.c_str(), _port) != 1) {
+    _state = MQTT_CONNECT_FAILED;
+    return false;
+  }
+
+  size_t length = mqttConnectPacket(_buffer, _bufferSize, id, user, pass, _keepAlive);
+
+  if (length == 0 || !sendPacket(_buffer, length)) {
+    _client.stop();
+    _state = MQTT_CONNECT_FAILED;
+    return false;
+  }
+
+  uint8_t type;
+  length = readPacket(&type, _socketTimeout * 1000UL);
+
+  if (length == 0) {
+    _client.stop();
+    _state = MQTT_CONNECTION_TIMEOUT;
+    return false;
+  }
+
+  // The CONNACK return code is the last byte of the packet.
+  if ((type & 0xF0) != MQTT_PACKET_CONNACK || length != 4 || _buffer[3] != 0) {
+    _client.stop();
+    _state = (type & 0xF0) == MQTT_PACKET_CONNACK && length == 4 ? _buffer[3] : MQTT_CONNECT_FAILED;
+    return false;
+  }
+
+  _lastInActivity = millis();
+  _isPingOutstanding = false;
+  _state = MQTT_CONNECTED;
+
+  return true;
+}
+
+void PubSubClient::disconnect() {
+  uint8_t packet[2];
+  size_t length = mqttSimplePacket(packet, sizeof(packet), MQTT_PACKET_DISCONNECT, nullptr, 0);
+
+  if (_state == MQTT_CONNECTED) {
+    sendPacket(packet, length);
+  }
+
+  _client.stop();
+  _state = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+  return publish(topic, (const uint8_t*)payload, payload != nullptr ? strlen(payload) : 0, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+  return publish(topic, (const uint8_t*)payload, payload != nullptr ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+  if (!connected()) {
+    return false;
+  }
+
+  // Like PubSubClient, packets larger than the buffer are not sent.
+  size_t packetLength = mqttPublishPacket(_buffer, _bufferSize, topic, payload, length, retained);
+  return packetLength > 0 && sendPacket(_buffer, packetLength);
+}
+
+bool PubSubClient::subscribe(const char* topic) {
+  return sendSubscription(MQTT_PACKET_SUBSCRIBE, topic);
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+  return sendSubscription(MQTT_PACKET_UNSUBSCRIBE, topic);
+}
+
+bool PubSubClient::sendSubscription(uint8_t type, const char* topic) {
+  if (!connected()) {
+    return false;
+  }
+
+  _nextPacketId = _nextPacketId == 0xFFFF ? 1 : _nextPacketId + 1;
+  size_t length = mqttSubscribePacket(_buffer, _bufferSize, type, _nextPacketId, topic);
+
+  return length > 0 && sendPacket(_buffer, length);
+}
+
+bool PubSubClient::loop() {
+  if (!connected()) {
+    return false;
+  }
+
+  unsigned long now = millis();
+  unsigned long keepAlive = _keepAlive * 1000UL;
+
+  if (keepAlive > 0 && (now - _lastInActivity > keepAlive || now - _lastOutActivity > keepAlive)) {
+    if (_isPingOutstanding) {
+      _state = MQTT_CONNECTION_TIMEOUT;
+      _client.stop();
+      return false;
+    }
+
+    uint8_t packet[2];
+    size_t length = mqttSimplePacket(packet, sizeof(packet), MQTT_PACKET_PINGREQ, nullptr, 0);
+    sendPacket(packet, length);
+    _lastInActivity = now;
+    _isPingOutstanding = true;
+  }
+
+  while (_client.available() > 0) {
+    uint8_t type;
+    size_t length = readPacket(&type, _socketTimeout * 1000UL);
+
+    if (length == 0) {
+      break;
+    }
+
+    _lastInActivity = millis();
+    size_t headerSize;
+    size_t remainingLength;
+    mqttDecodeHeader(_buffer, length, &headerSize, &remainingLength);
+
+    if ((type & 0xF0) == MQTT_PACKET_PUBLISH && _callback && remainingLength >= 2) {
+      // Move the topic one byte down to terminate it, like PubSubClient.
+      size_t topicLength = (_buffer[headerSize] << 8) | _buffer[headerSize + 1];
+
+      if (2 + topicLength <= remainingLength) {
+        char* topic = (char*)_buffer + headerSize + 1;
+        memmove(topic, _buffer + headerSize + 2, topicLength);
+        topic[topicLength] = '\0';
+        _callback(topic, _buffer + headerSize + 2 + topicLength, remainingLength - 2 - topicLength);
+      }
+    } else if ((type & 0xF0) == MQTT_PACKET_PINGREQ) {
+      uint8_t packet[2];
+      sendPacket(packet, mqttSimplePacket(packet, sizeof(packet), MQTT_PACKET_PINGRESP, nullptr, 0));
+    } else if ((type & 0xF0) == MQTT_PACKET_PINGRESP) {
+      _isPingOutstanding = false;
+    }
+  }
+
+  return connected();
+}
+
+bool PubSubClient::connected() {
+  if (_client.connected()) {
+    return _state == MQTT_CONNECTED;
+  }
+
+  if (_state == MQTT_CONNECTED) {
+    _state = MQTT_CONNECTION_LOST;
+    _client.stop();
+  }
+
+  return false;
+}
+
+bool PubSubClient::sendPacket(const uint8_t* packet, size_t length) {
+  if (_client.write(packet, length) != length) {
+    return false;
+  }
+
+  _lastOutActivity = millis();
+  return true;
+}
+
+bool PubSubClient::readByte(uint8_t* value, unsigned long timeout) {
+  unsigned long startedAt = millis();
+
+  while (_client.available() <= 0) {
+    if (millis() - startedAt >= timeout || !_client.connected()) {
+      return false;
+    }
+
+    delay(1);
+  }
+
+  *value = _client.read();
+  return true;
+}
+
+size_t PubSubClient::readPacket(uint8_t* type, unsigned long timeout) {
+  size_t length = 0;
+  size_t headerSize = 0;
+  size_t remainingLength = 0;
+  uint8_t header[MQTT_MAX_HEADER_SIZE];
+
+  // Read the fixed header byte by byte until its length is complete.
+  while (length < MQTT_MAX_HEADER_SIZE) {
+    if (!readByte(&header[length], timeout)) {
+      return 0;
+    }
+
+    length++;
+    int result = mqttDecodeHeader(header, length, &headerSize, &remainingLength);
+
+    if (result < 0) {
+      return 0;
+    }
+
+    if (result > 0) {
+      break;
+    }
+  }
+
+  *type = header[0];
+  bool isFitting = headerSize + remainingLength <= _bufferSize;
+
+  if (isFitting) {
+    memcpy(_buffer, header, headerSize);
+  }
+
+  // Packets larger than the buffer are read and dropped.
+  for (size_t index = 0; index < remainingLength; index++) {
+    uint8_t value;
+
+    if (!readByte(&value, timeout)) {
+      return 0;
+    }
+
+    if (isFitting) {
+      _buffer[headerSize + index] = value;
+    }
+  }
+
+  return isFitting ? headerSize + remainingLength : 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+* @file PubSubClient.h
+* @brief Host implementation of the PubSubClient MQTT library.
+*
+* A blocking MQTT 3.1.1 client with the API of PubSubClient. It publishes and
+* subscribes with QoS 0 and delivers received messages to the callback from loop().
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef PUB_SUB_CLIENT_H
+#define PUB_SUB_CLIENT_H
+
+#include <functional>
+#include "Arduino.h"
+#include "Client.h"
+
+// Define the defaults of PubSubClient.
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_KEEPALIVE 15
+#define MQTT_SOCKET_TIMEOUT 15
+
+// Define the client states reported by state().
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST -3
+#define MQTT_CONNECT_FAILED -2
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECTED 0
+#define MQTT_CONNECT_BAD_PROTOCOL 1
+#define MQTT_CONNECT_BAD_CLIENT_ID 2
+#define MQTT_CONNECT_UNAVAILABLE 3
+#define MQTT_CONNECT_BAD_CREDENTIALS 4
+#define MQTT_CONNECT_UNAUTHORIZED 5
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+class PubSubClient {
+public:
+  PubSubClient(Client& client);
+  ~PubSubClient();
+
+  PubSubClient& setServer(const char* domain, uint16_t port);
+  PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+  PubSubClient& setKeepAlive(uint16_t keepAlive);
+  PubSubClient& setSocketTimeout(uint16_t timeout);
+  bool setBufferSize(uint16_t size);
+  uint16_t getBufferSize() const { return _bufferSize; }
+
+  bool connect(const char* id);
+  bool connect(const char* id, const char* user, const char* pass);
+  void disconnect();
+  bool publish(const char* topic, const char* payload);
+  bool publish(const char* topic, const char* payload, bool retained);
+  bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+  bool subscribe(const char* topic);
+  bool unsubscribe(const char* topic);
+  bool loop();
+  bool connected();
+  int state() const { return _state; }
+
+private:
+  Client& _client;                                               // Connection to the broker.
+  std::function<void(char*, uint8_t*, unsigned int)> _callback;  // Receives published messages.
+  String _domain;                                                // Address of the broker.
+  uint16_t _port = 1883;                                         // Port of the broker.
+  uint16_t _keepAlive = MQTT_KEEPALIVE;                          // Keep alive interval in seconds.
+  uint16_t _socketTimeout = MQTT_SOCKET_TIMEOUT;                 // Time in seconds to wait for a packet.
+  uint8_t* _buffer = nullptr;                                    // Packet buffer, received packets larger than it are dropped.
+  uint16_t _bufferSize = 0;                                      // Size of the packet buffer.
+  uint16_t _nextPacketId = 1;                                    // Identifier of the next subscription.
+  unsigned long _lastOutActivity = 0;                            // Time the last packet was sent, in milliseconds.
+  unsigned long _lastInActivity = 0;                             // Time the last packet was received, in milliseconds.
+  bool _isPingOutstanding = false;                               // True while a PINGREQ waits for its response.
+  int _state = MQTT_DISCONNECTED;                                // State reported by state().
+
+  bool sendPacket(const uint8_t* packet, size_t length);
+  bool readByte(uint8_t* value, unsigned long timeout);
+  size_t readPacket(uint8_t* type, unsigned long timeout);
+  bool sendSubscription(uint8_t type, const char* topic);
+};
+
+#endif
\ No newline at end of file
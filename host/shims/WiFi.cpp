@@ -0,0 +1,429 @@
+/**
+* @file WiFi.cpp
+* @brief Host implementation of the ESP32 Wi-Fi API, client and server.
+*
+* See WiFi.h, WiFiClient.h and WiFiServer.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "Arduino.h"
+#include "HostRuntime.h"
+#include "WiFi.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+// Define the time in milliseconds an asynchronous scan takes.
+#define WIFI_HOST_SCAN_TIME 1500
+
+// Networks reported by scans.
+struct HostNetwork {
+  const char* ssid;  // Network name.
+  int32_t rssi;      // Signal strength in dBm.
+};
+
+static const HostNetwork HOST_NETWORKS[] = {
+  { "SMAF-Lab", -48 },
+  { "Workshop", -63 },
+  { "Guest", -79 }
+};
+
+// Offset added to server ports, read from SMAF_HOST_PORT_OFFSET until set.
+static int portOffset = -1;
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::status() {
+  return _status;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+  _mode = mode;
+  return true;
+}
+
+wifi_mode_t WiFiClass::getMode() {
+  return _mode;
+}
+
+bool WiFiClass::setAutoReconnect(bool isEnabled) {
+  return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+  // Every network is in range of the host.
+  _status = ssid != nullptr && ssid[0] != '\0' ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+  return _status;
+}
+
+bool WiFiClass::disconnect(bool isWiFiOff) {
+  _status = WL_DISCONNECTED;
+  return true;
+}
+
+IPAddress WiFiClass::localIP() {
+  return _status == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+int32_t WiFiClass::RSSI() {
+  return _status == WL_CONNECTED ? HOST_NETWORKS[0].rssi : 0;
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase) {
+  _mode = _mode == WIFI_STA ? WIFI_AP_STA : WIFI_AP;
+  return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool isWiFiOff) {
+  _mode = _mode == WIFI_AP_STA ? WIFI_STA : WIFI_OFF;
+  return true;
+}
+
+IPAddress WiFiClass::softAPIP() {
+  return IPAddress(127, 0, 0, 1);
+}
+
+int16_t WiFiClass::scanNetworks(bool isAsync, bool isHiddenShown) {
+  _scanStartedAt = millis();
+  _isScanning = true;
+
+  if (!isAsync) {
+    delay(WIFI_HOST_SCAN_TIME);
+    return scanComplete();
+  }
+
+  return WIFI_SCAN_RUNNING;
+}
+
+int16_t WiFiClass::scanComplete() {
+  if (_isScanning && millis() - _scanStartedAt >= WIFI_HOST_SCAN_TIME) {
+    _isScanning = false;
+    _hasScanResults = true;
+  }
+
+  if (_isScanning) {
+    return WIFI_SCAN_RUNNING;
+  }
+
+  return _hasScanResults ? sizeof(HOST_NETWORKS) / sizeof(HOST_NETWORKS[0]) : WIFI_SCAN_FAILED;
+}
+
+void WiFiClass::scanDelete() {
+  _hasScanResults = false;
+}
+
+String WiFiClass::SSID(uint8_t index) {
+  return index < sizeof(HOST_NETWORKS) / sizeof(HOST_NETWORKS[0]) ? String(HOST_NETWORKS[index].ssid) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t index) {
+  return index < sizeof(HOST_NETWORKS) / sizeof(HOST_NETWORKS[0]) ? HOST_NETWORKS[index].rssi : 0;
+}
+
+// Socket shared by the copies of a client, closed with the last copy.
+class WiFiSocket {
+public:
+  explicit WiFiSocket(int fd)
+    : fd(fd) {
+  }
+
+  ~WiFiSocket() {
+    close(fd);
+  }
+
+  int fd;
+};
+
+WiFiClient::WiFiClient() {
+}
+
+WiFiClient::WiFiClient(int fd)
+  : _socket(std::make_shared<WiFiSocket>(fd)) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  return connect(host, port, WIFI_CLIENT_TIMEOUT);
+}
+
+int WiFiClient::connect(IPAddress address, uint16_t port) {
+  return connect(address.toString().c_str(), port, WIFI_CLIENT_TIMEOUT);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeout) {
+  stop();
+
+  struct addrinfo hints = {};
+  struct addrinfo* addresses = nullptr;
+  char service[8];
+
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  snprintf(service, sizeof(service), "%u", port);
+
+  if (getaddrinfo(host, service, &hints, &addresses) != 0) {
+    return 0;
+  }
+
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  if (fd < 0) {
+    freeaddrinfo(addresses);
+    return 0;
+  }
+
+  int result = ::connect(fd, addresses->ai_addr, addresses->ai_addrlen);
+  freeaddrinfo(addresses);
+
+  // Wait for the connection without blocking longer than the timeout.
+  if (result != 0 && errno == EINPROGRESS) {
+    struct pollfd connection = { fd, POLLOUT, 0 };
+    int error = 0;
+    socklen_t length = sizeof(error);
+
+    if (poll(&connection, 1, timeout) == 1 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0) {
+      result = 0;
+    }
+  }
+
+  if (result != 0) {
+    close(fd);
+    return 0;
+  }
+
+  _socket = std::make_shared<WiFiSocket>(fd);
+  return 1;
+}
+
+size_t WiFiClient::write(uint8_t character) {
+  return write(&character, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* data, size_t length) {
+  size_t written = 0;
+
+  while (_socket && written < length) {
+    ssize_t count = send(_socket->fd, data + written, length - written, MSG_NOSIGNAL);
+
+    if (count > 0) {
+      written += count;
+      continue;
+    }
+
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      struct pollfd connection = { _socket->fd, POLLOUT, 0 };
+
+      if (poll(&connection, 1, WIFI_CLIENT_TIMEOUT) == 1) {
+        continue;
+      }
+    }
+
+    break;
+  }
+
+  return written;
+}
+
+int WiFiClient::available() {
+  int count = 0;
+
+  if (!_socket || ioctl(_socket->fd, FIONREAD, &count) != 0) {
+    return 0;
+  }
+
+  return count;
+}
+
+int WiFiClient::read() {
+  uint8_t character;
+  return read(&character, 1) == 1 ? character : -1;
+}
+
+int WiFiClient::read(uint8_t* data, size_t length) {
+  if (!_socket) {
+    return -1;
+  }
+
+  ssize_t count = recv(_socket->fd, data, length, MSG_DONTWAIT);
+  return count > 0 ? (int)count : -1;
+}
+
+int WiFiClient::peek() {
+  uint8_t character;
+
+  if (!_socket || recv(_socket->fd, &character, 1, MSG_DONTWAIT | MSG_PEEK) != 1) {
+    return -1;
+  }
+
+  return character;
+}
+
+void WiFiClient::stop() {
+  _socket.reset();
+}
+
+uint8_t WiFiClient::connected() {
+  if (!_socket) {
+    return 0;
+  }
+
+  // Data that is not read yet counts as connected, like on the ESP32.
+  uint8_t character;
+  ssize_t count = recv(_socket->fd, &character, 1, MSG_DONTWAIT | MSG_PEEK);
+
+  if (count > 0 || (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+    return 1;
+  }
+
+  return 0;
+}
+
+WiFiClient::operator bool() {
+  return connected();
+}
+
+bool WiFiClient::operator==(const WiFiClient& other) const {
+  return _socket == other._socket;
+}
+
+int WiFiClient::setNoDelay(bool isEnabled) {
+  int flag = isEnabled ? 1 : 0;
+  return _socket ? setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) : -1;
+}
+
+int WiFiClient::fd() const {
+  return _socket ? _socket->fd : -1;
+}
+
+// Get the address of the peer of a socket.
+static bool peerAddress(int fd, struct sockaddr_in* address) {
+  socklen_t length = sizeof(*address);
+  return fd >= 0 && getpeername(fd, (struct sockaddr*)address, &length) == 0 && address->sin_family == AF_INET;
+}
+
+IPAddress WiFiClient::remoteIP() const {
+  struct sockaddr_in address;
+  return peerAddress(fd(), &address) ? IPAddress(address.sin_addr.s_addr) : IPAddress();
+}
+
+uint16_t WiFiClient::remotePort() const {
+  struct sockaddr_in address;
+  return peerAddress(fd(), &address) ? ntohs(address.sin_port) : 0;
+}
+
+void hostSetPortOffset(uint16_t offset) {
+  portOffset = offset;
+}
+
+uint16_t hostPortOffset() {
+  if (portOffset < 0) {
+    const char* offset = getenv("SMAF_HOST_PORT_OFFSET");
+    portOffset = offset != nullptr ? atoi(offset) : 0;
+  }
+
+  return portOffset;
+}
+
+WiFiServer::WiFiServer(uint16_t port, uint8_t maxClients)
+  : _port(port),
+    _maxClients(maxClients) {
+}
+
+WiFiServer::~WiFiServer() {
+  end();
+}
+
+void WiFiServer::begin(uint16_t port) {
+  end();
+
+  if (port != 0) {
+    _port = port;
+  }
+
+  _fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  if (_fd < 0) {
+    return;
+  }
+
+  int reuse = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(_port + hostPortOffset());
+
+  if (bind(_fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(_fd, _maxClients) != 0) {
+    fprintf(stderr, "E WiFiServer: listening on port %u failed: %s\n", _port + hostPortOffset(), strerror(errno));
+    close(_fd);
+    _fd = -1;
+    return;
+  }
+
+  socklen_t length = sizeof(address);
+  getsockname(_fd, (struct sockaddr*)&address, &length);
+  _boundPort = ntohs(address.sin_port);
+}
+
+void WiFiServer::end() {
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+
+  _boundPort = 0;
+}
+
+WiFiClient WiFiServer::accept() {
+  if (_fd < 0) {
+    return WiFiClient();
+  }
+
+  int fd = accept4(_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+  if (fd < 0) {
+    return WiFiClient();
+  }
+
+  WiFiClient client(fd);
+
+  if (_isNoDelay) {
+    client.setNoDelay(true);
+  }
+
+  return client;
+}
+
+bool WiFiServer::hasClient() {
+  struct pollfd server = { _fd, POLLIN, 0 };
+  return _fd >= 0 && poll(&server, 1, 0) == 1;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+* @file WiFi.h
+* @brief Host implementation of the ESP32 Wi-Fi API.
+*
+* Joining a network succeeds at once and the device is reachable on the host loopback
+* address. Scans report a fixed list of networks after a short delay, so the
+* configuration page can be tried out on the host.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef WIFI_H
+#define WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+// Define the results of an asynchronous scan that has no networks yet.
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+enum wl_status_t {
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL,
+  WL_SCAN_COMPLETED,
+  WL_CONNECTED,
+  WL_CONNECT_FAILED,
+  WL_CONNECTION_LOST,
+  WL_DISCONNECTED
+};
+
+enum wifi_mode_t {
+  WIFI_OFF,
+  WIFI_STA,
+  WIFI_AP,
+  WIFI_AP_STA
+};
+
+class WiFiClass {
+public:
+  wl_status_t status();
+  bool mode(wifi_mode_t mode);
+  wifi_mode_t getMode();
+  bool setAutoReconnect(bool isEnabled);
+  wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+  bool disconnect(bool isWiFiOff = false);
+  IPAddress localIP();
+  int32_t RSSI();
+
+  bool softAP(const char* ssid, const char* passphrase = nullptr);
+  bool softAPdisconnect(bool isWiFiOff = false);
+  IPAddress softAPIP();
+
+  int16_t scanNetworks(bool isAsync = false, bool isHiddenShown = false);
+  int16_t scanComplete();
+  void scanDelete();
+  String SSID(uint8_t index);
+  int32_t RSSI(uint8_t index);
+
+private:
+  wl_status_t _status = WL_DISCONNECTED;  // Station status.
+  wifi_mode_t _mode = WIFI_OFF;           // Enabled interfaces.
+  unsigned long _scanStartedAt = 0;       // Time the scan started, in milliseconds.
+  bool _isScanning = false;               // True while a scan runs.
+  bool _hasScanResults = false;           // True once a scan completed.
+};
+
+extern WiFiClass WiFi;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+* @file WiFiClient.h
+* @brief Host implementation of the ESP32 Wi-Fi TCP client.
+*
+* The client wraps a TCP socket of the host. Copies share the socket, which is closed
+* when the last copy is stopped or destroyed, like on the ESP32. Reads never block,
+* writes block until the data is sent or the timeout passes.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef WIFI_CLIENT_H
+#define WIFI_CLIENT_H
+
+#include <memory>
+#include "Arduino.h"
+#include "Client.h"
+
+// Define the time in milliseconds connect() and write() wait.
+#define WIFI_CLIENT_TIMEOUT 3000
+
+class WiFiSocket;
+
+class WiFiClient : public Client {
+public:
+  WiFiClient();
+  explicit WiFiClient(int fd);
+
+  int connect(const char* host, uint16_t port) override;
+  int connect(const char* host, uint16_t port, int32_t timeout);
+  int connect(IPAddress address, uint16_t port);
+  size_t write(uint8_t character) override;
+  size_t write(const uint8_t* data, size_t length) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t* data, size_t length) override;
+  int peek() override;
+  void flush() override {}
+  void stop() override;
+  uint8_t connected() override;
+  operator bool() override;
+  bool operator==(const WiFiClient& other) const;
+  bool operator!=(const WiFiClient& other) const { return !(*this == other); }
+
+  int setNoDelay(bool isEnabled);
+  int fd() const;
+  IPAddress remoteIP() const;
+  uint16_t remotePort() const;
+
+  using Print::write;
+
+private:
+  std::shared_ptr<WiFiSocket> _socket;  // Socket shared by all copies.
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+* @file WiFiServer.h
+* @brief Host implementation of the ESP32 Wi-Fi TCP server.
+*
+* The server listens on a TCP port of the host. As ports below 1024 need privileges,
+* HostRuntime.h can shift every server port by an offset.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef WIFI_SERVER_H
+#define WIFI_SERVER_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+class WiFiServer {
+public:
+  WiFiServer(uint16_t port = 80, uint8_t maxClients = 4);
+  ~WiFiServer();
+
+  void begin(uint16_t port = 0);
+  void end();
+  WiFiClient accept();
+  WiFiClient available() { return accept(); }
+  bool hasClient();
+  void setNoDelay(bool isEnabled) { _isNoDelay = isEnabled; }
+  operator bool() { return _fd >= 0; }
+
+  uint16_t port() const { return _boundPort; }
+
+private:
+  uint16_t _port;           // Port of the device.
+  uint16_t _boundPort = 0;  // Port of the host, after the offset.
+  uint8_t _maxClients;      // Backlog of pending connections.
+  int _fd = -1;             // Listening socket.
+  bool _isNoDelay = false;  // True if accepted clients send without delay.
+};
+
+#endif
\ No newline at end of file
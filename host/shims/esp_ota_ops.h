@@ -0,0 +1,64 @@
+/**
+* @file esp_ota_ops.h
+* @brief Host implementation of the ESP-IDF OTA API.
+*
+* Two app partitions are emulated in memory. An image is valid if it starts with the
+* ESP image magic byte, and its boot and verification state follow the device.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef ESP_OTA_OPS_H
+#define ESP_OTA_OPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef uint32_t esp_ota_handle_t;
+
+typedef struct {
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+typedef enum {
+  ESP_OTA_IMG_NEW,
+  ESP_OTA_IMG_PENDING_VERIFY,
+  ESP_OTA_IMG_VALID,
+  ESP_OTA_IMG_INVALID,
+  ESP_OTA_IMG_ABORTED,
+  ESP_OTA_IMG_UNDEFINED
+} esp_ota_img_states_t;
+
+const esp_partition_t* esp_ota_get_running_partition();
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start);
+esp_err_t esp_ota_begin(const esp_partition_t* partition, size_t size, esp_ota_handle_t* handle);
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* data, size_t size);
+esp_err_t esp_ota_end(esp_ota_handle_t handle);
+esp_err_t esp_ota_abort(esp_ota_handle_t handle);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition);
+const esp_partition_t* esp_ota_get_boot_partition();
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* partition, esp_ota_img_states_t* state);
+esp_err_t esp_ota_mark_app_valid_cancel_rollback();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+* @file esp_task_wdt.h
+* @brief Host implementation of the ESP-IDF task watchdog.
+*
+* Subscribed threads that are not reset within the timeout trigger the watchdog,
+* which restarts the host firmware like the device, see HostRuntime.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef ESP_TASK_WDT_H
+#define ESP_TASK_WDT_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct {
+  uint32_t timeout_ms;
+  uint32_t idle_core_mask;
+  bool trigger_panic;
+} esp_task_wdt_config_t;
+
+esp_err_t esp_task_wdt_init(uint32_t timeout, bool panic);
+esp_err_t esp_task_wdt_reconfigure(const esp_task_wdt_config_t* config);
+esp_err_t esp_task_wdt_add(void* task);
+esp_err_t esp_task_wdt_reset();
+esp_err_t esp_task_wdt_delete(void* task);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+* @file task.h
+* @brief Host implementation of the FreeRTOS task API.
+*
+* Tasks run on their own threads. The core a task is pinned to is only reported by
+* xPortGetCoreID(), the host schedules the threads freely.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t ticks);
+TickType_t xTaskGetTickCount();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+void vTaskDelete(TaskHandle_t task);
+int xPortGetCoreID();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+* @file sha256.h
+* @brief Host implementation of the mbed TLS SHA-256 functions.
+*
+*
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef MBEDTLS_SHA256_H
+#define MBEDTLS_SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+  uint32_t state[8];        // Intermediate hash value.
+  uint64_t length;          // Number of hashed bytes.
+  unsigned char block[64];  // Bytes of the incomplete block.
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context* context);
+void mbedtls_sha256_free(mbedtls_sha256_context* context);
+int mbedtls_sha256_starts(mbedtls_sha256_context* context, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context* context, const unsigned char* data, size_t length);
+int mbedtls_sha256_finish(mbedtls_sha256_context* context, unsigned char output[32]);
+
+#endif
\ No newline at end of file
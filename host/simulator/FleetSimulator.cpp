@@ -0,0 +1,724 @@
+/**
+* @file FleetSimulator.cpp
+* @brief Simulates a fleet of SMAF devices against an MQTT broker.
+*
+* Every virtual device follows the firmware: it waits for connectToNetwork() to associate,
+* connects like connectToMqttBroker() with the ConnectionRetry of the firmware between
+* attempts, subscribes to its topic, and publishes a retained constructMqttMessage()
+* sample on every loop. The devices share one epoll loop, so a single process runs
+* thousands of them.
+*
+* The simulator reports broker throughput, the latency from a publish until the device
+* receives it back on its own subscription, and connection attempts over time, as JSON.
+* Without --broker it starts a MiniBroker, which can be taken down with --outage-at and
+* --outage-for to measure the reconnect storm after a broker restart.
+*
+* Usage: fleet_simulator [--devices N] [--duration S] [--broker HOST:PORT]
+*                        [--interval MS] [--boot-window MS] [--network-delay MS]
+*                        [--retry-delay MS] [--retry-max-delay MS]
+*                        [--outage-at S] [--outage-for S] [--output FILE]
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "ConnectionRetry.h"
+#include "Helpers.h"
+#include "MiniBroker.h"
+#include "MqttPacket.h"
+#include "PubSubClient.h"
+#include "WiFiClient.h"
+
+// Define the number of events handled per wait.
+#define SIMULATOR_EVENTS 512
+
+// Enumeration of the states of a virtual device, following connectToMqttBroker().
+enum DeviceStateEnum : byte {
+  DEVICE_JOINING,     // Waiting for connectToNetwork() to associate.
+  DEVICE_CONNECTING,  // TCP connection to the broker in progress.
+  DEVICE_HANDSHAKE,   // CONNECT sent, waiting for CONNACK.
+  DEVICE_BACKOFF,     // Waiting for the next connection attempt.
+  DEVICE_READY        // Connected, publishing a sample on every loop.
+};
+
+// Structure of a virtual device.
+struct VirtualDevice {
+  int fd = -1;                                                    // Connection to the broker.
+  DeviceStateEnum state = DEVICE_JOINING;                         // Step of the firmware the device is in.
+  ConnectionRetry retry{MQTT_RETRY_DELAY, MQTT_RETRY_MAX_DELAY};  // Pace of the connection attempts.
+  int64_t wakeAt = 0;                                             // Time of the pending timer in microseconds, 0 for none.
+  int64_t attemptStartedAt = 0;                                   // Time the connection attempt started in microseconds.
+  std::vector<uint8_t> input;                                     // Received bytes of incomplete packets.
+  std::string output;                                             // Bytes waiting for the socket to accept them.
+  std::deque<int64_t> publishedAt;                                // Times of the publishes not received back yet.
+  std::string topic;                                              // Topic the device publishes and subscribes to.
+  std::string clientId;                                           // MQTT client identifier.
+};
+
+// Structure of the counters of one second of the simulation.
+struct TimelineSecond {
+  uint32_t attempts = 0;    // Connection attempts started.
+  uint32_t successes = 0;   // Connections accepted by the broker.
+  uint32_t deliveries = 0;  // Publishes received back by their device.
+  uint32_t connected = 0;   // Connected devices at the end of the second.
+};
+
+// Structure of the command line options.
+struct SimulatorOptions {
+  uint32_t devices = 1000;                        // Number of virtual devices.
+  uint32_t duration = 60;                         // Length of the simulation in seconds.
+  std::string brokerHost;                         // External broker, empty to start a MiniBroker.
+  uint16_t brokerPort = 1883;                     // Port of the external broker.
+  uint32_t interval = LOOP_INTERVAL;              // Time between samples in milliseconds.
+  uint32_t bootWindow = 0;                        // Devices power on spread over this time in milliseconds.
+  uint32_t networkDelay = NETWORK_RETRY_DELAY;    // Time to associate with Wi-Fi in milliseconds.
+  uint32_t retryDelay = MQTT_RETRY_DELAY;         // Base delay between connection attempts in milliseconds.
+  uint32_t retryMaxDelay = MQTT_RETRY_MAX_DELAY;  // Upper bound of the delay in milliseconds.
+  int32_t outageAt = -1;                          // Second the MiniBroker goes down, -1 for none.
+  uint32_t outageFor = 0;                         // Length of the outage in seconds.
+  const char* output = nullptr;                   // JSON output file, nullptr for stdout.
+};
+
+class FleetSimulator {
+public:
+  FleetSimulator(const SimulatorOptions& options);
+  ~FleetSimulator();
+
+  bool start();
+  void run();
+  void report(FILE* output);
+
+private:
+  typedef std::pair<int64_t, uint32_t> Timer;
+
+  SimulatorOptions _options;                                                    // Command line options.
+  MiniBroker _broker;                                                           // Broker used without --broker.
+  sockaddr_storage _brokerAddress = {};                                         // Address devices connect to.
+  socklen_t _brokerAddressLength = 0;                                           // Length of the address.
+  int _epollFd = -1;                                                            // Readiness of all device sockets.
+  std::chrono::steady_clock::time_point _startedAt;                             // Start of the simulation.
+  std::vector<VirtualDevice> _devices;                                          // The simulated fleet.
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> _timers;  // Pending device timers.
+  std::vector<TimelineSecond> _timeline;                                        // Counters by second.
+  std::vector<int64_t> _latencies;                                              // Publish latencies in microseconds.
+  std::vector<int64_t> _connectLatencies;                                       // Attempt to CONNACK in microseconds.
+  uint32_t _connected = 0;                                                      // Devices in DEVICE_READY.
+  uint64_t _publishes = 0;                                                      // Publishes sent.
+  uint64_t _deliveries = 0;                                                     // Publishes received back.
+  uint64_t _retainedDeliveries = 0;                                             // Retained messages received on subscribe.
+  uint64_t _lostPublishes = 0;                                                  // Publishes lost with their connection.
+  uint64_t _attempts = 0;                                                       // Connection attempts.
+  uint64_t _failures = 0;                                                       // Failed connection attempts.
+  int64_t _outageEndedAt = -1;                                                  // End of the outage in microseconds.
+  int64_t _recoveredAt = -1;                                                    // All devices connected again after it.
+
+  int64_t now() const;
+  void schedule(uint32_t index, int64_t at);
+  void wake(uint32_t index);
+  void startConnection(uint32_t index);
+  void failConnection(uint32_t index);
+  void closeConnection(uint32_t index);
+  void connected(uint32_t index);
+  void publishSample(uint32_t index);
+  void send(uint32_t index, const uint8_t* data, size_t length);
+  void flush(uint32_t index);
+  void receive(uint32_t index);
+  void handlePacket(uint32_t index, const uint8_t* packet, size_t headerSize, size_t length);
+  TimelineSecond& second();
+};
+
+FleetSimulator::FleetSimulator(const SimulatorOptions& options)
+  : _options(options), _devices(options.devices), _timeline(options.duration + 1) {
+  for (uint32_t index = 0; index < _devices.size(); index++) {
+    char name[32];
+    snprintf(name, sizeof(name), "smaf-sim-%05u", index);
+    _devices[index].clientId = name;
+    snprintf(name, sizeof(name), "smaf/sim/%05u", index);
+    _devices[index].topic = name;
+    _devices[index].retry = ConnectionRetry(options.retryDelay, options.retryMaxDelay);
+  }
+}
+
+FleetSimulator::~FleetSimulator() {
+  for (uint32_t index = 0; index < _devices.size(); index++) {
+    closeConnection(index);
+  }
+
+  if (_epollFd >= 0) {
+    close(_epollFd);
+  }
+
+  _broker.stop();
+}
+
+bool FleetSimulator::start() {
+  std::string host = _options.brokerHost;
+  uint16_t port = _options.brokerPort;
+
+  if (host.empty()) {
+    if (!_broker.start()) {
+      fprintf(stderr, "Starting the broker failed.\n");
+      return false;
+    }
+
+    host = "127.0.0.1";
+    port = _broker.port();
+  }
+
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+
+  if (getaddrinfo(host.c_str(), String(port).c_str(), &hints, &result) != 0 || result == nullptr) {
+    fprintf(stderr, "Resolving broker '%s' failed.\n", host.c_str());
+    return false;
+  }
+
+  memcpy(&_brokerAddress, result->ai_addr, result->ai_addrlen);
+  _brokerAddressLength = result->ai_addrlen;
+  freeaddrinfo(result);
+
+  _epollFd = epoll_create1(EPOLL_CLOEXEC);
+  _startedAt = std::chrono::steady_clock::now();
+
+  // Power the devices on, spread over the boot window, and let them associate.
+  ConnectionRetry networkRetry(_options.networkDelay);
+
+  for (uint32_t index = 0; index < _devices.size(); index++) {
+    uint32_t bootAt = _options.bootWindow > 0 ? random(_options.bootWindow) : 0;
+    schedule(index, (bootAt + networkRetry.nextDelay()) * 1000LL + 1);
+  }
+
+  return _epollFd >= 0;
+}
+
+void FleetSimulator::run() {
+  int64_t endAt = _options.duration * 1000000LL;
+  int64_t outageStartAt = _options.outageAt >= 0 ? _options.outageAt * 1000000LL : -1;
+  int64_t outageEndAt = outageStartAt + _options.outageFor * 1000000LL;
+  bool isOutageStarted = false;
+  epoll_event events[SIMULATOR_EVENTS];
+  int64_t time = now();
+
+  while (time < endAt) {
+    if (outageStartAt >= 0 && !isOutageStarted && time >= outageStartAt) {
+      _broker.setAvailable(false);
+      isOutageStarted = true;
+    }
+
+    if (isOutageStarted && _outageEndedAt < 0 && time >= outageEndAt) {
+      _broker.setAvailable(true);
+      _outageEndedAt = time;
+    }
+
+    while (!_timers.empty() && _timers.top().first <= time) {
+      Timer timer = _timers.top();
+      _timers.pop();
+
+      // Skip timers that were replaced by a later schedule().
+      if (_devices[timer.second].wakeAt == timer.first) {
+        _devices[timer.second].wakeAt = 0;
+        wake(timer.second);
+      }
+    }
+
+    int64_t nextAt = _timers.empty() ? endAt : min(_timers.top().first, endAt);
+    int timeout = (int)constrain((nextAt - now() + 999) / 1000, (int64_t)0, (int64_t)10);
+    int count = epoll_wait(_epollFd, events, SIMULATOR_EVENTS, timeout);
+
+    for (int event = 0; event < count; event++) {
+      uint32_t index = events[event].data.u32;
+
+      if (events[event].events & EPOLLOUT) {
+        flush(index);
+      }
+
+      if (events[event].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        receive(index);
+      }
+    }
+
+    time = now();
+    size_t elapsed = min((size_t)(time / 1000000), _timeline.size() - 1);
+    _timeline[elapsed].connected = _connected;
+
+    if (_outageEndedAt >= 0 && _recoveredAt < 0 && _connected == _devices.size()) {
+      _recoveredAt = time;
+    }
+  }
+}
+
+int64_t FleetSimulator::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _startedAt).count();
+}
+
+TimelineSecond& FleetSimulator::second() {
+  return _timeline[min((size_t)(now() / 1000000), _timeline.size() - 1)];
+}
+
+void FleetSimulator::schedule(uint32_t index, int64_t at) {
+  _devices[index].wakeAt = at;
+  _timers.push(Timer(at, index));
+}
+
+void FleetSimulator::wake(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+
+  switch (device.state) {
+    case DEVICE_JOINING:
+    case DEVICE_BACKOFF:
+      startConnection(index);
+      break;
+
+    case DEVICE_CONNECTING:
+    case DEVICE_HANDSHAKE:
+      // The connection or the CONNACK timed out.
+      failConnection(index);
+      break;
+
+    case DEVICE_READY:
+      // Run the next loop(), it samples and publishes.
+      publishSample(index);
+      schedule(index, now() + _options.interval * 1000LL);
+      break;
+  }
+}
+
+void FleetSimulator::startConnection(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+  _attempts++;
+  second().attempts++;
+  device.attemptStartedAt = now();
+  device.fd = socket(_brokerAddress.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  if (device.fd < 0) {
+    failConnection(index);
+    return;
+  }
+
+  int isEnabled = 1;
+  setsockopt(device.fd, IPPROTO_TCP, TCP_NODELAY, &isEnabled, sizeof(isEnabled));
+
+  if (connect(device.fd, (sockaddr*)&_brokerAddress, _brokerAddressLength) != 0 && errno != EINPROGRESS) {
+    failConnection(index);
+    return;
+  }
+
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLOUT;
+  event.data.u32 = index;
+  epoll_ctl(_epollFd, EPOLL_CTL_ADD, device.fd, &event);
+
+  device.state = DEVICE_CONNECTING;
+  schedule(index, now() + WIFI_CLIENT_TIMEOUT * 1000LL);
+}
+
+void FleetSimulator::failConnection(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+  _failures++;
+  closeConnection(index);
+
+  // Wait like connectToMqttBroker() does before the next attempt.
+  device.state = DEVICE_BACKOFF;
+  schedule(index, now() + device.retry.nextDelay() * 1000LL);
+}
+
+void FleetSimulator::closeConnection(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+
+  if (device.state == DEVICE_READY) {
+    _connected--;
+  }
+
+  if (device.fd >= 0) {
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, device.fd, nullptr);
+    close(device.fd);
+    device.fd = -1;
+  }
+
+  _lostPublishes += device.publishedAt.size();
+  device.publishedAt.clear();
+  device.input.clear();
+  device.output.clear();
+}
+
+void FleetSimulator::connected(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+  _connectLatencies.push_back(now() - device.attemptStartedAt);
+  second().successes++;
+  device.state = DEVICE_READY;
+  device.retry.reset();
+  _connected++;
+
+  // Subscribe to the topic, like the firmware with the configuration import left off.
+  uint8_t packet[128];
+  send(index, packet, mqttSubscribePacket(packet, sizeof(packet), MQTT_PACKET_SUBSCRIBE, 1, device.topic.c_str()));
+
+  // The rest of the loop() runs right after connecting.
+  publishSample(index);
+  schedule(index, now() + _options.interval * 1000LL);
+}
+
+void FleetSimulator::publishSample(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+
+  if (device.state != DEVICE_READY) {
+    return;
+  }
+
+  char timestamp[24];
+  time_t seconds = time(nullptr);
+  struct tm timeinfo;
+  gmtime_r(&seconds, &timeinfo);
+  strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &timeinfo);
+
+  String message = constructMqttMessage(21.5 + random(-50, 51) / 100.0, 45.0 + random(-200, 201) / 100.0, timestamp);
+  uint8_t packet[MQTT_BUFFER_SIZE];
+  size_t length = mqttPublishPacket(packet, sizeof(packet), device.topic.c_str(), (const uint8_t*)message.c_str(), message.length(), true);
+
+  _publishes++;
+  device.publishedAt.push_back(now());
+  send(index, packet, length);
+}
+
+void FleetSimulator::send(uint32_t index, const uint8_t* data, size_t length) {
+  VirtualDevice& device = _devices[index];
+
+  if (device.fd < 0 || length == 0) {
+    return;
+  }
+
+  bool isQueued = !device.output.empty();
+  device.output.append((const char*)data, length);
+
+  if (!isQueued) {
+    flush(index);
+  }
+}
+
+void FleetSimulator::flush(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+
+  if (device.fd < 0) {
+    return;
+  }
+
+  if (device.state == DEVICE_CONNECTING) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    getsockopt(device.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+
+    if (error != 0) {
+      failConnection(index);
+      return;
+    }
+
+    // Connected, send CONNECT and wait for CONNACK as long as PubSubClient does.
+    uint8_t packet[128];
+    device.state = DEVICE_HANDSHAKE;
+    schedule(index, now() + MQTT_SOCKET_TIMEOUT * 1000000LL);
+    device.output.assign((const char*)packet, mqttConnectPacket(packet, sizeof(packet), device.clientId.c_str(), nullptr, nullptr, MQTT_KEEPALIVE));
+  }
+
+  while (!device.output.empty()) {
+    ssize_t sent = ::send(device.fd, device.output.data(), device.output.size(), MSG_NOSIGNAL);
+
+    if (sent < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        receive(index);
+        return;
+      }
+
+      break;
+    }
+
+    device.output.erase(0, sent);
+  }
+
+  epoll_event event = {};
+  event.events = device.output.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT;
+  event.data.u32 = index;
+  epoll_ctl(_epollFd, EPOLL_CTL_MOD, device.fd, &event);
+}
+
+void FleetSimulator::receive(uint32_t index) {
+  VirtualDevice& device = _devices[index];
+  uint8_t buffer[4096];
+
+  while (device.fd >= 0 && device.state != DEVICE_CONNECTING) {
+    ssize_t received = recv(device.fd, buffer, sizeof(buffer), 0);
+
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+
+    if (received <= 0) {
+      if (device.state == DEVICE_READY) {
+        // The next loop() finds the client disconnected and connects again at once.
+        closeConnection(index);
+        device.state = DEVICE_BACKOFF;
+        device.retry.reset();
+      } else {
+        failConnection(index);
+      }
+
+      return;
+    }
+
+    device.input.insert(device.input.end(), buffer, buffer + received);
+  }
+
+  size_t offset = 0;
+
+  while (device.fd >= 0) {
+    size_t headerSize;
+    size_t remainingLength;
+    int result = mqttDecodeHeader(device.input.data() + offset, device.input.size() - offset, &headerSize, &remainingLength);
+
+    if (result < 0) {
+      failConnection(index);
+      return;
+    }
+
+    if (result == 0 || device.input.size() - offset < headerSize + remainingLength) {
+      break;
+    }
+
+    std::vector<uint8_t> packet(device.input.begin() + offset, device.input.begin() + offset + headerSize + remainingLength);
+    offset += packet.size();
+    handlePacket(index, packet.data(), headerSize, remainingLength);
+  }
+
+  if (device.fd >= 0) {
+    device.input.erase(device.input.begin(), device.input.begin() + offset);
+  }
+}
+
+void FleetSimulator::handlePacket(uint32_t index, const uint8_t* packet, size_t headerSize, size_t length) {
+  VirtualDevice& device = _devices[index];
+  uint8_t type = packet[0] & 0xF0;
+
+  if (device.state == DEVICE_HANDSHAKE) {
+    if (type == MQTT_PACKET_CONNACK && length == 2 && packet[headerSize + 1] == 0) {
+      connected(index);
+    } else {
+      failConnection(index);
+    }
+
+    return;
+  }
+
+  if (type != MQTT_PACKET_PUBLISH || length < 2) {
+    return;
+  }
+
+  // Retained messages arrive on subscribe, only live ones measure the broker latency.
+  if (packet[0] & MQTT_PUBLISH_RETAIN) {
+    _retainedDeliveries++;
+    return;
+  }
+
+  size_t topicLength = (packet[headerSize] << 8) | packet[headerSize + 1];
+
+  if (!device.publishedAt.empty() && topicLength == device.topic.size()
+      && memcmp(packet + headerSize + 2, device.topic.data(), topicLength) == 0) {
+    _latencies.push_back(now() - device.publishedAt.front());
+    device.publishedAt.pop_front();
+    _deliveries++;
+    second().deliveries++;
+  }
+}
+
+// Print the percentiles of a list of durations in microseconds.
+static void printPercentiles(FILE* output, std::vector<int64_t>& values) {
+  std::sort(values.begin(), values.end());
+  const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+  const char* names[] = { "p50", "p90", "p99", "p999" };
+  fprintf(output, "{ ");
+
+  for (size_t index = 0; index < 4; index++) {
+    int64_t value = values.empty() ? 0 : values[(size_t)(percentiles[index] * (values.size() - 1))];
+    fprintf(output, "\"%s\": %lld, ", names[index], (long long)value);
+  }
+
+  fprintf(output, "\"max\": %lld }", (long long)(values.empty() ? 0 : values.back()));
+}
+
+void FleetSimulator::report(FILE* output) {
+  double seconds = _options.duration;
+  uint32_t peakAttempts = 0;
+
+  for (const TimelineSecond& timeline : _timeline) {
+    peakAttempts = max(peakAttempts, timeline.attempts);
+  }
+
+  fprintf(output, "{\n");
+  fprintf(output, "  \"devices\": %u,\n", _options.devices);
+  fprintf(output, "  \"durationSeconds\": %u,\n", _options.duration);
+  fprintf(output, "  \"broker\": \"%s\",\n", _options.brokerHost.empty() ? "internal" : _options.brokerHost.c_str());
+  fprintf(output, "  \"publishes\": %llu,\n", (unsigned long long)_publishes);
+  fprintf(output, "  \"deliveries\": %llu,\n", (unsigned long long)_deliveries);
+  fprintf(output, "  \"retainedDeliveries\": %llu,\n", (unsigned long long)_retainedDeliveries);
+  fprintf(output, "  \"lostPublishes\": %llu,\n", (unsigned long long)_lostPublishes);
+  fprintf(output, "  \"publishesPerSecond\": %.1f,\n", _publishes / seconds);
+  fprintf(output, "  \"deliveriesPerSecond\": %.1f,\n", _deliveries / seconds);
+  fprintf(output, "  \"latencyMicroseconds\": ");
+  printPercentiles(output, _latencies);
+  fprintf(output, ",\n  \"connectAttempts\": %llu,\n", (unsigned long long)_attempts);
+  fprintf(output, "  \"connectFailures\": %llu,\n", (unsigned long long)_failures);
+  fprintf(output, "  \"peakConnectAttemptsPerSecond\": %u,\n", peakAttempts);
+  fprintf(output, "  \"connectLatencyMicroseconds\": ");
+  printPercentiles(output, _connectLatencies);
+  fprintf(output, ",\n  \"connectedAtEnd\": %u,\n", _connected);
+
+  if (_options.outageAt >= 0) {
+    double recovery = _recoveredAt >= 0 ? (_recoveredAt - _outageEndedAt) / 1000000.0 : -1;
+    fprintf(output, "  \"outage\": { \"atSecond\": %d, \"seconds\": %u, \"recoverySeconds\": %.3f },\n", _options.outageAt, _options.outageFor, recovery);
+  }
+
+  fprintf(output, "  \"timeline\": [\n");
+
+  for (size_t index = 0; index < _timeline.size(); index++) {
+    const TimelineSecond& timeline = _timeline[index];
+    fprintf(output, "    { \"second\": %u, \"attempts\": %u, \"successes\": %u, \"deliveries\": %u, \"connected\": %u }%s\n",
+            (unsigned)index, timeline.attempts, timeline.successes, timeline.deliveries, timeline.connected,
+            index + 1 < _timeline.size() ? "," : "");
+  }
+
+  fprintf(output, "  ]\n}\n");
+}
+
+// Print the usage and return the exit code of a wrong command line.
+static int usage() {
+  fprintf(stderr,
+          "Usage: fleet_simulator [--devices N] [--duration S] [--broker HOST:PORT]\n"
+          "                       [--interval MS] [--boot-window MS] [--network-delay MS]\n"
+          "                       [--retry-delay MS] [--retry-max-delay MS]\n"
+          "                       [--outage-at S] [--outage-for S] [--output FILE]\n");
+  return 2;
+}
+
+int main(int argc, char** argv) {
+  SimulatorOptions options;
+
+  for (int index = 1; index < argc; index++) {
+    const char* name = argv[index];
+    const char* value = index + 1 < argc ? argv[index + 1] : nullptr;
+
+    if (value == nullptr) {
+      return usage();
+    }
+
+    if (strcmp(name, "--devices") == 0) {
+      options.devices = atol(value);
+    } else if (strcmp(name, "--duration") == 0) {
+      options.duration = atol(value);
+    } else if (strcmp(name, "--broker") == 0) {
+      const char* separator = strrchr(value, ':');
+      options.brokerHost = separator != nullptr ? std::string(value, separator) : value;
+      options.brokerPort = separator != nullptr ? atol(separator + 1) : 1883;
+    } else if (strcmp(name, "--interval") == 0) {
+      options.interval = atol(value);
+    } else if (strcmp(name, "--boot-window") == 0) {
+      options.bootWindow = atol(value);
+    } else if (strcmp(name, "--network-delay") == 0) {
+      options.networkDelay = atol(value);
+    } else if (strcmp(name, "--retry-delay") == 0) {
+      options.retryDelay = atol(value);
+    } else if (strcmp(name, "--retry-max-delay") == 0) {
+      options.retryMaxDelay = atol(value);
+    } else if (strcmp(name, "--outage-at") == 0) {
+      options.outageAt = atol(value);
+    } else if (strcmp(name, "--outage-for") == 0) {
+      options.outageFor = atol(value);
+    } else if (strcmp(name, "--output") == 0) {
+      options.output = value;
+    } else {
+      return usage();
+    }
+
+    index++;
+  }
+
+  if (options.devices == 0 || options.duration == 0 || options.interval == 0 || options.retryDelay == 0) {
+    return usage();
+  }
+
+  if (options.outageAt >= 0 && !options.brokerHost.empty()) {
+    fprintf(stderr, "An outage can only be simulated with the internal broker.\n");
+    return 2;
+  }
+
+  // Every device takes a socket, and the internal broker one more for each.
+  rlimit limit;
+  getrlimit(RLIMIT_NOFILE, &limit);
+  rlim_t needed = options.devices * (options.brokerHost.empty() ? 2 : 1) + 64;
+
+  if (limit.rlim_cur < needed) {
+    limit.rlim_cur = min(needed, limit.rlim_max);
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  if (limit.rlim_cur < needed) {
+    fprintf(stderr, "%u devices need %llu file descriptors, the limit is %llu.\n", options.devices,
+            (unsigned long long)needed, (unsigned long long)limit.rlim_max);
+    return 1;
+  }
+
+  FleetSimulator simulator(options);
+
+  if (!simulator.start()) {
+    return 1;
+  }
+
+  simulator.run();
+
+  FILE* output = options.output != nullptr ? fopen(options.output, "w") : stdout;
+
+  if (output == nullptr) {
+    fprintf(stderr, "Opening '%s' failed.\n", options.output);
+    return 1;
+  }
+
+  simulator.report(output);
+
+  if (output != stdout) {
+    fclose(output);
+  }
+
+  return 0;
+}
\ No newline at end of file
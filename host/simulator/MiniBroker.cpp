@@ -0,0 +1,407 @@
+/**
+* @file MiniBroker.cpp
+* @brief Minimal MQTT 3.1.1 broker for the fleet simulator.
+*
+* See MiniBroker.h.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include "MiniBroker.h"
+#include "MqttPacket.h"
+
+// Define the number of events handled per wait and the wait timeout in milliseconds.
+#define BROKER_EVENTS 256
+#define BROKER_POLL_TIMEOUT 50
+
+// Define the size of a received packet the broker drops the connection for.
+#define BROKER_MAX_PACKET_SIZE 65536
+
+MiniBroker::~MiniBroker() {
+  stop();
+}
+
+bool MiniBroker::start(uint16_t port) {
+  _port = port;
+  _epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+  if (_epollFd < 0 || !listen()) {
+    return false;
+  }
+
+  _isRunning = true;
+  _thread = std::thread(&MiniBroker::run, this);
+
+  return true;
+}
+
+void MiniBroker::stop() {
+  if (_isRunning.exchange(false)) {
+    _thread.join();
+  }
+
+  closeAll();
+
+  if (_epollFd >= 0) {
+    ::close(_epollFd);
+    _epollFd = -1;
+  }
+}
+
+bool MiniBroker::listen() {
+  _listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  if (_listenFd < 0) {
+    return false;
+  }
+
+  int isEnabled = 1;
+  setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &isEnabled, sizeof(isEnabled));
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(_port);
+  socklen_t length = sizeof(address);
+
+  if (bind(_listenFd, (sockaddr*)&address, sizeof(address)) != 0 || ::listen(_listenFd, SOMAXCONN) != 0
+      || getsockname(_listenFd, (sockaddr*)&address, &length) != 0) {
+    ::close(_listenFd);
+    _listenFd = -1;
+    return false;
+  }
+
+  // Keep the port, so the broker comes back on it after an outage.
+  _port = ntohs(address.sin_port);
+
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = _listenFd;
+  epoll_ctl(_epollFd, EPOLL_CTL_ADD, _listenFd, &event);
+
+  return true;
+}
+
+void MiniBroker::run() {
+  epoll_event events[BROKER_EVENTS];
+
+  while (_isRunning) {
+    if (!_isAvailable && _listenFd >= 0) {
+      closeAll();
+    } else if (_isAvailable && _listenFd < 0) {
+      listen();
+    }
+
+    int count = epoll_wait(_epollFd, events, BROKER_EVENTS, BROKER_POLL_TIMEOUT);
+
+    for (int index = 0; index < count; index++) {
+      int fd = events[index].data.fd;
+
+      if (fd == _listenFd) {
+        accept();
+        continue;
+      }
+
+      if (_connections.find(fd) == _connections.end()) {
+        continue;
+      }
+
+      if (events[index].events & EPOLLOUT) {
+        flush(fd);
+      }
+
+      if (events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        receive(fd);
+      }
+    }
+  }
+}
+
+void MiniBroker::accept() {
+  while (true) {
+    int fd = accept4(_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0) {
+      return;
+    }
+
+    int isEnabled = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &isEnabled, sizeof(isEnabled));
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event);
+    _connections[fd];
+  }
+}
+
+void MiniBroker::receive(int fd) {
+  uint8_t buffer[4096];
+
+  while (true) {
+    ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+
+    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      close(fd);
+      return;
+    }
+
+    if (received < 0) {
+      break;
+    }
+
+    std::vector<uint8_t>& input = _connections[fd].input;
+    input.insert(input.end(), buffer, buffer + received);
+  }
+
+  // Handle every complete packet, a handler may close the connection.
+  size_t offset = 0;
+
+  while (_connections.find(fd) != _connections.end()) {
+    std::vector<uint8_t>& input = _connections[fd].input;
+    size_t headerSize;
+    size_t remainingLength;
+    int result = mqttDecodeHeader(input.data() + offset, input.size() - offset, &headerSize, &remainingLength);
+
+    if (result < 0 || remainingLength > BROKER_MAX_PACKET_SIZE) {
+      close(fd);
+      return;
+    }
+
+    if (result == 0 || input.size() - offset < headerSize + remainingLength) {
+      input.erase(input.begin(), input.begin() + offset);
+      return;
+    }
+
+    // Copy the packet, handling it may grow the input of this connection.
+    std::vector<uint8_t> packet(input.begin() + offset, input.begin() + offset + headerSize + remainingLength);
+    offset += packet.size();
+    handlePacket(fd, packet.data(), headerSize, remainingLength);
+  }
+}
+
+// Read a length-prefixed string, or return false if it does not fit.
+static bool readString(const uint8_t*& position, const uint8_t* end, std::string& value) {
+  if (end - position < 2) {
+    return false;
+  }
+
+  size_t length = (position[0] << 8) | position[1];
+
+  if ((size_t)(end - position - 2) < length) {
+    return false;
+  }
+
+  value.assign((const char*)position + 2, length);
+  position += 2 + length;
+
+  return true;
+}
+
+void MiniBroker::handlePacket(int fd, const uint8_t* packet, size_t headerSize, size_t length) {
+  uint8_t type = packet[0] & 0xF0;
+  const uint8_t* position = packet + headerSize;
+  const uint8_t* end = position + length;
+  uint8_t response[MQTT_MAX_HEADER_SIZE + 8];
+
+  if (type == MQTT_PACKET_CONNECT) {
+    static const uint8_t accepted[] = { 0x00, 0x00 };
+    send(fd, response, mqttSimplePacket(response, sizeof(response), MQTT_PACKET_CONNACK, accepted, sizeof(accepted)));
+  } else if (type == MQTT_PACKET_PUBLISH) {
+    std::string topic;
+
+    if (!readString(position, end, topic)) {
+      close(fd);
+      return;
+    }
+
+    // Skip the packet identifier of QoS 1 and 2, they are delivered with QoS 0.
+    if (packet[0] & 0x06) {
+      position += 2;
+    }
+
+    std::string payload((const char*)std::min(position, end), (const char*)end);
+    _receivedPublishes++;
+
+    if (packet[0] & MQTT_PUBLISH_RETAIN) {
+      if (payload.empty()) {
+        _retained.erase(topic);
+      } else {
+        _retained[topic] = payload;
+      }
+    }
+
+    auto subscribers = _subscribers.find(topic);
+
+    if (subscribers == _subscribers.end()) {
+      return;
+    }
+
+    // Live messages are forwarded without the retain flag, like MQTT 3.1.1 brokers do.
+    std::vector<uint8_t> forward(MQTT_MAX_HEADER_SIZE + 2 + topic.size() + payload.size());
+    size_t forwardLength = mqttPublishPacket(forward.data(), forward.size(), topic.c_str(), (const uint8_t*)payload.data(), payload.size(), false);
+    std::set<int> recipients = subscribers->second;
+
+    for (int recipient : recipients) {
+      send(recipient, forward.data(), forwardLength);
+      _forwardedPublishes++;
+    }
+  } else if (type == MQTT_PACKET_SUBSCRIBE || type == MQTT_PACKET_UNSUBSCRIBE) {
+    if (end - position < 2) {
+      close(fd);
+      return;
+    }
+
+    uint8_t body[2 + 16];
+    size_t bodyLength = 2;
+    body[0] = position[0];
+    body[1] = position[1];
+    position += 2;
+    std::vector<std::string> subscribed;
+
+    while (position < end) {
+      std::string topic;
+
+      if (!readString(position, end, topic)) {
+        close(fd);
+        return;
+      }
+
+      if (type == MQTT_PACKET_SUBSCRIBE) {
+        position++;  // Requested QoS, granted as QoS 0.
+
+        if (bodyLength < sizeof(body)) {
+          body[bodyLength++] = 0x00;
+        }
+
+        _subscribers[topic].insert(fd);
+        _connections[fd].topics.insert(topic);
+        subscribed.push_back(topic);
+      } else {
+        _subscribers[topic].erase(fd);
+        _connections[fd].topics.erase(topic);
+      }
+    }
+
+    uint8_t responseType = type == MQTT_PACKET_SUBSCRIBE ? MQTT_PACKET_SUBACK : MQTT_PACKET_UNSUBACK;
+    send(fd, response, mqttSimplePacket(response, sizeof(response), responseType, body, bodyLength));
+
+    // Send retained messages after the acknowledgement, with the retain flag.
+    for (const std::string& topic : subscribed) {
+      auto retained = _retained.find(topic);
+
+      if (retained != _retained.end()) {
+        std::vector<uint8_t> message(MQTT_MAX_HEADER_SIZE + 2 + topic.size() + retained->second.size());
+        size_t messageLength = mqttPublishPacket(message.data(), message.size(), topic.c_str(), (const uint8_t*)retained->second.data(), retained->second.size(), true);
+        send(fd, message.data(), messageLength);
+      }
+    }
+  } else if (type == MQTT_PACKET_PINGREQ) {
+    send(fd, response, mqttSimplePacket(response, sizeof(response), MQTT_PACKET_PINGRESP, nullptr, 0));
+  } else if (type == MQTT_PACKET_DISCONNECT) {
+    close(fd);
+  }
+}
+
+void MiniBroker::send(int fd, const uint8_t* data, size_t length) {
+  auto connection = _connections.find(fd);
+
+  if (connection == _connections.end()) {
+    return;
+  }
+
+  connection->second.output.append((const char*)data, length);
+
+  // Write at once if nothing is queued before, else wait for the socket.
+  if (connection->second.output.size() == length) {
+    flush(fd);
+  }
+}
+
+void MiniBroker::flush(int fd) {
+  auto connection = _connections.find(fd);
+
+  if (connection == _connections.end()) {
+    return;
+  }
+
+  std::string& output = connection->second.output;
+
+  while (!output.empty()) {
+    ssize_t sent = ::send(fd, output.data(), output.size(), MSG_NOSIGNAL);
+
+    if (sent < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        close(fd);
+        return;
+      }
+
+      break;
+    }
+
+    output.erase(0, sent);
+  }
+
+  // Wait for the socket only while output is queued.
+  epoll_event event = {};
+  event.events = output.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT;
+  event.data.fd = fd;
+  epoll_ctl(_epollFd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void MiniBroker::close(int fd) {
+  auto connection = _connections.find(fd);
+
+  if (connection == _connections.end()) {
+    return;
+  }
+
+  for (const std::string& topic : connection->second.topics) {
+    _subscribers[topic].erase(fd);
+  }
+
+  _connections.erase(connection);
+  epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+}
+
+void MiniBroker::closeAll() {
+  while (!_connections.empty()) {
+    close(_connections.begin()->first);
+  }
+
+  if (_listenFd >= 0) {
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, _listenFd, nullptr);
+    ::close(_listenFd);
+    _listenFd = -1;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+* @file MiniBroker.h
+* @brief Minimal MQTT 3.1.1 broker for the fleet simulator.
+*
+* Serves CONNECT, SUBSCRIBE, UNSUBSCRIBE, PUBLISH with QoS 0 and retained messages,
+* and PINGREQ on its own thread. Topics match exactly, wildcards are not supported.
+* An outage closes every connection and the listening socket until it ends, like a
+* broker restart, so devices see refused connections meanwhile.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef MINI_BROKER_H
+#define MINI_BROKER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Structure of a client connection of the broker.
+struct BrokerConnection {
+  std::vector<uint8_t> input;    // Received bytes of incomplete packets.
+  std::string output;            // Bytes waiting for the socket to accept them.
+  std::set<std::string> topics;  // Subscribed topics.
+};
+
+class MiniBroker {
+public:
+  ~MiniBroker();
+
+  /**
+  * @brief Start listening on the loopback interface and serving on a thread.
+  *
+  * @param port The port to listen on, 0 picks a free port.
+  * @return True if the broker listens.
+  */
+  bool start(uint16_t port = 0);
+
+  /**
+  * @brief Stop serving and close every connection.
+  */
+  void stop();
+
+  /**
+  * @brief Start or end an outage, the broker thread applies it within 50 ms.
+  */
+  void setAvailable(bool isAvailable) { _isAvailable = isAvailable; }
+
+  uint16_t port() const { return _port; }
+  uint64_t receivedPublishes() const { return _receivedPublishes; }
+  uint64_t forwardedPublishes() const { return _forwardedPublishes; }
+
+private:
+  int _listenFd = -1;                                 // Listening socket, closed during an outage.
+  int _epollFd = -1;                                  // Readiness of the listening socket and connections.
+  uint16_t _port = 0;                                 // Port the broker listens on.
+  std::thread _thread;                                // Thread serving the connections.
+  std::atomic<bool> _isRunning{ false };              // False once stop() was called.
+  std::atomic<bool> _isAvailable{ true };             // False during an outage.
+  std::atomic<uint64_t> _receivedPublishes{ 0 };      // Number of PUBLISH packets received.
+  std::atomic<uint64_t> _forwardedPublishes{ 0 };     // Number of PUBLISH packets sent to subscribers.
+  std::map<int, BrokerConnection> _connections;       // Connections by socket.
+  std::map<std::string, std::set<int>> _subscribers;  // Subscribed sockets by topic.
+  std::map<std::string, std::string> _retained;       // Retained payloads by topic.
+
+  bool listen();
+  void run();
+  void accept();
+  void receive(int fd);
+  void handlePacket(int fd, const uint8_t* packet, size_t headerSize, size_t length);
+  void send(int fd, const uint8_t* data, size_t length);
+  void flush(int fd);
+  void close(int fd);
+  void closeAll();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+* @file ConfigServerFixture.h
+* @brief Helpers to run the configuration server in host tests.
+*
+* Starts the configuration server task on the station interface, as in normal
+* operation, saves a test configuration through the blob import, and builds the
+* Basic authentication header of the admin password.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef CONFIG_SERVER_FIXTURE_H
+#define CONFIG_SERVER_FIXTURE_H
+
+#include <string>
+#include "Arduino.h"
+#include "Preferences.h"
+#include "TestClient.h"
+#include "WiFi.h"
+#include "WiFiConfig.h"
+#include "esp_rom_crc.h"
+#include "mbedtls/base64.h"
+
+// Define the test configuration saved by saveTestConfiguration().
+#define TEST_ADMIN_PASS "test-admin-password"  // Admin password of the test configuration.
+#define TEST_CLIENT_ID "SMAF-TEST"             // MQTT client ID of the test configuration.
+#define TEST_FIRMWARE_HOST "127.0.0.1"         // Firmware server of the test configuration.
+#define TEST_NETWORK_PASS "test-network-pass"  // Wi-Fi password of the test configuration.
+#define TEST_TOPIC "smaf/test"                 // MQTT topic of the test configuration.
+
+/**
+* @brief Find a free port for a server.
+*/
+inline uint16_t freePort() {
+  WiFiServer server(0);
+  server.begin();
+  uint16_t port = server.port();
+  server.end();
+
+  return port;
+}
+
+/**
+* @brief Build the Authorization header line of Basic authentication.
+*/
+inline std::string basicAuthorization(const char* user, const char* password) {
+  std::string credentials = std::string(user) + ":" + password;
+  unsigned char encoded[128];
+  size_t length = 0;
+  mbedtls_base64_encode(encoded, sizeof(encoded), &length, (const unsigned char*)credentials.data(), credentials.size());
+
+  return "Authorization: Basic " + std::string((const char*)encoded, length) + "\r\n";
+}
+
+/**
+* @brief Build the Authorization header line of the test admin password.
+*/
+inline std::string adminAuthorization() {
+  return basicAuthorization(CONFIG_ADMIN_USER, TEST_ADMIN_PASS);
+}
+
+/**
+* @brief Save a complete test configuration as the only record and load it.
+*
+* The record is written directly, an import would keep the device specific settings.
+*
+* @param configuration The configuration to save to.
+* @param preferencesNamespace The preferences namespace of the configuration.
+* @param adminPassword The admin password, empty to serve configuration mode only.
+* @param clientId The MQTT client ID.
+* @param topic The MQTT topic.
+*/
+inline void saveTestConfiguration(WiFiConfig& configuration, const char* preferencesNamespace, const char* adminPassword,
+                                  const char* clientId = TEST_CLIENT_ID, const char* topic = TEST_TOPIC) {
+  ConfigurationRecord record;
+  memset(&record, 0, sizeof(record));
+  record.version = CONFIG_RECORD_VERSION;
+  record.size = sizeof(record);
+  record.sequence = 1;
+
+  auto setString = [&](const char* key, const char* value) {
+    strcpy(record.values.strings + settingOffset(settingIndex(key)), value);
+  };
+
+  setString(NETWORK_NAME, "SMAF-Lab");
+  setString(NETWORK_PASS, TEST_NETWORK_PASS);
+  setString(MQTT_SERVER_ADDRESS, "broker.local");
+  setString(MQTT_CLIENT_ID, clientId);
+  setString(MQTT_TOPIC, topic);
+  setString(ADMIN_PASS, adminPassword);
+  setString(FIRMWARE_HOST, TEST_FIRMWARE_HOST);
+
+  uint16_t port = 1883;
+  memcpy(record.values.numbers + settingOffset(settingIndex(MQTT_SERVER_PORT)), &port, sizeof(port));
+  record.checksum = esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(ConfigurationRecord, checksum));
+
+  Preferences preferences;
+  preferences.begin(preferencesNamespace, false);
+  preferences.clear();
+  preferences.putBytes(CONFIG_RECORD_SLOT_ODD, &record, sizeof(record));
+  preferences.end();
+
+  configuration.reloadPreferences();
+}
+
+/**
+* @brief Serve the configuration server on the station interface, like a device in normal operation.
+*
+* @param configuration The configuration whose server task is started.
+* @param port The port of the configuration server.
+* @return true once the server accepts connections.
+*/
+inline bool startStationServer(WiFiConfig& configuration, uint16_t port) {
+  WiFi.mode(WIFI_STA);
+  WiFi.begin("SMAF-Lab", TEST_NETWORK_PASS);
+  configuration.startServerTask(0);
+
+  TestClient probe;
+
+  for (int i = 0; i < 100; i++) {
+    if (probe.connect(port)) {
+      return true;
+    }
+
+    delay(20);
+  }
+
+  return false;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,203 @@
+/**
+* @file ConfigServerLoadTest.cpp
+* @brief Load test of the configuration server connection pool.
+*
+* Runs the configuration server task on the station interface and sends it more
+* keep-alive clients than it has connections, next to a client that never completes
+* its request, while a sampler calls the configuration like the main loop. Checks
+* that every request is answered, the stalled client gets 408, the sample interval
+* is kept under the load and pipelined requests are answered in order, and prints
+* the throughput, latency and sample intervals as JSON.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Arduino.h"
+#include "ConfigServerFixture.h"
+#include "HostRuntime.h"
+#include "HostTest.h"
+#include "TestClient.h"
+#include "WiFiConfig.h"
+
+// Define the load, more clients than the server has connections.
+#define LOAD_CLIENTS (2 * CONFIG_SERVER_MAX_CONNECTIONS)
+#define LOAD_REQUESTS_PER_CLIENT 50
+
+// Define the sample period of the sampler and the delay a sample may be taken late.
+#define LOAD_SAMPLE_PERIOD 50  // Milliseconds between samples.
+#define LOAD_SAMPLE_DELAY 25   // Milliseconds a sample interval may exceed the period.
+
+static uint16_t serverPort;
+static WiFiConfig* configuration;
+
+// Results of the load clients.
+static std::mutex resultsLock;
+static std::vector<double> latencies;        // Request latencies in milliseconds.
+static std::atomic<uint32_t> answered(0);    // Requests answered with 200.
+static std::atomic<uint32_t> reconnects(0);  // Connections opened again after the server closed one.
+static std::atomic<uint32_t> rejected(0);    // Requests answered with 503.
+static std::vector<double> sampleIntervals;  // Intervals between samples in milliseconds.
+
+// Send keep-alive requests, reconnecting whenever the server frees the connection.
+static void runClient() {
+  TestClient client;
+  std::vector<double> clientLatencies;
+
+  for (int request = 0; request < LOAD_REQUESTS_PER_CLIENT;) {
+    if (!client.isOpen()) {
+      client.connect(serverPort);
+    }
+
+    auto startedAt = std::chrono::steady_clock::now();
+    client.send("GET /configuration.css HTTP/1.1\r\nHost: device\r\n" + adminAuthorization() + "\r\n");
+    TestResponse response = client.receive(10000);
+
+    if (response.status == 200) {
+      clientLatencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startedAt).count());
+      answered++;
+      request++;
+      continue;
+    }
+
+    // A full pool answers 503, an evicted idle connection is closed.
+    if (response.status == 503) {
+      rejected++;
+      delay(10);
+    }
+
+    client.close();
+    reconnects++;
+  }
+
+  std::lock_guard<std::mutex> guard(resultsLock);
+  latencies.insert(latencies.end(), clientLatencies.begin(), clientLatencies.end());
+}
+
+// Take samples like the main loop, which shares the configuration with the server task.
+static void runSampler(WiFiConfig& configuration, const std::atomic<bool>& isLoaded) {
+  auto sampledAt = std::chrono::steady_clock::now();
+
+  while (isLoaded) {
+    configuration.hasPendingChanges();
+    configuration.publishEvent("{\"temperature\":21.50,\"humidity\":40.00}");
+    delay(LOAD_SAMPLE_PERIOD);
+
+    auto now = std::chrono::steady_clock::now();
+    sampleIntervals.push_back(std::chrono::duration<double, std::milli>(now - sampledAt).count());
+    sampledAt = now;
+  }
+}
+
+TEST_CASE(poolServesMoreClientsThanConnections) {
+  std::atomic<int> stalledStatus(0);
+
+  // A client that never completes its request holds a connection until it times out.
+  std::thread stalled([&]() {
+    TestClient client;
+    client.connect(serverPort);
+    client.send("GET / HTTP/1.1\r\nHost: device\r\n");
+    stalledStatus = client.receive(HTTP_READ_TIMEOUT * 3).status;
+  });
+
+  delay(100);
+  auto startedAt = std::chrono::steady_clock::now();
+  std::vector<std::thread> clients;
+  std::atomic<bool> isLoaded(true);
+  std::thread sampler(runSampler, std::ref(*configuration), std::cref(isLoaded));
+
+  for (int i = 0; i < LOAD_CLIENTS; i++) {
+    clients.push_back(std::thread(runClient));
+  }
+
+  for (std::thread& client : clients) {
+    client.join();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+  isLoaded = false;
+  sampler.join();
+  stalled.join();
+
+  CHECK_EQUAL((uint32_t)(LOAD_CLIENTS * LOAD_REQUESTS_PER_CLIENT), answered.load());
+  CHECK_EQUAL(408, stalledStatus.load());
+
+  std::sort(latencies.begin(), latencies.end());
+  double p50 = latencies.empty() ? 0 : latencies[latencies.size() / 2];
+  double p99 = latencies.empty() ? 0 : latencies[latencies.size() * 99 / 100];
+  double maximum = latencies.empty() ? 0 : latencies.back();
+
+  // The server task must not delay the samples.
+  std::sort(sampleIntervals.begin(), sampleIntervals.end());
+  double sampleMinimum = sampleIntervals.empty() ? 0 : sampleIntervals.front();
+  double sampleMaximum = sampleIntervals.empty() ? 0 : sampleIntervals.back();
+  CHECK(!sampleIntervals.empty());
+  CHECK(sampleMaximum < LOAD_SAMPLE_PERIOD + LOAD_SAMPLE_DELAY);
+
+  printf("{ \"clients\": %d, \"requests\": %u, \"seconds\": %.2f, \"requestsPerSecond\": %.1f, "
+         "\"latencyMilliseconds\": { \"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f }, \"reconnects\": %u, \"rejected\": %u, "
+         "\"sampleIntervalMilliseconds\": { \"samples\": %u, \"min\": %.1f, \"max\": %.1f } }\n",
+         LOAD_CLIENTS, answered.load(), seconds, answered / seconds, p50, p99, maximum, reconnects.load(), rejected.load(),
+         (unsigned int)sampleIntervals.size(), sampleMinimum, sampleMaximum);
+}
+
+TEST_CASE(pipelinedRequestsAreAnsweredInOrder) {
+  TestClient client;
+  CHECK(client.connect(serverPort));
+  client.send("GET /configuration.css HTTP/1.1\r\nHost: device\r\n" + adminAuthorization() + "\r\n"
+              "GET /schema HTTP/1.1\r\nHost: device\r\n" + adminAuthorization() + "\r\n"
+              "GET /configuration.js HTTP/1.1\r\nHost: device\r\nConnection: close\r\n" + adminAuthorization() + "\r\n");
+
+  TestResponse first = client.receive(5000);
+  TestResponse second = client.receive(5000);
+  TestResponse third = client.receive(5000);
+  CHECK_EQUAL(200, first.status);
+  CHECK_STRING("text/css", first.headers["content-type"]);
+  CHECK_EQUAL(200, second.status);
+  CHECK_STRING("application/json", second.headers["content-type"]);
+  CHECK_EQUAL(200, third.status);
+  CHECK_STRING("application/javascript", third.headers["content-type"]);
+  CHECK(client.isClosedByServer());
+}
+
+int main() {
+  hostSetSerialOutput(nullptr);
+  hostClearPreferences();
+
+  // Serve on the station interface, like a device in normal operation.
+  serverPort = freePort();
+  static WiFiConfig instance("SMAF-DK-SAP-configuration", "123456789", serverPort, "SMAF-LOAD");
+  configuration = &instance;
+  saveTestConfiguration(instance, "SMAF-LOAD", TEST_ADMIN_PASS);
+
+  if (!startStationServer(instance, serverPort)) {
+    fprintf(stderr, "Configuration server did not start.\n");
+    return 1;
+  }
+
+  return runTests();
+}
\ No newline at end of file
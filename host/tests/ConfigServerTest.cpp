@@ -0,0 +1,262 @@
+/**
+* @file ConfigServerTest.cpp
+* @brief Tests of the configuration server routes in normal operation.
+*
+* Runs the configuration server task on the station interface and covers the Basic
+* authentication with the admin password, secrets withheld from every response, the
+* rejection of cross-site changes, the restriction of firmware downloads to the
+* firmware server, the validation of the configuration form save, the clearing of
+* saved secrets, the values served before a save is applied, and the import of a
+* configuration into another device.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <string>
+#include "Arduino.h"
+#include "ConfigServerFixture.h"
+#include "HostRuntime.h"
+#include "HostTest.h"
+#include "TestClient.h"
+#include "WiFiConfig.h"
+
+static uint16_t serverPort;
+static WiFiConfig* configuration;
+
+// Send one request on a new connection and return the response.
+static TestResponse request(const std::string& head, const std::string& body = "") {
+  TestClient client;
+  client.connect(serverPort);
+
+  std::string message = head + "Host: device\r\nConnection: close\r\n";
+
+  if (!body.empty()) {
+    message += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+
+  client.send(message + "\r\n" + body);
+  return client.receive(5000);
+}
+
+TEST_CASE(serverIsClosedWithoutAdminPassword) {
+  saveTestConfiguration(*configuration, "SMAF-TEST", "");
+
+  TestResponse response = request("GET / HTTP/1.1\r\n" + basicAuthorization(CONFIG_ADMIN_USER, ""));
+  CHECK_EQUAL(403, response.status);
+  CHECK_STRING("HTTP/1.1 403 Forbidden", response.statusLine);
+
+  saveTestConfiguration(*configuration, "SMAF-TEST", TEST_ADMIN_PASS);
+}
+
+TEST_CASE(requestsNeedTheAdminPassword) {
+  TestResponse anonymous = request("GET / HTTP/1.1\r\n");
+  CHECK_EQUAL(401, anonymous.status);
+  CHECK_STRING("HTTP/1.1 401 Unauthorized", anonymous.statusLine);
+  CHECK_STRING(CONFIG_AUTH_CHALLENGE, anonymous.headers["www-authenticate"]);
+
+  CHECK_EQUAL(401, request("GET /values HTTP/1.1\r\n" + basicAuthorization(CONFIG_ADMIN_USER, "wrong-password")).status);
+  CHECK_EQUAL(401, request("GET /values HTTP/1.1\r\n" + basicAuthorization(CONFIG_ADMIN_USER, TEST_ADMIN_PASS "x")).status);
+  CHECK_EQUAL(401, request("GET /values HTTP/1.1\r\n" + basicAuthorization("root", TEST_ADMIN_PASS)).status);
+  CHECK_EQUAL(401, request("GET /values HTTP/1.1\r\nAuthorization: Basic !!!\r\n").status);
+  CHECK_EQUAL(200, request("GET /values HTTP/1.1\r\n" + adminAuthorization()).status);
+}
+
+TEST_CASE(secretsAreNeverServed) {
+  const char* paths[] = { "/values", "/api/config" };
+
+  for (const char* path : paths) {
+    TestResponse response = request("GET " + std::string(path) + " HTTP/1.1\r\n" + adminAuthorization());
+    CHECK_EQUAL(200, response.status);
+    CHECK(response.body.find("\"netPass\":null") != std::string::npos);
+    CHECK(response.body.find("\"adminPass\":null") != std::string::npos);
+    CHECK(response.body.find(TEST_NETWORK_PASS) == std::string::npos);
+    CHECK(response.body.find(TEST_ADMIN_PASS) == std::string::npos);
+  }
+
+  // The blob includes the passwords, so it is only imported over the network.
+  CHECK_EQUAL(405, request("GET " CONFIG_BLOB_PATH " HTTP/1.1\r\n" + adminAuthorization()).status);
+}
+
+TEST_CASE(crossSiteChangesAreRejected) {
+  std::string update = "{\"mqttTopic\":\"smaf/other\"}";
+
+  CHECK_EQUAL(403, request("PUT /api/config HTTP/1.1\r\nOrigin: http://attacker.example\r\n" + adminAuthorization(), update).status);
+  CHECK_EQUAL(403, request("POST /configuration HTTP/1.1\r\nOrigin: null\r\n" + adminAuthorization(), "mqttTopic=smaf%2Fother").status);
+  CHECK_EQUAL(200, request("PUT /api/config HTTP/1.1\r\nOrigin: http://device\r\n" + adminAuthorization(), update).status);
+  CHECK_EQUAL(200, request("PUT /api/config HTTP/1.1\r\n" + adminAuthorization(), "{\"mqttTopic\":\"smaf/test\"}").status);
+}
+
+TEST_CASE(firmwareIsOnlyPulledFromTheFirmwareServer) {
+  std::string hash = std::string(64, '0');
+
+  CHECK_EQUAL(401, request("POST " CONFIG_FIRMWARE_PATH " HTTP/1.1\r\n" CONFIG_FIRMWARE_HASH_HEADER ": " + hash + "\r\n", "image").status);
+  CHECK_EQUAL(401, request("POST " CONFIG_FIRMWARE_PULL_PATH " HTTP/1.1\r\n", "{}").status);
+
+  // Another host, also behind user information or with a longer name, is refused.
+  const char* foreign[] = { "http://firmware.example/smaf.bin", "http://" TEST_FIRMWARE_HOST "@firmware.example/smaf.bin",
+                            "http://" TEST_FIRMWARE_HOST ".example/smaf.bin", "ftp://" TEST_FIRMWARE_HOST "/smaf.bin" };
+
+  for (const char* url : foreign) {
+    TestResponse response = request("POST " CONFIG_FIRMWARE_PULL_PATH " HTTP/1.1\r\n" + adminAuthorization(),
+                                    "{\"url\":\"" + std::string(url) + "\",\"sha256\":\"" + hash + "\"}");
+    CHECK_EQUAL(403, response.status);
+    CHECK(response.body.find("firmware server") != std::string::npos);
+  }
+
+  // The firmware server itself is contacted, here on a port nothing listens on.
+  std::string url = "http://" TEST_FIRMWARE_HOST ":" + std::to_string(freePort()) + "/smaf.bin";
+  TestResponse response = request("POST " CONFIG_FIRMWARE_PULL_PATH " HTTP/1.1\r\n" + adminAuthorization(),
+                                  "{\"url\":\"" + url + "\",\"sha256\":\"" + hash + "\"}");
+  CHECK_EQUAL(502, response.status);
+}
+
+TEST_CASE(formSaveKeepsEmptySecrets) {
+  std::string form = "netName=SMAF-Lab&netPass=&mqttSrvAdr=broker.example&mqttSrvPort=8883&mqttUser=&mqttPass="
+                     "&mqttClient=SMAF-TEST&mqttTopic=smaf%2Fform&audioNotif=true&adminPass=";
+  TestResponse response = request("POST /configuration HTTP/1.1\r\nOrigin: http://device\r\n"
+                                  "Content-Type: application/x-www-form-urlencoded\r\n" + adminAuthorization(), form);
+  CHECK_EQUAL(200, response.status);
+  CHECK_STRING("text/html", response.headers["content-type"]);
+
+  configuration->reloadPreferences();
+  CHECK_STRING("broker.example", configuration->getMqttServerAddress());
+  CHECK_EQUAL(8883, configuration->getMqttServerPort());
+  CHECK_STRING("smaf/form", configuration->getMqttTopic());
+  CHECK_STRING(TEST_NETWORK_PASS, configuration->getNetworkPass());
+  CHECK(configuration->getAudioNotificationsStatus());
+  CHECK(!configuration->getVisualNotificationsStatus());
+
+  // The admin password was kept as well.
+  CHECK_EQUAL(200, request("GET /values HTTP/1.1\r\n" + adminAuthorization()).status);
+
+  // A GET of the page no longer saves anything.
+  request("GET /configuration?mqttTopic=smaf%2Fquery HTTP/1.1\r\n" + adminAuthorization());
+  configuration->reloadPreferences();
+  CHECK_STRING("smaf/form", configuration->getMqttTopic());
+}
+
+TEST_CASE(invalidFormIsNotSaved) {
+  std::string form = "netName=SMAF-Lab&netPass=&mqttSrvAdr=&mqttSrvPort=88x3&mqttUser=&mqttPass="
+                     "&mqttClient=SMAF-TEST&mqttTopic=smaf%2Finvalid&adminPass=short";
+  TestResponse response = request("POST /configuration HTTP/1.1\r\n" + adminAuthorization(), form);
+  CHECK_EQUAL(400, response.status);
+  CHECK(response.body.find("\"mqttSrvAdr\":\"Must not be empty.\"") != std::string::npos);
+  CHECK(response.body.find("\"mqttSrvPort\":\"Must be a number.\"") != std::string::npos);
+  CHECK(response.body.find("\"adminPass\":") != std::string::npos);
+  CHECK(response.body.find("\"mqttTopic\"") == std::string::npos);
+
+  // Numbers beyond the range of the setting are rejected rather than wrapped.
+  form = "netName=SMAF-Lab&mqttSrvAdr=broker.example&mqttSrvPort=65536&mqttClient=SMAF-TEST&mqttTopic=smaf%2Finvalid";
+  response = request("POST /configuration HTTP/1.1\r\n" + adminAuthorization(), form);
+  CHECK_EQUAL(400, response.status);
+  CHECK(response.body.find("\"mqttSrvPort\"") != std::string::npos);
+
+  configuration->reloadPreferences();
+  CHECK_STRING("smaf/form", configuration->getMqttTopic());
+  CHECK_EQUAL(8883, configuration->getMqttServerPort());
+}
+
+TEST_CASE(savedValuesAreServedBeforeTheyApply) {
+  std::string form = "netName=SMAF-Lab&netPass=&mqttSrvAdr=broker.example&mqttSrvPort=8883&mqttUser=&mqttPass="
+                     "&mqttClient=SMAF-TEST&mqttTopic=smaf%2Fsaved&audioNotif=true&adminPass=";
+  CHECK_EQUAL(200, request("POST /configuration HTTP/1.1\r\n" + adminAuthorization(), form).status);
+
+  // The page shows the saved topic, while the device still uses the applied one.
+  TestResponse response = request("GET /values HTTP/1.1\r\n" + adminAuthorization());
+  CHECK(response.body.find("\"mqttTopic\":\"smaf/saved\"") != std::string::npos);
+  CHECK_STRING("smaf/form", configuration->getMqttTopic());
+
+  // Applying the saved values still reports the change.
+  CHECK_EQUAL(CONFIG_CHANGED_MQTT_TOPIC, configuration->reloadPreferences());
+  CHECK_STRING("smaf/saved", configuration->getMqttTopic());
+
+  response = request("PUT /api/config HTTP/1.1\r\n" + adminAuthorization(), "{\"mqttTopic\":\"smaf/form\"}");
+  CHECK(response.body.find("\"mqttTopic\":\"smaf/form\"") != std::string::npos);
+  CHECK_EQUAL(CONFIG_CHANGED_MQTT_TOPIC, configuration->reloadPreferences());
+}
+
+TEST_CASE(importKeepsTheDeviceIdentity) {
+  char blob[CONFIG_BLOB_SIZE];
+  CHECK(configuration->exportConfiguration(blob, sizeof(blob)));
+
+  // A configured device takes the shared settings and keeps its own identity.
+  WiFiConfig clone("SMAF-DK-SAP-configuration", "123456789", 0, "SMAF-CLONE");
+  saveTestConfiguration(clone, "SMAF-CLONE", "clone-admin-password", "SMAF-CLONE", "smaf/clone");
+  CHECK(clone.importConfiguration(blob, strlen(blob)) == nullptr);
+  clone.reloadPreferences();
+  CHECK_STRING("broker.example", clone.getMqttServerAddress());
+  CHECK_EQUAL(8883, clone.getMqttServerPort());
+  CHECK_STRING("SMAF-CLONE", clone.getMqttClientId());
+  CHECK_STRING("smaf/clone", clone.getMqttTopic());
+
+  ConfigurationRecord record;
+  size_t length = 0;
+  CHECK(clone.exportConfiguration(blob, sizeof(blob)));
+  mbedtls_base64_decode((unsigned char*)&record, sizeof(record), &length, (const unsigned char*)blob, strlen(blob));
+  CHECK_STRING("clone-admin-password", record.values.strings + settingOffset(settingIndex(ADMIN_PASS)));
+
+  // A new device derives its identity from the imported one.
+  CHECK(configuration->exportConfiguration(blob, sizeof(blob)));
+  WiFiConfig fresh("SMAF-DK-SAP-configuration", "123456789", 0, "SMAF-FRESH");
+  CHECK(fresh.importConfiguration(blob, strlen(blob)) == nullptr);
+  fresh.reloadPreferences();
+  CHECK_STRING(TEST_CLIENT_ID "-a1b2c3", fresh.getMqttClientId());
+  CHECK_STRING("smaf/form-a1b2c3", fresh.getMqttTopic());
+  CHECK_STRING("broker.example", fresh.getMqttServerAddress());
+}
+
+TEST_CASE(formSaveClearsListedSecrets) {
+  std::string form = "netName=SMAF-Lab&netPass=&mqttSrvAdr=broker.example&mqttSrvPort=8883&mqttUser=smaf"
+                     "&mqttClient=SMAF-TEST&mqttTopic=smaf%2Fform&adminPass=";
+  CHECK_EQUAL(200, request("POST /configuration HTTP/1.1\r\n" + adminAuthorization(), form + "&mqttPass=broker-pass").status);
+  configuration->reloadPreferences();
+  CHECK_STRING("broker-pass", configuration->getMqttPass());
+
+  // Empty fields keep the secrets, the listed ones are cleared instead.
+  form += "&mqttPass=&clear=netPass%2CmqttPass%2CadminPass";
+  CHECK_EQUAL(200, request("POST /configuration HTTP/1.1\r\n" + adminAuthorization(), form).status);
+  configuration->reloadPreferences();
+  CHECK_STRING("", configuration->getNetworkPass());
+  CHECK_STRING("", configuration->getMqttPass());
+  CHECK_STRING("smaf/form", configuration->getMqttTopic());
+
+  // Without the admin password the server is closed again.
+  CHECK_EQUAL(403, request("GET /values HTTP/1.1\r\n" + adminAuthorization()).status);
+
+  saveTestConfiguration(*configuration, "SMAF-TEST", TEST_ADMIN_PASS);
+}
+
+int main() {
+  hostSetSerialOutput(nullptr);
+  hostClearPreferences();
+
+  serverPort = freePort();
+  static WiFiConfig instance("SMAF-DK-SAP-configuration", "123456789", serverPort, "SMAF-TEST");
+  configuration = &instance;
+  saveTestConfiguration(instance, "SMAF-TEST", TEST_ADMIN_PASS);
+
+  if (!startStationServer(instance, serverPort)) {
+    fprintf(stderr, "Configuration server did not start.\n");
+    return 1;
+  }
+
+  return runTests();
+}
\ No newline at end of file
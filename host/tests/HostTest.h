@@ -0,0 +1,113 @@
+/**
+* @file HostTest.h
+* @brief Minimal test harness of the host tests.
+*
+* Test cases register themselves with TEST_CASE and runTests() runs them in order.
+* A failed check prints its location and marks the test as failed, the test goes on.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Structure of a registered test case.
+struct HostTestCase {
+  const char* name;  // Name printed in the report.
+  void (*run)();     // Body of the test case.
+};
+
+/**
+* @brief Get the registered test cases, in the order of their definition.
+*/
+inline std::vector<HostTestCase>& hostTestCases() {
+  static std::vector<HostTestCase> cases;
+  return cases;
+}
+
+/**
+* @brief Get the number of failed checks.
+*/
+inline int& hostTestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+// Registers a test case before main() runs.
+struct HostTestRegistration {
+  HostTestRegistration(const char* name, void (*run)()) {
+    hostTestCases().push_back(HostTestCase{ name, run });
+  }
+};
+
+#define TEST_CASE(name) \
+  static void name(); \
+  static HostTestRegistration name##Registration(#name, name); \
+  static void name()
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      hostTestFailures()++; \
+    } \
+  } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+  do { \
+    if (!((expected) == (actual))) { \
+      fprintf(stderr, "%s:%d: CHECK_EQUAL(%s, %s) failed\n", __FILE__, __LINE__, #expected, #actual); \
+      hostTestFailures()++; \
+    } \
+  } while (0)
+
+#define CHECK_STRING(expected, actual) \
+  do { \
+    std::string expectedValue(expected); \
+    std::string actualValue(actual); \
+    if (expectedValue != actualValue) { \
+      fprintf(stderr, "%s:%d: expected \"%s\", got \"%s\"\n", __FILE__, __LINE__, expectedValue.c_str(), actualValue.c_str()); \
+      hostTestFailures()++; \
+    } \
+  } while (0)
+
+/**
+* @brief Run all registered test cases.
+*
+* @return The exit code of the test program, 0 if all checks passed.
+*/
+inline int runTests() {
+  for (const HostTestCase& testCase : hostTestCases()) {
+    int failures = hostTestFailures();
+    testCase.run();
+    printf("%s %s\n", hostTestFailures() == failures ? "PASS" : "FAIL", testCase.name);
+  }
+
+  printf("%d test cases, %d failed checks\n", (int)hostTestCases().size(), hostTestFailures());
+  return hostTestFailures() == 0 ? 0 : 1;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+/**
+* @file HttpConnectionTest.cpp
+* @brief Tests of HttpConnection over loopback sockets.
+*
+* Covers pipelined requests moved to the start of the buffer by finishRequest(),
+* the keep-alive and read timeouts, and clients closing the connection.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "HostRuntime.h"
+#include "HostTest.h"
+#include "HttpConnection.h"
+#include "TestClient.h"
+#include "WiFiServer.h"
+
+// Connects a TestClient to a server and opens an HttpConnection for it.
+struct ConnectionFixture {
+  WiFiServer server;
+  TestClient client;
+  HttpConnection connection;
+
+  ConnectionFixture()
+    : server(0) {
+    server.begin();
+    client.connect(server.port());
+
+    for (int i = 0; i < 100 && connection.isIdle(); i++) {
+      WiFiClient accepted = server.accept();
+
+      if (accepted) {
+        connection.open(accepted);
+      } else {
+        delay(5);
+      }
+    }
+  }
+
+  ~ConnectionFixture() {
+    if (!connection.isIdle()) {
+      connection.close();
+    }
+
+    server.end();
+  }
+
+  // Poll until the request state changes, or return REQUEST_PENDING after a second.
+  HttpRequestStateEnum waitForRequest() {
+    HttpRequestStateEnum state = REQUEST_PENDING;
+
+    for (int i = 0; i < 200 && state == REQUEST_PENDING; i++) {
+      state = connection.poll();
+
+      if (state == REQUEST_PENDING) {
+        delay(5);
+      }
+    }
+
+    return state;
+  }
+
+  // Poll once the client's data had time to arrive.
+  HttpRequestStateEnum pollAfterDelivery() {
+    delay(20);
+    return connection.poll();
+  }
+};
+
+TEST_CASE(pipelinedRequestsAreHandledInOrder) {
+  ConnectionFixture fixture;
+  CHECK(!fixture.connection.isIdle());
+
+  // Three requests in one segment, the last one split across two.
+  fixture.client.send("GET /first HTTP/1.1\r\nHost: a\r\n\r\n"
+                      "POST /second HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+                      "GET /thi");
+
+  CHECK_EQUAL(REQUEST_COMPLETE, fixture.waitForRequest());
+  CHECK(fixture.connection.request().path().equals("/first"));
+  fixture.connection.finishRequest();
+
+  // The pipelined request is complete without any new data.
+  CHECK_EQUAL(REQUEST_COMPLETE, fixture.connection.poll());
+  CHECK(fixture.connection.request().path().equals("/second"));
+  HttpView body = fixture.connection.request().body();
+  CHECK_STRING("hello", std::string(body.data, body.length));
+  fixture.connection.finishRequest();
+
+  // The partial request moved to the start of the buffer and completes with the rest.
+  CHECK_EQUAL(REQUEST_PENDING, fixture.connection.poll());
+  CHECK(!fixture.connection.isBetweenRequests());
+  fixture.client.send("rd?x=1 HTTP/1.1\r\n\r\n");
+  CHECK_EQUAL(REQUEST_COMPLETE, fixture.waitForRequest());
+  CHECK(fixture.connection.request().path().equals("/third"));
+  CHECK(fixture.connection.request().query().equals("x=1"));
+  fixture.connection.finishRequest();
+  CHECK(fixture.connection.isBetweenRequests());
+}
+
+TEST_CASE(idlePersistentConnectionExpires) {
+  ConnectionFixture fixture;
+  fixture.client.send("GET / HTTP/1.1\r\n\r\n");
+  CHECK_EQUAL(REQUEST_COMPLETE, fixture.waitForRequest());
+  fixture.connection.finishRequest();
+
+  hostAdvanceTime(HTTP_KEEP_ALIVE_TIMEOUT - 1000);
+  CHECK_EQUAL(REQUEST_PENDING, fixture.connection.poll());
+  hostAdvanceTime(2000);
+  CHECK_EQUAL(REQUEST_CLOSED, fixture.connection.poll());
+}
+
+TEST_CASE(readTimeoutStartsWithFirstByteOfNextRequest) {
+  ConnectionFixture fixture;
+  fixture.client.send("GET / HTTP/1.1\r\n\r\n");
+  CHECK_EQUAL(REQUEST_COMPLETE, fixture.waitForRequest());
+  fixture.connection.finishRequest();
+
+  // Idle time before the next request does not count against its read timeout.
+  hostAdvanceTime(HTTP_KEEP_ALIVE_TIMEOUT - 1000);
+  fixture.client.send("GET / HT");
+  CHECK_EQUAL(REQUEST_PENDING, fixture.pollAfterDelivery());
+  hostAdvanceTime(HTTP_READ_TIMEOUT - 1000);
+  CHECK_EQUAL(REQUEST_PENDING, fixture.connection.poll());
+  hostAdvanceTime(2000);
+  CHECK_EQUAL(REQUEST_TIMEOUT, fixture.connection.poll());
+}
+
+TEST_CASE(stalledRequestTimesOut) {
+  ConnectionFixture fixture;
+  fixture.client.send("GET /slow HTTP/1.1\r\nHost: a\r\n");
+  CHECK_EQUAL(REQUEST_PENDING, fixture.pollAfterDelivery());
+  hostAdvanceTime(HTTP_READ_TIMEOUT + 1);
+  CHECK_EQUAL(REQUEST_TIMEOUT, fixture.connection.poll());
+}
+
+TEST_CASE(closedClientIsReported) {
+  ConnectionFixture fixture;
+  fixture.client.send("GET / HT");
+  fixture.client.close();
+  CHECK_EQUAL(REQUEST_CLOSED, fixture.waitForRequest());
+}
+
+TEST_CASE(invalidRequestIsReported) {
+  ConnectionFixture fixture;
+  fixture.client.send("GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n");
+  CHECK_EQUAL(REQUEST_INVALID, fixture.waitForRequest());
+  CHECK_EQUAL(501, fixture.connection.request().errorStatus());
+}
+
+TEST_CASE(fullBufferWithoutHeaderEndIsRejected) {
+  ConnectionFixture fixture;
+  std::string request = "GET / HTTP/1.1\r\n";
+
+  // Valid header lines that together fill the buffer before the header section ends.
+  while (request.size() < HTTP_REQUEST_BUFFER_SIZE + 100) {
+    request += "X-Padding: " + std::string(400, 'p') + "\r\n";
+  }
+
+  fixture.client.send(request);
+  CHECK_EQUAL(REQUEST_INVALID, fixture.waitForRequest());
+  CHECK_EQUAL(431, fixture.connection.request().errorStatus());
+}
+
+int main() {
+  hostSetSerialOutput(nullptr);
+  return runTests();
+}
\ No newline at end of file
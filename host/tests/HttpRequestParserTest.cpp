@@ -0,0 +1,276 @@
+/**
+* @file HttpRequestParserTest.cpp
+* @brief Tests of the incremental HttpRequestParser.
+*
+* Covers requests parsed in one piece and byte by byte, queries, headers, bodies and
+* the keep-alive rules, and every rejection with its status code (400, 413, 414, 431
+* and 501), including limits enforced before a line is complete.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "HostTest.h"
+#include "HttpConnection.h"
+#include "HttpRequestParser.h"
+
+// Holds a receive buffer and a parser working on it, as HttpConnection does.
+struct ParserFixture {
+  std::vector<char> buffer;
+  HttpRequestParser parser;
+  size_t length = 0;
+
+  explicit ParserFixture(size_t capacity = HTTP_REQUEST_BUFFER_SIZE)
+    : buffer(capacity) {
+    parser.reset(buffer.data(), buffer.size());
+  }
+
+  // Append data to the buffer, up to its capacity, and parse it in one call.
+  HttpParseResultEnum receive(const std::string& data) {
+    size_t count = std::min(data.size(), buffer.size() - length);
+    memcpy(buffer.data() + length, data.data(), count);
+    length += count;
+
+    return parser.parse(length);
+  }
+
+  // Deliver data byte by byte and return the result after the last byte.
+  HttpParseResultEnum receiveBytewise(const std::string& data) {
+    HttpParseResultEnum result = HTTP_PARSE_INCOMPLETE;
+
+    for (size_t i = 0; i < data.size() && result == HTTP_PARSE_INCOMPLETE; i++) {
+      result = receive(data.substr(i, 1));
+    }
+
+    return result;
+  }
+};
+
+static std::string viewString(const HttpView& view) {
+  return std::string(view.data, view.length);
+}
+
+TEST_CASE(simpleRequestIsParsed) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("GET /configuration HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n"));
+  CHECK_STRING("GET", viewString(fixture.parser.method()));
+  CHECK_STRING("/configuration", viewString(fixture.parser.path()));
+  CHECK_STRING("", viewString(fixture.parser.query()));
+  CHECK_EQUAL(1, fixture.parser.headerCount());
+  CHECK_STRING("192.168.4.1", viewString(fixture.parser.header("host")));
+  CHECK_EQUAL(0u, fixture.parser.contentLength());
+  CHECK(fixture.parser.keepAlive());
+  CHECK_EQUAL(0, fixture.parser.errorStatus());
+}
+
+TEST_CASE(requestIsParsedByteByByte) {
+  ParserFixture fixture;
+  std::string request = "POST /configuration?save=1 HTTP/1.1\r\nHost: a\r\nContent-Length: 11\r\n\r\nssid=SMAF-1";
+
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receiveBytewise(request));
+  CHECK_EQUAL(request.size(), fixture.length);
+  CHECK_STRING("POST", viewString(fixture.parser.method()));
+  CHECK_STRING("/configuration", viewString(fixture.parser.path()));
+  CHECK_STRING("save=1", viewString(fixture.parser.query()));
+  CHECK_STRING("ssid=SMAF-1", viewString(fixture.parser.body()));
+  CHECK_EQUAL(request.size(), fixture.parser.requestLength());
+}
+
+TEST_CASE(viewsAreNullTerminated) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("GET /scan?refresh=1 HTTP/1.1\r\nAccept:  text/html \t\r\n\r\n"));
+  CHECK_STRING("/scan", fixture.parser.path().data);
+  CHECK_STRING("refresh=1", fixture.parser.query().data);
+  CHECK_STRING("Accept", fixture.parser.headerName(0).data);
+  CHECK_STRING("text/html", fixture.parser.headerValue(0).data);
+}
+
+TEST_CASE(bareLineFeedsAndLeadingEmptyLinesAreAccepted) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("\r\n\nGET / HTTP/1.0\nHost: a\n\n"));
+  CHECK_STRING("/", viewString(fixture.parser.path()));
+  CHECK_STRING("a", viewString(fixture.parser.header("Host")));
+}
+
+TEST_CASE(bodyWaitsForContentLength) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_INCOMPLETE, fixture.receive("PUT /api/config HTTP/1.1\r\nContent-Length: 8\r\n\r\n{\"a\":"));
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("1}\r\nGET"));
+  CHECK_STRING("{\"a\":1}\r", viewString(fixture.parser.body()));
+
+  // Bytes of a pipelined request are not part of this one.
+  CHECK(fixture.parser.requestLength() < fixture.length);
+}
+
+TEST_CASE(streamedBodyCompletesWithHeaders) {
+  ParserFixture fixture;
+  fixture.parser.setStreamedPath("/update");
+  fixture.parser.reset(fixture.buffer.data(), fixture.buffer.size());
+
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("POST /update HTTP/1.1\r\nContent-Length: 1000000\r\n\r\nabc"));
+  CHECK(fixture.parser.isBodyStreamed());
+  CHECK_EQUAL(1000000u, fixture.parser.contentLength());
+  CHECK_STRING("abc", viewString(fixture.parser.body()));
+}
+
+TEST_CASE(keepAliveFollowsVersionAndConnectionHeader) {
+  const struct {
+    const char* request;
+    bool keepAlive;
+  } cases[] = {
+    { "GET / HTTP/1.1\r\n\r\n", true },
+    { "GET / HTTP/1.1\r\nConnection: Close\r\n\r\n", false },
+    { "GET / HTTP/1.0\r\n\r\n", false },
+    { "GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n", true },
+  };
+
+  for (const auto& testCase : cases) {
+    ParserFixture fixture;
+    CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive(testCase.request));
+    CHECK_EQUAL(testCase.keepAlive, fixture.parser.keepAlive());
+  }
+}
+
+TEST_CASE(malformedRequestsAreRejectedWith400) {
+  const char* requests[] = {
+    "GET\r\n\r\n",
+    "GET /\r\n\r\n",
+    "GET / SPDY/3\r\n\r\n",
+    " / HTTP/1.1\r\n\r\n",
+    "GET  HTTP/1.1\r\n\r\n",
+    "GET / HTTP/1.1\r\nNo colon\r\n\r\n",
+    "GET / HTTP/1.1\r\n: empty name\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length: 12a\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length: 1234567890\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length:\r\n\r\n",
+  };
+
+  for (const char* request : requests) {
+    ParserFixture fixture;
+    CHECK_EQUAL(HTTP_PARSE_ERROR, fixture.receive(request));
+    CHECK_EQUAL(400, fixture.parser.errorStatus());
+  }
+}
+
+TEST_CASE(bodyLargerThanBufferIsRejectedWith413) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_ERROR, fixture.receive("POST /configuration HTTP/1.1\r\nContent-Length: 4096\r\n\r\n"));
+  CHECK_EQUAL(413, fixture.parser.errorStatus());
+
+  // The body must fit in the space left after the header section.
+  ParserFixture exact(64);
+  std::string head = "POST / HTTP/1.1\r\nContent-Length: 35\r\n\r\n";
+  CHECK_EQUAL(HTTP_PARSE_ERROR, exact.receive(head));
+  CHECK_EQUAL(413, exact.parser.errorStatus());
+
+  ParserFixture fitting(64);
+  CHECK_EQUAL(HTTP_PARSE_INCOMPLETE, fitting.receive("POST / HTTP/1.1\r\nContent-Length: 24\r\n\r\n"));
+  CHECK_EQUAL(0, fitting.parser.errorStatus());
+}
+
+TEST_CASE(longRequestLineIsRejectedWith414) {
+  std::string target = "/" + std::string(HTTP_MAX_REQUEST_LINE_LENGTH, 'a');
+
+  // Complete line.
+  ParserFixture complete;
+  CHECK_EQUAL(HTTP_PARSE_ERROR, complete.receive("GET " + target + " HTTP/1.1\r\n\r\n"));
+  CHECK_EQUAL(414, complete.parser.errorStatus());
+
+  // Partial line, rejected before its end arrives.
+  ParserFixture partial;
+  CHECK_EQUAL(HTTP_PARSE_ERROR, partial.receive("GET " + target));
+  CHECK_EQUAL(414, partial.parser.errorStatus());
+
+  // Partial line at the limit is still accepted.
+  ParserFixture limit;
+  CHECK_EQUAL(HTTP_PARSE_INCOMPLETE, limit.receive(std::string(HTTP_MAX_REQUEST_LINE_LENGTH, 'G')));
+}
+
+TEST_CASE(longHeaderLineIsRejectedWith431) {
+  std::string value(HTTP_MAX_HEADER_LINE_LENGTH, 'v');
+
+  ParserFixture complete;
+  CHECK_EQUAL(HTTP_PARSE_ERROR, complete.receive("GET / HTTP/1.1\r\nX-Long: " + value + "\r\n\r\n"));
+  CHECK_EQUAL(431, complete.parser.errorStatus());
+
+  ParserFixture partial;
+  CHECK_EQUAL(HTTP_PARSE_ERROR, partial.receive("GET / HTTP/1.1\r\nX-Long: " + value));
+  CHECK_EQUAL(431, partial.parser.errorStatus());
+}
+
+TEST_CASE(tooManyHeadersAreRejectedWith431) {
+  std::string request = "GET / HTTP/1.1\r\n";
+
+  for (int i = 0; i < HTTP_MAX_HEADER_COUNT; i++) {
+    request += "X-Header-" + std::to_string(i) + ": " + std::to_string(i) + "\r\n";
+  }
+
+  ParserFixture limit;
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, limit.receive(request + "\r\n"));
+  CHECK_EQUAL(HTTP_MAX_HEADER_COUNT, limit.parser.headerCount());
+
+  ParserFixture tooMany;
+  CHECK_EQUAL(HTTP_PARSE_ERROR, tooMany.receive(request + "X-Header-16: 16\r\n\r\n"));
+  CHECK_EQUAL(431, tooMany.parser.errorStatus());
+}
+
+TEST_CASE(fullBufferIsRejected) {
+  // Short lines that fill the buffer before the request line or header section ends.
+  ParserFixture requestLine(32);
+  CHECK_EQUAL(HTTP_PARSE_ERROR, requestLine.receive("GET /" + std::string(40, 'a')));
+  CHECK_EQUAL(414, requestLine.parser.errorStatus());
+
+  ParserFixture headers(32);
+  CHECK_EQUAL(HTTP_PARSE_ERROR, headers.receive("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n"));
+  CHECK_EQUAL(431, headers.parser.errorStatus());
+}
+
+TEST_CASE(transferEncodingIsRejectedWith501) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_ERROR, fixture.receive("POST /api/config HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"));
+  CHECK_EQUAL(501, fixture.parser.errorStatus());
+}
+
+TEST_CASE(errorIsKeptUntilReset) {
+  ParserFixture fixture;
+
+  CHECK_EQUAL(HTTP_PARSE_ERROR, fixture.receive("BROKEN\r\n"));
+  CHECK_EQUAL(HTTP_PARSE_ERROR, fixture.receive("GET / HTTP/1.1\r\n\r\n"));
+  CHECK_EQUAL(400, fixture.parser.errorStatus());
+
+  fixture.parser.reset(fixture.buffer.data(), fixture.buffer.size());
+  fixture.length = 0;
+  CHECK_EQUAL(HTTP_PARSE_COMPLETE, fixture.receive("GET / HTTP/1.1\r\n\r\n"));
+  CHECK_EQUAL(0, fixture.parser.errorStatus());
+}
+
+int main() {
+  return runTests();
+}
\ No newline at end of file
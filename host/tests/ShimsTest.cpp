@@ -0,0 +1,190 @@
+/**
+* @file ShimsTest.cpp
+* @brief Tests of the host shims the other host tests rely on.
+*
+* Covers the emulated NVS, timers, sockets and the hash, encoding and CRC functions.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <unistd.h>
+#include "Arduino.h"
+#include "HostRuntime.h"
+#include "HostTest.h"
+#include "Preferences.h"
+#include "WiFi.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "mbedtls/base64.h"
+#include "mbedtls/sha256.h"
+
+TEST_CASE(preferencesKeepTypedValues) {
+  hostClearPreferences();
+  Preferences preferences;
+
+  // Like NVS, a namespace that was never written cannot be read.
+  CHECK(!preferences.begin("test", true));
+  CHECK(preferences.begin("test", false));
+  CHECK_EQUAL(5u, preferences.putString("name", "value"));
+  CHECK_EQUAL(4u, preferences.putUInt("number", 42));
+  CHECK_EQUAL(0u, preferences.putString("a key that is too long", "value"));
+
+  char value[8];
+  CHECK_EQUAL(6u, preferences.getString("name", value, sizeof(value)));
+  CHECK_STRING("value", value);
+  CHECK_EQUAL(0u, preferences.getString("name", value, 5));
+  CHECK_EQUAL(42u, preferences.getUInt("number", 0));
+  CHECK_EQUAL(7, preferences.getInt("number", 7));
+  CHECK(preferences.isKey("name"));
+  CHECK(preferences.remove("name"));
+  CHECK(!preferences.isKey("name"));
+  preferences.end();
+
+  CHECK(preferences.begin("test", true));
+  CHECK_EQUAL(0u, preferences.putUInt("number", 1));
+  preferences.end();
+}
+
+TEST_CASE(preferencesCountEntries) {
+  hostClearPreferences();
+  Preferences preferences;
+  preferences.begin("test", false);
+  size_t freeEntries = preferences.freeEntries();
+
+  // A blob takes an entry and one for every 32 bytes of data.
+  uint8_t blob[100] = { 0 };
+  preferences.putBytes("blob", blob, sizeof(blob));
+  CHECK_EQUAL(freeEntries - 5, preferences.freeEntries());
+
+  uint8_t read[100];
+  CHECK_EQUAL(0u, preferences.getBytes("blob", read, 50));
+  CHECK_EQUAL(100u, preferences.getBytes("blob", read, sizeof(read)));
+  preferences.end();
+}
+
+TEST_CASE(preferencesSurviveRestart) {
+  char path[] = "/tmp/smaf-shims-XXXXXX";
+  int fd = mkstemp(path);
+  close(fd);
+
+  hostSetStorageFile(path);
+  Preferences preferences;
+  preferences.begin("test", false);
+  preferences.putString("name", "kept");
+  preferences.end();
+
+  // Loading the file again stands in for a restart of the device.
+  hostSetStorageFile(path);
+  preferences.begin("test", true);
+  CHECK_STRING("kept", preferences.getString("name").c_str());
+  preferences.end();
+
+  hostSetStorageFile(nullptr);
+  unlink(path);
+}
+
+static void countCall(void* arg) {
+  (*(std::atomic<int>*)arg)++;
+}
+
+TEST_CASE(timersFire) {
+  std::atomic<int> calls(0);
+  esp_timer_create_args_t args = {};
+  args.callback = countCall;
+  args.arg = &calls;
+  esp_timer_handle_t timer;
+
+  CHECK_EQUAL(ESP_OK, esp_timer_create(&args, &timer));
+  CHECK_EQUAL(ESP_OK, esp_timer_start_once(timer, 10000));
+  CHECK_EQUAL(ESP_ERR_INVALID_STATE, esp_timer_start_once(timer, 10000));
+  delay(100);
+  CHECK_EQUAL(1, calls.load());
+
+  CHECK_EQUAL(ESP_OK, esp_timer_start_periodic(timer, 10000));
+  delay(100);
+  CHECK_EQUAL(ESP_OK, esp_timer_stop(timer));
+  CHECK(calls.load() > 3);
+  CHECK_EQUAL(ESP_OK, esp_timer_delete(timer));
+}
+
+TEST_CASE(socketsExchangeData) {
+  WiFiServer server(0);
+  server.begin();
+  CHECK(server);
+
+  WiFiClient client;
+  CHECK_EQUAL(1, client.connect("127.0.0.1", server.port()));
+  delay(20);
+
+  WiFiClient accepted = server.accept();
+  CHECK(accepted);
+  CHECK_EQUAL(5u, client.write((const uint8_t*)"hello", 5));
+  delay(20);
+  CHECK_EQUAL(5, accepted.available());
+  CHECK_EQUAL('h', accepted.peek());
+
+  char received[6] = { 0 };
+  CHECK_EQUAL(5, accepted.read((uint8_t*)received, 5));
+  CHECK_STRING("hello", received);
+
+  client.stop();
+  delay(20);
+  CHECK(!accepted.connected());
+  server.end();
+}
+
+TEST_CASE(hashesMatchKnownValues) {
+  static const uint8_t expected[32] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+  };
+  uint8_t digest[32];
+  mbedtls_sha256_context context;
+  mbedtls_sha256_init(&context);
+  mbedtls_sha256_starts(&context, 0);
+  mbedtls_sha256_update(&context, (const unsigned char*)"abc", 3);
+  mbedtls_sha256_finish(&context, digest);
+  mbedtls_sha256_free(&context);
+  CHECK(memcmp(expected, digest, sizeof(digest)) == 0);
+
+  CHECK_EQUAL(0xCBF43926u, esp_rom_crc32_le(0, (const uint8_t*)"123456789", 9));
+}
+
+TEST_CASE(base64RoundTrips) {
+  unsigned char encoded[16];
+  unsigned char decoded[16];
+  size_t length;
+
+  CHECK_EQUAL(0, mbedtls_base64_encode(encoded, sizeof(encoded), &length, (const unsigned char*)"device", 6));
+  CHECK_STRING("ZGV2aWNl", (const char*)encoded);
+  CHECK_EQUAL(MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL, mbedtls_base64_encode(encoded, 8, &length, (const unsigned char*)"device", 6));
+
+  CHECK_EQUAL(0, mbedtls_base64_decode(decoded, sizeof(decoded), &length, (const unsigned char*)"ZGV2aQ==", 8));
+  CHECK_EQUAL(4u, length);
+  CHECK(memcmp("devi", decoded, 4) == 0);
+  CHECK_EQUAL(MBEDTLS_ERR_BASE64_INVALID_CHARACTER, mbedtls_base64_decode(decoded, sizeof(decoded), &length, (const unsigned char*)"ZG!2", 4));
+}
+
+int main() {
+  hostSetSerialOutput(nullptr);
+  return runTests();
+}
\ No newline at end of file
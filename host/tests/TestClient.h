@@ -0,0 +1,236 @@
+/**
+* @file TestClient.h
+* @brief Blocking HTTP client of the host tests.
+*
+* Sends raw request bytes over a loopback socket and reads responses, so tests
+* control pipelining, partial requests and connection reuse exactly.
+*
+* @license MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#ifndef TEST_CLIENT_H
+#define TEST_CLIENT_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <map>
+#include <string>
+
+// Structure of a received HTTP response.
+struct TestResponse {
+  int status = 0;                              // Status code, 0 if no response arrived.
+  std::string statusLine;                      // Status line, without its line ending.
+  std::map<std::string, std::string> headers;  // Headers by lowercase name.
+  std::string body;                            // Body, read by its Content-Length or chunks.
+};
+
+class TestClient {
+public:
+  ~TestClient() { close(); }
+
+  /**
+  * @brief Connect to a port of the loopback interface.
+  */
+  bool connect(uint16_t port) {
+    close();
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    int isEnabled = 1;
+    setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &isEnabled, sizeof(isEnabled));
+
+    if (::connect(_fd, (sockaddr*)&address, sizeof(address)) != 0) {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void close() {
+    if (_fd >= 0) {
+      ::close(_fd);
+      _fd = -1;
+    }
+
+    _input.clear();
+    _isClosed = false;
+  }
+
+  bool isOpen() const { return _fd >= 0; }
+
+  /**
+  * @brief Send raw bytes, e.g. one or more requests.
+  */
+  bool send(const std::string& data) {
+    size_t offset = 0;
+
+    while (_fd >= 0 && offset < data.size()) {
+      ssize_t sent = ::send(_fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+
+      if (sent <= 0) {
+        return false;
+      }
+
+      offset += sent;
+    }
+
+    return _fd >= 0;
+  }
+
+  /**
+  * @brief Read the next response.
+  *
+  * @param timeout Time in milliseconds to wait for the complete response.
+  * @return The response, with status 0 if it did not arrive in time or the
+  *         connection closed before.
+  */
+  TestResponse receive(int timeout = 2000) {
+    TestResponse response;
+    size_t headerEnd;
+
+    while ((headerEnd = _input.find("\r\n\r\n")) == std::string::npos) {
+      if (!fill(timeout)) {
+        return response;
+      }
+    }
+
+    std::string head = _input.substr(0, headerEnd);
+    size_t lineEnd = head.find("\r\n");
+    response.statusLine = head.substr(0, lineEnd);
+    size_t space = response.statusLine.find(' ');
+    response.status = space != std::string::npos ? atoi(response.statusLine.c_str() + space + 1) : 0;
+
+    while (lineEnd != std::string::npos && lineEnd < head.size()) {
+      size_t nextEnd = head.find("\r\n", lineEnd + 2);
+      std::string line = head.substr(lineEnd + 2, nextEnd == std::string::npos ? std::string::npos : nextEnd - lineEnd - 2);
+      size_t colon = line.find(':');
+
+      if (colon != std::string::npos) {
+        std::string name = line.substr(0, colon);
+
+        for (char& character : name) {
+          character = tolower(character);
+        }
+
+        size_t valueStart = line.find_first_not_of(' ', colon + 1);
+        response.headers[name] = valueStart != std::string::npos ? line.substr(valueStart) : "";
+      }
+
+      lineEnd = nextEnd;
+    }
+
+    _input.erase(0, headerEnd + 4);
+
+    if (response.headers["transfer-encoding"] == "chunked") {
+      // Read chunks until the last, empty one.
+      while (true) {
+        size_t sizeEnd;
+
+        while ((sizeEnd = _input.find("\r\n")) == std::string::npos) {
+          if (!fill(timeout)) {
+            response.status = 0;
+            return response;
+          }
+        }
+
+        size_t size = strtoul(_input.c_str(), nullptr, 16);
+
+        while (_input.size() < sizeEnd + 2 + size + 2) {
+          if (!fill(timeout)) {
+            response.status = 0;
+            return response;
+          }
+        }
+
+        response.body += _input.substr(sizeEnd + 2, size);
+        _input.erase(0, sizeEnd + 2 + size + 2);
+
+        if (size == 0) {
+          return response;
+        }
+      }
+    }
+
+    size_t length = response.headers.count("content-length") ? atol(response.headers["content-length"].c_str()) : 0;
+
+    while (_input.size() < length) {
+      if (!fill(timeout)) {
+        response.status = 0;
+        return response;
+      }
+    }
+
+    response.body = _input.substr(0, length);
+    _input.erase(0, length);
+
+    return response;
+  }
+
+  /**
+  * @brief Check if the server closed the connection, waiting up to the timeout.
+  */
+  bool isClosedByServer(int timeout = 2000) {
+    while (fill(timeout)) {
+    }
+
+    return _isClosed;
+  }
+
+private:
+  int _fd = -1;            // Connected socket.
+  std::string _input;      // Received bytes not returned yet.
+  bool _isClosed = false;  // True once the server closed the connection.
+
+  // Append received bytes, return false on timeout or once the connection closed.
+  bool fill(int timeout) {
+    if (_fd < 0) {
+      return false;
+    }
+
+    pollfd input = { _fd, POLLIN, 0 };
+
+    if (poll(&input, 1, timeout) <= 0) {
+      return false;
+    }
+
+    char buffer[4096];
+    ssize_t received = recv(_fd, buffer, sizeof(buffer), 0);
+
+    if (received <= 0) {
+      _isClosed = true;
+      return false;
+    }
+
+    _input.append(buffer, received);
+    return true;
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Embed the configuration web assets into the firmware.
+
+Minifies and compresses each file in SMAF-Development-Kit/web with gzip and
+writes SMAF-Development-Kit/WebAssets.h with one `const uint8_t[]` array,
+length and ETag per asset, ready to be served with `Content-Encoding: gzip`.
+The ETag is derived from the compressed content, so it changes whenever the
+served bytes do and the firmware does not need to hash anything at runtime.
+
+Run this script after editing any file in the web directory:
+
+    python3 tools/embed_web_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "SMAF-Development-Kit")
+WEB_DIR = os.path.join(ROOT, "web")
+OUTPUT = os.path.join(ROOT, "WebAssets.h")
+
+# Assets to embed, in the order they appear in the generated header.
+ASSETS = [
+    "configuration.html",
+    "configuration.css",
+    "configuration.js",
+]
+
+HEADER = """/**
+* @file WebAssets.h
+* @brief Gzip compressed web assets for the SoftAP configuration server.
+*
+* This file is generated by tools/embed_web_assets.py from the sources in the
+* web directory. Do not edit it by hand; edit the sources and run the script again.
+*/
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include "Arduino.h"
+"""
+
+FOOTER = """
+#endif
+"""
+
+
+def symbol_name(file_name):
+    """Convert a file name such as configuration.html to CONFIGURATION_HTML."""
+    return re.sub(r"[^A-Z0-9]", "_", file_name.upper())
+
+
+def minify_html(text):
+    """Remove comments and the indentation between tags."""
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    text = re.sub(r">\s*\n\s*<", "><", text)
+    return re.sub(r"\s*\n\s*", " ", text).strip()
+
+
+def minify_css(text):
+    """Remove comments and whitespace that does not separate tokens."""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    # Spaces before a colon are kept, they are significant in selectors such as `a :hover`.
+    text = re.sub(r"\s*([{};,>])\s*", r"\1", text)
+    text = re.sub(r":\s+", ":", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    """Remove whole line comments, indentation and empty lines.
+
+    Line breaks are kept, so automatic semicolon insertion still applies and
+    no tokenizer is needed.
+    """
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+
+# Minifier for each asset type, by file extension.
+MINIFIERS = {
+    ".html": minify_html,
+    ".css": minify_css,
+    ".js": minify_js,
+}
+
+
+def format_array(data):
+    """Format bytes as comma separated hex values, 16 per line."""
+    lines = []
+    for offset in range(0, len(data), 16):
+        chunk = data[offset:offset + 16]
+        lines.append("  " + ", ".join("0x%02x" % byte for byte in chunk) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parts = [HEADER.rstrip("\n")]
+
+    for file_name in ASSETS:
+        with open(os.path.join(WEB_DIR, file_name), encoding="utf-8") as source:
+            text = source.read()
+
+        minified = MINIFIERS[os.path.splitext(file_name)[1]](text).encode("utf-8")
+
+        # Fixed mtime keeps the output reproducible between runs.
+        compressed = gzip.compress(minified, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(compressed).hexdigest()[:16]
+        name = symbol_name(file_name)
+
+        parts.append("")
+        parts.append("// %s, %d bytes, %d bytes minified, %d bytes compressed." % (file_name, len(text.encode("utf-8")),
+                                                                             len(minified), len(compressed)))
+        parts.append("const char %s_ETAG[] = \"\\\"%s\\\"\";" % (name, etag))
+        parts.append("const size_t %s_GZIP_LENGTH = %d;" % (name, len(compressed)))
+        parts.append("const uint8_t %s_GZIP[] PROGMEM = {" % name)
+        parts.append(format_array(compressed))
+        parts.append("};")
+
+    parts.append(FOOTER)
+
+    with open(OUTPUT, "w", newline="\n") as output:
+        output.write("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
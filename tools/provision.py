@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Configure many SMAF-Development-Kit devices in parallel from a CSV manifest.
+
+Each manifest row describes one device in configuration mode: where to reach
+its configuration server and the preference values to store. The tool sends
+the values to the JSON API (PUT /api/config), retries transient failures,
+verifies that the effective configuration returned by the device matches the
+manifest (except the passwords, which the device never returns), and optionally waits until the device leaves configuration mode to
+continue with the new settings. The time to configure is reported per device.
+
+Manifest columns:
+
+    device       Name used in the report (required).
+    address      Configuration server address, default 192.168.4.1.
+    port         Configuration server port, default 80.
+    interface    Network interface joined to the device's SoftAP (Linux only,
+                 needs CAP_NET_RAW). Every device uses the same SoftAP address,
+                 so configuring several at once needs one interface per device.
+    netName, netPass, mqttSrvAdr, mqttSrvPort, mqttUser, mqttPass,
+    mqttClient, mqttTopic, audioNotif, visualNotif, adminPass, fwHost,
+    mqttImport
+                 Preference values. Empty cells are not sent, so the device
+                 keeps its current value.
+
+Only the Python standard library is used:
+
+    python3 tools/provision.py devices.csv --workers 8 --wait-restart
+"""
+
+import argparse
+import csv
+import http.client
+import json
+import socket
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+DEFAULT_ADDRESS = "192.168.4.1"
+DEFAULT_PORT = 80
+
+# Preference keys and their types, as served by /api/config.
+STRING_KEYS = ["netName", "netPass", "mqttSrvAdr", "mqttUser", "mqttPass", "mqttClient", "mqttTopic", "adminPass", "fwHost"]
+NUMBER_KEYS = ["mqttSrvPort"]
+BOOLEAN_KEYS = ["audioNotif", "visualNotif", "mqttImport"]
+
+# Keys of secrets, served as null so they never leave the device.
+SECRET_KEYS = ["netPass", "mqttPass", "adminPass"]
+
+
+class ProvisioningError(Exception):
+    """A failure that retrying can not fix, such as rejected values."""
+
+
+class InterfaceConnection(http.client.HTTPConnection):
+    """HTTP connection optionally bound to a network interface."""
+
+    def __init__(self, host, port, interface, timeout):
+        super().__init__(host, port, timeout=timeout)
+        self.interface = interface
+
+    def connect(self):
+        if not self.interface:
+            super().connect()
+            return
+
+        # Bind before connecting, so the SYN leaves through the interface joined to this device.
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_BINDTODEVICE, self.interface.encode() + b"\0")
+        self.sock.settimeout(self.timeout)
+        self.sock.connect((self.host, self.port))
+
+
+def parse_boolean(value):
+    """Convert a manifest cell such as true, 1, yes or on to a boolean."""
+    normalized = value.strip().lower()
+
+    if normalized in ("1", "true", "yes", "on"):
+        return True
+
+    if normalized in ("0", "false", "no", "off"):
+        return False
+
+    raise ValueError("not a boolean: %r" % value)
+
+
+def desired_configuration(row):
+    """Build the JSON object for /api/config from the non-empty cells of a manifest row."""
+    configuration = {}
+
+    for key in STRING_KEYS:
+        if row.get(key):
+            configuration[key] = row[key]
+
+    for key in NUMBER_KEYS:
+        if row.get(key):
+            configuration[key] = int(row[key])
+
+    for key in BOOLEAN_KEYS:
+        if row.get(key):
+            configuration[key] = parse_boolean(row[key])
+
+    return configuration
+
+
+def request(row, method, body, timeout):
+    """Send one request to a device and return the status and decoded JSON body."""
+    connection = InterfaceConnection(row.get("address") or DEFAULT_ADDRESS,
+                                     int(row.get("port") or DEFAULT_PORT),
+                                     row.get("interface"), timeout)
+
+    try:
+        headers = {"Content-Type": "application/json", "Connection": "close"}
+        connection.request(method, "/api/config", body=json.dumps(body) if body is not None else None, headers=headers)
+        response = connection.getresponse()
+        return response.status, json.loads(response.read() or b"null")
+    finally:
+        connection.close()
+
+
+def wait_for_restart(row, timeout):
+    """Poll the configuration server until it stops answering, which means the device left configuration mode."""
+    deadline = time.monotonic() + timeout
+
+    while time.monotonic() < deadline:
+        try:
+            request(row, "GET", None, 2)
+        except (OSError, http.client.HTTPException):
+            return True
+
+        time.sleep(0.5)
+
+    return False
+
+
+def provision(row, args):
+    """Configure one device and return its report entry."""
+    started = time.monotonic()
+    result = {"device": row["device"], "attempts": 0, "status": "failed", "detail": ""}
+
+    try:
+        configuration = desired_configuration(row)
+    except ValueError as error:
+        result["detail"] = "invalid manifest row: %s" % error
+        return result
+
+    for attempt in range(1, args.retries + 2):
+        result["attempts"] = attempt
+
+        try:
+            status, effective = request(row, "PUT", configuration, args.timeout)
+
+            # Validation errors are reported by the device and will not go away by retrying.
+            if status == 400:
+                raise ProvisioningError(json.dumps(effective))
+
+            if status != 200:
+                raise OSError("HTTP status %d" % status)
+
+            mismatches = [key for key, value in configuration.items() if key not in SECRET_KEYS and effective.get(key) != value]
+
+            if mismatches:
+                raise ProvisioningError("device reports different values for %s" % ", ".join(mismatches))
+
+            result["status"] = "configured"
+            break
+        except ProvisioningError as error:
+            result["detail"] = str(error)
+            break
+        except (OSError, ValueError, http.client.HTTPException) as error:
+            result["detail"] = str(error)
+
+            # Back off before the next attempt, the SoftAP may still be starting.
+            if attempt <= args.retries:
+                time.sleep(min(2 ** (attempt - 1), 8))
+
+    if result["status"] == "configured" and args.wait_restart:
+        if wait_for_restart(row, args.restart_timeout):
+            result["status"] = "restarted"
+        else:
+            result["status"] = "failed"
+            result["detail"] = "device did not restart within %d s" % args.restart_timeout
+
+    result["seconds"] = time.monotonic() - started
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Configure SMAF-Development-Kit devices in parallel.")
+    parser.add_argument("manifest", help="CSV manifest with one device per row")
+    parser.add_argument("--workers", type=int, default=8, help="devices configured at the same time")
+    parser.add_argument("--retries", type=int, default=3, help="retries per device after transient failures")
+    parser.add_argument("--timeout", type=float, default=5, help="request timeout in seconds")
+    parser.add_argument("--wait-restart", action="store_true", help="wait until each device leaves configuration mode")
+    parser.add_argument("--restart-timeout", type=int, default=15, help="seconds to wait for the restart")
+    args = parser.parse_args()
+
+    with open(args.manifest, newline="") as manifest:
+        rows = [row for row in csv.DictReader(manifest) if row.get("device")]
+
+    started = time.monotonic()
+
+    with ThreadPoolExecutor(max_workers=max(1, args.workers)) as executor:
+        results = list(executor.map(lambda row: provision(row, args), rows))
+
+    for result in results:
+        print("%-24s %-10s %d attempt(s) %6.2f s  %s" % (result["device"], result["status"], result["attempts"],
+                                                         result.get("seconds", 0), result["detail"]))
+
+    failed = sum(1 for result in results if result["status"] == "failed")
+    print("%d of %d devices configured in %.2f s." % (len(results) - failed, len(results), time.monotonic() - started))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())